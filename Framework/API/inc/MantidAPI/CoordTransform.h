@@ -34,6 +34,9 @@ public:
   virtual CoordTransform *clone() const = 0;
   virtual std::string id() const = 0;
 
+  virtual void applyBlock(const coord_t *inputs, coord_t *outputs,
+                          const size_t numPoints) const;
+
   /// Wrapper for VMD
   Mantid::Kernel::VMD applyVMD(const Mantid::Kernel::VMD &inputVector) const;
 
@@ -19,6 +19,7 @@ namespace Mantid {
 // Forward declaration
 //---------------------------------------------------------------------------
 namespace Geometry {
+class Parameter;
 class ParameterMap;
 class XMLInstrumentParameter;
 }
@@ -177,8 +178,12 @@ protected:
 
 private:
   /// Fill with given instrument parameter
-  void populateWithParameter(Geometry::ParameterMap &paramMap,
-                             const std::string &name,
+  void populateWithParameter(
+      Geometry::ParameterMap &paramMap,
+      std::vector<std::pair<const Geometry::IComponent *,
+                            boost::shared_ptr<Geometry::Parameter>>> &
+          newParameters,
+      const std::string &name,
                              const Geometry::XMLInstrumentParameter &paramInfo,
                              const Run &runData);
 
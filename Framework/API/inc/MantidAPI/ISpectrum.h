@@ -72,6 +72,8 @@ public:
 
   virtual MantidVecPtr ptrX() const;
   virtual MantidVecPtr ptrDx() const;
+  virtual MantidVecPtr ptrY() const;
+  virtual MantidVecPtr ptrE() const;
 
   virtual void setData(const MantidVec &Y) = 0;
   virtual void setData(const MantidVec &Y, const MantidVec &E) = 0;
@@ -251,6 +251,16 @@ public:
     return getSpectrum(index).ptrDx();
   }
 
+  /// Returns a pointer to the y data
+  virtual Kernel::cow_ptr<MantidVec> refY(const std::size_t index) const {
+    return getSpectrum(index).ptrY();
+  }
+
+  /// Returns a pointer to the error data
+  virtual Kernel::cow_ptr<MantidVec> refE(const std::size_t index) const {
+    return getSpectrum(index).ptrE();
+  }
+
   /// Set the specified X array to point to the given existing array
   virtual void setX(const std::size_t index, const MantidVec &X) {
     getSpectrum(index).setX(X);
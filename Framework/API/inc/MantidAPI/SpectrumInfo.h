@@ -0,0 +1,149 @@
+#ifndef MANTID_API_SPECTRUMINFO_H_
+#define MANTID_API_SPECTRUMINFO_H_
+
+#include "MantidAPI/DllConfig.h"
+#include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidKernel/V3D.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+class MatrixWorkspace;
+
+/** SpectrumInfo provides flat, index-addressable access to the geometry of
+  all spectra of a MatrixWorkspace: L1, L2, 2-theta, phi, position, mask and
+  monitor flags.
+
+  In contrast to GeometryInfo, which builds a (parametrized) detector or
+  DetectorGroup for every call, SpectrumInfo computes all values for all
+  spectra once on construction (in parallel) and stores them in contiguous
+  arrays. Access in a loop is then a simple array lookup. Values for spectra
+  with more than one detector are averaged in the same way as
+  Geometry::DetectorGroup does.
+
+  Usage:
+  ~~~{.cpp}
+  const SpectrumInfo spectrumInfo(*inputWorkspace);
+  PARALLEL_FOR1(inputWorkspace)
+  for (int64_t i = 0; i < numberOfHistograms; ++i) {
+    if (!spectrumInfo.hasDetectors(i) || spectrumInfo.isMasked(i))
+      continue;
+    const auto l2 = spectrumInfo.l2(i);
+    const auto twoTheta = spectrumInfo.twoTheta(i);
+    // Your code
+  }
+  ~~~
+
+  The values are a snapshot: changes to the instrument, its parameters or the
+  spectrum-detector mapping made after construction are not reflected.
+
+  Copyright &copy; 2016 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_API_DLL SpectrumInfo {
+public:
+  explicit SpectrumInfo(const MatrixWorkspace &workspace);
+
+  /// Returns the number of spectra.
+  size_t size() const { return m_hasDetectors.size(); }
+
+  /// Returns true if the spectrum is associated with at least one detector
+  /// that is known to the instrument.
+  bool hasDetectors(const size_t index) const {
+    return m_hasDetectors[index] != 0;
+  }
+  /// Returns true if the spectrum is a monitor (all its detectors are).
+  bool isMonitor(const size_t index) const {
+    checkDetectors(index);
+    return m_isMonitor[index] != 0;
+  }
+  /// Returns true if the spectrum is masked (all its detectors are).
+  bool isMasked(const size_t index) const {
+    checkDetectors(index);
+    return m_isMasked[index] != 0;
+  }
+  /// Returns L1 (distance from source to sample).
+  double l1() const { return m_detectorInfo.l1(); }
+  /** Returns L2 (distance from sample to spectrum).
+   *
+   * For monitors this is defined such that L1+L2 = source-detector distance,
+   * i.e., for a monitor in the beamline between source and sample L2 is
+   * negative. */
+  double l2(const size_t index) const {
+    checkDetectors(index);
+    return m_l2[index];
+  }
+  /// Returns 2 theta (angle w.r.t. to beam direction).
+  double twoTheta(const size_t index) const {
+    checkDetectors(index);
+    checkBeamline();
+    return m_twoTheta[index];
+  }
+  /// Returns signed 2 theta (signed angle w.r.t. to beam direction).
+  double signedTwoTheta(const size_t index) const {
+    checkDetectors(index);
+    checkBeamline();
+    return m_signedTwoTheta[index];
+  }
+  /// Returns the azimuthal angle phi (in radians) of the spectrum position.
+  double phi(const size_t index) const {
+    checkDetectors(index);
+    return m_phi[index];
+  }
+  /// Returns the (average) position of the spectrum.
+  const Kernel::V3D &position(const size_t index) const {
+    checkDetectors(index);
+    return m_positions[index];
+  }
+
+  /// Returns the underlying per-detector information.
+  const Geometry::DetectorInfo &detectorInfo() const { return m_detectorInfo; }
+
+private:
+  void checkDetectors(const size_t index) const {
+    if (!m_hasDetectors[index])
+      throwNoDetectors(index);
+  }
+  void checkBeamline() const {
+    if (m_nullBeamline)
+      throwNullBeamline();
+  }
+  [[noreturn]] void throwNoDetectors(const size_t index) const;
+  [[noreturn]] void throwNullBeamline() const;
+
+  const Geometry::DetectorInfo m_detectorInfo;
+  bool m_nullBeamline;
+  std::vector<uint8_t> m_hasDetectors;
+  std::vector<uint8_t> m_isMonitor;
+  std::vector<uint8_t> m_isMasked;
+  std::vector<double> m_l2;
+  std::vector<double> m_twoTheta;
+  std::vector<double> m_signedTwoTheta;
+  std::vector<double> m_phi;
+  std::vector<Kernel::V3D> m_positions;
+};
+
+} // namespace API
+} // namespace Mantid
+
+#endif /* MANTID_API_SPECTRUMINFO_H_ */
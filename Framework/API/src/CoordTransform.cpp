@@ -6,6 +6,7 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/format.hpp>
 #include "MantidKernel/VMD.h"
+#include <vector>
 
 using namespace Mantid::Geometry;
 using namespace Mantid::Kernel;
@@ -52,5 +53,30 @@ CoordTransform::applyVMD(const Mantid::Kernel::VMD &inputVector) const {
   return out;
 }
 
+//----------------------------------------------------------------------------------------------
+/** Apply the transformation to a block of points, stored one dimension after
+ * the other: coordinate d of point i is at [d * numPoints + i] of the inputs
+ * and of the outputs.
+ *
+ * This calls apply() for each point. Subclasses override it with a loop over
+ * the points for each dimension, which the compiler can vectorize.
+ *
+ * @param inputs :: inD * numPoints input coordinates
+ * @param outputs :: outD * numPoints output coordinates
+ * @param numPoints :: number of points
+ */
+void CoordTransform::applyBlock(const coord_t *inputs, coord_t *outputs,
+                                const size_t numPoints) const {
+  std::vector<coord_t> inputVector(inD);
+  std::vector<coord_t> outVector(outD);
+  for (size_t i = 0; i < numPoints; ++i) {
+    for (size_t d = 0; d < inD; ++d)
+      inputVector[d] = inputs[d * numPoints + i];
+    this->apply(inputVector.data(), outVector.data());
+    for (size_t d = 0; d < outD; ++d)
+      outputs[d * numPoints + i] = outVector[d];
+  }
+}
+
 } // namespace Mantid
 } // namespace API
@@ -261,6 +261,9 @@ void ExperimentInfo::populateInstrumentParameters() {
 
   const double deg2rad(M_PI / 180.0);
   std::map<const IComponent *, RTP> rtpParams;
+  // Parameters that are added to the map at once, see populateWithParameter
+  std::vector<ParameterMap::ComponentParameter> newParameters;
+  newParameters.reserve(paramInfoFromIDF.size());
 
   auto cacheEnd = paramInfoFromIDF.end();
   for (auto cacheItr = paramInfoFromIDF.begin(); cacheItr != cacheEnd;
@@ -289,6 +292,8 @@ void ExperimentInfo::populateInstrumentParameters() {
         }
         if (rtpValues.haveRadius) // Just overwrite x,y,z
         {
+          paramMap.add(newParameters);
+          newParameters.clear();
           // convert spherical coordinates to Cartesian coordinate values
           double x = rtpValues.radius * std::sin(rtpValues.theta) *
                      std::cos(rtpValues.phi);
@@ -300,7 +305,8 @@ void ExperimentInfo::populateInstrumentParameters() {
           paramMap.addPositionCoordinate(paramInfo->m_component, "z", z);
         }
       } else {
-        populateWithParameter(paramMap, paramN, *paramInfo, runData);
+        populateWithParameter(paramMap, newParameters, paramN, *paramInfo,
+                              runData);
       }
     } catch (std::exception &exc) {
       g_log.information() << "Unable to add component parameter '"
@@ -308,6 +314,7 @@ void ExperimentInfo::populateInstrumentParameters() {
       continue;
     }
   }
+  paramMap.add(newParameters);
 }
 
 //---------------------------------------------------------------------------------------
@@ -1130,6 +1137,7 @@ void ExperimentInfo::readParameterMap(const std::string &parameterStr) {
   options += Mantid::Kernel::StringTokenizer::TOK_TRIM;
   Mantid::Kernel::StringTokenizer splitter(parameterStr, "|", options);
 
+  std::vector<ParameterMap::ComponentParameter> newParameters;
   auto iend = splitter.end();
   // std::string prev_name;
   for (auto itr = splitter.begin(); itr != iend; ++itr) {
@@ -1162,8 +1170,10 @@ void ExperimentInfo::readParameterMap(const std::string &parameterStr) {
     int size = static_cast<int>(tokens.count());
     for (int i = 4; i < size; i++)
       paramValue += ";" + tokens[4];
-    pmap.add(tokens[1], comp, tokens[2], paramValue);
+    newParameters.emplace_back(
+        comp, ParameterMap::makeParameter(tokens[1], tokens[2], paramValue));
   }
+  pmap.add(newParameters);
 }
 
 //------------------------------------------------------------------------------------------------------
@@ -1174,14 +1184,19 @@ void ExperimentInfo::readParameterMap(const std::string &parameterStr) {
  * Fill map with instrument parameter first set in xml file
  * Where this is appropriate a parameter value is dependent on values in a log
  * entry
- * @param paramMap Map to populate
+ * @param paramMap Map to populate, only for the parameters that set the
+ * position or rotation of a component
+ * @param newParameters Other parameters are appended to this, to be added to
+ * the map at once
  * @param name The name of the parameter
  * @param paramInfo A reference to the object describing this parameter
  * @param runData A reference to the run object, which stores log value entries
  */
 void ExperimentInfo::populateWithParameter(
-    Geometry::ParameterMap &paramMap, const std::string &name,
-    const Geometry::XMLInstrumentParameter &paramInfo, const Run &runData) {
+    Geometry::ParameterMap &paramMap,
+    std::vector<Geometry::ParameterMap::ComponentParameter> &newParameters,
+    const std::string &name, const Geometry::XMLInstrumentParameter &paramInfo,
+    const Run &runData) {
   const std::string &category = paramInfo.m_type;
   ParameterValue paramValue(paramInfo,
                             runData); // Defines implicit conversion operator
@@ -1190,12 +1205,17 @@ void ExperimentInfo::populateWithParameter(
   if (!paramInfo.m_description.empty())
     pDescription = &paramInfo.m_description;
 
-  // Some names are special. Values should be convertible to double
+  // Some names are special. Values should be convertible to double. These
+  // depend on the parameters already in the map, so add the others first.
   if (name.compare("x") == 0 || name.compare("y") == 0 ||
       name.compare("z") == 0) {
+    paramMap.add(newParameters);
+    newParameters.clear();
     paramMap.addPositionCoordinate(paramInfo.m_component, name, paramValue);
   } else if (name.compare("rot") == 0 || name.compare("rotx") == 0 ||
              name.compare("roty") == 0 || name.compare("rotz") == 0) {
+    paramMap.add(newParameters);
+    newParameters.clear();
     paramMap.addRotationParam(paramInfo.m_component, name, paramValue,
                               pDescription);
   } else if (category.compare("fitting") == 0) {
@@ -1206,17 +1226,32 @@ void ExperimentInfo::populateWithParameter(
         << " , " << paramInfo.m_tie << " , " << paramInfo.m_formula << " , "
         << paramInfo.m_formulaUnit << " , " << paramInfo.m_resultUnit << " , "
         << (*(paramInfo.m_interpolation));
-    paramMap.add("fitting", paramInfo.m_component, name, str.str(),
-                 pDescription);
+    newParameters.emplace_back(
+        paramInfo.m_component,
+        ParameterMap::makeParameter("fitting", name, str.str(), pDescription));
   } else if (category.compare("string") == 0) {
-    paramMap.addString(paramInfo.m_component, name, paramInfo.m_value,
-                       pDescription);
+    newParameters.emplace_back(
+        paramInfo.m_component,
+        ParameterMap::makeParameter<std::string>(
+            ParameterMap::pString(), name, paramInfo.m_value, pDescription));
   } else if (category.compare("bool") == 0) {
-    paramMap.addBool(paramInfo.m_component, name, paramValue, pDescription);
+    newParameters.emplace_back(paramInfo.m_component,
+                               ParameterMap::makeParameter<bool>(
+                                   ParameterMap::pBool(), name,
+                                   static_cast<bool>(paramValue),
+                                   pDescription));
   } else if (category.compare("int") == 0) {
-    paramMap.addInt(paramInfo.m_component, name, paramValue, pDescription);
+    newParameters.emplace_back(
+        paramInfo.m_component,
+        ParameterMap::makeParameter<int>(ParameterMap::pInt(), name,
+                                         static_cast<int>(paramValue),
+                                         pDescription));
   } else { // assume double
-    paramMap.addDouble(paramInfo.m_component, name, paramValue, pDescription);
+    newParameters.emplace_back(
+        paramInfo.m_component,
+        ParameterMap::makeParameter<double>(ParameterMap::pDouble(), name,
+                                            static_cast<double>(paramValue),
+                                            pDescription));
   }
 }
 
@@ -113,6 +113,22 @@ MantidVecPtr ISpectrum::ptrDx() const {
   return refDx;
 }
 
+/** Returns a pointer to the y data. Spectra that do not store the y data in
+ * a reference counted vector return a pointer to a copy of it. */
+MantidVecPtr ISpectrum::ptrY() const {
+  MantidVecPtr y;
+  y.access() = this->dataY();
+  return y;
+}
+
+/** Returns a pointer to the y error data. Spectra that do not store the
+ * errors in a reference counted vector return a pointer to a copy of them. */
+MantidVecPtr ISpectrum::ptrE() const {
+  MantidVecPtr e;
+  e.access() = this->dataE();
+  return e;
+}
+
 // =============================================================================================
 // --------------------------------------------------------------------------
 /** Add a detector ID to the set of detector IDs
@@ -0,0 +1,114 @@
+#include "MantidAPI/SpectrumInfo.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidKernel/Exception.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/Tolerance.h"
+
+#include <cmath>
+
+namespace Mantid {
+namespace API {
+
+/** Compute the geometry of all spectra of a workspace.
+ *
+ * @param workspace :: The workspace. Its instrument must define a source and
+ * a sample.
+ * @throw Kernel::Exception::InstrumentDefinitionError if the instrument does
+ * not have a source or sample.
+ */
+SpectrumInfo::SpectrumInfo(const MatrixWorkspace &workspace)
+    : m_detectorInfo(*workspace.getInstrument()), m_nullBeamline(false) {
+  const size_t numberOfSpectra = workspace.getNumberHistograms();
+  m_hasDetectors.resize(numberOfSpectra, 0);
+  m_isMonitor.resize(numberOfSpectra, 0);
+  m_isMasked.resize(numberOfSpectra, 0);
+  m_l2.resize(numberOfSpectra, 0.0);
+  m_twoTheta.resize(numberOfSpectra, 0.0);
+  m_signedTwoTheta.resize(numberOfSpectra, 0.0);
+  m_phi.resize(numberOfSpectra, 0.0);
+  m_positions.resize(numberOfSpectra);
+
+  const auto &detInfo = m_detectorInfo;
+  const Kernel::V3D sourcePos = detInfo.sourcePosition();
+  const Kernel::V3D samplePos = detInfo.samplePosition();
+  const double l1 = detInfo.l1();
+  const Kernel::V3D beamLine = samplePos - sourcePos;
+  m_nullBeamline = beamLine.nullVector();
+  const Kernel::V3D normToSurface =
+      beamLine.cross_prod(detInfo.upDirection());
+
+  const int64_t numberOfSpectra_i = static_cast<int64_t>(numberOfSpectra);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < numberOfSpectra_i; ++i) {
+    const auto &detIDs = workspace.getSpectrum(i).getDetectorIDs();
+    if (detIDs.empty())
+      continue;
+
+    // Same conventions as Geometry::DetectorGroup: a group is a monitor or
+    // masked only if all its members are, all other values are averages.
+    bool allKnown = true;
+    bool isMonitor = true;
+    bool isMasked = true;
+    Kernel::V3D position;
+    double sampleDistance = 0.0;
+    double sourceDistance = 0.0;
+    double twoTheta = 0.0;
+    double signedTwoTheta = 0.0;
+    for (const auto detID : detIDs) {
+      if (!detInfo.contains(detID)) {
+        allKnown = false;
+        break;
+      }
+      const size_t index = detInfo.indexOf(detID);
+      const Kernel::V3D &detPos = detInfo.position(index);
+      isMonitor &= detInfo.isMonitor(index);
+      isMasked &= detInfo.isMasked(index);
+      position += detPos;
+      sampleDistance += detPos.distance(samplePos);
+      sourceDistance += detPos.distance(sourcePos);
+      if (!m_nullBeamline) {
+        const Kernel::V3D sampleDetVec = detPos - samplePos;
+        const double angle = sampleDetVec.angle(beamLine);
+        twoTheta += angle;
+        const Kernel::V3D cross = beamLine.cross_prod(sampleDetVec);
+        signedTwoTheta += normToSurface.scalar_prod(cross) < 0 ? -angle : angle;
+      }
+    }
+    if (!allKnown)
+      continue;
+
+    const double n = static_cast<double>(detIDs.size());
+    if (detIDs.size() > 1) {
+      // Very small components should be zero, see DetectorGroup::getPos().
+      for (size_t k = 0; k < 3; ++k)
+        if (std::abs(position[k]) < Kernel::Tolerance)
+          position[k] = 0.0;
+    }
+    position /= n;
+
+    m_hasDetectors[i] = 1;
+    m_isMonitor[i] = isMonitor;
+    m_isMasked[i] = isMasked;
+    m_l2[i] = isMonitor ? sourceDistance / n - l1 : sampleDistance / n;
+    m_twoTheta[i] = twoTheta / n;
+    m_signedTwoTheta[i] = signedTwoTheta / n;
+    double r, theta, phi;
+    position.getSpherical(r, theta, phi);
+    m_phi[i] = phi * M_PI / 180.0;
+    m_positions[i] = position;
+  }
+}
+
+void SpectrumInfo::throwNoDetectors(const size_t index) const {
+  throw Kernel::Exception::NotFoundError(
+      "SpectrumInfo: No detectors for this workspace index.", index);
+}
+
+void SpectrumInfo::throwNullBeamline() const {
+  throw Kernel::Exception::InstrumentDefinitionError(
+      "Source and sample are at same position!");
+}
+
+} // namespace API
+} // namespace Mantid
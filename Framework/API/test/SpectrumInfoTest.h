@@ -0,0 +1,145 @@
+#ifndef MANTID_API_SPECTRUMINFOTEST_H_
+#define MANTID_API_SPECTRUMINFOTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/GeometryInfo.h"
+#include "MantidAPI/SpectrumInfo.h"
+#include "MantidGeometry/Instrument/ParameterMap.h"
+#include "MantidKernel/Exception.h"
+
+#include "MantidTestHelpers/FakeObjects.h"
+#include "MantidTestHelpers/InstrumentCreationHelper.h"
+
+using namespace Mantid;
+using namespace Mantid::Geometry;
+using namespace Mantid::API;
+
+class SpectrumInfoTest : public CxxTest::TestSuite {
+public:
+  static SpectrumInfoTest *createSuite() { return new SpectrumInfoTest(); }
+  static void destroySuite(SpectrumInfoTest *suite) { delete suite; }
+
+  SpectrumInfoTest() : m_workspace(nullptr) {
+    size_t numberOfHistograms = 5;
+    size_t numberOfBins = 1;
+    m_workspace.init(numberOfHistograms, numberOfBins, numberOfBins - 1);
+
+    bool includeMonitors = true;
+    bool startYNegative = true;
+    const std::string instrumentName("SimpleFakeInstrument");
+    InstrumentCreationHelper::addFullInstrumentToWorkspace(
+        m_workspace, includeMonitors, startYNegative, instrumentName);
+
+    std::set<int64_t> toMask{0, 3};
+    ParameterMap &pmap = m_workspace.instrumentParameters();
+    for (size_t i = 0; i < m_workspace.getNumberHistograms(); ++i) {
+      if (toMask.find(i) != toMask.end()) {
+        IDetector_const_sptr det = m_workspace.getDetector(i);
+        pmap.addBool(det.get(), "masked", true);
+      }
+    }
+  }
+
+  void test_size() {
+    SpectrumInfo info(m_workspace);
+    TS_ASSERT_EQUALS(info.size(), 5);
+    TS_ASSERT_EQUALS(info.detectorInfo().size(), 5);
+  }
+
+  void test_isMonitor() {
+    SpectrumInfo info(m_workspace);
+    TS_ASSERT_EQUALS(info.isMonitor(0), false);
+    TS_ASSERT_EQUALS(info.isMonitor(1), false);
+    TS_ASSERT_EQUALS(info.isMonitor(2), false);
+    TS_ASSERT_EQUALS(info.isMonitor(3), true);
+    TS_ASSERT_EQUALS(info.isMonitor(4), true);
+  }
+
+  void test_isMasked() {
+    SpectrumInfo info(m_workspace);
+    TS_ASSERT_EQUALS(info.isMasked(0), true);
+    TS_ASSERT_EQUALS(info.isMasked(1), false);
+    TS_ASSERT_EQUALS(info.isMasked(2), false);
+    TS_ASSERT_EQUALS(info.isMasked(3), true);
+    TS_ASSERT_EQUALS(info.isMasked(4), false);
+  }
+
+  void test_l1() {
+    SpectrumInfo info(m_workspace);
+    TS_ASSERT_EQUALS(info.l1(), 20.0);
+  }
+
+  void test_l2() {
+    SpectrumInfo info(m_workspace);
+    double x2 = 5.0 * 5.0;
+    double y2 = 2.0 * 2.0 * 0.05 * 0.05;
+    TS_ASSERT_DELTA(info.l2(0), sqrt(x2 + 1 * 1 * y2), 1e-12);
+    TS_ASSERT_DELTA(info.l2(1), sqrt(x2 + 0 * 0 * y2), 1e-12);
+    TS_ASSERT_DELTA(info.l2(2), sqrt(x2 + 1 * 1 * y2), 1e-12);
+    TS_ASSERT_DELTA(info.l2(3), -9.0, 1e-12);
+    TS_ASSERT_DELTA(info.l2(4), -2.0, 1e-12);
+  }
+
+  void test_twoTheta() {
+    SpectrumInfo info(m_workspace);
+    TS_ASSERT_DELTA(info.twoTheta(0), 0.0199973, 1e-6);
+    TS_ASSERT_DELTA(info.twoTheta(1), 0.0, 1e-6);
+    TS_ASSERT_DELTA(info.twoTheta(2), 0.0199973, 1e-6);
+  }
+
+  void test_signedTwoTheta() {
+    SpectrumInfo info(m_workspace);
+    TS_ASSERT_DELTA(info.signedTwoTheta(0), -0.0199973, 1e-6);
+    TS_ASSERT_DELTA(info.signedTwoTheta(1), 0.0, 1e-6);
+    TS_ASSERT_DELTA(info.signedTwoTheta(2), 0.0199973, 1e-6);
+  }
+
+  void test_matches_GeometryInfo() {
+    SpectrumInfo info(m_workspace);
+    GeometryInfoFactory factory(m_workspace);
+    for (size_t i = 0; i < 3; ++i) {
+      auto geometry = factory.create(i);
+      TS_ASSERT_DELTA(info.l2(i), geometry.getL2(), 1e-12);
+      TS_ASSERT_DELTA(info.twoTheta(i), geometry.getTwoTheta(), 1e-12);
+      TS_ASSERT_DELTA(info.signedTwoTheta(i), geometry.getSignedTwoTheta(),
+                      1e-12);
+      TS_ASSERT_DELTA(info.phi(i), geometry.getDetector()->getPhi(), 1e-12);
+      TS_ASSERT_EQUALS(info.position(i), geometry.getDetector()->getPos());
+    }
+  }
+
+  void test_grouped_spectrum_averages_like_DetectorGroup() {
+    WorkspaceTester ws;
+    ws.init(3, 1, 0);
+    InstrumentCreationHelper::addFullInstrumentToWorkspace(
+        ws, false, true, "SimpleFakeInstrument");
+    // Group the detectors of the first two spectra into the first spectrum.
+    const auto secondID = *ws.getSpectrum(1).getDetectorIDs().begin();
+    ws.getSpectrum(0).addDetectorID(secondID);
+    SpectrumInfo info(ws);
+    auto group = ws.getDetector(0);
+    const auto sample = ws.getInstrument()->getSample();
+    TS_ASSERT_DELTA(info.l2(0), group->getDistance(*sample), 1e-12);
+    TS_ASSERT_EQUALS(info.position(0), group->getPos());
+    TS_ASSERT_DELTA(info.twoTheta(0), ws.detectorTwoTheta(*group), 1e-12);
+  }
+
+  void test_spectrum_without_detectors_throws() {
+    WorkspaceTester ws;
+    ws.init(3, 1, 0);
+    InstrumentCreationHelper::addFullInstrumentToWorkspace(
+        ws, false, true, "SimpleFakeInstrument");
+    ws.getSpectrum(1).clearDetectorIDs();
+    SpectrumInfo info(ws);
+    TS_ASSERT(info.hasDetectors(0));
+    TS_ASSERT(!info.hasDetectors(1));
+    TS_ASSERT_THROWS(info.l2(1), Kernel::Exception::NotFoundError);
+    TS_ASSERT_THROWS(info.isMasked(1), Kernel::Exception::NotFoundError);
+  }
+
+private:
+  WorkspaceTester m_workspace;
+};
+
+#endif /* MANTID_API_SPECTRUMINFOTEST_H_ */
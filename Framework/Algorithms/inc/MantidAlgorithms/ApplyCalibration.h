@@ -69,10 +69,10 @@ private:
   void init() override;
   /// Overwrites Algorithm method
   void exec() override;
-  /// Set the detector position from the calibration table
-  void setDetectorPosition(const Geometry::Instrument_const_sptr &instrument,
-                           const int detID, Mantid::Kernel::V3D pos,
-                           bool sameParent);
+  /// Create the position parameter of a detector from the calibration table
+  Geometry::ParameterMap::ComponentParameter
+  newDetectorPosition(const Geometry::Instrument_const_sptr &instrument,
+                      const int detID, const Mantid::Kernel::V3D &pos);
 
   /// A pointer to the parameter map being modified
   Geometry::ParameterMap *m_pmap;
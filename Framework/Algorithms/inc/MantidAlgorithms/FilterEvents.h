@@ -106,6 +106,12 @@ private:
   /// Set up detector calibration parameters from customized values
   void setupCustomizedTOFCorrection();
 
+  /// Compile the splitters for looking up the output of each event
+  Kernel::TimeSplitterIndex createSplitterIndex() const;
+
+  /// Output event lists of a spectrum, in the order of m_outputWS
+  std::vector<DataObjects::EventList *> getOutputEventLists(size_t iws);
+
   /// Filter events by splitters in format of Splitter
   void filterEventsBySplitters(double progressamount);
 
@@ -140,7 +146,7 @@ private:
 
   std::vector<std::string> getTimeSeriesLogNames();
 
-  Kernel::TimeSplitterType generateSplitters(int wsindex);
+  std::map<int, Kernel::TimeSplitterType> generateSplitters() const;
 
   void splitLog(DataObjects::EventWorkspace_sptr eventws, std::string logname,
                 Kernel::TimeSplitterType &splitters);
@@ -26,6 +26,9 @@ struct SofQCommon {
 
   /// Get the efixed value for the given detector
   double getEFixed(const Geometry::IDetector &det) const;
+  /// Get the efixed value for the given spectrum
+  double getEFixed(const API::MatrixWorkspace &workspace,
+                   const size_t index) const;
 };
 }
 }
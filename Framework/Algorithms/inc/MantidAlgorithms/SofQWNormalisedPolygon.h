@@ -11,6 +11,9 @@
 #include "MantidAlgorithms/SofQCommon.h"
 
 namespace Mantid {
+namespace API {
+class SpectrumInfo;
+}
 namespace Algorithms {
 
 /**
@@ -86,10 +89,11 @@ private:
   /// Init variables cache base on the given workspace
   void initCachedValues(const API::MatrixWorkspace_const_sptr &workspace);
   /// Init the theta index
-  void
-  initAngularCachesNonPSD(const API::MatrixWorkspace_const_sptr &workspace);
+  void initAngularCachesNonPSD(const API::MatrixWorkspace_const_sptr &workspace,
+                               const API::SpectrumInfo &spectrumInfo);
   /// Get angles and calculate angular widths.
-  void initAngularCachesPSD(const API::MatrixWorkspace_const_sptr &workspace);
+  void initAngularCachesPSD(const API::MatrixWorkspace_const_sptr &workspace,
+                            const API::SpectrumInfo &spectrumInfo);
 
   /// Create the output workspace
   DataObjects::RebinnedOutput_sptr
@@ -64,32 +64,38 @@ void ApplyCalibration::exec() {
   ColumnVector<V3D> detPos = PosTable->getVector("Detector Position");
   // numDetector needs to be got as the number of rows in the table and the
   // detID got from the (i)th row of table.
+  // The positions are added to the parameter map in one go. Moving a detector
+  // does not move any other detector, so all positions can be computed first.
+  std::vector<Geometry::ParameterMap::ComponentParameter> positions;
+  positions.reserve(numDetector);
   for (size_t i = 0; i < numDetector; ++i) {
-    setDetectorPosition(instrument, detID[i], detPos[i], false);
+    positions.push_back(newDetectorPosition(instrument, detID[i], detPos[i]));
   }
+  m_pmap->add(positions);
   // Ensure pointer is only valid for execution
   m_pmap = nullptr;
 }
 
 /**
-* Set the absolute detector position of a detector
+* Create the parameter for the absolute position of a detector
 * @param instrument :: The instrument that contains the defined detector
 * @param detID :: Detector ID
 * @param pos :: new position of Dectector
-* @param sameParent :: true if detector has same parent as previous detector set
-* here.
+* @return the detector and its new "pos" parameter
 */
-void ApplyCalibration::setDetectorPosition(
-    const Geometry::Instrument_const_sptr &instrument, int detID, V3D pos,
-    bool /*sameParent*/) {
-
+Geometry::ParameterMap::ComponentParameter
+ApplyCalibration::newDetectorPosition(
+    const Geometry::Instrument_const_sptr &instrument, const int detID,
+    const V3D &pos) {
+  using Geometry::ParameterMap;
   IComponent_const_sptr det = instrument->getDetector(detID);
-  ;
-  // Do the move
-  using namespace Geometry::ComponentHelper;
-  TransformType positionType = Absolute;
-  // TransformType positionType = Relative;
-  Geometry::ComponentHelper::moveComponent(*det, *m_pmap, pos, positionType);
+  // The "pos" parameter is relative to the parent of the detector
+  const V3D relativePos = Geometry::ComponentHelper::getRelativePosition(
+      *det, pos, Geometry::ComponentHelper::Absolute);
+  return ParameterMap::ComponentParameter(
+      det->getComponentID(), ParameterMap::makeParameter(
+                                 ParameterMap::pV3D(), ParameterMap::pos(),
+                                 relativePos));
 }
 
 } // namespace Algorithms
@@ -7,6 +7,7 @@
 #include "MantidAPI/CommonBinsValidator.h"
 #include "MantidAPI/HistogramValidator.h"
 #include "MantidAPI/Run.h"
+#include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidAPI/WorkspaceUnitValidator.h"
 #include "MantidDataObjects/Workspace2D.h"
@@ -24,6 +25,7 @@
 
 #include <cfloat>
 #include <limits>
+#include <memory>
 
 namespace Mantid {
 namespace Algorithms {
@@ -348,6 +350,7 @@ void ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
   Instrument_const_sptr instrument = outputWS->getInstrument();
   // Get the parameter map
   const ParameterMap &pmap = outputWS->constInstrumentParameters();
+  const Geometry::ParameterName efixedName("Efixed");
 
   // Get the unit object for each workspace
   Kernel::Unit_const_sptr outputUnit = outputWS->getAxis(0)->unit();
@@ -360,15 +363,11 @@ void ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
                                                "defined: failed to get source "
                                                "and/or sample");
   }
-  double l1;
-  try {
-    l1 = source->getDistance(*sample);
-    g_log.debug() << "Source-sample distance: " << l1 << '\n';
-  } catch (Exception::NotFoundError &) {
-    g_log.error("Unable to calculate source-sample distance");
-    throw Exception::InstrumentDefinitionError(
-        "Unable to calculate source-sample distance", outputWS->getTitle());
-  }
+  // Flat per-spectrum geometry, computed once for all spectra instead of
+  // building a (parametrized) detector for every spectrum in the loop below.
+  const SpectrumInfo spectrumInfo(*outputWS);
+  const double l1 = spectrumInfo.l1();
+  g_log.debug() << "Source-sample distance: " << l1 << '\n';
 
   int failedDetectorCount = 0;
 
@@ -420,10 +419,15 @@ void ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
   bool bUseSignedVersion =
       (!parameters.empty()) &&
       find(parameters.begin(), parameters.end(), "Always") != parameters.end();
-  function<double(const IDetector &)> thetaFunction =
-      bUseSignedVersion
-          ? bind(&MatrixWorkspace::detectorSignedTwoTheta, outputWS, _1)
-          : bind(&MatrixWorkspace::detectorTwoTheta, outputWS, _1);
+
+  // Local copies of the units for each thread. They are initialized for each
+  // spectrum in turn.
+  const int numThreads = PARALLEL_GET_MAX_THREADS;
+  std::vector<std::unique_ptr<Unit>> localFromUnits, localOutputUnits;
+  for (int thread = 0; thread < numThreads; ++thread) {
+    localFromUnits.emplace_back(fromUnit->clone());
+    localOutputUnits.emplace_back(outputUnit->clone());
+  }
 
   // Loop over the histograms (detector spectra)
   PARALLEL_FOR1(outputWS)
@@ -431,21 +435,21 @@ void ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
     PARALLEL_START_INTERUPT_REGION
     double efixed = efixedProp;
 
-    try {
-      // Now get the detector object for this histogram
-      IDetector_const_sptr det = outputWS->getDetector(i);
+    if (spectrumInfo.hasDetectors(i)) {
       // Get the sample-detector distance for this detector (in metres)
       double l2, twoTheta;
-      if (!det->isMonitor()) {
-        l2 = det->getDistance(*sample);
+      if (!spectrumInfo.isMonitor(i)) {
+        l2 = spectrumInfo.l2(i);
         // The scattering angle for this detector (in radians).
-        twoTheta = thetaFunction(*det);
+        twoTheta = bUseSignedVersion ? spectrumInfo.signedTwoTheta(i)
+                                     : spectrumInfo.twoTheta(i);
         // If an indirect instrument, try getting Efixed from the geometry
         if (emode == 2) // indirect
         {
           if (efixed == EMPTY_DBL()) {
             try {
-              Parameter_sptr par = pmap.getRecursive(det.get(), "Efixed");
+              IDetector_const_sptr det = outputWS->getDetector(i);
+              Parameter_sptr par = pmap.getRecursive(det.get(), efixedName);
               if (par) {
                 efixed = par->value<double>();
                 g_log.debug() << "Detector: " << det->getID()
@@ -459,8 +463,7 @@ void ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
       } else // If this is a monitor then make l1+l2 = source-detector distance
              // and twoTheta=0
       {
-        l2 = det->getDistance(*source);
-        l2 = l2 - l1;
+        l2 = spectrumInfo.l2(i);
         twoTheta = 0.0;
         efixed = DBL_MIN;
         // Energy transfer is meaningless for a monitor, so set l2 to 0.
@@ -469,10 +472,10 @@ void ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
         }
       }
 
-      // Make local copies of the units. This allows running the loop in
-      // parallel
-      Unit *localFromUnit = fromUnit->clone();
-      Unit *localOutputUnit = outputUnit->clone();
+      // Use the copies of the units of this thread. This allows running the
+      // loop in parallel
+      Unit *localFromUnit = localFromUnits[PARALLEL_THREAD_NUMBER].get();
+      Unit *localOutputUnit = localOutputUnits[PARALLEL_THREAD_NUMBER].get();
 
       /// @todo Don't yet consider hold-off (delta)
       const double delta = 0.0;
@@ -494,12 +497,9 @@ void ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
         //        localOutputUnit->fromTOF(tofs,emptyVec,l1,l2,twoTheta,emode,efixed,delta);
         //        eventWS->getSpectrum(i).setTofs(tofs);
       }
-      // Clear unit memory
-      delete localFromUnit;
-      delete localOutputUnit;
 
-    } catch (Exception::NotFoundError &) {
-      // Get to here if exception thrown when calculating distance to detector
+    } else {
+      // Get to here if there is no detector for this spectrum
       failedDetectorCount++;
       // Since you usually (always?) get to here when there's no attached
       // detectors, this call is
@@ -23,6 +23,8 @@
 #include <algorithm>
 #include <cfloat>
 #include <limits>
+#include <memory>
+#include <unordered_map>
 
 namespace Mantid {
 namespace Algorithms {
@@ -297,6 +299,16 @@ void ConvertUnitsUsingDetectorTable::convertViaTOF(
   std::vector<double> emptyVec;
   int failedDetectorCount = 0;
 
+  // Index the rows of the detector table by their spectrum number
+  std::unordered_map<int, size_t> rowOfSpectrum;
+  rowOfSpectrum.reserve(spectraColumn.size());
+  for (size_t row = 0; row < spectraColumn.size(); ++row)
+    rowOfSpectrum.emplace(spectraColumn[row], row);
+
+  // Local copies of the units, initialized for each spectrum in turn
+  std::unique_ptr<Unit> localFromUnit(fromUnit->clone());
+  std::unique_ptr<Unit> localOutputUnit(outputUnit->clone());
+
   // ConstColumnVector<int> spectraNumber = paramWS->getVector("spectra");
 
   // TODO: Check why this parallel stuff breaks
@@ -323,11 +335,9 @@ void ConvertUnitsUsingDetectorTable::convertViaTOF(
                     << " ==> Workspace ID:" << wsid << '\n';
 
       // Now we need to find the row that contains this spectrum
-      std::vector<int>::iterator specIter;
-
-      specIter = std::find(spectraColumn.begin(), spectraColumn.end(), specNo);
-      if (specIter != spectraColumn.end()) {
-        size_t detectorRow = std::distance(spectraColumn.begin(), specIter);
+      auto rowIter = rowOfSpectrum.find(specNo);
+      if (rowIter != rowOfSpectrum.end()) {
+        size_t detectorRow = rowIter->second;
         double l1 = l1Column[detectorRow];
         double l2 = l2Column[detectorRow];
         double twoTheta = twoThetaColumn[detectorRow] * deg2rad;
@@ -349,10 +359,6 @@ void ConvertUnitsUsingDetectorTable::convertViaTOF(
         g_log.debug() << "\tL1=" << l1 << ",L2=" << l2 << ",TT=" << twoTheta
                       << ",EF=" << efixed << ",EM=" << emode << '\n';
 
-        // Make local copies of the units. This allows running the loop in
-        // parallel
-        Unit *localFromUnit = fromUnit->clone();
-        Unit *localOutputUnit = outputUnit->clone();
         /// @todo Don't yet consider hold-off (delta)
         const double delta = 0.0;
         // Convert the input unit to time-of-flight
@@ -364,11 +370,8 @@ void ConvertUnitsUsingDetectorTable::convertViaTOF(
         // EventWorkspace part, modifying the EventLists.
         if (m_inputEvents) {
           eventWS->getSpectrum(wsid)
-              .convertUnitsViaTof(localFromUnit, localOutputUnit);
+              .convertUnitsViaTof(localFromUnit.get(), localOutputUnit.get());
         }
-        // Clear unit memory
-        delete localFromUnit;
-        delete localOutputUnit;
 
       } else {
         // Not found
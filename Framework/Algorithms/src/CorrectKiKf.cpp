@@ -98,6 +98,7 @@ void CorrectKiKf::exec() {
 
   // Get the parameter map
   const ParameterMap &pmap = outputWS->constInstrumentParameters();
+  const ParameterName efixedName("Efixed");
 
   PARALLEL_FOR2(inputWS, outputWS)
   for (int64_t i = 0; i < int64_t(numberOfSpectra); ++i) {
@@ -113,7 +114,7 @@ void CorrectKiKf::exec() {
           IDetector_const_sptr det = inputWS->getDetector(i);
           if (!det->isMonitor()) {
             try {
-              Parameter_sptr par = pmap.getRecursive(det.get(), "Efixed");
+              Parameter_sptr par = pmap.getRecursive(det.get(), efixedName);
               if (par) {
                 Efi = par->value<double>();
                 g_log.debug() << "Detector: " << det->getID()
@@ -223,6 +224,7 @@ void CorrectKiKf::execEvent() {
 
   // Get the parameter map
   const ParameterMap &pmap = outputWS->constInstrumentParameters();
+  const ParameterName efixedName("Efixed");
 
   int64_t numHistograms = static_cast<int64_t>(inputWS->getNumberHistograms());
   API::Progress prog = API::Progress(this, 0.0, 1.0, numHistograms);
@@ -241,7 +243,7 @@ void CorrectKiKf::execEvent() {
           IDetector_const_sptr det = inputWS->getDetector(i);
           if (!det->isMonitor()) {
             try {
-              Parameter_sptr par = pmap.getRecursive(det.get(), "Efixed");
+              Parameter_sptr par = pmap.getRecursive(det.get(), efixedName);
               if (par) {
                 Efi = par->value<double>();
                 g_log.debug() << "Detector: " << det->getID()
@@ -217,18 +217,19 @@ void DetectorEfficiencyCor::correctForEfficiency(int64_t spectraIn) {
   // Storage for the reciprocal wave vectors that are calculated as the
   // correction proceeds
   std::vector<double> oneOverWaveVectors(yValues.size());
+  static const ParameterName pressureName(PRESSURE_PARAM);
+  static const ParameterName thicknessName(THICKNESS_PARAM);
   for (auto it = dets.cbegin(); it != dets.cend(); ++it) {
     IDetector_const_sptr det_member =
         m_inputWS->getInstrument()->getDetector(*it);
 
     Parameter_sptr par =
-        m_paraMap->getRecursive(det_member->getComponentID(), PRESSURE_PARAM);
+        m_paraMap->getRecursive(det_member->getComponentID(), pressureName);
     if (!par) {
       throw Exception::NotFoundError(PRESSURE_PARAM, spectraIn);
     }
     const double atms = par->value<double>();
-    par =
-        m_paraMap->getRecursive(det_member->getComponentID(), THICKNESS_PARAM);
+    par = m_paraMap->getRecursive(det_member->getComponentID(), thicknessName);
     if (!par) {
       throw Exception::NotFoundError(THICKNESS_PARAM, spectraIn);
     }
@@ -5,6 +5,7 @@
 #include "MantidAPI/ISpectrum.h"
 #include "MantidAPI/RawCountValidator.h"
 #include "MantidAPI/SpectraAxis.h"
+#include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/GroupingWorkspace.h"
@@ -564,6 +565,10 @@ void DiffractionFocussing2::determineRebinParameters() {
     checkForMask = ((instrument->getSource() != nullptr) &&
                     (instrument->getSample() != nullptr));
   }
+  // Mask flags of all spectra, looked up once rather than per detector
+  std::unique_ptr<SpectrumInfo> spectrumInfo;
+  if (checkForMask)
+    spectrumInfo = make_unique<SpectrumInfo>(*m_matrixInputW);
 
   groupAtWorkspaceIndex.resize(nHist);
   for (int wi = 0; wi < nHist;
@@ -577,7 +582,7 @@ void DiffractionFocussing2::determineRebinParameters() {
     // the spectrum is the real thing we want to work with
     const auto &spec = m_matrixInputW->getSpectrum(wi);
     if (checkForMask) {
-      if (instrument->isDetectorMasked(spec.getDetectorIDs())) {
+      if (spectrumInfo->hasDetectors(wi) && spectrumInfo->isMasked(wi)) {
         groupAtWorkspaceIndex[wi] = -1;
         continue;
       }
@@ -7,6 +7,8 @@
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/VectorHelper.h"
 
+#include <boost/make_shared.hpp>
+
 #include <algorithm>
 
 namespace {
@@ -135,9 +137,14 @@ void ExtractSpectra::execHistogram() {
 
   cow_ptr<MantidVec> newX;
   if (m_commonBoundaries) {
-    const MantidVec &oldX =
-        m_inputWorkspace->readX(m_workspaceIndexList.front());
-    newX.access().assign(oldX.begin() + m_minX, oldX.begin() + m_maxX);
+    if (m_croppingInX) {
+      const MantidVec &oldX =
+          m_inputWorkspace->readX(m_workspaceIndexList.front());
+      newX = boost::make_shared<MantidVec>(oldX.begin() + m_minX,
+                                           oldX.begin() + m_maxX);
+    } else {
+      newX = m_inputWorkspace->refX(m_workspaceIndexList.front());
+    }
   }
 
   Progress prog(this, 0.0, 1.0, (m_workspaceIndexList.size()));
@@ -150,27 +157,40 @@ void ExtractSpectra::execHistogram() {
     // Preserve/restore sharing if X vectors are the same
     if (m_commonBoundaries) {
       outputWorkspace->setX(j, newX);
-      if (hasDx) {
-        const MantidVec &oldDx = m_inputWorkspace->readDx(i);
-        outputWorkspace->dataDx(j)
-            .assign(oldDx.begin() + m_minX, oldDx.begin() + m_maxX);
-      }
     } else {
       // Safe to just copy whole vector 'cos can't be cropping in X if not
       // common
       outputWorkspace->setX(j, m_inputWorkspace->refX(i));
+    }
+
+    if (m_commonBoundaries && m_croppingInX) {
+      // Allocate the cropped vectors directly, rather than writing into the
+      // vectors the output workspace shares between its spectra
+      if (hasDx) {
+        const MantidVec &oldDx = m_inputWorkspace->readDx(i);
+        outputWorkspace->setDx(j, boost::make_shared<MantidVec>(
+                                      oldDx.begin() + m_minX,
+                                      oldDx.begin() + m_maxX));
+      }
+      const MantidVec &oldY = m_inputWorkspace->readY(i);
+      const MantidVec &oldE = m_inputWorkspace->readE(i);
+      outputWorkspace->setData(
+          j, boost::make_shared<MantidVec>(oldY.begin() + m_minX,
+                                           oldY.begin() +
+                                               (m_maxX - m_histogram)),
+          boost::make_shared<MantidVec>(oldE.begin() + m_minX,
+                                        oldE.begin() +
+                                            (m_maxX - m_histogram)));
+    } else {
+      // The whole spectrum is kept: share the data with the input until
+      // either of them is modified
       if (hasDx) {
         outputWorkspace->setDx(j, m_inputWorkspace->refDx(i));
       }
+      outputWorkspace->setData(j, m_inputWorkspace->refY(i),
+                               m_inputWorkspace->refE(i));
     }
 
-    const MantidVec &oldY = m_inputWorkspace->readY(i);
-    outputWorkspace->dataY(j)
-        .assign(oldY.begin() + m_minX, oldY.begin() + (m_maxX - m_histogram));
-    const MantidVec &oldE = m_inputWorkspace->readE(i);
-    outputWorkspace->dataE(j)
-        .assign(oldE.begin() + m_minX, oldE.begin() + (m_maxX - m_histogram));
-
     // copy over the axis entry for each spectrum, regardless of the type of
     // axes present
     if (inAxis1) {
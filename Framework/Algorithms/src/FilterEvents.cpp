@@ -16,6 +16,7 @@
 #include "MantidKernel/LogFilter.h"
 #include "MantidKernel/PhysicalConstants.h"
 #include "MantidKernel/ArrayProperty.h"
+#include <limits>
 #include <memory>
 #include <sstream>
 
@@ -832,6 +833,79 @@ void FilterEvents::setupCustomizedTOFCorrection() {
   return;
 }
 
+//----------------------------------------------------------------------------------------------
+/** Compile the splitters into a TimeSplitterIndex. The destination of an
+ * interval is the position of its output workspace in m_outputWS.
+ *
+ * Events outside of all splitters go to the "unfiltered" workspace, except,
+ * for a SplittersWorkspace, the ones after the last splitter, which are not
+ * in any output.
+ */
+Kernel::TimeSplitterIndex FilterEvents::createSplitterIndex() const {
+  std::map<int, int> destinationOfGroup;
+  for (const auto &ws : m_outputWS) {
+    const int destination = static_cast<int>(destinationOfGroup.size());
+    destinationOfGroup.emplace(ws.first, destination);
+  }
+  auto destinationOf = [&destinationOfGroup](const int group) {
+    auto iter = destinationOfGroup.find(group);
+    return iter != destinationOfGroup.end()
+               ? iter->second
+               : TimeSplitterIndex::NO_DESTINATION;
+  };
+  const int unfiltered = destinationOf(-1);
+
+  std::vector<int64_t> boundaries;
+  std::vector<int> destinations(1, unfiltered);
+  if (m_useTableSplitters) {
+    // Splitters [start, stop), sorted by their start. An overlapping splitter
+    // starts where the previous one stops.
+    boundaries.reserve(2 * m_splitters.size());
+    int64_t lastStop = std::numeric_limits<int64_t>::min();
+    for (const auto &splitter : m_splitters) {
+      const int64_t start =
+          std::max(splitter.start().totalNanoseconds(), lastStop);
+      const int64_t stop = splitter.stop().totalNanoseconds();
+      if (stop <= start)
+        continue;
+      boundaries.push_back(start);
+      destinations.push_back(destinationOf(splitter.index()));
+      boundaries.push_back(stop);
+      destinations.push_back(unfiltered);
+      lastStop = stop;
+    }
+    if (!boundaries.empty())
+      destinations.back() = TimeSplitterIndex::NO_DESTINATION;
+  } else {
+    // Splitters (time[i], time[i+1]] of group[i]. The times are integers, so
+    // the intervals are [time[i]+1, time[i+1]+1).
+    boundaries.reserve(m_vecSplitterTime.size());
+    for (const auto time : m_vecSplitterTime)
+      boundaries.push_back(time + 1);
+    for (const auto group : m_vecSplitterGroup)
+      destinations.push_back(destinationOf(group));
+    if (!boundaries.empty())
+      destinations.push_back(unfiltered);
+  }
+
+  return TimeSplitterIndex(std::move(boundaries), std::move(destinations));
+}
+
+//----------------------------------------------------------------------------------------------
+/** Get the output event lists of a spectrum
+ * @param iws :: workspace index of the spectrum
+ * @return the event list of the spectrum in each output workspace, in the
+ * order of m_outputWS
+ */
+std::vector<DataObjects::EventList *>
+FilterEvents::getOutputEventLists(size_t iws) {
+  std::vector<DataObjects::EventList *> outputs;
+  outputs.reserve(m_outputWS.size());
+  for (auto &ws : m_outputWS)
+    outputs.push_back(&ws.second->getSpectrum(iws));
+  return outputs;
+}
+
 //----------------------------------------------------------------------------------------------
 /** Main filtering method
   * Structure: per spectrum --> per workspace
@@ -844,35 +918,28 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
   g_log.debug() << "Number of spectra in input/source EventWorkspace = "
                 << numberOfSpectra << ".\n";
 
-  // FIXME - Turn on parallel:
+  const TimeSplitterIndex splitterIndex = createSplitterIndex();
+
   PARALLEL_FOR_NO_WSP_CHECK()
   for (int64_t iws = 0; iws < int64_t(numberOfSpectra); ++iws) {
     PARALLEL_START_INTERUPT_REGION
 
     // Filter the non-skipped
     if (!m_vecSkip[iws]) {
-      // Get the output event lists (should be empty) to be a map
-      std::map<int, DataObjects::EventList *> outputs;
-      PARALLEL_CRITICAL(build_elist) {
-        for (auto &ws : m_outputWS) {
-          int index = ws.first;
-          auto &output_el = ws.second->getSpectrum(iws);
-          outputs.emplace(index, &output_el);
-        }
-      }
+      // Get the output event lists (should be empty)
+      auto outputs = getOutputEventLists(iws);
 
       // Get a holder on input workspace's event list of this spectrum
       const DataObjects::EventList &input_el = m_eventWS->getSpectrum(iws);
 
       // Perform the filtering (using the splitting function and just one
       // output)
-      if (m_FilterByPulseTime) {
-        input_el.splitByPulseTime(m_splitters, outputs);
-      } else if (m_tofCorrType != NoneCorrect) {
-        input_el.splitByFullTime(m_splitters, outputs, true,
-                                 m_detTofFactors[iws], m_detTofOffsets[iws]);
+      if (m_tofCorrType != NoneCorrect) {
+        input_el.splitByTimeIndex(splitterIndex, outputs, m_FilterByPulseTime,
+                                  m_detTofFactors[iws], m_detTofOffsets[iws]);
       } else {
-        input_el.splitByFullTime(m_splitters, outputs, false, 1.0, 0.0);
+        input_el.splitByTimeIndex(splitterIndex, outputs, m_FilterByPulseTime,
+                                  1.0, 0.0);
       }
     }
 
@@ -896,12 +963,13 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
 
   double numws = static_cast<double>(m_outputWS.size());
   double outwsindex = 0.;
+  auto splittersOfGroups = generateSplitters();
   for (auto &ws : m_outputWS) {
     int wsindex = ws.first;
     DataObjects::EventWorkspace_sptr opws = ws.second;
 
-    // Generate a list of splitters for current output workspace
-    Kernel::TimeSplitterType splitters = generateSplitters(wsindex);
+    // The list of splitters for current output workspace
+    Kernel::TimeSplitterType &splitters = splittersOfGroups[wsindex];
 
     g_log.debug() << "[FilterEvents D1215]: Output workspace Index " << wsindex
                   << ": Name = " << opws->name()
@@ -935,28 +1003,25 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
   */
 void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
   size_t numberOfSpectra = m_eventWS->getNumberHistograms();
-  // FIXME : consider to use vector to index workspace and event list
 
   // Loop over the histograms (detector spectra) to do split from 1 event list
   // to N event list
   g_log.debug() << "Number of spectra in input/source EventWorkspace = "
                 << numberOfSpectra << ".\n";
 
+  if (m_FilterByPulseTime)
+    throw runtime_error(
+        "It is not a good practice to split fast event by pulse time. ");
+  const TimeSplitterIndex splitterIndex = createSplitterIndex();
+
   PARALLEL_FOR_NO_WSP_CHECK()
   for (int64_t iws = 0; iws < int64_t(numberOfSpectra); ++iws) {
     PARALLEL_START_INTERUPT_REGION
 
     // Filter the non-skipped spectrum
     if (!m_vecSkip[iws]) {
-      // Get the output event lists (should be empty) to be a map
-      map<int, DataObjects::EventList *> outputs;
-      PARALLEL_CRITICAL(build_elist) {
-        for (auto &ws : m_outputWS) {
-          int index = ws.first;
-          auto &output_el = ws.second->getSpectrum(iws);
-          outputs.emplace(index, &output_el);
-        }
-      }
+      // Get the output event lists (should be empty)
+      auto outputs = getOutputEventLists(iws);
 
       // Get a holder on input workspace's event list of this spectrum
       const DataObjects::EventList &input_el = m_eventWS->getSpectrum(iws);
@@ -967,21 +1032,19 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
 
       // Perform the filtering (using the splitting function and just one
       // output)
-      std::string logmessage("");
-      if (m_FilterByPulseTime) {
-        throw runtime_error(
-            "It is not a good practice to split fast event by pulse time. ");
-      } else if (m_tofCorrType != NoneCorrect) {
-        logmessage = input_el.splitByFullTimeMatrixSplitter(
-            m_vecSplitterTime, m_vecSplitterGroup, outputs, true,
-            m_detTofFactors[iws], m_detTofOffsets[iws]);
+      size_t numDropped;
+      if (m_tofCorrType != NoneCorrect) {
+        numDropped = input_el.splitByTimeIndex(
+            splitterIndex, outputs, false, m_detTofFactors[iws],
+            m_detTofOffsets[iws]);
       } else {
-        logmessage = input_el.splitByFullTimeMatrixSplitter(
-            m_vecSplitterTime, m_vecSplitterGroup, outputs, false, 1.0, 0.0);
+        numDropped =
+            input_el.splitByTimeIndex(splitterIndex, outputs, false, 1.0, 0.0);
       }
 
-      if (printdetail)
-        g_log.notice(logmessage);
+      if (printdetail && numDropped > 0)
+        g_log.notice() << numDropped << " events of spectrum " << iws
+                       << " are in a group without an output workspace.\n";
     }
 
     PARALLEL_END_INTERUPT_REGION
@@ -999,16 +1062,14 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
 }
 
 //----------------------------------------------------------------------------------------------
-/** Generate splitters for specified workspace index as a subset of
+/** Generate the splitters of each workspace group index as subsets of
  * m_splitters
  */
-Kernel::TimeSplitterType FilterEvents::generateSplitters(int wsindex) {
-  Kernel::TimeSplitterType splitters;
+std::map<int, Kernel::TimeSplitterType>
+FilterEvents::generateSplitters() const {
+  std::map<int, Kernel::TimeSplitterType> splitters;
   for (const auto &splitter : m_splitters) {
-    int index = splitter.index();
-    if (index == wsindex) {
-      splitters.push_back(splitter);
-    }
+    splitters[splitter.index()].push_back(splitter);
   }
   return splitters;
 }
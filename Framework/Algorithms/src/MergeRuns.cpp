@@ -266,35 +266,44 @@ void MergeRuns::execEvent() {
   EventWorkspace_sptr inputWS = m_inEventWS[0];
   EventWorkspace_sptr outWS(inputWS->clone());
 
-  int64_t n = m_inEventWS.size() - 1;
-  m_progress = new Progress(this, 0.0, 1.0, n);
-
+  // The event lists to add to each spectrum of the output, as the tables say.
   // Note that we start at 1, since we already have the 0th workspace
+  std::vector<std::vector<const EventList *>> addees(
+      outWS->getNumberHistograms());
   for (size_t workspaceNum = 1; workspaceNum < m_inEventWS.size();
        workspaceNum++) {
     // You are adding this one here
-    EventWorkspace_sptr addee = m_inEventWS[workspaceNum];
+    EventWorkspace_const_sptr addee = m_inEventWS[workspaceNum];
 
     boost::shared_ptr<AdditionTable> table = m_tables[workspaceNum - 1];
-
-    // Add all the event lists together as the table says to do
     for (auto &WI : *table) {
-      int64_t inWI = WI.first;
       int64_t outWI = WI.second;
-      if (outWI >= 0) {
-        outWS->getSpectrum(outWI) += addee->getSpectrum(inWI);
-      } else {
+      if (outWI < 0) {
         // Add an entry to list
-        outWS->getOrAddEventList(outWS->getNumberHistograms()) +=
-            addee->getSpectrum(inWI);
+        outWI = static_cast<int64_t>(outWS->getNumberHistograms());
+        outWS->getOrAddEventList(outWI);
+        addees.resize(outWI + 1);
       }
+      addees[outWI].push_back(&addee->getSpectrum(WI.first));
     }
 
     // Now we add up the runs
-    outWS->mutableRun() += addee->mutableRun();
+    outWS->mutableRun() += m_inEventWS[workspaceNum]->mutableRun();
+  }
 
+  // Add the event lists of all workspaces to each spectrum at once, so that
+  // the memory is allocated once and sorted lists are merged
+  const int64_t numHistograms = static_cast<int64_t>(addees.size());
+  m_progress = new Progress(this, 0.0, 1.0, numHistograms);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t outWI = 0; outWI < numHistograms; ++outWI) {
+    PARALLEL_START_INTERUPT_REGION
+    if (!addees[outWI].empty())
+      outWS->getSpectrum(outWI).addEventLists(addees[outWI]);
     m_progress->report();
+    PARALLEL_END_INTERUPT_REGION
   }
+  PARALLEL_CHECK_INTERUPT_REGION
 
   // Set the final workspace to the output property
   setProperty("OutputWorkspace",
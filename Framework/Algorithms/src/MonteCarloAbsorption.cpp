@@ -7,6 +7,7 @@
 #include "MantidAPI/ExperimentInfo.h"
 #include "MantidAPI/InstrumentValidator.h"
 #include "MantidAPI/Sample.h"
+#include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidAPI/WorkspaceProperty.h"
 #include "MantidAPI/WorkspaceUnitValidator.h"
@@ -52,22 +53,23 @@ double getWavelengthHistogramData(int i, const std::vector<double> &lambdas) {
 }
 
 struct EFixedProvider {
-  explicit EFixedProvider(const ExperimentInfo &expt)
-      : m_expt(expt), m_emode(expt.getEMode()), m_value(0.0) {
+  explicit EFixedProvider(const MatrixWorkspace &ws)
+      : m_ws(ws), m_emode(ws.getEMode()), m_value(0.0) {
     if (m_emode == DeltaEMode::Direct) {
-      m_value = m_expt.getEFixed();
+      m_value = m_ws.getEFixed();
     }
   }
   inline DeltaEMode::Type emode() const { return m_emode; }
-  inline double value(const IDetector_const_sptr &det) const {
+  /// Only builds the detector of the spectrum in indirect mode
+  inline double value(const size_t index) const {
     if (m_emode != DeltaEMode::Indirect)
       return m_value;
     else
-      return m_expt.getEFixed(det);
+      return m_ws.getEFixed(m_ws.getDetector(index));
   }
 
 private:
-  const ExperimentInfo &m_expt;
+  const MatrixWorkspace &m_ws;
   const DeltaEMode::Type m_emode;
   double m_value;
 };
@@ -153,6 +155,7 @@ MonteCarloAbsorption::doSimulation(const MatrixWorkspace &inputWS,
   }
 
   EFixedProvider efixed(inputWS);
+  const SpectrumInfo spectrumInfo(inputWS);
   auto beamProfile = createBeamProfile(*instrument, inputWS.sample());
 
   // Configure progress
@@ -182,16 +185,11 @@ MonteCarloAbsorption::doSimulation(const MatrixWorkspace &inputWS,
     // Y values are all overwritten later
     std::fill(errors.begin(), errors.end(), 0.0);
 
-    // Final detector position
-    IDetector_const_sptr detector;
-    try {
-      detector = outputWS->getDetector(i);
-    } catch (Kernel::Exception::NotFoundError &) {
+    if (!spectrumInfo.hasDetectors(i))
       continue;
-    }
     // Per spectrum values
-    const auto &detPos = detector->getPos();
-    const double lambdaFixed = toWavelength(efixed.value(detector));
+    const auto &detPos = spectrumInfo.position(i);
+    const double lambdaFixed = toWavelength(efixed.value(i));
     MersenneTwister rng(seed);
 
     // Simulation for each requested wavelength point
@@ -6,6 +6,7 @@
 #include "MantidKernel/EnabledWhenProperty.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/RebinParamsValidator.h"
+#include "MantidKernel/TaskGraph.h"
 #include <boost/optional.hpp>
 
 /*Anonymous namespace*/
@@ -718,51 +719,81 @@ bool ReflectometryReductionOneAuto::processGroups() {
   }
   std::vector<std::string> IvsQGroup, IvsLamGroup;
 
+  // If our transmission run is a group and PolarizationCorrection is on
+  // then we sum our transmission group members, and use the sum for all
+  // members of the input group.
+  Workspace_sptr firstTransmissionSum, secondTransmissionSum;
+  if (firstTransG && isPolarizationCorrectionOn)
+    firstTransmissionSum = sumOverTransmissionGroup(firstTransG);
+  if (secondTransG && isPolarizationCorrectionOn)
+    secondTransmissionSum = sumOverTransmissionGroup(secondTransG);
+
+  // Copies the non-workspace properties of one algorithm to another
+  const auto copyProperties = [](const Algorithm &from, Algorithm &to) {
+    for (const auto prop : from.getProperties()) {
+      if (!dynamic_cast<IWorkspaceProperty *>(prop))
+        to.setPropertyValue(prop->name(), prop->value());
+    }
+  };
+
   // Execute algorithm over each group member (or period, if this is
-  // multiperiod)
+  // multiperiod). Each member gets its own copy of the algorithm. The first
+  // member determines ThetaIn and the momentum transfer range used by all
+  // others, which are then reduced in parallel.
   size_t numMembers = group->size();
+  std::vector<Algorithm_sptr> memberAlgs;
+  Kernel::TaskGraph reductions;
   for (size_t i = 0; i < numMembers; ++i) {
     const std::string IvsQName = outputIvsQ + "_" + std::to_string(i + 1);
     const std::string IvsLamName = outputIvsLam + "_" + std::to_string(i + 1);
 
-    // If our transmission run is a group and PolarizationCorrection is on
-    // then we sum our transmission group members.
-    //
-    // This is done inside of the for loop to avoid the wrong workspace being
-    // used when these arguments are passed through to the exec() method.
-    // If this is not set in the loop, exec() will fetch the first workspace
-    // from the specified Transmission Group workspace that the user entered.
-    if (firstTransG && isPolarizationCorrectionOn) {
-      auto firstTransmissionSum = sumOverTransmissionGroup(firstTransG);
-      alg->setProperty("FirstTransmissionRun", firstTransmissionSum);
-    }
-    if (secondTransG && isPolarizationCorrectionOn) {
-      auto secondTransmissionSum = sumOverTransmissionGroup(secondTransG);
-      alg->setProperty("SecondTransmissionRun", secondTransmissionSum);
-    }
+    Algorithm_sptr memberAlg = this->createChildAlgorithm(
+        this->name(), -1, -1, this->isLogging(), this->version());
+    memberAlg->setChild(false);
+    memberAlg->setRethrows(true);
+    copyProperties(*alg, *memberAlg);
+    if (!firstTrans.empty() && !firstTransG)
+      memberAlg->setProperty("FirstTransmissionRun", firstTrans);
+    if (!secondTrans.empty() && !secondTransG)
+      memberAlg->setProperty("SecondTransmissionRun", secondTrans);
+    if (firstTransmissionSum)
+      memberAlg->setProperty("FirstTransmissionRun", firstTransmissionSum);
+    if (secondTransmissionSum)
+      memberAlg->setProperty("SecondTransmissionRun", secondTransmissionSum);
 
     // Otherwise, if polarization correction is off, we process them
     // using one transmission group member at a time.
     if (firstTransG && !isPolarizationCorrectionOn) // polarization off
-      alg->setProperty("FirstTransmissionRun", firstTransG->getItem(i)->name());
+      memberAlg->setProperty("FirstTransmissionRun",
+                             firstTransG->getItem(i)->name());
     if (secondTransG && !isPolarizationCorrectionOn) // polarization off
-      alg->setProperty("SecondTransmissionRun",
-                       secondTransG->getItem(i)->name());
-
-    alg->setProperty("InputWorkspace", group->getItem(i)->name());
-    alg->setProperty("OutputWorkspace", IvsQName);
-    alg->setProperty("OutputWorkspaceWavelength", IvsLamName);
-    alg->execute();
-
-    MatrixWorkspace_sptr tempFirstTransWS =
-        alg->getProperty("FirstTransmissionRun");
+      memberAlg->setProperty("SecondTransmissionRun",
+                             secondTransG->getItem(i)->name());
+
+    memberAlg->setProperty("InputWorkspace", group->getItem(i)->name());
+    memberAlg->setProperty("OutputWorkspace", IvsQName);
+    memberAlg->setProperty("OutputWorkspaceWavelength", IvsLamName);
+    if (i == 0) {
+      reductions.addTask([memberAlg] { memberAlg->execute(); });
+    } else {
+      Algorithm_sptr firstAlg = memberAlgs.front();
+      reductions.addTask([copyProperties, firstAlg, memberAlg] {
+        copyProperties(*firstAlg, *memberAlg);
+        memberAlg->execute();
+      }, {0});
+    }
+    memberAlgs.push_back(memberAlg);
 
     IvsQGroup.push_back(IvsQName);
     IvsLamGroup.push_back(IvsLamName);
+  }
+  reductions.execute();
 
-    // We use the first group member for our thetaout value
-    if (i == 0)
-      this->setPropertyValue("ThetaOut", alg->getPropertyValue("ThetaOut"));
+  // We use the first group member for our thetaout value
+  if (!memberAlgs.empty()) {
+    this->setPropertyValue("ThetaOut",
+                           memberAlgs.front()->getPropertyValue("ThetaOut"));
+    alg = memberAlgs.back();
   }
 
   // Group the IvsQ and IvsLam workspaces
@@ -800,18 +831,21 @@ bool ReflectometryReductionOneAuto::processGroups() {
 
       // Now we've overwritten the IvsLam workspaces, we'll need to recalculate
       // the IvsQ ones
-      alg->setProperty("FirstTransmissionRun", "");
-      alg->setProperty("SecondTransmissionRun", "");
+      Kernel::TaskGraph recalculations;
       for (size_t i = 0; i < numMembers; ++i) {
         const std::string IvsQName = outputIvsQ + "_" + std::to_string(i + 1);
         const std::string IvsLamName =
             outputIvsLam + "_" + std::to_string(i + 1);
-        alg->setProperty("InputWorkspace", IvsLamName);
-        alg->setProperty("OutputWorkspace", IvsQName);
-        alg->setProperty("CorrectionAlgorithm", "None");
-        alg->setProperty("OutputWorkspaceWavelength", IvsLamName);
-        alg->execute();
+        auto &memberAlg = memberAlgs[i];
+        memberAlg->setProperty("FirstTransmissionRun", "");
+        memberAlg->setProperty("SecondTransmissionRun", "");
+        memberAlg->setProperty("InputWorkspace", IvsLamName);
+        memberAlg->setProperty("OutputWorkspace", IvsQName);
+        memberAlg->setProperty("CorrectionAlgorithm", "None");
+        memberAlg->setProperty("OutputWorkspaceWavelength", IvsLamName);
+        recalculations.addTask([memberAlg] { memberAlg->execute(); });
       }
+      recalculations.execute();
     } else {
       g_log.warning("Polarization corrections can only be performed on "
                     "multiperiod workspaces.");
@@ -81,5 +81,19 @@ double SofQCommon::getEFixed(const Geometry::IDetector &det) const {
   }
   return efixed;
 }
+
+/**
+ * Return the efixed for a spectrum. The detector of the spectrum is only
+ * built if efixed has to be read from its parameters.
+ * @param workspace The workspace containing the spectrum
+ * @param index The workspace index of the spectrum
+ * @return The value of efixed
+ */
+double SofQCommon::getEFixed(const API::MatrixWorkspace &workspace,
+                             const size_t index) const {
+  if (m_emode == 1 || m_efixedGiven)
+    return m_efixed;
+  return getEFixed(*workspace.getDetector(index));
+}
 }
 }
@@ -9,10 +9,10 @@
 #include "MantidAPI/InstrumentValidator.h"
 #include "MantidAPI/SpectraAxisValidator.h"
 #include "MantidAPI/SpectrumDetectorMapping.h"
+#include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidAPI/WorkspaceUnitValidator.h"
 #include "MantidGeometry/Instrument.h"
-#include "MantidGeometry/Instrument/DetectorGroup.h"
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/CompositeValidator.h"
@@ -115,7 +115,8 @@ void SofQWCentre::exec() {
   // Get the distance between the source and the sample (assume in metres)
   IComponent_const_sptr source = instrument->getSource();
   IComponent_const_sptr sample = instrument->getSample();
-  V3D beamDir = sample->getPos() - source->getPos();
+  const V3D samplePos = sample->getPos();
+  V3D beamDir = samplePos - source->getPos();
   beamDir.normalize();
 
   try {
@@ -137,31 +138,24 @@ void SofQWCentre::exec() {
   // qw workspace
   const size_t numHists = inputWorkspace->getNumberHistograms();
   const size_t numBins = inputWorkspace->blocksize();
+  const SpectrumInfo spectrumInfo(*inputWorkspace);
+  const auto &detectorInfo = spectrumInfo.detectorInfo();
   Progress prog(this, 0.0, 1.0, numHists);
   for (int64_t i = 0; i < int64_t(numHists); ++i) {
     try {
-      // Now get the detector object for this histogram
-      IDetector_const_sptr spectrumDet = inputWorkspace->getDetector(i);
-      if (spectrumDet->isMonitor())
+      if (!spectrumInfo.hasDetectors(i) || spectrumInfo.isMonitor(i))
         continue;
 
-      const double efixed = m_EmodeProperties.getEFixed(*spectrumDet);
+      const double efixed = m_EmodeProperties.getEFixed(*inputWorkspace, i);
 
       // For inelastic scattering the simple relationship q=4*pi*sinTheta/lambda
       // does not hold. In order to
       // be completely general we must calculate the momentum transfer by
       // calculating the incident and final
       // wave vectors and then use |q| = sqrt[(ki - kf)*(ki - kf)]
-      DetectorGroup_const_sptr detGroup =
-          boost::dynamic_pointer_cast<const DetectorGroup>(spectrumDet);
-      std::vector<IDetector_const_sptr> detectors;
-      if (detGroup) {
-        detectors = detGroup->getDetectors();
-      } else {
-        detectors.push_back(spectrumDet);
-      }
+      const auto &detectorIDs = inputWorkspace->getSpectrum(i).getDetectorIDs();
 
-      const size_t numDets = detectors.size();
+      const size_t numDets = detectorIDs.size();
       const double numDets_d = static_cast<double>(
           numDets); // cache to reduce number of static casts
       const MantidVec &Y = inputWorkspace->readY(i);
@@ -169,10 +163,11 @@ void SofQWCentre::exec() {
       const MantidVec &X = inputWorkspace->readX(i);
 
       // Loop over the detectors and for each bin calculate Q
-      for (size_t idet = 0; idet < numDets; ++idet) {
-        IDetector_const_sptr det = detectors[idet];
+      size_t idet = 0;
+      for (const auto detID : detectorIDs) {
         // Calculate kf vector direction and then Q for each energy bin
-        V3D scatterDir = (det->getPos() - sample->getPos());
+        V3D scatterDir =
+            detectorInfo.position(detectorInfo.indexOf(detID)) - samplePos;
         scatterDir.normalize();
         for (size_t j = 0; j < numBins; ++j) {
           const double deltaE = 0.5 * (X[j] + X[j + 1]);
@@ -225,7 +220,7 @@ void SofQWCentre::exec() {
           // Add this spectra-detector pair to the mapping
           specNumberMapping.push_back(
               outputWorkspace->getSpectrum(qIndex).getSpectrumNo());
-          detIDMapping.push_back(det->getID());
+          detIDMapping.push_back(detID);
 
           // And add the data and it's error to that bin, taking into account
           // the number of detectors contributing to this bin
@@ -235,6 +230,7 @@ void SofQWCentre::exec() {
               sqrt((pow(outputWorkspace->readE(qIndex)[j], 2) + pow(E[j], 2)) /
                    numDets_d);
         }
+        ++idet;
       }
 
     } catch (Exception::NotFoundError &) {
@@ -5,10 +5,10 @@
 #include "MantidAlgorithms/SofQW.h"
 #include "MantidAPI/BinEdgeAxis.h"
 #include "MantidAPI/SpectrumDetectorMapping.h"
+#include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidDataObjects/FractionalRebinning.h"
 #include "MantidGeometry/Instrument.h"
-#include "MantidGeometry/Instrument/DetectorGroup.h"
 #include "MantidGeometry/Instrument/ReferenceFrame.h"
 #include "MantidKernel/UnitFactory.h"
 #include "MantidKernel/VectorHelper.h"
@@ -17,7 +17,6 @@ namespace Mantid {
 namespace Algorithms {
 // Setup typedef for later use
 typedef std::map<specnum_t, Mantid::Kernel::V3D> SpectraDistanceMap;
-typedef Geometry::IDetector_const_sptr DetConstPtr;
 
 // Register the algorithm into the AlgorithmFactory
 DECLARE_ALGORITHM(SofQWNormalisedPolygon)
@@ -88,16 +87,18 @@ void SofQWNormalisedPolygon::exec() {
 
   // Compute input caches
   m_EmodeProperties.initCachedValues(*inputWS, this);
+  inputWS->getInstrument()->cacheDetectorPositions();
+  const SpectrumInfo spectrumInfo(*inputWS);
 
   std::vector<double> par =
       inputWS->getInstrument()->getNumberParameter("detector-neighbour-offset");
   if (par.empty()) {
     // Index theta cache
-    this->initAngularCachesNonPSD(inputWS);
+    this->initAngularCachesNonPSD(inputWS, spectrumInfo);
   } else {
     g_log.debug() << "Offset: " << par[0] << '\n';
     this->m_detNeighbourOffset = static_cast<int>(par[0]);
-    this->initAngularCachesPSD(inputWS);
+    this->initAngularCachesPSD(inputWS, spectrumInfo);
   }
 
   const MantidVec &X = inputWS->readX(0);
@@ -109,8 +110,7 @@ void SofQWNormalisedPolygon::exec() {
   {
     PARALLEL_START_INTERUPT_REGION
 
-    DetConstPtr detector = inputWS->getDetector(i);
-    if (detector->isMasked() || detector->isMonitor()) {
+    if (spectrumInfo.isMasked(i) || spectrumInfo.isMonitor(i)) {
       continue;
     }
 
@@ -129,8 +129,11 @@ void SofQWNormalisedPolygon::exec() {
     const double phiLower = phi - phiHalfWidth;
     const double phiUpper = phi + phiHalfWidth;
 
-    const double efixed = m_EmodeProperties.getEFixed(*detector);
-    const specnum_t specNo = inputWS->getSpectrum(i).getSpectrumNo();
+    const double efixed = m_EmodeProperties.getEFixed(*inputWS, i);
+    const auto &spectrum = inputWS->getSpectrum(i);
+    const specnum_t specNo = spectrum.getSpectrumNo();
+    // The ID of a DetectorGroup is that of its first detector
+    const detid_t detectorID = *spectrum.getDetectorIDs().begin();
     std::stringstream logStream;
     for (size_t j = 0; j < nEnergyBins; ++j) {
       m_progress->report("Computing polygon intersections");
@@ -169,7 +172,7 @@ void SofQWNormalisedPolygon::exec() {
         PARALLEL_CRITICAL(SofQWNormalisedPolygon_spectramap) {
           specNumberMapping.push_back(
               outputWS->getSpectrum(qIndex - 1).getSpectrumNo());
-          detIDMapping.push_back(detector->getID());
+          detIDMapping.push_back(detectorID);
         }
       }
     }
@@ -226,7 +229,8 @@ double SofQWNormalisedPolygon::calculateQ(const double efixed, int emode,
  * offset by this precaching step
  */
 void SofQWNormalisedPolygon::initAngularCachesNonPSD(
-    const API::MatrixWorkspace_const_sptr &workspace) {
+    const API::MatrixWorkspace_const_sptr &workspace,
+    const API::SpectrumInfo &spectrumInfo) {
   const size_t nhist = workspace->getNumberHistograms();
   this->m_theta = std::vector<double>(nhist);
   this->m_thetaWidths = std::vector<double>(nhist);
@@ -240,29 +244,22 @@ void SofQWNormalisedPolygon::initAngularCachesNonPSD(
   for (size_t i = 0; i < nhist; ++i) // signed for OpenMP
   {
     m_progress->report("Calculating detector angles");
-    IDetector_const_sptr det;
-    try {
-      det = workspace->getDetector(i);
+    bool hasEFixed = spectrumInfo.hasDetectors(i);
+    if (hasEFixed) {
       // Check to see if there is an EFixed, if not skip it
       try {
-        m_EmodeProperties.getEFixed(*det);
+        m_EmodeProperties.getEFixed(*workspace, i);
       } catch (std::runtime_error &) {
-        det.reset();
+        hasEFixed = false;
       }
-    } catch (Kernel::Exception::NotFoundError &) {
-      // Catch if no detector. Next line tests whether this happened - test
-      // placed
-      // outside here because Mac Intel compiler doesn't like 'continue' in a
-      // catch
-      // in an openmp block.
     }
     // If no detector found, skip onto the next spectrum
-    if (!det || det->isMonitor()) {
+    if (!hasEFixed || spectrumInfo.isMonitor(i)) {
       this->m_theta[i] = -1.0; // Indicates a detector to skip
       this->m_thetaWidths[i] = -1.0;
       continue;
     }
-    this->m_theta[i] = workspace->detectorTwoTheta(*det);
+    this->m_theta[i] = spectrumInfo.twoTheta(i);
 
     /**
      * Determine width from shape geometry. A group is assumed to contain
@@ -270,11 +267,9 @@ void SofQWNormalisedPolygon::initAngularCachesNonPSD(
      * The shape is retrieved and rotated to match the rotation of the detector.
      * The angular width is computed using the l2 distance from the sample
      */
-    if (auto group = boost::dynamic_pointer_cast<const DetectorGroup>(det)) {
-      // assume they all have same shape and same r,theta
-      auto dets = group->getDetectors();
-      det = dets[0];
-    }
+    // assume they all have same shape and same r,theta
+    const auto det =
+        inst->getDetector(*workspace->getSpectrum(i).getDetectorIDs().begin());
     const auto pos = det->getPos();
     double l2(0.0), t(0.0), p(0.0);
     pos.getSpherical(l2, t, p);
@@ -304,7 +299,8 @@ void SofQWNormalisedPolygon::initAngularCachesNonPSD(
  * @param workspace : the workspace containing the needed detector information
  */
 void SofQWNormalisedPolygon::initAngularCachesPSD(
-    const API::MatrixWorkspace_const_sptr &workspace) {
+    const API::MatrixWorkspace_const_sptr &workspace,
+    const API::SpectrumInfo &spectrumInfo) {
   // Trigger a build of the nearst neighbors outside the OpenMP loop
   const int numNeighbours = 4;
   const size_t nHistos = workspace->getNumberHistograms();
@@ -317,7 +313,6 @@ void SofQWNormalisedPolygon::initAngularCachesPSD(
 
   for (size_t i = 0; i < nHistos; ++i) {
     m_progress->report("Calculating detector angular widths");
-    DetConstPtr detector = workspace->getDetector(i);
     g_log.debug() << "Current histogram: " << i << '\n';
     specnum_t inSpec = workspace->getSpectrum(i).getSpectrumNo();
     SpectraDistanceMap neighbours =
@@ -329,8 +324,8 @@ void SofQWNormalisedPolygon::initAngularCachesPSD(
     double phiWidth = -DBL_MAX;
 
     // Find theta and phi widths
-    double theta = workspace->detectorTwoTheta(*detector);
-    double phi = detector->getPhi();
+    double theta = spectrumInfo.twoTheta(i);
+    double phi = spectrumInfo.phi(i);
 
     specnum_t deltaPlus1 = inSpec + 1;
     specnum_t deltaMinus1 = inSpec - 1;
@@ -342,9 +337,8 @@ void SofQWNormalisedPolygon::initAngularCachesPSD(
       g_log.debug() << "Neighbor ID: " << spec << '\n';
       if (spec == deltaPlus1 || spec == deltaMinus1 || spec == deltaPlusT ||
           spec == deltaMinusT) {
-        DetConstPtr detector_n = workspace->getDetector(spec - 1);
-        double theta_n = workspace->detectorTwoTheta(*detector_n) * 0.5;
-        double phi_n = detector_n->getPhi();
+        double theta_n = spectrumInfo.twoTheta(spec - 1) * 0.5;
+        double phi_n = spectrumInfo.phi(spec - 1);
 
         double dTheta = std::fabs(theta - theta_n);
         double dPhi = std::fabs(phi - phi_n);
@@ -5,9 +5,10 @@
 #include "MantidAlgorithms/SofQW.h"
 #include "MantidAPI/SpectraAxis.h"
 #include "MantidAPI/SpectrumDetectorMapping.h"
+#include "MantidAPI/SpectrumInfo.h"
+#include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Math/PolygonIntersection.h"
 #include "MantidGeometry/Math/Quadrilateral.h"
-#include "MantidGeometry/Instrument/DetectorGroup.h"
 #include "MantidDataObjects/FractionalRebinning.h"
 
 namespace Mantid {
@@ -54,6 +55,7 @@ void SofQWPolygon::exec() {
       new API::Progress(this, 0.0, 1.0, nreports));
 
   // Compute input caches
+  inputWS->getInstrument()->cacheDetectorPositions();
   this->initCachedValues(inputWS);
 
   const size_t nTheta = m_thetaPts.size();
@@ -86,11 +88,13 @@ void SofQWPolygon::exec() {
       continue;
     }
 
-    IDetector_const_sptr det = inputWS->getDetector(i);
+    // The ID of a DetectorGroup is that of its first detector
+    const detid_t detectorID =
+        *inputWS->getSpectrum(i).getDetectorIDs().begin();
     double halfWidth(0.5 * m_thetaWidth);
     const double thetaLower = theta - halfWidth;
     const double thetaUpper = theta + halfWidth;
-    const double efixed = m_EmodeProperties.getEFixed(*det);
+    const double efixed = m_EmodeProperties.getEFixed(*inputWS, i);
 
     for (size_t j = 0; j < nenergyBins; ++j) {
       m_progress->report("Computing polygon intersections");
@@ -119,7 +123,7 @@ void SofQWPolygon::exec() {
         PARALLEL_CRITICAL(SofQWPolygon_spectramap) {
           specNumberMapping.push_back(
               outputWS->getSpectrum(qIndex - 1).getSpectrumNo());
-          detIDMapping.push_back(det->getID());
+          detIDMapping.push_back(detectorID);
         }
       }
     }
@@ -198,33 +202,27 @@ void SofQWPolygon::initThetaCache(const API::MatrixWorkspace &workspace) {
   m_thetaPts = std::vector<double>(nhist);
   size_t ndets(0);
   double minTheta(DBL_MAX), maxTheta(-DBL_MAX);
+  const SpectrumInfo spectrumInfo(workspace);
 
   for (int64_t i = 0; i < static_cast<int64_t>(nhist); ++i) // signed for OpenMP
   {
 
     m_progress->report("Calculating detector angles");
-    IDetector_const_sptr det;
-    try {
-      det = workspace.getDetector(i);
+    bool hasEFixed = spectrumInfo.hasDetectors(i);
+    if (hasEFixed) {
       // Check to see if there is an EFixed, if not skip it
       try {
-        m_EmodeProperties.getEFixed(*det);
+        m_EmodeProperties.getEFixed(workspace, i);
       } catch (std::runtime_error &) {
-        det.reset();
+        hasEFixed = false;
       }
-    } catch (Kernel::Exception::NotFoundError &) {
-      // Catch if no detector. Next line tests whether this happened - test
-      // placed
-      // outside here because Mac Intel compiler doesn't like 'continue' in a
-      // catch
-      // in an openmp block.
     }
     // If no detector found, skip onto the next spectrum
-    if (!det || det->isMonitor()) {
+    if (!hasEFixed || spectrumInfo.isMonitor(i)) {
       m_thetaPts[i] = -1.0; // Indicates a detector to skip
     } else {
       ++ndets;
-      const double theta = workspace.detectorTwoTheta(*det);
+      const double theta = spectrumInfo.twoTheta(i);
       m_thetaPts[i] = theta;
       minTheta = std::min(minTheta, theta);
       maxTheta = std::max(maxTheta, theta);
@@ -69,9 +69,8 @@ void XDataConverter::exec() {
   for (int i = 0; i < int(numSpectra); ++i) {
     PARALLEL_START_INTERUPT_REGION
 
-    // Copy over the Y and E data
-    outputWS->dataY(i) = inputWS->readY(i);
-    outputWS->dataE(i) = inputWS->readE(i);
+    // Share the Y and E data with the input until either is modified
+    outputWS->setData(i, inputWS->refY(i), inputWS->refE(i));
     setXData(outputWS, inputWS, i);
     prog.report();
 
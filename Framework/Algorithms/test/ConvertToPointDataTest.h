@@ -97,6 +97,23 @@ public:
     Mantid::API::AnalysisDataService::Instance().remove(outputWS->getName());
   }
 
+  void test_Y_And_E_Are_Shared_With_The_Input_Until_Modified() {
+    Workspace2D_sptr testWS =
+        WorkspaceCreationHelper::Create2DWorkspaceBinned(2, 10);
+    MatrixWorkspace_sptr outputWS = runAlgorithm(testWS);
+    TS_ASSERT(outputWS);
+    if (!outputWS)
+      return;
+
+    TS_ASSERT_EQUALS(&outputWS->readY(1), &testWS->readY(1));
+    TS_ASSERT_EQUALS(&outputWS->readE(1), &testWS->readE(1));
+    outputWS->dataY(1)[0] = 5.0;
+    TS_ASSERT_DIFFERS(&outputWS->readY(1), &testWS->readY(1));
+    TS_ASSERT_EQUALS(testWS->readY(1)[0], 2.0);
+
+    Mantid::API::AnalysisDataService::Instance().remove(outputWS->getName());
+  }
+
   void test_A_Non_Uniformly_Binned_Histogram_Is_Transformed_Correctly() {
     // Creates a workspace with 2 spectra, and the given bin structure
     double xBoundaries[11] = {0.0,  1.0,  3.0,  5.0,  6.0, 7.0,
@@ -197,6 +197,51 @@ public:
     params.testDx(*ws);
   }
 
+  void test_data_is_shared_with_input_if_not_cropping_in_x() {
+    auto input = createInputWorkspaceHisto();
+    ExtractSpectra alg;
+    alg.setChild(true);
+    alg.initialize();
+    alg.setProperty("InputWorkspace", input);
+    alg.setPropertyValue("OutputWorkspace", outWSName);
+    alg.setProperty("StartWorkspaceIndex", 1);
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    MatrixWorkspace_sptr ws = alg.getProperty("OutputWorkspace");
+    TS_ASSERT_EQUALS(ws->getNumberHistograms(), nSpec - 1);
+
+    TS_ASSERT_EQUALS(&ws->readX(0), &input->readX(1));
+    TS_ASSERT_EQUALS(&ws->readY(0), &input->readY(1));
+    TS_ASSERT_EQUALS(&ws->readE(0), &input->readE(1));
+
+    // Modifying the output copies the data
+    ws->dataY(0)[0] = 42.0;
+    TS_ASSERT_EQUALS(ws->readY(0)[0], 42.0);
+    TS_ASSERT_EQUALS(input->readY(1)[0], 1.0);
+    TS_ASSERT_EQUALS(&ws->readE(0), &input->readE(1));
+  }
+
+  void test_data_is_not_shared_with_input_if_cropping_in_x() {
+    auto input = createInputWorkspaceHisto();
+    ExtractSpectra alg;
+    alg.setChild(true);
+    alg.initialize();
+    alg.setProperty("InputWorkspace", input);
+    alg.setPropertyValue("OutputWorkspace", outWSName);
+    alg.setProperty("XMin", 2.0);
+    alg.setProperty("XMax", 4.1);
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    MatrixWorkspace_sptr ws = alg.getProperty("OutputWorkspace");
+    TS_ASSERT_EQUALS(ws->blocksize(), 2);
+
+    TS_ASSERT_DIFFERS(&ws->readY(0), &input->readY(0));
+    // The cropped X is shared between the output spectra
+    TS_ASSERT_EQUALS(&ws->readX(0), &ws->readX(1));
+    TS_ASSERT_EQUALS(ws->readX(1)[0], 2.0);
+    TS_ASSERT_EQUALS(ws->readY(1)[0], 1.0);
+    // The output Y vectors are not shared with each other
+    TS_ASSERT_DIFFERS(&ws->readY(1), &ws->readY(2));
+  }
+
   // ---- test event ----
 
   void test_x_range_event() {
@@ -14,6 +14,7 @@
 #include "MantidKernel/TimeSeriesProperty.h"
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
+#include <algorithm>
 
 using namespace Mantid::API;
 using namespace Mantid::Algorithms;
@@ -444,6 +445,43 @@ public:
     EventTeardown();
   }
 
+  //-----------------------------------------------------------------------------------------------
+  void testExec_Events_sorted_inputs_give_sorted_output() {
+    EventSetup();
+    auto &ads = AnalysisDataService::Instance();
+    auto ev2 = ads.retrieveWS<EventWorkspace>("ev2");
+    ev1->sortAll(TOF_SORT, nullptr);
+    ev2->sortAll(TOF_SORT, nullptr);
+
+    MergeRuns mrg;
+    mrg.initialize();
+    mrg.setPropertyValue("InputWorkspaces", "ev1,ev2");
+    mrg.setPropertyValue("OutputWorkspace", "outWS");
+    mrg.execute();
+    TS_ASSERT(mrg.isExecuted());
+
+    EventWorkspace_const_sptr output = ads.retrieveWS<EventWorkspace>("outWS");
+    TS_ASSERT(output);
+    TS_ASSERT_EQUALS(output->getNumberEvents(), 900);
+    TS_ASSERT_EQUALS(output->getNumberHistograms(), 3);
+    for (size_t wi = 0; wi < output->getNumberHistograms(); ++wi) {
+      const auto &el = output->getSpectrum(wi);
+      // The events were merged, no need to sort them again
+      TS_ASSERT_EQUALS(el.getSortType(), TOF_SORT);
+      const auto &events = el.getEvents();
+      TS_ASSERT(std::is_sorted(events.begin(), events.end(),
+                               [](const TofEvent &e1, const TofEvent &e2) {
+                                 return e1.tof() < e2.tof();
+                               }));
+    }
+    // The inputs are unchanged
+    TS_ASSERT_EQUALS(ev1->getNumberEvents(), 300);
+    TS_ASSERT_EQUALS(ev2->getNumberEvents(), 600);
+
+    ads.remove("outWS");
+    EventTeardown();
+  }
+
   //-----------------------------------------------------------------------------------------------
   void testExec_Events_MatchingPixelIDs_WithWorkspaceGroup() {
     EventSetup();
@@ -0,0 +1,114 @@
+#ifndef MANTID_DATAHANDLING_LAZYEVENTNEXUSLOADER_H_
+#define MANTID_DATAHANDLING_LAZYEVENTNEXUSLOADER_H_
+
+#include "MantidDataObjects/LazyEventLoader.h"
+#include "MantidGeometry/IDTypes.h"
+#include "MantidKernel/System.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace NeXus {
+class File;
+}
+
+namespace Mantid {
+namespace DataHandling {
+class BankPulseTimes;
+
+/** LazyEventNexusLoader : Reads the events of one NXevent_data entry of an
+  event NeXus file at a time, for an EventWorkspace that is loaded lazily by
+  LoadEventNexus. Each bank is one part of the workspace.
+
+  Events of pixels that do not belong to the spectra of the bank are
+  discarded, as are events outside of the time-of-flight filter.
+
+  Copyright &copy; 2016 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport LazyEventNexusLoader : public DataObjects::LazyEventLoader {
+public:
+  LazyEventNexusLoader(const std::string &filename,
+                       const std::string &topEntryName,
+                       const std::string &entryType,
+                       const bool oldNeXusFileNames,
+                       std::vector<size_t> pixelIDToWorkspaceIndex,
+                       const detid_t pixelIDOffset,
+                       boost::shared_ptr<BankPulseTimes> allBanksPulseTimes);
+
+  void addBank(const std::string &entryName,
+               std::vector<size_t> workspaceIndices);
+  void setTofFilter(const double tofMin, const double tofMax);
+  void setTofOffset(const double offset);
+  void setMaxPixelID(const detid_t maxPixelID);
+
+  size_t numberOfParts() const override;
+  std::vector<size_t> workspaceIndices(const size_t part) const override;
+  void load(const size_t part, const std::vector<DataObjects::EventList *>
+                                   &eventLists) const override;
+  bool readX(std::vector<double> &x) const override;
+
+private:
+  size_t tofRange(double &shortest, double &longest) const;
+  bool readPixelsAndTofs(::NeXus::File &file, const std::string &entryName,
+                         std::vector<uint32_t> &eventIDs,
+                         std::vector<float> &tofs) const;
+  size_t workspaceIndex(const uint32_t pixelID,
+                        const std::vector<bool> &inBank) const;
+
+  /// Name of the NeXus file
+  const std::string m_filename;
+  /// Top level NXentry of the file
+  const std::string m_topEntryName;
+  /// Class of the event entries, NXevent_data
+  const std::string m_entryType;
+  /// Use the field names of old SNS files
+  const bool m_oldNeXusFileNames;
+  /// Vector where (index = pixel ID + m_pixelIDOffset), value = workspace
+  /// index
+  const std::vector<size_t> m_pixelIDToWorkspaceIndex;
+  /// Offset in m_pixelIDToWorkspaceIndex
+  const detid_t m_pixelIDOffset;
+  /// Pulse times from the DAS logs, used if a bank has no event_time_zero
+  boost::shared_ptr<BankPulseTimes> m_allBanksPulseTimes;
+  /// Names of the event entries
+  std::vector<std::string> m_bankNames;
+  /// Workspace indices of the spectra of each bank
+  std::vector<std::vector<size_t>> m_bankIndices;
+  /// Events outside of [m_tofMin, m_tofMax] are skipped
+  double m_tofMin;
+  double m_tofMax;
+  /// Added to the time-of-flight of all events that are loaded
+  double m_tofOffset;
+  /// Events of larger pixel IDs do not count towards the X range
+  detid_t m_maxPixelID;
+  /// The NeXus API is not thread safe
+  mutable std::mutex m_fileMutex;
+};
+
+} // namespace DataHandling
+} // namespace Mantid
+
+#endif /* MANTID_DATAHANDLING_LAZYEVENTNEXUSLOADER_H_ */
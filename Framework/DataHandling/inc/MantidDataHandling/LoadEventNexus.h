@@ -117,6 +117,10 @@ public:
    * @param value :: true if you want to precount. */
   void setPrecount(bool value) { precount = value; }
 
+  /** Sets the maximum number of events of a bank read from the file at once.
+   * @param value :: number of events, must be larger than 0. */
+  void setEventsPerSlab(size_t value) { eventsPerSlab = value; }
+
   template <typename T>
   static boost::shared_ptr<BankPulseTimes> runLoadNexusLogs(
       const std::string &nexusfilename, T localWorkspace, Algorithm &alg,
@@ -201,7 +205,9 @@ public:
   /// Do we pre-count the # of events in each pixel ID?
   bool precount;
 
-  /// Tolerance for CompressEvents; use -1 to mean don't compress.
+  /// Do we compress the events while loading?
+  bool compress;
+  /// Tolerance for CompressEvents; negative for logarithmic compression.
   double compressTolerance;
 
   /// Pointer to the vector of events
@@ -237,6 +243,10 @@ public:
   /// whether or not to launch multiple ProcessBankData jobs per bank
   bool splitProcessing;
 
+  /// Maximum number of events of a bank read from the file at once. Whole
+  /// banks are read when compressing events.
+  size_t eventsPerSlab;
+
   /// Flag for dealing with a simulated file
   bool m_haveWeights;
 
@@ -264,6 +274,10 @@ private:
   void createWorkspaceIndexMaps(const bool monitors,
                                 const std::vector<std::string> &bankNames);
   void loadEvents(API::Progress *const prog, const bool monitors);
+  bool setUpLazyLoading(const std::vector<std::string> &bankNames,
+                        const std::string &classType,
+                        const bool oldNeXusFileNames,
+                        const bool isTimeFiltered);
   void createSpectraMapping(
       const std::string &nxsfile, const bool monitorsOnly,
       const std::vector<std::string> &bankNames = std::vector<std::string>());
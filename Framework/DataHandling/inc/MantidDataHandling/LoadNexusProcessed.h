@@ -194,6 +194,9 @@ private:
   /// Validates the optional 'spectra to read' properties, if they have been set
   void checkOptionalProperties(const std::size_t numberofspectra);
 
+  /// Number of consecutive spectra in the SpectrumList from a given position
+  int64_t consecutiveSpectraInList(const size_t first) const;
+
   /// calculates the workspace size
   std::size_t calculateWorkspaceSize(const std::size_t numberofspectra,
                                      bool gen_filtered_list = false);
@@ -40,6 +40,12 @@ void CompressEvents::init() {
       "The tolerance on each event's X value (normally TOF, but may be a "
       "different unit if you have used ConvertUnits).\n"
       "Any events within Tolerance will be summed into a single event.");
+
+  declareProperty(
+      "Logarithmic", false,
+      "If true, Tolerance is relative to the X value: events are summed if "
+      "they are within Tolerance times the X value of the first event of the "
+      "group, like logarithmic binning.");
 }
 
 void CompressEvents::exec() {
@@ -47,6 +53,10 @@ void CompressEvents::exec() {
   EventWorkspace_sptr inputWS = getProperty("InputWorkspace");
   EventWorkspace_sptr outputWS = getProperty("OutputWorkspace");
   double tolerance = getProperty("Tolerance");
+  // EventList::compressEvents() takes a negative tolerance as relative
+  const bool logarithmic = getProperty("Logarithmic");
+  if (logarithmic)
+    tolerance = -tolerance;
 
   // Some starting things
   bool inplace = (inputWS == outputWS);
@@ -0,0 +1,340 @@
+#include "MantidDataHandling/LazyEventNexusLoader.h"
+#include "MantidDataHandling/LoadEventNexus.h"
+#include "MantidDataObjects/EventList.h"
+#include "MantidKernel/Logger.h"
+
+#include <boost/make_shared.hpp>
+#include <nexus/NeXusFile.hpp>
+#include <nexus/NeXusException.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+
+namespace Mantid {
+namespace DataHandling {
+
+using DataObjects::EventList;
+using DataObjects::TofEvent;
+using DataObjects::WeightedEvent;
+using Kernel::DateAndTime;
+
+namespace {
+/// static logger
+Kernel::Logger g_log("LazyEventNexusLoader");
+
+/** Read a one dimensional field of the open group.
+ * @param file :: File handle, opened in the bank entry
+ * @param name :: Name of the field
+ * @param type :: Expected type of the field
+ * @param data :: Vector to fill
+ * @return false if the field has the wrong type
+ */
+template <typename T>
+bool readField(::NeXus::File &file, const std::string &name,
+               const ::NeXus::NXnumtype type, std::vector<T> &data) {
+  file.openData(name);
+  const bool typeOk = (file.getInfo().type == type);
+  if (typeOk)
+    file.getData(data);
+  else
+    g_log.warning() << "Field " << name << " has an unexpected type. The "
+                                           "bank will be skipped.\n";
+  file.closeData();
+  return typeOk;
+}
+}
+
+/** Constructor
+ *
+ * @param filename :: Name of the NeXus file
+ * @param topEntryName :: Top level NXentry of the file
+ * @param entryType :: Class of the event entries
+ * @param oldNeXusFileNames :: Use the field names of old SNS files
+ * @param pixelIDToWorkspaceIndex :: Vector where (index = pixel ID +
+ * pixelIDOffset), value = workspace index
+ * @param pixelIDOffset :: Offset in pixelIDToWorkspaceIndex
+ * @param allBanksPulseTimes :: Pulse times from the DAS logs
+ */
+LazyEventNexusLoader::LazyEventNexusLoader(
+    const std::string &filename, const std::string &topEntryName,
+    const std::string &entryType, const bool oldNeXusFileNames,
+    std::vector<size_t> pixelIDToWorkspaceIndex, const detid_t pixelIDOffset,
+    boost::shared_ptr<BankPulseTimes> allBanksPulseTimes)
+    : m_filename(filename), m_topEntryName(topEntryName),
+      m_entryType(entryType), m_oldNeXusFileNames(oldNeXusFileNames),
+      m_pixelIDToWorkspaceIndex(std::move(pixelIDToWorkspaceIndex)),
+      m_pixelIDOffset(pixelIDOffset),
+      m_allBanksPulseTimes(std::move(allBanksPulseTimes)), m_tofMin(-1e20),
+      m_tofMax(1e20), m_tofOffset(0.),
+      m_maxPixelID(std::numeric_limits<detid_t>::max()) {}
+
+/** Add a bank of the file as a part of the workspace
+ * @param entryName :: Name of the NXevent_data entry
+ * @param workspaceIndices :: Workspace indices of the pixels of the bank
+ */
+void LazyEventNexusLoader::addBank(const std::string &entryName,
+                                   std::vector<size_t> workspaceIndices) {
+  m_bankNames.push_back(entryName);
+  m_bankIndices.push_back(std::move(workspaceIndices));
+}
+
+/// Only load events with a time-of-flight in [tofMin, tofMax]
+void LazyEventNexusLoader::setTofFilter(const double tofMin,
+                                        const double tofMax) {
+  m_tofMin = tofMin;
+  m_tofMax = tofMax;
+}
+
+/// Add an offset to the time-of-flight of the events after filtering
+void LazyEventNexusLoader::setTofOffset(const double offset) {
+  m_tofOffset = offset;
+}
+
+/// Events of pixel IDs above maxPixelID do not count towards the X range
+void LazyEventNexusLoader::setMaxPixelID(const detid_t maxPixelID) {
+  m_maxPixelID = maxPixelID;
+}
+
+/** Read the time-of-flight range of the events of all banks, without their
+ * pulse times and weights. The range is the one loading all banks eagerly
+ * would find, before adding the time-of-flight offset: events outside of the
+ * filter are skipped, as are pixel IDs above m_maxPixelID, and
+ * times-of-flight of 2e8 microseconds or more do not count towards the
+ * longest one.
+ *
+ * @param shortest :: Lowered to the shortest time-of-flight.
+ * @param longest :: Raised to the longest time-of-flight.
+ * @return The number of events that will be loaded.
+ */
+size_t LazyEventNexusLoader::tofRange(double &shortest,
+                                      double &longest) const {
+  size_t numIndices = 0;
+  for (const auto &indices : m_bankIndices)
+    for (const auto wi : indices)
+      numIndices = std::max(numIndices, wi + 1);
+
+  size_t numLoaded = 0;
+  std::vector<uint32_t> eventIDs;
+  std::vector<float> tofs;
+  for (size_t part = 0; part < m_bankNames.size(); ++part) {
+    {
+      std::lock_guard<std::mutex> lock(m_fileMutex);
+      ::NeXus::File file(m_filename);
+      file.openGroup(m_topEntryName, "NXentry");
+      file.openGroup(m_bankNames[part], m_entryType);
+      if (!readPixelsAndTofs(file, m_bankNames[part], eventIDs, tofs))
+        continue;
+    }
+
+    std::vector<bool> inBank(numIndices, false);
+    for (const auto wi : m_bankIndices[part])
+      inBank[wi] = true;
+    const size_t numEvents = std::min(eventIDs.size(), tofs.size());
+    for (size_t i = 0; i < numEvents; ++i) {
+      if (static_cast<detid_t>(eventIDs[i]) > m_maxPixelID)
+        continue;
+      const double tof = static_cast<double>(tofs[i]);
+      if (tof < m_tofMin || tof > m_tofMax)
+        continue;
+      shortest = std::min(shortest, tof);
+      if (tof < 2e8)
+        longest = std::max(longest, tof);
+      if (workspaceIndex(eventIDs[i], inBank) < inBank.size())
+        ++numLoaded;
+    }
+  }
+  return numLoaded;
+}
+
+/** The X vector loading all events would give, [shortest - 1, longest + 1]
+ * of the times-of-flight without the offset, or [0, 0] if no event is
+ * loaded. Reading it scans the times-of-flight of all banks, so it is only
+ * done when a spectrum is first accessed.
+ *
+ * @param x :: Set to the X vector.
+ * @return true
+ */
+bool LazyEventNexusLoader::readX(std::vector<double> &x) const {
+  double shortest =
+      static_cast<double>(std::numeric_limits<uint32_t>::max()) * 0.1;
+  double longest = 0.;
+  x.assign(2, 0.);
+  if (tofRange(shortest, longest) > 0) {
+    x[0] = shortest - 1;
+    x[1] = longest + 1;
+  }
+  return true;
+}
+
+size_t LazyEventNexusLoader::numberOfParts() const {
+  return m_bankNames.size();
+}
+
+std::vector<size_t>
+LazyEventNexusLoader::workspaceIndices(const size_t part) const {
+  return m_bankIndices[part];
+}
+
+/** Read the pixel IDs and times-of-flight of the events of a bank.
+ * @param file :: File handle, opened in the bank entry
+ * @param entryName :: Name of the bank entry
+ * @param eventIDs :: Vector to fill with the pixel IDs
+ * @param tofs :: Vector to fill with the times-of-flight in microseconds
+ * @return false if the bank has to be skipped
+ */
+bool LazyEventNexusLoader::readPixelsAndTofs(::NeXus::File &file,
+                                             const std::string &entryName,
+                                             std::vector<uint32_t> &eventIDs,
+                                             std::vector<float> &tofs) const {
+  if (!readField(file, m_oldNeXusFileNames ? "event_pixel_id" : "event_id",
+                 ::NeXus::UINT32, eventIDs))
+    return false;
+
+  const std::string tofName =
+      m_oldNeXusFileNames ? "event_time_of_flight" : "event_time_offset";
+  file.openData(tofName);
+  std::string units;
+  file.getAttr("units", units);
+  file.closeData();
+  if (units != "microsecond") {
+    g_log.warning() << "Entry " << entryName
+                    << "'s event_time_offset field's units are not "
+                       "microsecond. It will be skipped.\n";
+    return false;
+  }
+  return readField(file, tofName, ::NeXus::FLOAT32, tofs);
+}
+
+/** Returns the workspace index of the events of a pixel.
+ * @param pixelID :: The pixel ID of an event
+ * @param inBank :: True for the workspace indices of the bank
+ * @return The workspace index, inBank.size() if the pixel has none or it is
+ * not in the bank.
+ */
+size_t LazyEventNexusLoader::workspaceIndex(
+    const uint32_t pixelID, const std::vector<bool> &inBank) const {
+  const size_t index =
+      static_cast<size_t>(static_cast<int64_t>(pixelID) + m_pixelIDOffset);
+  if (index >= m_pixelIDToWorkspaceIndex.size())
+    return inBank.size();
+  const size_t wi = m_pixelIDToWorkspaceIndex[index];
+  if (wi >= inBank.size() || !inBank[wi])
+    return inBank.size();
+  return wi;
+}
+
+/** Read all events of a bank and add them to the event lists of its pixels.
+ *
+ * @param part :: Index of the bank.
+ * @param eventLists :: All event lists of the workspace.
+ */
+void LazyEventNexusLoader::load(
+    const size_t part, const std::vector<EventList *> &eventLists) const {
+  const std::string &entryName = m_bankNames[part];
+  std::vector<uint64_t> eventIndex;
+  std::vector<uint32_t> eventIDs;
+  std::vector<float> tofs;
+  std::vector<float> weights;
+  boost::shared_ptr<BankPulseTimes> pulseTimes = m_allBanksPulseTimes;
+  {
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+    ::NeXus::File file(m_filename);
+    file.openGroup(m_topEntryName, "NXentry");
+    file.openGroup(entryName, m_entryType);
+    if (!readField(file, "event_index", ::NeXus::UINT64, eventIndex))
+      return;
+
+    std::map<std::string, std::string> entries = file.getEntries();
+    if (entries.count("event_time_zero") > 0)
+      pulseTimes =
+          boost::make_shared<BankPulseTimes>(file, std::vector<int>());
+
+    if (!readPixelsAndTofs(file, entryName, eventIDs, tofs))
+      return;
+
+    if (entries.count("event_weight") > 0 &&
+        !readField(file, "event_weight", ::NeXus::FLOAT32, weights))
+      return;
+  }
+
+  const size_t numEvents = std::min(eventIDs.size(), tofs.size());
+  if (!weights.empty() && weights.size() < numEvents) {
+    g_log.warning() << "Entry " << entryName
+                    << "'s event_weight field is too small. It will be "
+                       "skipped.\n";
+    return;
+  }
+
+  // Count the events of each spectrum of the bank first, so that the event
+  // lists do not need to grow while adding them.
+  const auto &bankIndices = m_bankIndices[part];
+  std::vector<size_t> counts(eventLists.size(), 0);
+  std::vector<bool> inBank(eventLists.size(), false);
+  for (const auto wi : bankIndices)
+    inBank[wi] = true;
+  size_t discarded = 0;
+  for (size_t i = 0; i < numEvents; ++i) {
+    const double tof = static_cast<double>(tofs[i]);
+    if (tof < m_tofMin || tof > m_tofMax)
+      continue;
+    const size_t wi = workspaceIndex(eventIDs[i], inBank);
+    if (wi < eventLists.size())
+      ++counts[wi];
+    else
+      ++discarded;
+  }
+  for (const auto wi : bankIndices)
+    eventLists[wi]->reserve(eventLists[wi]->getNumberEvents() + counts[wi]);
+  // LoadEventNexus switches all lists to weighted events if any bank has
+  // weights
+  const bool weighted =
+      !bankIndices.empty() &&
+      eventLists[bankIndices.front()]->getEventType() == API::WEIGHTED;
+
+  const size_t numPulses =
+      pulseTimes ? std::min(pulseTimes->numPulses, eventIndex.size()) : 0;
+  size_t pulse = 0;
+  DateAndTime pulseTime;
+  DateAndTime lastPulseTime;
+  bool pulseTimesIncreasing = true;
+  for (size_t i = 0; i < numEvents; ++i) {
+    // Find the pulse of this event: event_index[pulse] <= i < the next one
+    if (numPulses > 0) {
+      while (pulse + 1 < numPulses && i >= eventIndex[pulse + 1])
+        ++pulse;
+      pulseTime = pulseTimes->pulseTimes[pulse];
+      if (pulseTime < lastPulseTime)
+        pulseTimesIncreasing = false;
+      else
+        lastPulseTime = pulseTime;
+    }
+
+    const double tof = static_cast<double>(tofs[i]);
+    if (tof < m_tofMin || tof > m_tofMax)
+      continue;
+    const size_t wi = workspaceIndex(eventIDs[i], inBank);
+    if (wi >= eventLists.size())
+      continue;
+    if (!weighted) {
+      eventLists[wi]->addEventQuickly(TofEvent(tof + m_tofOffset, pulseTime));
+    } else {
+      const double weight =
+          weights.empty() ? 1. : static_cast<double>(weights[i]);
+      eventLists[wi]->addEventQuickly(
+          WeightedEvent(tof + m_tofOffset, pulseTime, weight, weight * weight));
+    }
+  }
+
+  for (const auto wi : bankIndices)
+    eventLists[wi]->setSortOrder(pulseTimesIncreasing
+                                     ? DataObjects::PULSETIME_SORT
+                                     : DataObjects::UNSORTED);
+
+  if (discarded > 0)
+    g_log.debug() << "Discarded " << discarded << " events of " << entryName
+                  << " from pixels that are not in the bank.\n";
+}
+
+} // namespace DataHandling
+} // namespace Mantid
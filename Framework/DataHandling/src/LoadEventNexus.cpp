@@ -1,5 +1,6 @@
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidDataHandling/EventWorkspaceCollection.h"
+#include "MantidDataHandling/LazyEventNexusLoader.h"
 
 #include "MantidAPI/Axis.h"
 #include "MantidAPI/FileProperty.h"
@@ -23,6 +24,9 @@
 #include <boost/shared_array.hpp>
 #include <boost/function.hpp>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <functional>
 
 using std::map;
@@ -136,6 +140,44 @@ bool BankPulseTimes::equals(size_t otherNumPulse, std::string otherStartTime) {
           (this->numPulses == otherNumPulse));
 }
 
+//==============================================================================================
+// Struct BankSlabs
+//==============================================================================================
+/** State shared by the tasks loading and processing the events of one bank.
+*
+* A bank is read from the file in slabs of at most
+* LoadEventNexus::eventsPerSlab events. Each slab is handed to ProcessBankData
+* as soon as it has been read, and the next slab is read once all tasks
+* processing the current one have started. Reading of one slab thus overlaps
+* with processing of the previous one, at most two slabs per bank are held in
+* memory, and the events end up in the event lists in file order. A bank that
+* cannot be read from its first slab is skipped; an error reading a later slab
+* aborts the loading, since the bank would otherwise be incomplete.
+*/
+struct BankSlabs {
+  /// Vector of event index (length of # of pulses)
+  boost::shared_ptr<std::vector<uint64_t>> event_index;
+  /// Pulse times for this bank
+  boost::shared_ptr<BankPulseTimes> pulseTimes;
+  /// Index of the first event to load
+  size_t startEvent = 0;
+  /// Index after the last event to load
+  size_t stopEvent = 0;
+  /// Largest pixel ID handled by the first of the two processing tasks
+  uint32_t midID = std::numeric_limits<uint32_t>::max();
+  /// Mutexes serializing the processing of consecutive slabs, one for the
+  /// pixel IDs up to midID and one for those above.
+  boost::shared_ptr<std::mutex> lowMutex;
+  boost::shared_ptr<std::mutex> highMutex;
+  /// Pulse of the last event processed, for the pixel IDs up to midID and for
+  /// those above. The next slab continues the search for its pulses there.
+  std::array<int, 2> pulseIndex{{0, 0}};
+  /// Number of tasks processing the current slab that have not started yet
+  std::atomic<int> tasksToStart{0};
+  /// Schedules loading of the next slab; empty after the last one
+  std::function<void()> loadNextSlab;
+};
+
 //==============================================================================================
 // Class ProcessBankData
 //==============================================================================================
@@ -160,6 +202,9 @@ public:
   * @param event_weight :: array with weights for events
   * @param min_event_id ;: minimum detector ID to load
   * @param max_event_id :: maximum detector ID to load
+  * @param slabs :: state shared by all tasks loading this bank
+  * @param precountScale :: ratio of the events of the whole bank to those in
+  *the arrays, used to scale the pre-counted events. 0 skips pre-counting.
   * @return
   */
   ProcessBankData(LoadEventNexus *alg, std::string entry_name, Progress *prog,
@@ -169,7 +214,8 @@ public:
                   boost::shared_ptr<std::vector<uint64_t>> event_index,
                   boost::shared_ptr<BankPulseTimes> thisBankPulseTimes,
                   bool have_weight, boost::shared_array<float> event_weight,
-                  detid_t min_event_id, detid_t max_event_id)
+                  detid_t min_event_id, detid_t max_event_id,
+                  boost::shared_ptr<BankSlabs> slabs, double precountScale)
       : Task(), alg(alg), entry_name(entry_name),
         pixelID_to_wi_vector(alg->pixelID_to_wi_vector),
         pixelID_to_wi_offset(alg->pixelID_to_wi_offset), prog(prog),
@@ -177,7 +223,8 @@ public:
         numEvents(numEvents), startAt(startAt), event_index(event_index),
         thisBankPulseTimes(thisBankPulseTimes), have_weight(have_weight),
         event_weight(event_weight), m_min_id(min_event_id),
-        m_max_id(max_event_id) {
+        m_max_id(max_event_id), m_slabs(slabs),
+        m_precountScale(precountScale) {
     // Cost is approximately proportional to the number of events to process.
     m_cost = static_cast<double>(numEvents);
   }
@@ -186,6 +233,14 @@ public:
   /** Run the data processing
   */
   void run() override {
+    // This task holds its mutex now, so the next slab of the bank can be read
+    // without its processing overtaking this one.
+    if (--m_slabs->tasksToStart == 0) {
+      auto loadNextSlab = std::move(m_slabs->loadNextSlab);
+      if (loadNextSlab)
+        loadNextSlab();
+    }
+
     // Local tof limits
     double my_shortest_tof =
         static_cast<double>(std::numeric_limits<uint32_t>::max()) * 0.1;
@@ -197,7 +252,7 @@ public:
     prog->report(entry_name + ": precount");
     // ---- Pre-counting events per pixel ID ----
     auto &outputWS = *(alg->m_ws);
-    if (alg->precount) {
+    if (alg->precount && m_precountScale > 0.) {
 
       std::vector<size_t> counts(m_max_id - m_min_id + 1, 0);
       for (size_t i = 0; i < numEvents; i++) {
@@ -215,7 +270,10 @@ public:
           size_t wi = pixelID_to_wi_vector[pixID + pixelID_to_wi_offset];
           // Allocate it
           if (wi < numEventLists) {
-            outputWS.reserveEventListAt(wi, counts[pixID - m_min_id]);
+            outputWS.reserveEventListAt(
+                wi, static_cast<size_t>(
+                        static_cast<double>(counts[pixID - m_min_id]) *
+                        m_precountScale));
           }
           if (alg->getCancel())
             break; // User cancellation
@@ -236,12 +294,16 @@ public:
 
     bool pulsetimesincreasing = true;
 
-    // Index into the pulse array
-    int pulse_i = 0;
+    // Index into the pulse array, continuing from the previous slab. Only
+    // the tasks holding the mutex of this half of the bank use it.
+    int &slabPulseIndex =
+        m_slabs->pulseIndex[static_cast<uint32_t>(m_min_id) > m_slabs->midID];
+    int pulse_i = slabPulseIndex;
 
     // And there are this many pulses
     int numPulses = static_cast<int>(thisBankPulseTimes->numPulses);
-    if (numPulses > static_cast<int>(event_index->size())) {
+    if (numPulses > static_cast<int>(event_index->size()) &&
+        pulse_i <= numPulses) {
       alg->getLogger().warning()
           << "Entry " << entry_name
           << "'s event_index vector is smaller than the event_time_zero field. "
@@ -254,7 +316,7 @@ public:
     prog->report(entry_name + ": filling events");
 
     // Will we need to compress?
-    bool compress = (alg->compressTolerance >= 0);
+    const bool compress = alg->compress;
 
     // Which detector IDs were touched? - only matters if compress is on
     std::vector<bool> usedDetIds;
@@ -364,6 +426,7 @@ public:
 
       } // valid detector IDs
     }   //(for each event)
+    slabPulseIndex = pulse_i;
 
     //------------ Compress Events (or set sort order) ------------------
     // Do it on all the detector IDs we touched
@@ -373,8 +436,9 @@ public:
           // Find the the workspace index corresponding to that pixel ID
           size_t wi = pixelID_to_wi_vector[pixID + pixelID_to_wi_offset];
           auto &el = outputWS.getSpectrum(wi);
+          // Events of later slabs are merged into the compressed events
           if (compress)
-            el.compressEvents(alg->compressTolerance, &el);
+            el.compressAppendedEvents(alg->compressTolerance);
           else {
             if (pulsetimesincreasing)
               el.setSortOrder(DataObjects::PULSETIME_SORT);
@@ -442,6 +506,10 @@ private:
   detid_t m_min_id;
   /// Maximum pixel id
   detid_t m_max_id;
+  /// State shared by all tasks loading this bank
+  boost::shared_ptr<BankSlabs> m_slabs;
+  /// Scale from the events in the arrays to those of the whole bank
+  double m_precountScale;
   /// timer for performance
   Mantid::Kernel::Timer m_timer;
 }; // END-DEF-CLASS ProcessBankData
@@ -466,6 +534,10 @@ public:
   * @param ioMutex :: a mutex shared for all Disk I-O tasks
   * @param scheduler :: the ThreadScheduler that runs this task.
   * @param framePeriodNumbers :: Period numbers corresponding to each frame
+  * @param slabs :: state of the bank shared with the tasks loading the previous
+  *slabs, or NULL to start loading the bank.
+  * @param slabStart :: index of the first event of the slab to load. Ignored if
+  *slabs is NULL.
   */
   LoadBankFromDiskTask(LoadEventNexus *alg, const std::string &entry_name,
                        const std::string &entry_type,
@@ -473,11 +545,14 @@ public:
                        const bool oldNeXusFileNames, Progress *prog,
                        boost::shared_ptr<std::mutex> ioMutex,
                        ThreadScheduler *scheduler,
-                       const std::vector<int> &framePeriodNumbers)
+                       const std::vector<int> &framePeriodNumbers,
+                       boost::shared_ptr<BankSlabs> slabs = nullptr,
+                       const size_t slabStart = 0)
       : Task(), alg(alg), entry_name(entry_name), entry_type(entry_type),
         // prog(prog), scheduler(scheduler), thisBankPulseTimes(NULL),
         // m_loadError(false),
-        prog(prog), scheduler(scheduler), m_loadError(false),
+        prog(prog), scheduler(scheduler), m_slabs(slabs),
+        m_slabStart(slabStart), m_loadError(false),
         m_oldNexusFileNames(oldNeXusFileNames), m_loadStart(), m_loadSize(),
         m_event_id(nullptr), m_event_time_of_flight(nullptr),
         m_have_weight(false), m_event_weight(nullptr),
@@ -559,6 +634,19 @@ public:
     return;
   }
 
+  //---------------------------------------------------------------------------------------------------
+  /** Open the event_id field
+  *
+  * @param file :: File handle for the NeXus file
+  */
+  void openEventId(::NeXus::File &file) {
+    // Get the list of pixel ID's
+    if (m_oldNexusFileNames)
+      file.openData("event_pixel_id");
+    else
+      file.openData("event_id");
+  }
+
   //---------------------------------------------------------------------------------------------------
   /** Open the event_id field and validate the contents
   *
@@ -570,11 +658,7 @@ public:
   */
   void prepareEventId(::NeXus::File &file, size_t &start_event,
                       size_t &stop_event, std::vector<uint64_t> &event_index) {
-    // Get the list of pixel ID's
-    if (m_oldNexusFileNames)
-      file.openData("event_pixel_id");
-    else
-      file.openData("event_id");
+    this->openEventId(file);
 
     // By default, use all available indices
     start_event = 0;
@@ -674,14 +758,10 @@ public:
           m_max_id = temp;
       }
 
-      if (m_min_id > static_cast<uint32_t>(alg->eventid_max)) {
-        // All the detector IDs in the bank are higher than the highest 'known'
-        // (from the IDF)
-        // ID. Setting this will abort the loading of the bank.
-        m_loadError = true;
-      }
       // fixup the maximum pixel id in the case that it's higher than the
-      // highest 'known' id
+      // highest 'known' id. If all the detector IDs in the slab are higher
+      // than the highest 'known' (from the IDF) ID, this makes the maximum
+      // lower than the minimum and the slab is skipped.
       if (m_max_id > static_cast<uint32_t>(alg->eventid_max))
         m_max_id = static_cast<uint32_t>(alg->eventid_max);
     }
@@ -786,11 +866,48 @@ public:
   }
 
   //---------------------------------------------------------------------------------------------------
-  void run() override {
-    // The vectors we will be filling
-    auto event_index_ptr = new std::vector<uint64_t>();
-    std::vector<uint64_t> &event_index = *event_index_ptr;
+  /** Load the information needed to read the events of the bank: event_index,
+  * pulse times and the range of events to load. Creates the state shared by
+  * the tasks loading the slabs of this bank.
+  *
+  * @param file :: File handle for the NeXus file, opened in the bank entry
+  */
+  void prepareBank(::NeXus::File &file) {
+    auto event_index = boost::make_shared<std::vector<uint64_t>>();
+
+    // Load the event_index field.
+    this->loadEventIndex(file, *event_index);
+    if (m_loadError)
+      return;
 
+    // Load and validate the pulse times
+    this->loadPulseTimes(file);
+
+    // The event_index should be the same length as the pulse times from DAS
+    // logs.
+    if (event_index->size() != thisBankPulseTimes->numPulses)
+      alg->getLogger().warning()
+          << "Bank " << entry_name
+          << " has a mismatch between the number of event_index entries "
+             "and the number of pulse times in event_time_zero.\n";
+
+    // Open and validate event_id field.
+    size_t start_event = 0;
+    size_t stop_event = 0;
+    this->prepareEventId(file, start_event, stop_event, *event_index);
+
+    m_slabs = boost::make_shared<BankSlabs>();
+    m_slabs->event_index = event_index;
+    m_slabs->pulseTimes = thisBankPulseTimes;
+    m_slabs->startEvent = start_event;
+    m_slabs->stopEvent = stop_event;
+    m_slabs->lowMutex = boost::make_shared<std::mutex>();
+    m_slabs->highMutex = boost::make_shared<std::mutex>();
+    m_slabStart = start_event;
+  }
+
+  //---------------------------------------------------------------------------------------------------
+  void run() override {
     // These give the limits in each file as to which events we actually load
     // (when filtering by time).
     m_loadStart.resize(1, 0);
@@ -803,6 +920,9 @@ public:
 
     m_loadError = false;
     m_have_weight = alg->m_haveWeights;
+    // The events of the previous slabs are in the workspace already
+    const bool laterSlab = static_cast<bool>(m_slabs);
+    std::string errorMessage;
 
     prog->report(entry_name + ": load from disk");
 
@@ -814,29 +934,19 @@ public:
       // Open the bankN_event group
       file.openGroup(entry_name, entry_type);
 
-      // Load the event_index field.
-      this->loadEventIndex(file, event_index);
+      if (!m_slabs)
+        // First slab: find out what to load
+        this->prepareBank(file);
+      else
+        this->openEventId(file);
 
       if (!m_loadError) {
-        // Load and validate the pulse times
-        this->loadPulseTimes(file);
-
-        // The event_index should be the same length as the pulse times from DAS
-        // logs.
-        if (event_index.size() != thisBankPulseTimes->numPulses)
-          alg->getLogger().warning()
-              << "Bank " << entry_name
-              << " has a mismatch between the number of event_index entries "
-                 "and the number of pulse times in event_time_zero.\n";
-
-        // Open and validate event_id field.
-        size_t start_event = 0;
-        size_t stop_event = 0;
-        this->prepareEventId(file, start_event, stop_event, event_index);
-
         // These are the arguments to getSlab()
-        m_loadStart[0] = static_cast<int>(start_event);
-        m_loadSize[0] = static_cast<int>(stop_event - start_event);
+        size_t stop_event = m_slabs->stopEvent;
+        if (stop_event - m_slabStart > alg->eventsPerSlab)
+          stop_event = m_slabStart + alg->eventsPerSlab;
+        m_loadStart[0] = static_cast<int>(m_slabStart);
+        m_loadSize[0] = static_cast<int>(stop_event - m_slabStart);
 
         if ((m_loadSize[0] > 0) && (m_loadStart[0] >= 0)) {
           // Load pixel IDs
@@ -864,10 +974,12 @@ public:
       alg->getLogger().error() << "Error while loading bank " << entry_name
                                << ":\n";
       alg->getLogger().error() << e.what() << '\n';
+      errorMessage = e.what();
       m_loadError = true;
     } catch (...) {
       alg->getLogger().error() << "Unspecified error while loading bank "
                                << entry_name << '\n';
+      errorMessage = "unspecified error";
       m_loadError = true;
     }
 
@@ -883,10 +995,54 @@ public:
       if (m_have_weight) {
         delete[] m_event_weight;
       }
-      delete event_index_ptr;
+      // A bank that failed part way through would silently be incomplete
+      if (laterSlab && !errorMessage.empty())
+        throw std::runtime_error(
+            "Bank " + entry_name + " could only be loaded up to event " +
+            std::to_string(m_slabStart) + " of " +
+            std::to_string(m_slabs->stopEvent) + ": " + errorMessage);
       return;
     }
 
+    this->scheduleProcessing();
+  }
+
+  //---------------------------------------------------------------------------------------------------
+  /** Schedule the tasks processing the loaded slab, and make the last of them
+  * to start schedule loading of the next slab.
+  */
+  void scheduleProcessing() {
+    // convert things to shared_arrays
+    boost::shared_array<uint32_t> event_id_shrd(m_event_id);
+    boost::shared_array<float> event_time_of_flight_shrd(
+        m_event_time_of_flight);
+    boost::shared_array<float> event_weight_shrd(m_event_weight);
+
+    size_t numEvents = m_loadSize[0];
+    size_t startAt = m_loadStart[0];
+    const bool firstSlab = (startAt == m_slabs->startEvent);
+
+    std::function<void()> loadNextSlab;
+    const size_t nextSlabStart = startAt + numEvents;
+    if (nextSlabStart < m_slabs->stopEvent) {
+      // Copies, this task is gone when the next slab is scheduled
+      auto alg = this->alg;
+      auto entry_name = this->entry_name;
+      auto entry_type = this->entry_type;
+      auto oldNexusFileNames = m_oldNexusFileNames;
+      auto prog = this->prog;
+      auto ioMutex = getMutex();
+      auto scheduler = this->scheduler;
+      auto framePeriodNumbers = m_framePeriodNumbers;
+      auto slabs = m_slabs;
+      loadNextSlab = [=]() {
+        scheduler->push(new LoadBankFromDiskTask(
+            alg, entry_name, entry_type, slabs->stopEvent - nextSlabStart,
+            oldNexusFileNames, prog, ioMutex, scheduler, framePeriodNumbers,
+            slabs, nextSlabStart));
+      };
+    }
+
     const auto bank_size = m_max_id - m_min_id;
     const uint32_t minSpectraToLoad = static_cast<uint32_t>(alg->m_specMin);
     const uint32_t maxSpectraToLoad = static_cast<uint32_t>(alg->m_specMax);
@@ -894,57 +1050,61 @@ public:
     // check that if a range of spectra were requested that these fit within
     // this bank
     if (minSpectraToLoad != emptyInt && m_min_id < minSpectraToLoad) {
-      if (minSpectraToLoad > m_max_id) { // the minimum spectra to load is more
-                                         // than the max of this bank
-        return;
-      }
-      // the min spectra to load is higher than the min for this bank
+      // the min spectra to load is higher than the min for this bank. If it is
+      // more than the max of this bank nothing is left to load.
       m_min_id = minSpectraToLoad;
     }
     if (maxSpectraToLoad != emptyInt && m_max_id > maxSpectraToLoad) {
-      if (maxSpectraToLoad < m_min_id) {
-        // the maximum spectra to load is less than the minimum of this bank
-        return;
-      }
-      // the max spectra to load is lower than the max for this bank
+      // the max spectra to load is lower than the max for this bank. If it is
+      // less than the min of this bank nothing is left to load.
       m_max_id = maxSpectraToLoad;
     }
     if (m_min_id > m_max_id) {
       // the min is now larger than the max, this means the entire block of
-      // spectra to load is outside this bank
+      // spectra to load is outside this slab
+      if (loadNextSlab)
+        loadNextSlab();
       return;
     }
 
-    // schedule the job to generate the event lists
-    auto mid_id = m_max_id;
-    if (alg->splitProcessing && m_max_id > (m_min_id + (bank_size / 4)))
+    // The first slab decides whether the bank is processed by two tasks
+    if (firstSlab && alg->splitProcessing &&
+        m_max_id > (m_min_id + (bank_size / 4)))
       // only split if told to and the section to load is at least 1/4 the size
       // of the whole bank
-      mid_id = (m_max_id + m_min_id) / 2;
-
-    // No error? Launch a new task to process that data.
-    size_t numEvents = m_loadSize[0];
-    size_t startAt = m_loadStart[0];
-
-    // convert things to shared_arrays
-    boost::shared_array<uint32_t> event_id_shrd(m_event_id);
-    boost::shared_array<float> event_time_of_flight_shrd(
-        m_event_time_of_flight);
-    boost::shared_array<float> event_weight_shrd(m_event_weight);
-    boost::shared_ptr<std::vector<uint64_t>> event_index_shrd(event_index_ptr);
-
-    ProcessBankData *newTask1 = new ProcessBankData(
-        alg, entry_name, prog, event_id_shrd, event_time_of_flight_shrd,
-        numEvents, startAt, event_index_shrd, thisBankPulseTimes, m_have_weight,
-        event_weight_shrd, m_min_id, mid_id);
-    scheduler->push(newTask1);
-    if (alg->splitProcessing && (mid_id < m_max_id)) {
-      ProcessBankData *newTask2 = new ProcessBankData(
+      m_slabs->midID = (m_max_id + m_min_id) / 2;
+
+    // Pre-count on the first slab only, scaled to the whole bank
+    const double precountScale =
+        firstSlab ? static_cast<double>(m_slabs->stopEvent - startAt) /
+                        static_cast<double>(numEvents)
+                  : 0.;
+
+    // No error? Launch new tasks to process that data.
+    std::vector<Task *> tasks;
+    if (m_min_id <= m_slabs->midID) {
+      tasks.push_back(new ProcessBankData(
           alg, entry_name, prog, event_id_shrd, event_time_of_flight_shrd,
-          numEvents, startAt, event_index_shrd, thisBankPulseTimes,
-          m_have_weight, event_weight_shrd, (mid_id + 1), m_max_id);
-      scheduler->push(newTask2);
+          numEvents, startAt, m_slabs->event_index, m_slabs->pulseTimes,
+          m_have_weight, event_weight_shrd, m_min_id,
+          std::min(m_max_id, m_slabs->midID), m_slabs, precountScale));
+      tasks.back()->setMutex(m_slabs->lowMutex);
     }
+    if (m_max_id > m_slabs->midID) {
+      tasks.push_back(new ProcessBankData(
+          alg, entry_name, prog, event_id_shrd, event_time_of_flight_shrd,
+          numEvents, startAt, m_slabs->event_index, m_slabs->pulseTimes,
+          m_have_weight, event_weight_shrd,
+          std::max(m_min_id, m_slabs->midID + 1), m_max_id, m_slabs,
+          precountScale));
+      tasks.back()->setMutex(m_slabs->highMutex);
+    }
+
+    // Only this task touches the shared state until the tasks start
+    m_slabs->loadNextSlab = loadNextSlab;
+    m_slabs->tasksToStart = static_cast<int>(tasks.size());
+    for (auto task : tasks)
+      scheduler->push(task);
   }
 
   //---------------------------------------------------------------------------------------------------
@@ -973,6 +1133,10 @@ private:
   Progress *prog;
   /// ThreadScheduler running this task
   ThreadScheduler *scheduler;
+  /// State shared by the tasks loading this bank
+  boost::shared_ptr<BankSlabs> m_slabs;
+  /// Index of the first event of the slab to load
+  size_t m_slabStart;
   /// Object with the pulse times for this bank
   boost::shared_ptr<BankPulseTimes> thisBankPulseTimes;
   /// Did we get an error in loading
@@ -1012,12 +1176,13 @@ LoadEventNexus::LoadEventNexus()
       filter_time_start(), filter_time_stop(), chunk(0), totalChunks(0),
       firstChunkForBank(0), eventsPerChunk(0), m_tofMutex(), longest_tof(0),
       shortest_tof(0), bad_tofs(0), discarded_events(0), precount(0),
-      compressTolerance(0), eventVectors(), m_eventVectorMutex(),
-      eventid_max(0), pixelID_to_wi_vector(), pixelID_to_wi_offset(),
-      m_bankPulseTimes(), m_allBanksPulseTimes(), m_top_entry_name(),
-      m_file(nullptr), splitProcessing(false), m_haveWeights(false),
-      weightedEventVectors(), m_instrument_loaded_correctly(false),
-      loadlogs(false), m_logs_loaded_correctly(false), event_id_is_spec(false) {
+      compress(false), compressTolerance(0), eventVectors(),
+      m_eventVectorMutex(), eventid_max(0), pixelID_to_wi_vector(),
+      pixelID_to_wi_offset(), m_bankPulseTimes(), m_allBanksPulseTimes(),
+      m_top_entry_name(), m_file(nullptr), splitProcessing(false),
+      eventsPerSlab(4000000), m_haveWeights(false), weightedEventVectors(),
+      m_instrument_loaded_correctly(false), loadlogs(false),
+      m_logs_loaded_correctly(false), event_id_is_spec(false) {
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1131,6 +1296,11 @@ void LoadEventNexus::init() {
                   "negative to not do). "
                   "This specified the tolerance to use (in microseconds) when "
                   "compressing.");
+  declareProperty(
+      "CompressLogarithmic", false,
+      "If true, CompressTolerance is relative to the TOF: events are summed "
+      "if they are within CompressTolerance times the TOF of the first event "
+      "of the group, like logarithmic binning.");
 
   auto mustBePositive = boost::make_shared<BoundedValidator<int>>();
   mustBePositive->setLower(1);
@@ -1146,11 +1316,31 @@ void LoadEventNexus::init() {
   setPropertySettings("TotalChunks", make_unique<VisibleWhenProperty>(
                                          "ChunkNumber", IS_NOT_DEFAULT));
 
+  declareProperty(
+      make_unique<PropertyWithValue<bool>>("LoadLazily", false,
+                                           Direction::Input),
+      "Read the events of a bank from the file only when its spectra are "
+      "accessed (optional, default False). Not supported together with "
+      "filtering by time, chunks or CompressTolerance.");
+
+  auto mustBeNonNegative = boost::make_shared<BoundedValidator<int>>();
+  mustBeNonNegative->setLower(0);
+  declareProperty("LazyMemoryLimit", 0, mustBeNonNegative,
+                  "If loading lazily, the memory in MB that banks which were "
+                  "only read may use before the least recently used ones are "
+                  "dropped and read again when needed (optional, default 0 "
+                  "keeps all banks that were read).");
+  setPropertySettings("LazyMemoryLimit", make_unique<VisibleWhenProperty>(
+                                             "LoadLazily", IS_NOT_DEFAULT));
+
   std::string grp3 = "Reduce Memory Use";
   setPropertyGroup("Precount", grp3);
   setPropertyGroup("CompressTolerance", grp3);
+  setPropertyGroup("CompressLogarithmic", grp3);
   setPropertyGroup("ChunkNumber", grp3);
   setPropertyGroup("TotalChunks", grp3);
+  setPropertyGroup("LoadLazily", grp3);
+  setPropertyGroup("LazyMemoryLimit", grp3);
 
   declareProperty(make_unique<PropertyWithValue<bool>>("LoadMonitors", false,
                                                        Direction::Input),
@@ -1324,6 +1514,11 @@ void LoadEventNexus::exec() {
 
   precount = getProperty("Precount");
   compressTolerance = getProperty("CompressTolerance");
+  compress = compressTolerance >= 0;
+  // EventList::compressEvents() takes a negative tolerance as logarithmic
+  const bool compressLogarithmic = getProperty("CompressLogarithmic");
+  if (compressLogarithmic)
+    compressTolerance = -compressTolerance;
 
   loadlogs = getProperty("LoadLogs");
 
@@ -1889,6 +2084,12 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
   for (size_t i = 0; i < m_ws->getNumberHistograms(); i++)
     m_ws->getSpectrum(i).setSortOrder(DataObjects::PULSETIME_SORT);
 
+  const bool loadLazily = getProperty("LoadLazily");
+  if (loadLazily && !monitors &&
+      setUpLazyLoading(bankNames, classType, oldNeXusFileNames,
+                       is_time_filtered))
+    return;
+
   // Count the limits to time of flight
   shortest_tof =
       static_cast<double>(std::numeric_limits<uint32_t>::max()) * 0.1;
@@ -1967,9 +2168,12 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
       bool(bankNames.size() * 2 < ThreadPool::getNumPhysicalCores());
 
   // set up progress bar for the rest of the (multi-threaded) process
-  size_t numProg = bankNames.size() * (1 + 3); // 1 = disktask, 3 = proc task
+  size_t numSlabs = 0;
+  for (const auto bankEvents : bankNumEvents)
+    numSlabs += bankEvents > 0 ? (bankEvents - 1) / eventsPerSlab + 1 : 1;
+  size_t numProg = numSlabs * (1 + 3); // 1 = disktask, 3 = proc task
   if (splitProcessing)
-    numProg += bankNames.size() * 3; // 3 = second proc task
+    numProg += numSlabs * 3; // 3 = second proc task
   auto prog2 = new Progress(this, 0.3, 1.0, numProg);
 
   const std::vector<int> periodLogVec = periodLog->valuesAsVector();
@@ -2039,6 +2243,119 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
   loadTimeOfFlight(m_ws, m_top_entry_name, classType);
 }
 
+//-----------------------------------------------------------------------------
+/** Attach a LazyEventNexusLoader to the output workspace instead of reading
+* the events. Each bank is read when one of its spectra is first accessed.
+* This needs the pixels of every bank from the instrument, so that the
+* spectra of a bank can be filled without reading any other bank.
+*
+* @param bankNames :: The NXevent_data entries to load
+* @param classType :: The class of the entries
+* @param oldNeXusFileNames :: Identify if file is of old variety
+* @param isTimeFiltered :: Whether events are filtered by pulse time
+* @return false if the file can not be loaded lazily; the events need to be
+* loaded as usual then.
+*/
+bool LoadEventNexus::setUpLazyLoading(const std::vector<std::string> &bankNames,
+                                      const std::string &classType,
+                                      const bool oldNeXusFileNames,
+                                      const bool isTimeFiltered) {
+  std::string reason;
+  if (isTimeFiltered)
+    reason = "filtering by time";
+  else if (chunk != EMPTY_INT())
+    reason = "loading chunks";
+  else if (compress)
+    reason = "CompressTolerance";
+  else if (m_ws->nPeriods() > 1)
+    reason = "multi-period data";
+  else if (event_id_is_spec)
+    reason = "files with spectrum numbers as event IDs";
+  else if (std::find(bankNames.begin(), bankNames.end(),
+                     "detector_1_events") != bankNames.end())
+    // loadTimeOfFlight() changes the events of ISIS files
+    reason = "ISIS event files";
+  else if (!ConfigService::Instance().hasProperty(
+               "loadeventnexus.keeppausedevents") &&
+           m_ws->run().hasProperty("pause") &&
+           m_ws->run().getLogData("pause")->size() > 1)
+    // filterDuringPause() would read all events again
+    reason = "runs that were paused";
+
+  const size_t numHistograms = m_ws->getNumberHistograms();
+  std::vector<std::vector<size_t>> bankIndices;
+  std::vector<bool> used(numHistograms, false);
+  for (const auto &bankName : bankNames) {
+    if (!reason.empty())
+      break;
+    std::vector<IDetector_const_sptr> dets;
+    m_ws->getInstrument()->getDetectorsInBank(
+        dets, bankName.substr(0, bankName.rfind("_events")));
+    if (dets.empty()) {
+      reason = "banks that are not found in the instrument";
+      break;
+    }
+    std::vector<size_t> indices;
+    indices.reserve(dets.size());
+    for (const auto &det : dets) {
+      const int64_t index =
+          static_cast<int64_t>(det->getID()) + pixelID_to_wi_offset;
+      if (index < 0 ||
+          index >= static_cast<int64_t>(pixelID_to_wi_vector.size()))
+        continue;
+      const size_t wi = pixelID_to_wi_vector[index];
+      if (wi >= numHistograms)
+        continue;
+      if (used[wi]) {
+        reason = "spectra with detectors in several banks";
+        break;
+      }
+      used[wi] = true;
+      indices.push_back(wi);
+    }
+    bankIndices.push_back(std::move(indices));
+  }
+  if (!reason.empty()) {
+    g_log.warning() << "LoadLazily is not supported for " << reason
+                    << ". All events are loaded now.\n";
+    return false;
+  }
+
+  auto loader = boost::make_shared<LazyEventNexusLoader>(
+      m_filename, m_top_entry_name, classType, oldNeXusFileNames,
+      pixelID_to_wi_vector, pixelID_to_wi_offset, m_allBanksPulseTimes);
+  for (size_t i = 0; i < bankNames.size(); ++i)
+    loader->addBank(bankNames[i], std::move(bankIndices[i]));
+  loader->setTofFilter(filter_tof_min, filter_tof_max);
+
+  // Use T0 offset from TOPAZ Parameter file if it exists
+  double mT0 = 0.;
+  if (m_ws->getInstrument()->hasParameter("T0")) {
+    std::vector<double> instrumentT0 =
+        m_ws->getInstrument()->getNumberParameter("T0", true);
+    if (!instrumentT0.empty() && instrumentT0.front() != 0.0) {
+      mT0 = instrumentT0.front();
+      loader->setTofOffset(mT0);
+      m_ws->mutableRun().addProperty<double>("T0", mT0, true);
+    }
+  }
+
+  // The X axis is the one loading all events would give. Finding it reads the
+  // times-of-flight of all banks, so the loader does so on the first access
+  // to a spectrum. The placeholder has to be set before the loader.
+  loader->setMaxPixelID(eventid_max);
+  Kernel::cow_ptr<MantidVec> axis;
+  axis.access().resize(2, 0.0);
+  m_ws->setAllX(axis);
+  const int memoryLimit = getProperty("LazyMemoryLimit");
+  m_ws->getSingleHeldWorkspace()->setLazyLoader(
+      loader, static_cast<size_t>(memoryLimit) * 1024 * 1024);
+
+  g_log.information() << "Events of " << bankNames.size()
+                      << " banks will be read when they are accessed.\n";
+  return true;
+}
+
 //-----------------------------------------------------------------------------
 /** Load the instrument from the nexus file
 *
@@ -33,6 +33,8 @@
 
 #include <nexus/NeXusException.hpp>
 
+#include <algorithm>
+
 namespace Mantid {
 namespace DataHandling {
 
@@ -170,6 +172,29 @@ bool isMultiPeriodFile(int nWorkspaceEntries, Workspace_sptr sampleWS,
   }
   return isMultiPeriod;
 }
+
+/// Events between two spectra to load that are read rather than skipped
+const int64_t MAX_EVENTS_SKIPPED = 65536;
+/// Events read at once when loading an event_workspace, unless a single
+/// spectrum has more
+const int64_t MAX_EVENTS_PER_BLOCK = 8 * 1024 * 1024;
+
+/**
+* Read a range of one of the event columns of an event_workspace
+* @param wksp_cls :: Nexus data for "event_workspace"
+* @param name :: name of the column
+* @param start :: index of the first event to read
+* @param size :: number of events to read, must be larger than 0
+* @return the values
+*/
+template <typename T>
+boost::shared_array<T> loadEventColumn(NXData &wksp_cls,
+                                       const std::string &name, int64_t start,
+                                       int64_t size) {
+  NXDataSetTyped<T> column = wksp_cls.openNXDataSet<T>(name);
+  column.load(static_cast<int>(size), static_cast<int>(start));
+  return column.sharedBuffer();
+}
 }
 
 /// Default constructor
@@ -671,96 +696,121 @@ LoadNexusProcessed::loadEventEntry(NXData &wksp_cls, NXDouble &xbins,
 
   // Handle optional fields.
   // TODO: Handle inconsistent sizes
-  boost::shared_array<int64_t> pulsetimes;
-  if (wksp_cls.isValid("pulsetime")) {
-    NXDataSetTyped<int64_t> pulsetime =
-        wksp_cls.openNXDataSet<int64_t>("pulsetime");
-    pulsetime.load();
-    pulsetimes = pulsetime.sharedBuffer();
-  }
-
-  boost::shared_array<double> tofs;
-  if (wksp_cls.isValid("tof")) {
-    NXDouble tof = wksp_cls.openNXDouble("tof");
-    tof.load();
-    tofs = tof.sharedBuffer();
-  }
-
-  boost::shared_array<float> error_squareds;
-  if (wksp_cls.isValid("error_squared")) {
-    NXFloat error_squared = wksp_cls.openNXFloat("error_squared");
-    error_squared.load();
-    error_squareds = error_squared.sharedBuffer();
-  }
-
-  boost::shared_array<float> weights;
-  if (wksp_cls.isValid("weight")) {
-    NXFloat weight = wksp_cls.openNXFloat("weight");
-    weight.load();
-    weights = weight.sharedBuffer();
-  }
+  const bool hasPulsetimes = wksp_cls.isValid("pulsetime");
+  const bool hasTofs = wksp_cls.isValid("tof");
+  const bool hasErrorSquareds = wksp_cls.isValid("error_squared");
+  const bool hasWeights = wksp_cls.isValid("weight");
 
   // What type of event lists?
   EventType type = TOF;
-  if (tofs && pulsetimes && weights && error_squareds)
+  if (hasTofs && hasPulsetimes && hasWeights && hasErrorSquareds)
     type = WEIGHTED;
-  else if ((tofs && weights && error_squareds))
+  else if ((hasTofs && hasWeights && hasErrorSquareds))
     type = WEIGHTED_NOTIME;
-  else if (pulsetimes && tofs)
+  else if (hasPulsetimes && hasTofs)
     type = TOF;
   else
     throw std::runtime_error("Could not figure out the type of event list!");
 
   // indices of events
   boost::shared_array<int64_t> indices = indices_data.sharedBuffer();
-  // Create all the event lists
-  PARALLEL_FOR_NO_WSP_CHECK()
-  for (int64_t j = 0; j < static_cast<int64_t>(m_filtered_spec_idxs.size());
-       j++) {
-    PARALLEL_START_INTERUPT_REGION
-    size_t wi = m_filtered_spec_idxs[j] - 1;
-    int64_t index_start = indices[wi];
-    int64_t index_end = indices[wi + 1];
-    if (index_end >= index_start) {
-      EventList &el = ws->getSpectrum(j);
-      el.switchTo(type);
-
-      // Allocate all the required memory
-      el.reserve(index_end - index_start);
-      el.clearDetectorIDs();
-
-      for (int64_t i = index_start; i < index_end; i++)
-        switch (type) {
-        case TOF:
-          el.addEventQuickly(TofEvent(tofs[i], DateAndTime(pulsetimes[i])));
-          break;
-        case WEIGHTED:
-          el.addEventQuickly(WeightedEvent(tofs[i], DateAndTime(pulsetimes[i]),
-                                           weights[i], error_squareds[i]));
-          break;
-        case WEIGHTED_NOTIME:
-          el.addEventQuickly(
-              WeightedEventNoTime(tofs[i], weights[i], error_squareds[i]));
-          break;
-        }
 
-      // Set the X axis
-      if (this->m_shared_bins)
-        el.setX(this->m_xbins);
-      else {
-        MantidVec x;
-        x.resize(xbins.dim1());
-        for (int i = 0; i < xbins.dim1(); i++)
-          x[i] = xbins(static_cast<int>(wi), i);
-        el.setX(x);
+  // The spectra to load, as pairs of the index in the file and the workspace
+  // index, in the order of their events in the file
+  std::vector<std::pair<size_t, size_t>> spectra;
+  spectra.reserve(m_filtered_spec_idxs.size());
+  for (size_t j = 0; j < m_filtered_spec_idxs.size(); j++)
+    spectra.emplace_back(static_cast<size_t>(m_filtered_spec_idxs[j] - 1), j);
+  std::sort(spectra.begin(), spectra.end());
+
+  // Only the events of the spectra to load are read, in blocks of spectra
+  // whose events are close to each other in the file
+  auto blockBegin = spectra.begin();
+  while (blockBegin != spectra.end()) {
+    const int64_t eventStart = indices[blockBegin->first];
+    int64_t eventStop = indices[blockBegin->first + 1];
+    auto blockEnd = blockBegin + 1;
+    for (; blockEnd != spectra.end(); ++blockEnd) {
+      const int64_t start = indices[blockEnd->first];
+      const int64_t stop = indices[blockEnd->first + 1];
+      if (start - eventStop > MAX_EVENTS_SKIPPED ||
+          stop - eventStart > MAX_EVENTS_PER_BLOCK)
+        break;
+      eventStop = std::max(eventStop, stop);
+    }
+
+    boost::shared_array<double> tofs;
+    boost::shared_array<int64_t> pulsetimes;
+    boost::shared_array<float> weights;
+    boost::shared_array<float> error_squareds;
+    const int64_t numEvents = eventStop - eventStart;
+    if (numEvents > 0) {
+      tofs = loadEventColumn<double>(wksp_cls, "tof", eventStart, numEvents);
+      if (type != WEIGHTED_NOTIME)
+        pulsetimes = loadEventColumn<int64_t>(wksp_cls, "pulsetime",
+                                              eventStart, numEvents);
+      if (type != TOF) {
+        weights =
+            loadEventColumn<float>(wksp_cls, "weight", eventStart, numEvents);
+        error_squareds = loadEventColumn<float>(wksp_cls, "error_squared",
+                                                eventStart, numEvents);
+      }
+    }
+
+    // Create the event lists of the block
+    const int64_t numInBlock = blockEnd - blockBegin;
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t k = 0; k < numInBlock; k++) {
+      PARALLEL_START_INTERUPT_REGION
+      const size_t wi = blockBegin[k].first;
+      const size_t j = blockBegin[k].second;
+      // Positions of the events in the block
+      int64_t index_start = indices[wi] - eventStart;
+      int64_t index_end = indices[wi + 1] - eventStart;
+      if (index_end >= index_start) {
+        EventList &el = ws->getSpectrum(j);
+        el.switchTo(type);
+
+        // Allocate all the required memory
+        el.reserve(index_end - index_start);
+        el.clearDetectorIDs();
+
+        for (int64_t i = index_start; i < index_end; i++)
+          switch (type) {
+          case TOF:
+            el.addEventQuickly(TofEvent(tofs[i], DateAndTime(pulsetimes[i])));
+            break;
+          case WEIGHTED:
+            el.addEventQuickly(WeightedEvent(tofs[i],
+                                             DateAndTime(pulsetimes[i]),
+                                             weights[i], error_squareds[i]));
+            break;
+          case WEIGHTED_NOTIME:
+            el.addEventQuickly(
+                WeightedEventNoTime(tofs[i], weights[i], error_squareds[i]));
+            break;
+          }
+
+        // Set the X axis
+        if (this->m_shared_bins)
+          el.setX(this->m_xbins);
+        else {
+          MantidVec x;
+          x.resize(xbins.dim1());
+          for (int i = 0; i < xbins.dim1(); i++)
+            x[i] = xbins(static_cast<int>(wi), i);
+          el.setX(x);
+        }
       }
+      PARALLEL_END_INTERUPT_REGION
     }
+    PARALLEL_CHECK_INTERUPT_REGION
 
+    blockBegin = blockEnd;
     progress(progressStart +
-             progressRange * (1.0 / static_cast<double>(numspec)));
-    PARALLEL_END_INTERUPT_REGION
+             progressRange * static_cast<double>(blockEnd - spectra.begin()) /
+                 static_cast<double>(spectra.size()));
   }
-  PARALLEL_CHECK_INTERUPT_REGION
 
   return ws;
 }
@@ -1336,19 +1386,19 @@ API::MatrixWorkspace_sptr LoadNexusProcessed::loadNonEventEntry(
                     local_workspace);
         }
       }
-      // if spectrum list property is set read each spectrum separately by
-      // setting blocksize=1
+      // if spectrum list property is set read each run of consecutive
+      // spectra in the list as one block
       if (m_list) {
-        auto itr = m_spec_list.begin();
-        for (; itr != m_spec_list.end(); ++itr) {
-          int64_t specIndex = (*itr) - 1;
+        for (size_t k = 0; k < m_spec_list.size();) {
+          const int64_t run = consecutiveSpectraInList(k);
+          int64_t specIndex = m_spec_list[k] - 1;
           progress(progressBegin +
-                       progressScaler * static_cast<double>(specIndex) /
+                       progressScaler * static_cast<double>(k) /
                            static_cast<double>(m_spec_list.size()),
                    "Reading workspace data...");
           loadBlock(data, errors, fracarea, hasFracArea, xErrors, hasXErrors,
-                    static_cast<int64_t>(1), nchannels, specIndex, wsIndex,
-                    local_workspace);
+                    run, nchannels, specIndex, wsIndex, local_workspace);
+          k += static_cast<size_t>(run);
         }
       }
     } else {
@@ -1398,15 +1448,17 @@ API::MatrixWorkspace_sptr LoadNexusProcessed::loadNonEventEntry(
       }
       //
       if (m_list) {
-        auto itr = m_spec_list.begin();
-        for (; itr != m_spec_list.end(); ++itr) {
-          int64_t specIndex = (*itr) - 1;
+        for (size_t k = 0; k < m_spec_list.size();) {
+          const int64_t run = consecutiveSpectraInList(k);
+          int64_t specIndex = m_spec_list[k] - 1;
           progress(progressBegin +
-                       progressScaler * static_cast<double>(specIndex) /
-                           static_cast<double>(read_stop),
+                       progressScaler * static_cast<double>(k) /
+                           static_cast<double>(m_spec_list.size()),
                    "Reading workspace data...");
           loadBlock(data, errors, fracarea, hasFracArea, xErrors, hasXErrors,
-                    xbins, 1, nchannels, specIndex, wsIndex, local_workspace);
+                    xbins, run, nchannels, specIndex, wsIndex,
+                    local_workspace);
+          k += static_cast<size_t>(run);
         }
       }
     } else {
@@ -2050,6 +2102,20 @@ void LoadNexusProcessed::loadBlock(NXDataSetTyped<double> &data,
   }
 }
 
+/**
+* Count the spectra in the SpectrumList that follow each other in the file,
+* i.e. that can be read as one block
+* @param first :: index in the list of the first spectrum of the block
+* @return the number of spectra in the block, at least 1
+*/
+int64_t LoadNexusProcessed::consecutiveSpectraInList(const size_t first) const {
+  size_t last = first + 1;
+  while (last < m_spec_list.size() &&
+         m_spec_list[last] == m_spec_list[last - 1] + 1)
+    ++last;
+  return static_cast<int64_t>(last - first);
+}
+
 /**
 *Validates the optional 'spectra to read' properties, if they have been set
 * @param numberofspectra :: number of spectrum
@@ -17,6 +17,9 @@
 #include <boost/shared_ptr.hpp>
 #include <Poco/File.h>
 
+#include <algorithm>
+#include <future>
+
 using namespace Mantid::API;
 
 namespace Mantid {
@@ -86,6 +89,16 @@ void SaveNexusProcessed::init() {
   setPropertySettings("CompressNexus",
                       make_unique<EnabledWhenWorkspaceIsType<EventWorkspace>>(
                           "InputWorkspace", true));
+
+  auto mustBeAtLeastOne = boost::make_shared<BoundedValidator<int>>();
+  mustBeAtLeastOne->setLower(1);
+  declareProperty(
+      "EventsPerSlab", 4 * 1024 * 1024, mustBeAtLeastOne,
+      "For EventWorkspaces, the maximum number of events gathered and\n"
+      "written to the file at once. Larger slabs use more memory.");
+  setPropertySettings("EventsPerSlab",
+                      make_unique<EnabledWhenWorkspaceIsType<EventWorkspace>>(
+                          "InputWorkspace", true));
 }
 
 /** Get the list of workspace indices to use
@@ -318,45 +331,42 @@ void SaveNexusProcessed::exec() {
 }
 
 //-------------------------------------------------------------------------------------
-/** Append out each field of a vector of events to separate array.
+/** Append out each field of a range of events to separate array.
  *
  * @param events :: vector of TofEvent or WeightedEvent, etc.
+ * @param begin :: index of the first event to copy
+ * @param end :: index after the last event to copy
  * @param offset :: where the first event goes in the array
  * @param tofs, weights, errorSquareds, pulsetimes :: arrays to write to.
  *        Must be initialized and big enough,
  *        or NULL if they are not meant to be written to.
  */
 template <class T>
-void SaveNexusProcessed::appendEventListData(std::vector<T> events,
+void SaveNexusProcessed::appendEventListData(const std::vector<T> &events,
+                                             size_t begin, size_t end,
                                              size_t offset, double *tofs,
                                              float *weights,
                                              float *errorSquareds,
                                              int64_t *pulsetimes) {
-  // Do nothing if there are no events.
-  if (events.empty())
-    return;
-
-  typename std::vector<T>::const_iterator it;
-  typename std::vector<T>::const_iterator it_end = events.end();
-  size_t i = offset;
-
   // Fill the C-arrays with the fields from all the events, as requested.
-  for (it = events.begin(); it != it_end; it++) {
+  for (size_t i = begin; i < end; ++i, ++offset) {
+    const T &event = events[i];
     if (tofs)
-      tofs[i] = it->tof();
+      tofs[offset] = event.tof();
     if (weights)
-      weights[i] = static_cast<float>(it->weight());
+      weights[offset] = static_cast<float>(event.weight());
     if (errorSquareds)
-      errorSquareds[i] = static_cast<float>(it->errorSquared());
+      errorSquareds[offset] = static_cast<float>(event.errorSquared());
     if (pulsetimes)
-      pulsetimes[i] = it->pulseTime().totalNanoseconds();
-    i++;
+      pulsetimes[offset] = event.pulseTime().totalNanoseconds();
   }
 }
 
 //-----------------------------------------------------------------------------------------------
 /** Execute the saving of event data.
- * This will make one long event list for all events contained.
+ * This will make one long event list for all events contained. The list is
+ * gathered and written in slabs of EventsPerSlab events, each slab being
+ * gathered in parallel while the previous one is written to the file.
  * */
 void SaveNexusProcessed::execEvent(Mantid::NeXus::NexusFileIO *nexusFile,
                                    const bool uniformSpectra,
@@ -381,19 +391,12 @@ void SaveNexusProcessed::execEvent(Mantid::NeXus::NexusFileIO *nexusFile,
   }
   indices.push_back(index);
 
-  // Initialize all the arrays
-  int64_t num = index;
-  double *tofs = nullptr;
-  float *weights = nullptr;
-  float *errorSquareds = nullptr;
-  int64_t *pulsetimes = nullptr;
+  const int64_t num = index;
 
   // overall event type.
   EventType type = m_eventWorkspace->getEventType();
-  bool writeTOF = true;
   bool writePulsetime = false;
   bool writeWeight = false;
-  bool writeError = false;
 
   switch (type) {
   case TOF:
@@ -402,68 +405,116 @@ void SaveNexusProcessed::execEvent(Mantid::NeXus::NexusFileIO *nexusFile,
   case WEIGHTED:
     writePulsetime = true;
     writeWeight = true;
-    writeError = true;
     break;
   case WEIGHTED_NOTIME:
     writeWeight = true;
-    writeError = true;
     break;
   }
 
-  // --- Initialize the combined event arrays ----
-  if (writeTOF)
-    tofs = new double[num];
-  if (writeWeight)
-    weights = new float[num];
-  if (writeError)
-    errorSquareds = new float[num];
-  if (writePulsetime)
-    pulsetimes = new int64_t[num];
-
-  // --- Fill in the combined event arrays ----
-  PARALLEL_FOR_NO_WSP_CHECK()
-  for (int wi = 0;
-       wi < static_cast<int>(m_eventWorkspace->getNumberHistograms()); wi++) {
-    PARALLEL_START_INTERUPT_REGION
-    const DataObjects::EventList &el = m_eventWorkspace->getSpectrum(wi);
-
-    // This is where it will land in the output array.
-    // It is okay to write in parallel since none should step on each other.
-    size_t offset = indices[wi];
-
-    switch (el.getEventType()) {
-    case TOF:
-      appendEventListData(el.getEvents(), offset, tofs, weights, errorSquareds,
-                          pulsetimes);
-      break;
-    case WEIGHTED:
-      appendEventListData(el.getWeightedEvents(), offset, tofs, weights,
-                          errorSquareds, pulsetimes);
-      break;
-    case WEIGHTED_NOTIME:
-      appendEventListData(el.getWeightedEventsNoTime(), offset, tofs, weights,
-                          errorSquareds, pulsetimes);
-      break;
+  /*Default = DONT compress - much faster*/
+  bool CompressNexus = getProperty("CompressNexus");
+
+  nexusFile->openNexusProcessedDataEventColumns(
+      m_eventWorkspace, indices, writePulsetime, writeWeight, CompressNexus);
+
+  const int eventsPerSlab = getProperty("EventsPerSlab");
+  // Spectra of a lazily loaded workspace are read from a NeXus file while the
+  // slab is gathered. HDF5 must not be called from two threads at once, so
+  // the slabs are then written by the calling thread, in between gathering.
+  const auto writePolicy = m_eventWorkspace->isLazilyLoaded()
+                               ? std::launch::deferred
+                               : std::launch::async;
+
+  // Two sets of buffers, one being filled while the other is written out
+  std::vector<double> tofBuffers[2];
+  std::vector<float> weightBuffers[2];
+  std::vector<float> errorSquaredBuffers[2];
+  std::vector<int64_t> pulsetimeBuffers[2];
+  std::future<void> writing;
+  int64_t writingSize = 0;
+
+  for (int64_t start = 0; start < num; start += eventsPerSlab) {
+    const int64_t stop = std::min(num, start + eventsPerSlab);
+    const size_t buffer = static_cast<size_t>(start / eventsPerSlab) % 2;
+    const size_t size = static_cast<size_t>(stop - start);
+
+    // --- Initialize the combined event arrays ----
+    tofBuffers[buffer].resize(size);
+    double *tofs = tofBuffers[buffer].data();
+    float *weights = nullptr;
+    float *errorSquareds = nullptr;
+    int64_t *pulsetimes = nullptr;
+    if (writeWeight) {
+      weightBuffers[buffer].resize(size);
+      weights = weightBuffers[buffer].data();
+      errorSquaredBuffers[buffer].resize(size);
+      errorSquareds = errorSquaredBuffers[buffer].data();
+    }
+    if (writePulsetime) {
+      pulsetimeBuffers[buffer].resize(size);
+      pulsetimes = pulsetimeBuffers[buffer].data();
     }
-    prog->reportIncrement(el.getNumberEvents(), "Copying EventList");
 
-    PARALLEL_END_INTERUPT_REGION
-  }
-  PARALLEL_CHECK_INTERUPT_REGION
+    // The spectra with events in this slab
+    const auto firstIndex =
+        std::upper_bound(indices.begin(), indices.end(), start) - 1;
+    const auto endIndex = std::lower_bound(indices.begin(), indices.end(), stop);
+    const int firstSpectrum = static_cast<int>(firstIndex - indices.begin());
+    const int endSpectrum = static_cast<int>(endIndex - indices.begin());
+
+    // --- Fill in the combined event arrays ----
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int wi = firstSpectrum; wi < endSpectrum; wi++) {
+      PARALLEL_START_INTERUPT_REGION
+      const DataObjects::EventList &el = m_eventWorkspace->getSpectrum(wi);
+
+      // The events of this spectrum that are in the slab, and where they
+      // land in the output array. It is okay to write in parallel since none
+      // should step on each other.
+      const int64_t first = std::max(start, indices[wi]);
+      const int64_t last = std::min(stop, indices[wi + 1]);
+      const size_t begin = static_cast<size_t>(first - indices[wi]);
+      const size_t end = static_cast<size_t>(last - indices[wi]);
+      const size_t offset = static_cast<size_t>(first - start);
+
+      switch (el.getEventType()) {
+      case TOF:
+        appendEventListData(el.getEvents(), begin, end, offset, tofs, weights,
+                            errorSquareds, pulsetimes);
+        break;
+      case WEIGHTED:
+        appendEventListData(el.getWeightedEvents(), begin, end, offset, tofs,
+                            weights, errorSquareds, pulsetimes);
+        break;
+      case WEIGHTED_NOTIME:
+        appendEventListData(el.getWeightedEventsNoTime(), begin, end, offset,
+                            tofs, weights, errorSquareds, pulsetimes);
+        break;
+      }
+      prog->reportIncrement(end - begin, "Copying EventList");
 
-  /*Default = DONT compress - much faster*/
-  bool CompressNexus = getProperty("CompressNexus");
+      PARALLEL_END_INTERUPT_REGION
+    }
+    PARALLEL_CHECK_INTERUPT_REGION
 
-  // Write out to the NXS file.
-  nexusFile->writeNexusProcessedDataEventCombined(m_eventWorkspace, indices,
-                                                  tofs, weights, errorSquareds,
-                                                  pulsetimes, CompressNexus);
+    // Write out to the NXS file, once the previous slab is written
+    if (writing.valid()) {
+      writing.get();
+      prog->reportIncrement(static_cast<size_t>(writingSize), "Writing events");
+    }
+    writing = std::async(writePolicy, [=] {
+      nexusFile->writeNexusProcessedDataEventSlab(start, stop - start, tofs,
+                                                  weights, errorSquareds,
+                                                  pulsetimes);
+    });
+    writingSize = stop - start;
+  }
+  if (writing.valid()) {
+    writing.get();
+    prog->reportIncrement(static_cast<size_t>(writingSize), "Writing events");
+  }
 
-  // Free mem.
-  delete[] tofs;
-  delete[] weights;
-  delete[] errorSquareds;
-  delete[] pulsetimes;
+  nexusFile->closeNexusProcessedDataEventColumns();
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -116,6 +116,42 @@ public:
   void test_InPlace_Parallel() {
     doTest("CompressEvents_input", "CompressEvents_input", 0.5, 1);
   }
+
+  void test_Logarithmic() {
+    // Two events at 0.5, 1.5, ..., 99.5
+    EventWorkspace_sptr input =
+        WorkspaceCreationHelper::CreateEventWorkspace(1, 100, 100, 0.0, 1.0, 2);
+    AnalysisDataService::Instance().addOrReplace("CompressEvents_input",
+                                                 input);
+    CompressEvents alg;
+    alg.initialize();
+    alg.setPropertyValue("InputWorkspace", "CompressEvents_input");
+    alg.setPropertyValue("OutputWorkspace", "CompressEvents_output");
+    alg.setProperty("Tolerance", 0.5);
+    alg.setProperty("Logarithmic", true);
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT(alg.isExecuted());
+
+    EventWorkspace_sptr output;
+    TS_ASSERT_THROWS_NOTHING(
+        output = AnalysisDataService::Instance().retrieveWS<EventWorkspace>(
+            "CompressEvents_output"));
+    // Groups of events within 50% of the first: 0.5, 1.5, 2.5-3.5, 4.5-6.5,
+    // 7.5-10.5, 11.5-16.5, 17.5-25.5, 26.5-39.5, 40.5-60.5, 61.5-91.5 and
+    // 92.5-99.5
+    TS_ASSERT_EQUALS(output->getNumberEvents(), 11);
+    const auto &events = output->getSpectrum(0).getWeightedEventsNoTime();
+    if (events.size() == 11) {
+      TS_ASSERT_DELTA(events[0].tof(), 0.5, 1e-6);
+      TS_ASSERT_DELTA(events[0].weight(), 2.0, 1e-6);
+      TS_ASSERT_DELTA(events[3].tof(), 5.5, 1e-6);
+      TS_ASSERT_DELTA(events[3].weight(), 6.0, 1e-6);
+      TS_ASSERT_DELTA(events[10].tof(), 96.0, 1e-6);
+      TS_ASSERT_DELTA(events[10].weight(), 16.0, 1e-6);
+    }
+    AnalysisDataService::Instance().remove("CompressEvents_input");
+    AnalysisDataService::Instance().remove("CompressEvents_output");
+  }
 };
 
 #endif
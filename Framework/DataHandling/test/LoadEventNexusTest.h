@@ -185,6 +185,149 @@ public:
     }
   }
 
+  void test_loading_in_small_slabs_gives_same_events() {
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "cncs_whole_banks");
+    ld.setProperty<bool>("LoadLogs", false); // Time-saver
+    TS_ASSERT(ld.execute());
+
+    // Every bank is read in many slabs
+    LoadEventNexus ld2;
+    ld2.initialize();
+    ld2.setEventsPerSlab(1000);
+    ld2.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld2.setPropertyValue("OutputWorkspace", "cncs_slabs");
+    ld2.setProperty<bool>("LoadLogs", false); // Time-saver
+    TS_ASSERT(ld2.execute());
+
+    auto &ads = AnalysisDataService::Instance();
+    auto WS = ads.retrieveWS<EventWorkspace>("cncs_whole_banks");
+    auto WS2 = ads.retrieveWS<EventWorkspace>("cncs_slabs");
+    TS_ASSERT_EQUALS(WS2->getNumberEvents(), 112266);
+    TS_ASSERT_EQUALS(WS2->getNumberHistograms(), WS->getNumberHistograms());
+    TS_ASSERT_EQUALS((*WS2->refX(0))[0], (*WS->refX(0))[0]);
+    TS_ASSERT_EQUALS((*WS2->refX(0))[1], (*WS->refX(0))[1]);
+    // Events are in the same order
+    for (size_t wi = 0; wi < WS->getNumberHistograms(); wi += 97)
+      TS_ASSERT_EQUALS(WS2->getSpectrum(wi).getEvents(),
+                       WS->getSpectrum(wi).getEvents());
+
+    ads.remove("cncs_whole_banks");
+    ads.remove("cncs_slabs");
+  }
+
+  void test_compressing_in_small_slabs_gives_same_events() {
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "cncs_compressed_banks");
+    ld.setPropertyValue("CompressTolerance", "0.05");
+    ld.setProperty<bool>("LoadLogs", false); // Time-saver
+    TS_ASSERT(ld.execute());
+
+    // The events of every slab are merged into the compressed events
+    LoadEventNexus ld2;
+    ld2.initialize();
+    ld2.setEventsPerSlab(1000);
+    ld2.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld2.setPropertyValue("OutputWorkspace", "cncs_compressed_slabs");
+    ld2.setPropertyValue("CompressTolerance", "0.05");
+    ld2.setProperty<bool>("LoadLogs", false); // Time-saver
+    TS_ASSERT(ld2.execute());
+
+    auto &ads = AnalysisDataService::Instance();
+    auto WS = ads.retrieveWS<EventWorkspace>("cncs_compressed_banks");
+    auto WS2 = ads.retrieveWS<EventWorkspace>("cncs_compressed_slabs");
+    // Groups of earlier slabs are not merged with each other, so there may be
+    // more compressed events, but no event is lost
+    TS_ASSERT_EQUALS(WS->getNumberEvents(), 111274);
+    TS_ASSERT_LESS_THAN_EQUALS(WS->getNumberEvents(), WS2->getNumberEvents());
+    TS_ASSERT_LESS_THAN_EQUALS(WS2->getNumberEvents(), 112266);
+    for (size_t wi = 0; wi < WS->getNumberHistograms(); wi += 97) {
+      const auto &el = WS->getSpectrum(wi);
+      const auto &el2 = WS2->getSpectrum(wi);
+      if (el.getNumberEvents() == 0)
+        continue;
+      TS_ASSERT_EQUALS(el2.getEventType(), WEIGHTED_NOTIME);
+      TS_ASSERT(el2.isSortedByTof());
+      TS_ASSERT_DELTA(el2.integrate(0., 0., true), el.integrate(0., 0., true),
+                      1e-6);
+    }
+
+    ads.remove("cncs_compressed_banks");
+    ads.remove("cncs_compressed_slabs");
+  }
+
+  void test_lazy_loading_gives_same_events() {
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "cncs_eager");
+    ld.setProperty<bool>("LoadLogs", false); // Time-saver
+    TS_ASSERT(ld.execute());
+
+    LoadEventNexus ld2;
+    ld2.initialize();
+    ld2.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld2.setPropertyValue("OutputWorkspace", "cncs_lazy");
+    ld2.setProperty<bool>("LoadLogs", false); // Time-saver
+    ld2.setProperty<bool>("LoadLazily", true);
+    TS_ASSERT(ld2.execute());
+
+    auto &ads = AnalysisDataService::Instance();
+    auto WS = ads.retrieveWS<EventWorkspace>("cncs_eager");
+    auto WS2 = ads.retrieveWS<EventWorkspace>("cncs_lazy");
+    TS_ASSERT(WS2->isLazilyLoaded());
+    TS_ASSERT(!WS2->isLoaded(0));
+    TS_ASSERT_EQUALS(WS2->getNumberHistograms(), WS->getNumberHistograms());
+    TS_ASSERT_EQUALS(WS2->readX(0), WS->readX(0));
+    const EventWorkspace &lazyWS = *WS2;
+    for (size_t wi = 0; wi < WS->getNumberHistograms(); wi += 97)
+      TS_ASSERT_EQUALS(lazyWS.getSpectrum(wi).getEvents(),
+                       WS->getSpectrum(wi).getEvents());
+    TS_ASSERT_EQUALS(lazyWS.getNumberEvents(), 112266);
+
+    ads.remove("cncs_eager");
+    ads.remove("cncs_lazy");
+  }
+
+  void test_lazy_loading_with_memory_limit() {
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "cncs_lazy_limited");
+    ld.setProperty<bool>("LoadLogs", false); // Time-saver
+    ld.setProperty<bool>("LoadLazily", true);
+    ld.setProperty<int>("LazyMemoryLimit", 1);
+    TS_ASSERT(ld.execute());
+
+    auto &ads = AnalysisDataService::Instance();
+    auto WS = ads.retrieveWS<EventWorkspace>("cncs_lazy_limited");
+    const EventWorkspace &lazyWS = *WS;
+    TS_ASSERT_EQUALS(lazyWS.getNumberEvents(), 112266);
+    // The first banks were dropped again to stay within the limit
+    TS_ASSERT(!WS->isLoaded(0));
+    ads.remove("cncs_lazy_limited");
+  }
+
+  void test_lazy_loading_falls_back_when_filtering_by_time() {
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "cncs_lazy_filtered");
+    ld.setProperty<bool>("LoadLazily", true);
+    ld.setPropertyValue("FilterByTimeStart", "60.0");
+    TS_ASSERT(ld.execute());
+
+    auto &ads = AnalysisDataService::Instance();
+    auto WS = ads.retrieveWS<EventWorkspace>("cncs_lazy_filtered");
+    TS_ASSERT(!WS->isLazilyLoaded());
+    TS_ASSERT_LESS_THAN(WS->getNumberEvents(), 112266);
+    ads.remove("cncs_lazy_filtered");
+  }
+
   void test_TOF_filtered_loading() {
     const std::string wsName = "test_filtering";
     const double filterStart = 45000;
@@ -561,6 +561,46 @@ public:
     doCommonEventLoadChecks(alg, 5, 2);
   }
 
+  void test_loadEventNexus_List_reads_the_events_of_each_spectrum() {
+    writeTmpEventNexus();
+
+    LoadNexusProcessed loadAll;
+    loadAll.initialize();
+    loadAll.setChild(true);
+    loadAll.setPropertyValue("Filename", m_savedTmpEventFile);
+    loadAll.setPropertyValue("OutputWorkspace", "dummy");
+    loadAll.execute();
+    Workspace_sptr allOut = loadAll.getProperty("OutputWorkspace");
+    auto all = boost::dynamic_pointer_cast<EventWorkspace>(allOut);
+    TS_ASSERT(all);
+
+    // Out of order, with an empty spectrum
+    LoadNexusProcessed alg;
+    alg.initialize();
+    alg.setChild(true);
+    alg.setPropertyValue("Filename", m_savedTmpEventFile);
+    alg.setPropertyValue("OutputWorkspace", "dummy");
+    alg.setPropertyValue("SpectrumList", "6,2,5,1");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    Workspace_sptr out = alg.getProperty("OutputWorkspace");
+    auto ws = boost::dynamic_pointer_cast<EventWorkspace>(out);
+    TS_ASSERT(ws);
+    if (!all || !ws)
+      return;
+
+    TS_ASSERT_EQUALS(ws->getNumberHistograms(), 4);
+    size_t wi = 0;
+    for (const size_t index : {5, 1, 4, 0}) {
+      const EventList &el = ws->getSpectrum(wi);
+      const EventList &expected = all->getSpectrum(index);
+      TS_ASSERT_EQUALS(el.getNumberEvents(), expected.getNumberEvents());
+      TS_ASSERT_EQUALS(el.getTofs(), expected.getTofs());
+      TS_ASSERT_EQUALS(el.getPulseTimes(), expected.getPulseTimes());
+      ++wi;
+    }
+    TS_ASSERT_EQUALS(ws->getSpectrum(2).getNumberEvents(), 0);
+  }
+
   void test_load_saved_workspace_group() {
     LoadNexusProcessed alg;
     TS_ASSERT_THROWS_NOTHING(alg.initialize());
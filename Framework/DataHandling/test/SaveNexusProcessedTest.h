@@ -330,6 +330,64 @@ public:
         true /* DONT preserve events */, true /* Compress */);
   }
 
+  void testExec_EventWorkspace_in_slabs_that_split_spectra() {
+    EventWorkspace_sptr WS =
+        WorkspaceCreationHelper::CreateEventWorkspace(4, 10, 10);
+    WS->getSpectrum(2).clear(false);
+    for (size_t wi = 0; wi < WS->getNumberHistograms(); wi++)
+      WS->getSpectrum(wi).switchTo(WEIGHTED);
+    WS->getSpectrum(1) *= 2.5;
+
+    SaveNexusProcessed alg;
+    alg.initialize();
+    TS_ASSERT_THROWS(alg.setProperty("EventsPerSlab", 0),
+                     std::invalid_argument);
+    // Fewer events than in a spectrum
+    alg.setProperty("EventsPerSlab", 7);
+    alg.setProperty("InputWorkspace",
+                    boost::dynamic_pointer_cast<Workspace>(WS));
+    alg.setPropertyValue("Filename", "SaveNexusProcessed_Slabs.nxs");
+    const std::string outputFile = alg.getPropertyValue("Filename");
+    alg.setProperty("CompressNexus", true);
+    if (Poco::File(outputFile).exists())
+      Poco::File(outputFile).remove();
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT(alg.isExecuted());
+
+    std::vector<int64_t> indices;
+    std::vector<double> tofs;
+    std::vector<int64_t> pulsetimes;
+    std::vector<float> weights;
+    ::NeXus::File file(outputFile);
+    file.openGroup("mantid_workspace_1", "NXentry");
+    file.openGroup("event_workspace", "NXdata");
+    file.readData("indices", indices);
+    file.readData("tof", tofs);
+    file.readData("pulsetime", pulsetimes);
+    file.readData("weight", weights);
+    file.close();
+
+    TS_ASSERT_EQUALS(indices.size(), WS->getNumberHistograms() + 1);
+    TS_ASSERT_EQUALS(tofs.size(), WS->getNumberEvents());
+    TS_ASSERT_EQUALS(pulsetimes.size(), WS->getNumberEvents());
+    TS_ASSERT_EQUALS(weights.size(), WS->getNumberEvents());
+    for (size_t wi = 0; wi < WS->getNumberHistograms(); wi++) {
+      const auto &events = WS->getSpectrum(wi).getWeightedEvents();
+      TS_ASSERT_EQUALS(indices[wi + 1] - indices[wi],
+                       static_cast<int64_t>(events.size()));
+      for (size_t i = 0; i < events.size(); i++) {
+        const size_t index = static_cast<size_t>(indices[wi]) + i;
+        TS_ASSERT_EQUALS(tofs[index], events[i].tof());
+        TS_ASSERT_EQUALS(pulsetimes[index],
+                         events[i].pulseTime().totalNanoseconds());
+        TS_ASSERT_EQUALS(weights[index], static_cast<float>(events[i].weight()));
+      }
+    }
+
+    if (clearfiles)
+      Poco::File(outputFile).remove();
+  }
+
   void testExecSaveLabel() {
     SaveNexusProcessed alg;
     if (!alg.isInitialized())
@@ -66,6 +66,8 @@ public:
   std::string toXMLString() const override;
   std::string id() const override;
   void apply(const coord_t *inputVector, coord_t *outVector) const override;
+  void applyBlock(const coord_t *inputs, coord_t *outputs,
+                  const size_t numPoints) const override;
   Mantid::Kernel::Matrix<coord_t> makeAffineMatrix() const override;
 
 protected:
@@ -19,6 +19,9 @@
 #include "MantidKernel/MultiThreaded.h"
 
 namespace Mantid {
+namespace Kernel {
+class HistogramBinner;
+}
 namespace DataObjects {
 
 /// How the event list is sorted.
@@ -99,6 +102,8 @@ public:
 
   EventList &operator+=(const EventList &more_events);
 
+  void addEventLists(const std::vector<const EventList *> &others);
+
   EventList &operator-=(const EventList &more_events);
 
   bool operator==(const EventList &rhs) const;
@@ -114,7 +119,12 @@ public:
    * @param event :: TofEvent to add at the end of the list.
    * */
   inline void addEventQuickly(const TofEvent &event) {
-    this->events.push_back(event);
+    if (m_columnar) {
+      m_tofs.push_back(event.tof());
+      m_pulseTimes.push_back(event.pulseTime().totalNanoseconds());
+    } else {
+      this->events.push_back(event);
+    }
     this->order = UNSORTED;
   }
 
@@ -164,16 +174,29 @@ public:
 
   void reserve(size_t num) override;
 
-  void sort(const EventSortType order) const;
+  /// Hold the TofEvent's as separate TOF and pulse time arrays. The
+  /// following switch the list back to a vector of TofEvent: getEvents(),
+  /// getEvent(), operator+=, operator-=, addEventLists(), operator==,
+  /// equals(), switchToWeightedEvents(), switchToWeightedEventsNoTime(),
+  /// compressEvents(), compressAppendedEvents(), filterByPulseTime(),
+  /// filterByTimeAtSample(), filterInPlace(), splitByTime(),
+  /// splitByFullTime(), splitByPulseTime(), splitByTimeIndex(),
+  /// splitByFullTimeMatrixSplitter(), generateCountsHistogramPulseTime(),
+  /// generateCountsHistogramTimeAtSample(), getTimeAtSampleMin() and
+  /// getTimeAtSampleMax().
+  void setColumnarStorage(const bool columnar);
+  bool hasColumnarStorage() const;
+
+  void sort(const EventSortType order, const size_t numThreads = 1) const;
 
   void setSortOrder(const EventSortType order) const;
 
-  void sortTof() const;
+  void sortTof(const size_t numThreads = 1) const;
   void sortTof2() const;
   void sortTof4() const;
 
-  void sortPulseTime() const;
-  void sortPulseTimeTOF() const;
+  void sortPulseTime(const size_t numThreads = 1) const;
+  void sortPulseTimeTOF(const size_t numThreads = 1) const;
   void sortTimeAtSample(const double &tofFactor, const double &tofShift,
                         bool forceResort = false) const;
 
@@ -255,6 +278,7 @@ public:
 
   void compressEvents(double tolerance, EventList *destination,
                       bool parallel = false);
+  void compressAppendedEvents(double tolerance);
   // get EventType declaration
   void generateHistogram(const MantidVec &X, MantidVec &Y, MantidVec &E,
                          bool skipError = false) const override;
@@ -324,6 +348,10 @@ public:
 
   void filterInPlace(Kernel::TimeSplitterType &splitter);
 
+  void buildPulseIndex() const;
+  bool hasPulseIndex() const;
+  void clearPulseIndex() const;
+
   void splitByTime(Kernel::TimeSplitterType &splitter,
                    std::vector<EventList *> outputs) const;
 
@@ -341,6 +369,11 @@ public:
   void splitByPulseTime(Kernel::TimeSplitterType &splitter,
                         std::map<int, EventList *> outputs) const;
 
+  size_t splitByTimeIndex(const Kernel::TimeSplitterIndex &index,
+                          const std::vector<EventList *> &outputs,
+                          bool pulseTimeOnly, double toffactor,
+                          double tofshift) const;
+
   void multiply(const double value, const double error = 0.0) override;
   EventList &operator*=(const double value);
 
@@ -379,6 +412,36 @@ private:
   /// Mutex that is locked while sorting an event list
   mutable std::mutex m_sortMutex;
 
+  /// TOF of the TofEvent's when using columnar storage
+  mutable std::vector<double> m_tofs;
+
+  /// Pulse times (in nanoseconds) of the TofEvent's when using columnar storage
+  mutable std::vector<int64_t> m_pulseTimes;
+
+  /// True if the TofEvent's are held in m_tofs and m_pulseTimes. Only
+  /// changed by methods that modify the list.
+  bool m_columnar;
+
+  void toColumnarStorage();
+  void toRowStorage();
+  const std::vector<TofEvent> &rowEvents(std::vector<TofEvent> &buffer) const;
+
+  /// Distinct pulse times (in nanoseconds) of the events sorted by pulse time
+  mutable std::vector<int64_t> m_indexPulseTimes;
+
+  /// Offset of the first event of each pulse in m_indexPulseTimes, followed
+  /// by the number of events
+  mutable std::vector<size_t> m_indexOffsets;
+
+  bool pulseIndexIsCurrent() const;
+
+  /// First TOF of each group of the compressed events, kept between the
+  /// calls to compressAppendedEvents()
+  std::vector<double> m_groupStarts;
+
+  bool groupStartsMatch(const double tolerance) const;
+  int64_t pulseTimeOfEvent(const size_t i) const;
+
   template <class T>
   static typename std::vector<T>::const_iterator
   findFirstEvent(const std::vector<T> &events, const double seek_tof);
@@ -398,7 +461,8 @@ private:
   static typename std::vector<T>::iterator
   findFirstEvent(std::vector<T> &events, const double seek_tof);
 
-  void generateCountsHistogram(const MantidVec &X, MantidVec &Y) const;
+  void generateCountsHistogram(const Kernel::HistogramBinner &binner,
+                               MantidVec &Y) const;
 
   void generateCountsHistogramPulseTime(const MantidVec &X, MantidVec &Y) const;
 
@@ -408,6 +472,8 @@ private:
 
   void generateErrorsHistogram(const MantidVec &Y, MantidVec &E) const;
 
+  const CachedHistogram &cachedHistogram() const;
+
   void switchToWeightedEvents();
   void switchToWeightedEventsNoTime();
 
@@ -418,15 +484,22 @@ private:
   template <class T>
   static void compressEventsHelper(const std::vector<T> &events,
                                    std::vector<WeightedEventNoTime> &out,
-                                   double tolerance);
+                                   double tolerance, bool weightedTof = false,
+                                   std::vector<double> *groupStarts = nullptr);
+  template <class T>
+  void mergeAppendedEventsHelper(std::vector<T> &events, double tolerance);
+  template <class T>
+  static void mergeSortedHelper(std::vector<T> &events,
+                                const std::vector<const EventList *> &others,
+                                const EventSortType sortOrder);
   template <class T>
   void compressEventsParallelHelper(const std::vector<T> &events,
                                     std::vector<WeightedEventNoTime> &out,
                                     double tolerance);
   template <class T>
   static void histogramForWeightsHelper(const std::vector<T> &events,
-                                        const MantidVec &X, MantidVec &Y,
-                                        MantidVec &E);
+                                        const Kernel::HistogramBinner &binner,
+                                        MantidVec &Y, MantidVec &E);
   template <class T>
   static void integrateHelper(std::vector<T> &events, const double minX,
                               const double maxX, const bool entireRange,
@@ -463,35 +536,46 @@ private:
   static void setTofsHelper(std::vector<T> &events,
                             const std::vector<double> &tofs);
   template <class T>
-  static void
-  filterByPulseTimeHelper(std::vector<T> &events, Kernel::DateAndTime start,
-                          Kernel::DateAndTime stop, std::vector<T> &output);
+  size_t findPulseOffset(const std::vector<T> &events,
+                         const int64_t pulseTime) const;
   template <class T>
-  static void
-  filterByTimeAtSampleHelper(std::vector<T> &events, Kernel::DateAndTime start,
-                             Kernel::DateAndTime stop, double tofFactor,
-                             double tofOffset, std::vector<T> &output);
+  void filterByPulseTimeHelper(const std::vector<T> &events,
+                               Kernel::DateAndTime start,
+                               Kernel::DateAndTime stop,
+                               std::vector<T> &output) const;
+  template <class T>
+  void filterByTimeAtSampleHelper(const std::vector<T> &events,
+                                  Kernel::DateAndTime start,
+                                  Kernel::DateAndTime stop, double tofFactor,
+                                  double tofOffset,
+                                  std::vector<T> &output) const;
   template <class T>
   void filterInPlaceHelper(Kernel::TimeSplitterType &splitter,
                            typename std::vector<T> &events);
   template <class T>
   void splitByTimeHelper(Kernel::TimeSplitterType &splitter,
                          std::vector<EventList *> outputs,
-                         typename std::vector<T> &events) const;
+                         const std::vector<T> &events) const;
   template <class T>
   void splitByFullTimeHelper(Kernel::TimeSplitterType &splitter,
                              std::map<int, EventList *> outputs,
-                             typename std::vector<T> &events, bool docorrection,
+                             const std::vector<T> &events, bool docorrection,
                              double toffactor, double tofshift) const;
   /// Split events by pulse time
   template <class T>
   void splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter,
                               std::map<int, EventList *> outputs,
-                              typename std::vector<T> &events) const;
+                              const std::vector<T> &events) const;
+  template <class T>
+  size_t splitByTimeIndexHelper(const Kernel::TimeSplitterIndex &index,
+                                const std::vector<EventList *> &outputs,
+                                const std::vector<T> &events,
+                                bool pulseTimeOnly, double toffactor,
+                                double tofshift) const;
   template <class T>
   std::string splitByFullTimeVectorSplitterHelper(
       const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
-      std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
+      std::map<int, EventList *> outputs, const std::vector<T> &vecEvents,
       bool docorrection, double toffactor, double tofshift) const;
   template <class T>
   static void multiplyHelper(std::vector<T> &events, const double value,
@@ -8,8 +8,10 @@
 #include "MantidAPI/IEventWorkspace.h"
 #include "MantidAPI/ISpectrum.h"
 #include "MantidDataObjects/EventList.h"
+#include "MantidDataObjects/LazyEventLoader.h"
 #include "MantidKernel/System.h"
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <memory>
 #include <string>
 
 namespace Mantid {
@@ -22,6 +24,7 @@ class Progress;
 
 namespace DataObjects {
 class EventWorkspaceMRU;
+class LazyEventCache;
 
 /// EventList objects, with the detector ID as the index.
 typedef std::vector<EventList *> EventListVector;
@@ -163,6 +166,9 @@ public:
   // Change the event type
   void switchEventType(const Mantid::API::EventType type);
 
+  // Change the storage layout of the TofEvent's
+  void setColumnarStorage(const bool columnar);
+
   // Returns true always - an EventWorkspace always represents histogramm-able
   // data
   bool isHistogramData() const override;
@@ -171,6 +177,8 @@ public:
 
   void clearMRU() const override;
 
+  void setMRUMemoryLimit(const std::size_t memoryLimit);
+
   void clearData();
 
   EventSortType getSortType() const;
@@ -182,6 +190,14 @@ public:
   void getIntegratedSpectra(std::vector<double> &out, const double minX,
                             const double maxX,
                             const bool entireRange) const override;
+
+  // Read the events of the spectra on demand
+  void setLazyLoader(boost::shared_ptr<LazyEventLoader> loader,
+                     const size_t memoryLimit = 0);
+  bool isLazilyLoaded() const;
+  bool isLoaded(const size_t index) const;
+  void pinSpectrum(const size_t index) const;
+  void unpinSpectrum(const size_t index) const;
   EventWorkspace &operator=(const EventWorkspace &other) = delete;
 
 protected:
@@ -191,6 +207,8 @@ protected:
 private:
   EventWorkspace *doClone() const override { return new EventWorkspace(*this); }
 
+  void loadAllEvents();
+
   /** A vector that holds the event list for each spectrum; the key is
    * the workspace index, which is not necessarily the pixelid.
    */
@@ -201,6 +219,9 @@ private:
 
   /// Container for the MRU lists of the event lists contained.
   mutable EventWorkspaceMRU *mru;
+
+  /// Tracks which spectra are in memory if the events are loaded on demand.
+  std::unique_ptr<LazyEventCache> m_lazyCache;
 };
 
 /// shared pointer to the EventWorkspace class
@@ -4,9 +4,15 @@
 #include "MantidKernel/System.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/cow_ptr.h"
-#include "MantidKernel/MRUList.h"
-#include <vector>
+#include <boost/shared_ptr.hpp>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <list>
 #include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace Mantid {
 namespace DataObjects {
@@ -14,44 +20,24 @@ namespace DataObjects {
 //============================================================================
 //============================================================================
 /**
- * This little class holds a MantidVec of data and an index marker that
- * is used for uniqueness.
- * This is used in the MRUList.
- *
+ * The histogram of one spectrum for one set of bin edges, as held in the
+ * EventWorkspaceMRU.
  */
-class MantidVecWithMarker {
-public:
-  /**
-   * Constructor.
-   * @param the_index :: unique index into the workspace of this data
-   */
-  MantidVecWithMarker(const size_t the_index) : m_index(the_index) {}
-
-  /// Destructor
-  ~MantidVecWithMarker() {
-    m_data.clear();
-    // Trick to release the allocated memory
-    // MantidVec().swap(m_data);
-  }
+struct DLLExport CachedHistogram {
+  CachedHistogram(const size_t index, const Kernel::cow_ptr<MantidVec> &x);
 
-private:
-  /// Unimplemented, private copy constructor
-  MantidVecWithMarker(const MantidVecWithMarker &other);
-  /// Unimplemented, private assignment operator
-  MantidVecWithMarker &operator=(const MantidVecWithMarker &other);
+  size_t getMemorySize() const;
 
-public:
-  /// Unique index value.
+  /// Spectrum number of the histogrammed spectrum
   size_t m_index;
-
-  /// Pointer to a vector of data
-  MantidVec m_data;
-
-  /// Function returns a unique index, used for hashing for MRU list
-  size_t hashIndexFunction() const { return m_index; }
-
-  /// Set the unique index value.
-  void setIndex(const size_t the_index) { m_index = the_index; }
+  /// Bin edges
+  Kernel::cow_ptr<MantidVec> m_x;
+  /// Hash of the bin edges
+  size_t m_binningHash;
+  /// Counts
+  MantidVec m_y;
+  /// Errors
+  MantidVec m_e;
 };
 
 //============================================================================
@@ -59,6 +45,13 @@ public:
 /** This is a container for the MRU (most-recently-used) list
  * of generated histograms.
 
+  Histograms are cached for each spectrum and set of bin edges, so that a
+  spectrum can be viewed with several binnings without histogramming its
+  events again. A histogram for bin edges that are a subset of the edges of a
+  cached histogram is computed by summing its bins. The cache is split in
+  shards that are locked independently and drops the least recently used
+  histograms of a shard when the memory limit is reached.
+
   Copyright &copy; 2011-2 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
  National Laboratory & European Spallation Source
 
@@ -82,41 +75,73 @@ public:
 */
 class DLLExport EventWorkspaceMRU {
 public:
-  // Typedef for a Most-Recently-Used list of Data objects.
-  typedef Mantid::Kernel::MRUList<MantidVecWithMarker> mru_list;
-  // Typedef for a vector of MRUlists.
-  typedef std::vector<mru_list *> mru_lists;
+  /// Shared pointer to a cached histogram
+  typedef boost::shared_ptr<const CachedHistogram> histogram_ptr;
+
+  /// Number of independently locked parts of the cache
+  static const size_t NUM_SHARDS = 16;
+  /// Number of histograms returned last to each thread that are kept in
+  /// memory even if they were dropped from the cache
+  static const size_t NUM_RETAINED = 50;
 
   EventWorkspaceMRU();
-  ~EventWorkspaceMRU();
+  explicit EventWorkspaceMRU(const size_t memoryLimit);
 
-  void ensureEnoughBuffersY(size_t thread_num) const;
-  void ensureEnoughBuffersE(size_t thread_num) const;
+  histogram_ptr find(const size_t index, const MantidVec &x);
+  histogram_ptr insert(const histogram_ptr &histogram);
 
   void clear();
-
-  MantidVecWithMarker *findY(size_t thread_num, size_t index);
-  MantidVecWithMarker *findE(size_t thread_num, size_t index);
-  void insertY(size_t thread_num, MantidVecWithMarker *data);
-  void insertE(size_t thread_num, MantidVecWithMarker *data);
-
   void deleteIndex(size_t index);
 
-  /** Return how many entries in the Y MRU list are used.
-   * Only used in tests. It only returns the 0-th MRU list size.
-   * @return :: number of entries in the MRU list. */
-  size_t MRUSize() const { return this->m_bufferedDataY[0]->size(); }
+  void setMemoryLimit(const size_t memoryLimit);
+  size_t getMemoryLimit() const;
+  size_t getMemorySize() const;
 
-protected:
-  /// The most-recently-used list of dataY histograms
-  mutable mru_lists m_bufferedDataY;
+  size_t MRUSize() const;
 
-  /// The most-recently-used list of dataE histograms
-  mutable mru_lists m_bufferedDataE;
+  static size_t binningHash(const MantidVec &x);
 
-  /// Mutex when adding entries in the MRU list
-  mutable std::mutex m_changeMruListsMutexE;
-  mutable std::mutex m_changeMruListsMutexY;
+private:
+  /// Type of the list of cached histograms, most recently used first
+  typedef std::list<histogram_ptr> histogram_list;
+
+  /// The histograms of the spectra whose index modulo NUM_SHARDS is the same
+  struct Shard {
+    /// Locked while accessing the shard
+    std::mutex m_mutex;
+    /// Cached histograms, most recently used first
+    histogram_list m_histograms;
+    /// The histograms of each spectrum
+    std::unordered_multimap<size_t, histogram_list::iterator> m_byIndex;
+    /// Memory used by the cached histograms
+    size_t m_memorySize = 0;
+  };
+
+  /// The histograms returned last to the threads whose id hashes to the same
+  /// value modulo NUM_SHARDS
+  struct Retained {
+    /// Locked while accessing the lists
+    std::mutex m_mutex;
+    /// The histograms returned last to each thread, oldest first
+    std::unordered_map<std::thread::id, std::deque<histogram_ptr>> m_byThread;
+  };
+
+  Shard &shardOf(const size_t index) const {
+    return m_shards[index % NUM_SHARDS];
+  }
+  histogram_ptr useCached(Shard &shard,
+                          const histogram_list::iterator &it) const;
+  void addCached(Shard &shard, const histogram_ptr &histogram) const;
+  void dropOldest(Shard &shard) const;
+  void retain(const histogram_ptr &histogram) const;
+
+  /// The parts of the cache
+  mutable std::array<Shard, NUM_SHARDS> m_shards;
+  /// The histograms kept in memory for the threads, see retain()
+  mutable std::array<Retained, NUM_SHARDS> m_retained;
+
+  /// Memory limit of all cached histograms, in bytes
+  std::atomic<size_t> m_memoryLimit;
 };
 
 } // namespace DataObjects
@@ -86,6 +86,11 @@ public:
   /// Returns the error data
   MantidVec &dataE() override { return refE.access(); }
 
+  /// Returns a pointer to the y data, shared with this spectrum
+  MantidVecPtr ptrY() const override { return refY; }
+  /// Returns a pointer to the error data, shared with this spectrum
+  MantidVecPtr ptrE() const override { return refE; }
+
   virtual std::size_t size() const { return refY->size(); } ///< get pseudo size
 
   /// Checks for errors
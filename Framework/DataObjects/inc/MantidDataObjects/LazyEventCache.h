@@ -0,0 +1,118 @@
+#ifndef MANTID_DATAOBJECTS_LAZYEVENTCACHE_H_
+#define MANTID_DATAOBJECTS_LAZYEVENTCACHE_H_
+
+#include "MantidDataObjects/LazyEventLoader.h"
+#include "MantidKernel/System.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** LazyEventCache : Keeps track of which parts of a lazily loaded
+  EventWorkspace are in memory and loads a part on the first access to one of
+  its spectra.
+
+  Without a memory limit, parts stay in memory once they are loaded and
+  accessing a part that is already loaded does not lock. With a limit, the
+  least recently used parts that have not been modified are cleared again
+  when the unmodified parts in memory exceed it. A part is never cleared
+  while it is pinned, while it was modified, or while it is the part a thread
+  accessed last, so a thread may keep using the spectrum it just accessed.
+  Cleared parts are read again on their next access.
+
+  If the loader provides the X vector (see LazyEventLoader::readX()), it is
+  set on all event lists on the first access to any spectrum.
+
+  Copyright &copy; 2016 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport LazyEventCache {
+public:
+  LazyEventCache(boost::shared_ptr<LazyEventLoader> loader,
+                 const size_t numberOfHistograms, const size_t memoryLimit);
+
+  void access(const size_t workspaceIndex, const bool modify,
+              const std::vector<EventList *> &eventLists);
+  void pin(const size_t workspaceIndex,
+           const std::vector<EventList *> &eventLists);
+  void unpin(const size_t workspaceIndex);
+
+  bool isLoaded(const size_t workspaceIndex) const;
+  bool allLoaded() const;
+  size_t memoryLimit() const;
+  size_t memoryInUse() const;
+  void setColumnarStorage(const bool columnar,
+                          const std::vector<EventList *> &eventLists);
+  void discardDeferredX();
+
+private:
+  size_t partOf(const size_t workspaceIndex) const;
+  void readX(const std::vector<EventList *> &eventLists);
+  void loadPart(const size_t part, const std::vector<EventList *> &eventLists);
+  void evictParts(const std::vector<EventList *> &eventLists);
+
+  /// Reads the events of a part
+  boost::shared_ptr<LazyEventLoader> m_loader;
+  /// Part of each workspace index, or the number of parts if it has none
+  std::vector<size_t> m_partOfIndex;
+  /// Workspace indices of each part
+  std::vector<std::vector<size_t>> m_indicesOfPart;
+  /// True for the parts that are in memory. Set with release semantics once
+  /// the events of the part have been added, so it is read without the lock.
+  std::unique_ptr<std::atomic<bool>[]> m_loaded;
+  /// Number of parts that are in memory
+  std::atomic<size_t> m_numLoaded;
+  /// True while the X vector of the loader has not been set
+  std::atomic<bool> m_xPending;
+  /// Memory in bytes the unmodified parts may use, 0 for no limit
+  const size_t m_memoryLimit;
+  /// Memory in bytes used by the unmodified parts that are in memory
+  size_t m_memoryInUse;
+  /// Memory in bytes of each part when it was loaded
+  std::vector<size_t> m_memory;
+  /// True for the parts that were accessed for modification
+  std::vector<bool> m_modified;
+  /// Number of pins of each part
+  std::vector<size_t> m_pins;
+  /// Value of m_accessCount at the last access of each part
+  std::vector<size_t> m_lastAccess;
+  /// Counts accesses, orders the parts by their last access
+  size_t m_accessCount;
+  /// The part each thread accessed last
+  std::map<std::thread::id, size_t> m_threadParts;
+  /// Storage layout of the TofEvent's of parts that are loaded later
+  bool m_columnar;
+  /// Serialises loading and clearing parts and changing the members above
+  mutable std::mutex m_mutex;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_LAZYEVENTCACHE_H_ */
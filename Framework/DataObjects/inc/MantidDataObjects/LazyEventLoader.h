@@ -0,0 +1,75 @@
+#ifndef MANTID_DATAOBJECTS_LAZYEVENTLOADER_H_
+#define MANTID_DATAOBJECTS_LAZYEVENTLOADER_H_
+
+#include "MantidKernel/System.h"
+
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+class EventList;
+
+/** LazyEventLoader : Interface for reading the events of an EventWorkspace
+  on demand, see EventWorkspace::setLazyLoader().
+
+  The spectra of the workspace are split into parts, e.g., the detector banks
+  of a file, that are loaded as a whole. Every workspace index belongs to at
+  most one part, and loading a part must only add events to the event lists
+  of that part.
+
+  Copyright &copy; 2016 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport LazyEventLoader {
+public:
+  virtual ~LazyEventLoader() = default;
+
+  /// Returns the number of parts the events are loaded in.
+  virtual size_t numberOfParts() const = 0;
+
+  /// Returns the workspace indices of the event lists of a part.
+  virtual std::vector<size_t> workspaceIndices(const size_t part) const = 0;
+
+  /** Read the events of a part and add them to its event lists.
+   *
+   * @param part :: The part to load.
+   * @param eventLists :: All event lists of the workspace, indexed by
+   * workspace index.
+   */
+  virtual void load(const size_t part,
+                    const std::vector<EventList *> &eventLists) const = 0;
+
+  /** Read the X vector of all event lists. Called once, on the first access
+   * to any spectrum, unless the X vector was set explicitly before.
+   *
+   * @param x :: Set to the X vector.
+   * @return false if the loader does not provide an X vector.
+   */
+  virtual bool readX(std::vector<double> &x) const {
+    UNUSED_ARG(x);
+    return false;
+  }
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_LAZYEVENTLOADER_H_ */
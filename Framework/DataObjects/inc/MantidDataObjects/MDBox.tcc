@@ -122,9 +122,16 @@ TMDE(MDBox)::MDBox(const MDBox<MDE, nd> &other,
       this->setFileBacked();
   }
 }
-// unhide MDBoxBase method
+//-----------------------------------------------------------------------------------------------
+/** Add all events, in a NON-THREAD-SAFE manner. No bounds checking is made!
+ *
+ * @param events :: vector of events to be copied.
+ *
+ * @return always returns 0
+ */
 TMDE(size_t MDBox)::addEventsUnsafe(const std::vector<MDE> &events) {
-  return MDBoxBase<MDE, nd>::addEventsUnsafe(events);
+  this->data.insert(this->data.end(), events.cbegin(), events.cend());
+  return 0;
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -222,12 +229,9 @@ TMDE(std::vector<MDE> &MDBox)::getEvents() {
   if (!m_Saveable)
     return data;
   else {
-    if (m_Saveable->wasSaved()) { // Load and concatenate the events if needed
-      m_Saveable
-          ->load(); // this will set isLoaded to true if not already loaded;
-    }
-    // The data vector is busy - can't release the memory yet
-    m_Saveable->setBusy(true);
+    // Load and concatenate the events if needed. The data vector is busy -
+    // can't release the memory yet
+    m_Saveable->loadAndSetBusy();
     // the non-const access to events assumes that the data will be modified;
     m_Saveable->setDataChanged();
 
@@ -251,14 +255,10 @@ TMDE(const std::vector<MDE> &MDBox)::getConstEvents() const {
   if (!m_Saveable)
     return data;
   else {
-    if (m_Saveable->wasSaved()) {
-      // Load and concatenate the events if needed
-      m_Saveable
-          ->load(); // this will set isLoaded to true if not already loaded;
-      // This access to data was const. Don't change the m_dataModified flag.
-    }
-    // The data vector is busy - can't release the memory yet
-    m_Saveable->setBusy(true);
+    // Load and concatenate the events if needed. The data vector is busy -
+    // can't release the memory yet. This access to data was const. Don't
+    // change the m_dataModified flag.
+    m_Saveable->loadAndSetBusy();
 
     // Tell the to-write buffer to discard the object (when no longer busy) as
     // it has not been modified
@@ -129,6 +129,7 @@ public:
   //----------------------------------------------------------------------------------------------------------------------
   size_t addEvent(const MDE &event) override;
   size_t addEventUnsafe(const MDE &event) override;
+  size_t addEventsUnsafe(const std::vector<MDE> &events) override;
 
   /*--------------->  EVENTS from event data
    * <-------------------------------------------------------------*/
@@ -1,6 +1,7 @@
 #include "MantidKernel/Task.h"
 #include "MantidKernel/Utils.h"
 #include "MantidKernel/FunctionTask.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/ThreadPool.h"
 #include "MantidKernel/ThreadScheduler.h"
@@ -1679,6 +1680,67 @@ TMDE(inline size_t MDGridBox)::addEventUnsafe(const MDE &event) {
     return 0;
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Add several events to the grid box. The events are sorted into the child
+ * boxes they fall in, and each child adds all of its events at once. If there
+ * are many events, the children add them in parallel: they share no data, so
+ * no locking is needed.
+ *
+ * Warning! No bounds checking is done (for performance), but events that do
+ * not fall in any child box are rejected.
+ *
+ * Warning! Call is NOT thread-safe. Only 1 thread should be writing to this
+ * box (or any child boxes) at a time
+ *
+ * Note! nPoints, signal and error must be re-calculated using refreshCache()
+ * after all events have been added.
+ *
+ * @param events :: vector of events to add.
+ * @return the number of events that were rejected
+ * */
+TMDE(size_t MDGridBox)::addEventsUnsafe(const std::vector<MDE> &events) {
+  // Sort the events by child box, keeping their order within each child
+  std::vector<size_t> childIndices(events.size());
+  std::vector<size_t> counts(numBoxes, 0);
+  size_t numBad = 0;
+  for (size_t i = 0; i < events.size(); ++i) {
+    size_t cindex = calculateChildIndex(events[i]);
+    // We can erroneously get cindex == numBoxes for events which fall on the
+    // upper boundary of the last child box, so add these events to the last
+    // box
+    if (cindex == numBoxes)
+      cindex = numBoxes - 1;
+    if (cindex < numBoxes)
+      ++counts[cindex];
+    else
+      ++numBad;
+    childIndices[i] = cindex;
+  }
+  std::vector<std::vector<MDE>> childEvents(numBoxes);
+  for (size_t i = 0; i < numBoxes; ++i)
+    childEvents[i].reserve(counts[i]);
+  for (size_t i = 0; i < events.size(); ++i) {
+    if (childIndices[i] < numBoxes)
+      childEvents[childIndices[i]].push_back(events[i]);
+  }
+
+  // Each child adds its events, recursively sorting them into its own
+  // children if it is a grid box
+  const bool inParallel =
+      events.size() >= this->m_BoxController->getAddingEvents_eventsPerTask();
+  std::vector<size_t> childNumBad(numBoxes, 0);
+  PARALLEL_FOR_IF(inParallel)
+  for (int i = 0; i < static_cast<int>(numBoxes); ++i) {
+    if (!childEvents[i].empty()) {
+      childNumBad[i] = m_Children[i]->addEventsUnsafe(childEvents[i]);
+      std::vector<MDE>().swap(childEvents[i]);
+    }
+  }
+  for (const size_t bad : childNumBad)
+    numBad += bad;
+  return numBad;
+}
+
 /**Sets particular child MDgridBox at the index, specified by the input
 *parameters
 *@param index     -- the position of the new child in the list of GridBox
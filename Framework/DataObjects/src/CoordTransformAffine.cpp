@@ -278,6 +278,35 @@ void CoordTransformAffine::apply(const coord_t *inputVector,
   }
 }
 
+//----------------------------------------------------------------------------------------------
+/** Apply the coordinate transformation to a block of points. The sums are
+ * done in the same order as apply(), for the same results.
+ *
+ * @param inputs :: inD * numPoints input coordinates, coordinate d of point i
+ *        at [d * numPoints + i]
+ * @param outputs :: outD * numPoints output coordinates, in the same layout
+ * @param numPoints :: number of points
+ */
+void CoordTransformAffine::applyBlock(const coord_t *inputs, coord_t *outputs,
+                                      const size_t numPoints) const {
+  for (size_t out = 0; out < outD; ++out) {
+    const coord_t *rawMatrixRow = m_rawMatrix[out];
+    coord_t *outValues = outputs + out * numPoints;
+    for (size_t i = 0; i < numPoints; ++i)
+      outValues[i] = 0.0;
+    for (size_t in = 0; in < inD; ++in) {
+      const coord_t factor = rawMatrixRow[in];
+      const coord_t *inValues = inputs + in * numPoints;
+      for (size_t i = 0; i < numPoints; ++i)
+        outValues[i] += factor * inValues[i];
+    }
+    // The homogenous coordinate
+    const coord_t translation = rawMatrixRow[inD];
+    for (size_t i = 0; i < numPoints; ++i)
+      outValues[i] += translation;
+  }
+}
+
 //----------------------------------------------------------------------------------------------
 /** Serialize the coordinate transform
 *
@@ -133,6 +133,27 @@ void CoordTransformAligned::apply(const coord_t *inputVector,
   }
 }
 
+//----------------------------------------------------------------------------------------------
+/** Apply the coordinate transformation to a block of points
+ *
+ * @param inputs :: inD * numPoints input coordinates, coordinate d of point i
+ *        at [d * numPoints + i]
+ * @param outputs :: outD * numPoints output coordinates, in the same layout
+ * @param numPoints :: number of points
+ */
+void CoordTransformAligned::applyBlock(const coord_t *inputs,
+                                       coord_t *outputs,
+                                       const size_t numPoints) const {
+  for (size_t out = 0; out < outD; ++out) {
+    const coord_t *inValues = inputs + m_dimensionToBinFrom[out] * numPoints;
+    coord_t *outValues = outputs + out * numPoints;
+    const coord_t origin = m_origin[out];
+    const coord_t scaling = m_scaling[out];
+    for (size_t i = 0; i < numPoints; ++i)
+      outValues[i] = (inValues[i] - origin) * scaling;
+  }
+}
+
 //----------------------------------------------------------------------------------------------
 /** Create an equivalent affine transformation matrix out of the
  * parameters of this axis-aligned transformation.
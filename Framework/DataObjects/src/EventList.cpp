@@ -3,12 +3,18 @@
 #include "MantidDataObjects/EventWorkspaceMRU.h"
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/Exception.h"
+#include "MantidKernel/HistogramBinner.h"
 #include "MantidKernel/Logger.h"
+#include <boost/make_shared.hpp>
+#include <algorithm>
+#include <array>
 #include <cfloat>
 
 #include <cmath>
+#include <cstring>
 #include <functional>
 #include <limits>
+#include <numeric>
 #include <stdexcept>
 
 using std::ostream;
@@ -25,6 +31,18 @@ using namespace Mantid::API;
 namespace {
 /// The number of events to split for parallel sorting.
 const size_t NUM_EVENTS_PARALLEL_THRESHOLD = 500000;
+/// Ranges with fewer events are sorted with std::sort instead of radix sort.
+const size_t NUM_EVENTS_RADIX_SORT_THRESHOLD = 4096;
+/// The minimum number of events sorted by each thread of a parallel sort.
+const size_t NUM_EVENTS_PER_SORT_BLOCK = 100000;
+/// The number of bits of the sort keys handled by each radix sort pass.
+const size_t RADIX_BITS = 11;
+const size_t RADIX_SIZE = size_t(1) << RADIX_BITS;
+const uint64_t RADIX_MASK = RADIX_SIZE - 1;
+const size_t RADIX_PASSES = (64 + RADIX_BITS - 1) / RADIX_BITS;
+const uint64_t SIGN_BIT = uint64_t(1) << 63;
+/// The number of events whose bin indices are computed in one batch.
+const size_t HISTOGRAM_CHUNK_SIZE = 1024;
 
 /**
  * Calculate the corrected full time in nanoseconds
@@ -118,25 +136,29 @@ bool compareEventPulseTimeTOF(const TofEvent &e1, const TofEvent &e2) {
 // -------------------------------------------------------------------
 
 /// Constructor (empty)
-EventList::EventList() : eventType(TOF), order(UNSORTED), mru(nullptr) {}
+EventList::EventList()
+    : eventType(TOF), order(UNSORTED), mru(nullptr), m_columnar(false) {}
 
 /** Constructor with a MRU list
  * @param mru :: pointer to the MRU of the parent EventWorkspace
  * @param specNo :: the spectrum number for the event list
  */
 EventList::EventList(EventWorkspaceMRU *mru, specnum_t specNo)
-    : IEventList(specNo), eventType(TOF), order(UNSORTED), mru(mru) {}
+    : IEventList(specNo), eventType(TOF), order(UNSORTED), mru(mru),
+      m_columnar(false) {}
 
 /** Constructor copying from an existing event list
  * @param rhs :: EventList object to copy*/
-EventList::EventList(const EventList &rhs) : IEventList(rhs), mru(rhs.mru) {
+EventList::EventList(const EventList &rhs)
+    : IEventList(rhs), mru(rhs.mru), m_columnar(false) {
   // Call the copy operator to do the job,
   this->operator=(rhs);
 }
 
 /** Constructor, taking a vector of events.
  * @param events :: Vector of TofEvent's */
-EventList::EventList(const std::vector<TofEvent> &events) : mru(nullptr) {
+EventList::EventList(const std::vector<TofEvent> &events)
+    : mru(nullptr), m_columnar(false) {
   this->events.assign(events.begin(), events.end());
   this->eventType = TOF;
   this->order = UNSORTED;
@@ -144,7 +166,8 @@ EventList::EventList(const std::vector<TofEvent> &events) : mru(nullptr) {
 
 /** Constructor, taking a vector of events.
  * @param events :: Vector of WeightedEvent's */
-EventList::EventList(const std::vector<WeightedEvent> &events) : mru(nullptr) {
+EventList::EventList(const std::vector<WeightedEvent> &events)
+    : mru(nullptr), m_columnar(false) {
   this->weightedEvents.assign(events.begin(), events.end());
   this->eventType = WEIGHTED;
   this->order = UNSORTED;
@@ -153,7 +176,7 @@ EventList::EventList(const std::vector<WeightedEvent> &events) : mru(nullptr) {
 /** Constructor, taking a vector of events.
  * @param events :: Vector of WeightedEventNoTime's */
 EventList::EventList(const std::vector<WeightedEventNoTime> &events)
-    : mru(nullptr) {
+    : mru(nullptr), m_columnar(false) {
   this->weightedEventsNoTime.assign(events.begin(), events.end());
   this->eventType = WEIGHTED_NOTIME;
   this->order = UNSORTED;
@@ -278,6 +301,12 @@ EventList &EventList::operator=(const EventList &rhs) {
   events = rhs.events;
   weightedEvents = rhs.weightedEvents;
   weightedEventsNoTime = rhs.weightedEventsNoTime;
+  m_tofs = rhs.m_tofs;
+  m_pulseTimes = rhs.m_pulseTimes;
+  m_columnar = rhs.m_columnar;
+  m_indexPulseTimes = rhs.m_indexPulseTimes;
+  m_indexOffsets = rhs.m_indexOffsets;
+  m_groupStarts = rhs.m_groupStarts;
   eventType = rhs.eventType;
   order = rhs.order;
   return *this;
@@ -293,7 +322,12 @@ EventList &EventList::operator+=(const TofEvent &event) {
   switch (this->eventType) {
   case TOF:
     // Simply push the events
-    this->events.push_back(event);
+    if (m_columnar) {
+      m_tofs.push_back(event.tof());
+      m_pulseTimes.push_back(event.pulseTime().totalNanoseconds());
+    } else {
+      this->events.push_back(event);
+    }
     break;
 
   case WEIGHTED:
@@ -306,6 +340,7 @@ EventList &EventList::operator+=(const TofEvent &event) {
   }
 
   this->order = UNSORTED;
+  clearPulseIndex();
   return *this;
 }
 
@@ -320,8 +355,17 @@ EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
   switch (this->eventType) {
   case TOF:
     // Simply push the events
-    this->events.insert(this->events.end(), more_events.begin(),
-                        more_events.end());
+    if (m_columnar) {
+      m_tofs.reserve(m_tofs.size() + more_events.size());
+      m_pulseTimes.reserve(m_pulseTimes.size() + more_events.size());
+      for (const auto &event : more_events) {
+        m_tofs.push_back(event.tof());
+        m_pulseTimes.push_back(event.pulseTime().totalNanoseconds());
+      }
+    } else {
+      this->events.insert(this->events.end(), more_events.begin(),
+                          more_events.end());
+    }
     break;
 
   case WEIGHTED:
@@ -345,6 +389,7 @@ EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
   }
 
   this->order = UNSORTED;
+  clearPulseIndex();
   return *this;
 }
 
@@ -360,6 +405,7 @@ EventList &EventList::operator+=(const WeightedEvent &event) {
   this->switchTo(WEIGHTED);
   this->weightedEvents.push_back(event);
   this->order = UNSORTED;
+  clearPulseIndex();
   return *this;
 }
 
@@ -397,6 +443,7 @@ operator+=(const std::vector<WeightedEvent> &more_events) {
   }
 
   this->order = UNSORTED;
+  clearPulseIndex();
   return *this;
 }
 
@@ -425,6 +472,7 @@ operator+=(const std::vector<WeightedEventNoTime> &more_events) {
   }
 
   this->order = UNSORTED;
+  clearPulseIndex();
   return *this;
 }
 
@@ -440,9 +488,10 @@ operator+=(const std::vector<WeightedEventNoTime> &more_events) {
 EventList &EventList::operator+=(const EventList &more_events) {
   // We'll let the += operator for the given vector of event lists handle it
   switch (more_events.getEventType()) {
-  case TOF:
-    this->operator+=(more_events.events);
-    break;
+  case TOF: {
+    std::vector<TofEvent> rowBuffer;
+    this->operator+=(more_events.rowEvents(rowBuffer));
+  } break;
 
   case WEIGHTED:
     this->operator+=(more_events.weightedEvents);
@@ -455,6 +504,7 @@ EventList &EventList::operator+=(const EventList &more_events) {
 
   // No guaranteed order
   this->order = UNSORTED;
+  clearPulseIndex();
   // Do a union between the detector IDs of both lists
   std::set<detid_t>::const_iterator it;
   for (it = more_events.detectorIDs.begin();
@@ -464,6 +514,159 @@ EventList &EventList::operator+=(const EventList &more_events) {
   return *this;
 }
 
+// --------------------------------------------------------------------------
+/** Merge sorted ranges of events into one sorted vector, taking equal events
+ * from the range that comes first.
+ *
+ * @param ranges :: begin and end of each range
+ * @param out :: the merged events are appended to this vector
+ * @param compare :: the order of the events in the ranges
+ */
+template <class T, class COMPARE>
+void mergeSortedRanges(
+    std::vector<std::pair<const T *, const T *>> ranges,
+    std::vector<T> &out, COMPARE compare) {
+  ranges.erase(std::remove_if(ranges.begin(), ranges.end(),
+                              [](const std::pair<const T *, const T *> &range) {
+                                return range.first == range.second;
+                              }),
+               ranges.end());
+  // Heap of the indices of the ranges, with the smallest first event on top
+  auto later = [&ranges, &compare](const size_t a, const size_t b) {
+    if (compare(*ranges[b].first, *ranges[a].first))
+      return true;
+    return !compare(*ranges[a].first, *ranges[b].first) && b < a;
+  };
+  std::vector<size_t> heap(ranges.size());
+  std::iota(heap.begin(), heap.end(), 0);
+  std::make_heap(heap.begin(), heap.end(), later);
+  while (heap.size() > 1) {
+    std::pop_heap(heap.begin(), heap.end(), later);
+    auto &range = ranges[heap.back()];
+    out.push_back(*range.first++);
+    if (range.first != range.second)
+      std::push_heap(heap.begin(), heap.end(), later);
+    else
+      heap.pop_back();
+  }
+  // The rest of the last range in one go
+  if (!heap.empty())
+    out.insert(out.end(), ranges[heap.front()].first,
+               ranges[heap.front()].second);
+}
+
+// --------------------------------------------------------------------------
+/** Merge the events of other lists with the events of this list, which all
+ * have events of type T and are sorted in the given order.
+ *
+ * @param events :: the events of this list
+ * @param others :: the other lists
+ * @param sortOrder :: TOF_SORT or PULSETIME_SORT
+ */
+template <class T>
+void EventList::mergeSortedHelper(std::vector<T> &events,
+                                  const std::vector<const EventList *> &others,
+                                  const EventSortType sortOrder) {
+  std::vector<std::pair<const T *, const T *>> ranges;
+  ranges.reserve(others.size() + 1);
+  size_t numEvents = events.size();
+  ranges.emplace_back(events.data(), events.data() + events.size());
+  for (const auto other : others) {
+    const std::vector<T> *otherEvents;
+    getEventsFrom(*other, otherEvents);
+    ranges.emplace_back(otherEvents->data(),
+                        otherEvents->data() + otherEvents->size());
+    numEvents += otherEvents->size();
+  }
+
+  std::vector<T> merged;
+  merged.reserve(numEvents);
+  if (sortOrder == TOF_SORT)
+    mergeSortedRanges(ranges, merged, compareEventTof<T>);
+  else
+    mergeSortedRanges(ranges, merged, [](const T &e1, const T &e2) {
+      return e1.pulseTime() < e2.pulseTime();
+    });
+  events.swap(merged);
+}
+
+// --------------------------------------------------------------------------
+/** Append the events of several other event lists to this one, as
+ * operator+=() does for each of them, but allocating the memory only once.
+ *
+ * If all lists that have events are sorted by TOF, or all by pulse time, and
+ * have events of the same type, the events are merged so that the result is
+ * sorted in the same order and does not need to be sorted again.
+ *
+ * @param others :: the event lists to add; must not include this list.
+ */
+void EventList::addEventLists(const std::vector<const EventList *> &others) {
+  toRowStorage();
+  // Switch to the type that the sum of the lists has
+  EventType type = eventType;
+  for (const auto other : others)
+    type = std::max(type, other->getEventType());
+  this->switchTo(type);
+  clearPulseIndex();
+
+  // Can the lists be merged?
+  bool sameType = true;
+  bool haveEvents = false;
+  EventSortType sortOrder = order;
+  size_t numEvents = this->getNumberEvents();
+  if (numEvents > 0)
+    haveEvents = true;
+  for (const auto other : others) {
+    const size_t otherNumEvents = other->getNumberEvents();
+    if (otherNumEvents == 0)
+      continue;
+    numEvents += otherNumEvents;
+    // Columnar lists are added through operator+=(), which reads their
+    // columns without changing their layout
+    sameType = sameType && other->getEventType() == type && !other->m_columnar;
+    if (!haveEvents)
+      sortOrder = other->getSortType();
+    else if (other->getSortType() != sortOrder)
+      sortOrder = UNSORTED;
+    haveEvents = true;
+  }
+  const bool merge =
+      sameType && (sortOrder == TOF_SORT ||
+                   (sortOrder == PULSETIME_SORT && type != WEIGHTED_NOTIME));
+
+  if (merge) {
+    switch (type) {
+    case TOF:
+      mergeSortedHelper(this->events, others, sortOrder);
+      break;
+    case WEIGHTED:
+      mergeSortedHelper(this->weightedEvents, others, sortOrder);
+      break;
+    case WEIGHTED_NOTIME:
+      mergeSortedHelper(this->weightedEventsNoTime, others, sortOrder);
+      break;
+    }
+    this->order = sortOrder;
+    for (const auto other : others)
+      this->detectorIDs.insert(other->detectorIDs.begin(),
+                               other->detectorIDs.end());
+  } else {
+    switch (type) {
+    case TOF:
+      this->events.reserve(numEvents);
+      break;
+    case WEIGHTED:
+      this->weightedEvents.reserve(numEvents);
+      break;
+    case WEIGHTED_NOTIME:
+      this->weightedEventsNoTime.reserve(numEvents);
+      break;
+    }
+    for (const auto other : others)
+      *this += *other;
+  }
+}
+
 // --------------------------------------------------------------------------
 /** SUBTRACT another EventList from this event list.
  * The event lists are concatenated, but the weights of the incoming
@@ -513,6 +716,8 @@ EventList &EventList::operator-=(const EventList &more_events) {
     this->clearData();
     return *this;
   }
+  std::vector<TofEvent> rowBuffer;
+  const std::vector<TofEvent> &moreTofEvents = more_events.rowEvents(rowBuffer);
 
   // We'll let the -= operator for the given vector of event lists handle it
   switch (this->getEventType()) {
@@ -523,7 +728,7 @@ EventList &EventList::operator-=(const EventList &more_events) {
   case WEIGHTED:
     switch (more_events.getEventType()) {
     case TOF:
-      minusHelper(this->weightedEvents, more_events.events);
+      minusHelper(this->weightedEvents, moreTofEvents);
       break;
     case WEIGHTED:
       minusHelper(this->weightedEvents, more_events.weightedEvents);
@@ -538,7 +743,7 @@ EventList &EventList::operator-=(const EventList &more_events) {
   case WEIGHTED_NOTIME:
     switch (more_events.getEventType()) {
     case TOF:
-      minusHelper(this->weightedEventsNoTime, more_events.events);
+      minusHelper(this->weightedEventsNoTime, moreTofEvents);
       break;
     case WEIGHTED:
       minusHelper(this->weightedEventsNoTime, more_events.weightedEvents);
@@ -552,6 +757,7 @@ EventList &EventList::operator-=(const EventList &more_events) {
 
   // No guaranteed order
   this->order = UNSORTED;
+  clearPulseIndex();
 
   // NOTE: What to do about detector ID's?
   return *this;
@@ -568,7 +774,8 @@ bool EventList::operator==(const EventList &rhs) const {
   if (this->eventType != rhs.eventType)
     return false;
   // Check all event lists; The empty ones will compare equal
-  if (events != rhs.events)
+  std::vector<TofEvent> rowBuffer, rhsRowBuffer;
+  if (rowEvents(rowBuffer) != rhs.rowEvents(rhsRowBuffer))
     return false;
   if (weightedEvents != rhs.weightedEvents)
     return false;
@@ -596,12 +803,15 @@ bool EventList::equals(const EventList &rhs, const double tolTof,
   // loop over the events
   size_t numEvents = this->getNumberEvents();
   switch (this->eventType) {
-  case TOF:
+  case TOF: {
+    std::vector<TofEvent> rowBuffer, rhsRowBuffer;
+    const std::vector<TofEvent> &tofEvents = rowEvents(rowBuffer);
+    const std::vector<TofEvent> &rhsTofEvents = rhs.rowEvents(rhsRowBuffer);
     for (size_t i = 0; i < numEvents; ++i) {
-      if (!this->events[i].equals(rhs.events[i], tolTof, tolPulse))
+      if (!tofEvents[i].equals(rhsTofEvents[i], tolTof, tolPulse))
         return false;
     }
-    break;
+  } break;
   case WEIGHTED:
     for (size_t i = 0; i < numEvents; ++i) {
       if (!this->weightedEvents[i].equals(rhs.weightedEvents[i], tolTof,
@@ -674,6 +884,7 @@ void EventList::switchToWeightedEvents() {
     break;
 
   case TOF:
+    toRowStorage();
     weightedEvents.clear();
     weightedEventsNoTime.clear();
     // Convert and copy all TofEvents to the weightedEvents list.
@@ -694,12 +905,15 @@ void EventList::switchToWeightedEvents() {
  * of TofEvent.
  */
 void EventList::switchToWeightedEventsNoTime() {
+  if (eventType != WEIGHTED_NOTIME)
+    clearPulseIndex();
   switch (eventType) {
   case WEIGHTED_NOTIME:
     // Do nothing if already there
     return;
 
   case TOF: {
+    toRowStorage();
     // Convert and copy all TofEvents to the weightedEvents list.
     weightedEventsNoTime.clear();
     std::vector<TofEvent>::const_iterator it;
@@ -741,6 +955,7 @@ void EventList::switchToWeightedEventsNoTime() {
  * @return a WeightedEvent
  */
 WeightedEvent EventList::getEvent(size_t event_number) {
+  toRowStorage();
   switch (eventType) {
   case TOF:
     return WeightedEvent(events[event_number]);
@@ -763,14 +978,21 @@ WeightedEvent EventList::getEvent(size_t event_number) {
  * NOTE! This should be used for testing purposes only, as much as possible. The
  *EventList
  * may contain weighted events, requiring use of getWeightedEvents() instead.
+ * A const list in columnar storage is not switched back to the row layout,
+ * use getTofs() and getPulseTimes() or the non-const getEvents() instead.
  *
  * @return a const reference to the list of non-weighted events
+ * @throw std::runtime_error if the list has weights or columnar storage
  * */
 const std::vector<TofEvent> &EventList::getEvents() const {
   if (eventType != TOF)
     throw std::runtime_error("EventList::getEvents() called for an EventList "
                              "that has weights. Use getWeightedEvents() or "
                              "getWeightedEventsNoTime().");
+  if (m_columnar)
+    throw std::runtime_error("EventList::getEvents() const called for an "
+                             "EventList with columnar storage. Use getTofs() "
+                             "and getPulseTimes().");
   return this->events;
 }
 
@@ -786,6 +1008,9 @@ std::vector<TofEvent> &EventList::getEvents() {
     throw std::runtime_error("EventList::getEvents() called for an EventList "
                              "that has weights. Use getWeightedEvents() or "
                              "getWeightedEventsNoTime().");
+  toRowStorage();
+  // The caller may change the events
+  clearPulseIndex();
   return this->events;
 }
 
@@ -801,6 +1026,8 @@ std::vector<WeightedEvent> &EventList::getWeightedEvents() {
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEvent. Use "
                              "getEvents() or getWeightedEventsNoTime().");
+  // The caller may change the events
+  clearPulseIndex();
   return this->weightedEvents;
 }
 
@@ -858,6 +1085,10 @@ void EventList::clear(const bool removeDetIDs) {
   this->weightedEventsNoTime.clear();
   std::vector<WeightedEventNoTime>().swap(
       this->weightedEventsNoTime); // STL Trick to release memory
+  std::vector<double>().swap(m_tofs);
+  std::vector<int64_t>().swap(m_pulseTimes);
+  std::vector<double>().swap(m_groupStarts);
+  clearPulseIndex();
   if (removeDetIDs)
     this->detectorIDs.clear();
 }
@@ -870,6 +1101,9 @@ void EventList::clearUnused() {
   if (eventType != TOF) {
     this->events.clear();
     std::vector<TofEvent>().swap(this->events); // STL Trick to release memory
+    std::vector<double>().swap(m_tofs);
+    std::vector<int64_t>().swap(m_pulseTimes);
+    m_columnar = false;
   }
   if (eventType != WEIGHTED) {
     this->weightedEvents.clear();
@@ -880,6 +1114,7 @@ void EventList::clearUnused() {
     this->weightedEventsNoTime.clear();
     std::vector<WeightedEventNoTime>().swap(
         this->weightedEventsNoTime); // STL Trick to release memory
+    std::vector<double>().swap(m_groupStarts);
   }
 }
 
@@ -904,7 +1139,98 @@ EventWorkspaceMRU *EventList::getMRU() { return mru; }
  *
  * @param num :: number of events that will be in this EventList
  */
-void EventList::reserve(size_t num) { this->events.reserve(num); }
+void EventList::reserve(size_t num) {
+  if (m_columnar) {
+    m_tofs.reserve(num);
+    m_pulseTimes.reserve(num);
+  } else {
+    this->events.reserve(num);
+  }
+}
+
+// ==============================================================================================
+// --- Columnar storage ------------------------------------------------------
+// ==============================================================================================
+
+// --------------------------------------------------------------------------
+/** Select the storage layout of the TofEvent's in this list.
+ *
+ * In columnar mode the TOF and the pulse time of the events are held in two
+ * separate arrays instead of an array of TofEvent. Operations that only need
+ * the TOF (sorting and histogramming by TOF, unit conversion, masking, ...)
+ * then only touch the TOF array, which halves the memory traffic. Other
+ * operations that modify the list switch it back to the row (TofEvent)
+ * layout. Const methods never change the layout, so they can be called
+ * concurrently; those that need TofEvent's read a copy of the columns, and the
+ * const getEvents() throws.
+ *
+ * Only lists of TofEvent's can use columnar storage; for weighted lists this
+ * does nothing.
+ *
+ * @param columnar :: true to use columnar storage, false for a vector of
+ * TofEvent.
+ */
+void EventList::setColumnarStorage(const bool columnar) {
+  if (columnar)
+    toColumnarStorage();
+  else
+    toRowStorage();
+}
+
+/** Return true if the TofEvent's in this list are held in columnar storage.
+ * @see setColumnarStorage()
+ */
+bool EventList::hasColumnarStorage() const { return m_columnar; }
+
+/// Move the events from the vector of TofEvent into the TOF and pulse time
+/// columns. Only called by methods that modify the list, so const readers
+/// never see the layout change.
+void EventList::toColumnarStorage() {
+  if (m_columnar || eventType != TOF)
+    return;
+  const size_t numEvents = events.size();
+  m_tofs.resize(numEvents);
+  m_pulseTimes.resize(numEvents);
+  for (size_t i = 0; i < numEvents; ++i) {
+    m_tofs[i] = events[i].tof();
+    m_pulseTimes[i] = events[i].pulseTime().totalNanoseconds();
+  }
+  std::vector<TofEvent>().swap(events);
+  m_columnar = true;
+}
+
+/// Move the events from the TOF and pulse time columns back into the vector
+/// of TofEvent. Does nothing if the list does not use columnar storage. Only
+/// called by methods that modify the list.
+void EventList::toRowStorage() {
+  if (!m_columnar)
+    return;
+  const size_t numEvents = m_tofs.size();
+  events.clear();
+  events.reserve(numEvents);
+  for (size_t i = 0; i < numEvents; ++i)
+    events.emplace_back(m_tofs[i], DateAndTime(m_pulseTimes[i]));
+  std::vector<double>().swap(m_tofs);
+  std::vector<int64_t>().swap(m_pulseTimes);
+  m_columnar = false;
+}
+
+/** Return the TofEvent's of the list for a const reader, without changing
+ * the storage layout.
+ * @param buffer :: filled with the events if the list uses columnar storage
+ * @return the vector of TofEvent, or buffer
+ */
+const std::vector<TofEvent> &
+EventList::rowEvents(std::vector<TofEvent> &buffer) const {
+  if (!m_columnar)
+    return events;
+  const size_t numEvents = m_tofs.size();
+  buffer.clear();
+  buffer.reserve(numEvents);
+  for (size_t i = 0; i < numEvents; ++i)
+    buffer.emplace_back(m_tofs[i], DateAndTime(m_pulseTimes[i]));
+  return buffer;
+}
 
 // ==============================================================================================
 // --- Sorting functions -----------------------------------------------------
@@ -913,16 +1239,17 @@ void EventList::reserve(size_t num) { this->events.reserve(num); }
 // --------------------------------------------------------------------------
 /** Sort events by TOF or Frame
  * @param order :: Order by which to sort.
+ * @param numThreads :: number of threads used to sort long lists.
  * */
-void EventList::sort(const EventSortType order) const {
+void EventList::sort(const EventSortType order, const size_t numThreads) const {
   if (order == UNSORTED) {
     return; // don't bother doing anything. Why did you ask to unsort?
   } else if (order == TOF_SORT) {
-    this->sortTof();
+    this->sortTof(numThreads);
   } else if (order == PULSETIME_SORT) {
-    this->sortPulseTime();
+    this->sortPulseTime(numThreads);
   } else if (order == PULSETIMETOF_SORT) {
-    this->sortPulseTimeTOF();
+    this->sortPulseTimeTOF(numThreads);
   } else if (order == TIMEATSAMPLE_SORT) {
     throw std::invalid_argument("sorting by time at sample requires extra "
                                 "parameters. call sortTimeAtSample instead.");
@@ -938,6 +1265,7 @@ void EventList::sort(const EventSortType order) const {
  */
 void EventList::setSortOrder(const EventSortType order) const {
   this->order = order;
+  clearPulseIndex();
 }
 
 //  // MergeSort from:
@@ -977,213 +1305,234 @@ void EventList::setSortOrder(const EventSortType order) const {
 //  }
 
 //----------------------------------------------------------------------------------------------------
-/** Merge two sorted lists into one sorted vector.
- *
- * @tparam T :: the type in the vector.
- * @param begin1 :: iterator at the start of the first list.
- * @param end1 :: iterator at the end of the first list.
- * @param begin2 :: iterator at the start of the second list.
- * @param end2 :: iterator at the end of the second list.
- * @param result_vector :: a vector (by reference) that will be filled with the
- *result.
- * */
-template <typename T>
-void merge(typename std::vector<T>::iterator begin1,
-           typename std::vector<T>::iterator end1,
-           typename std::vector<T>::iterator begin2,
-           typename std::vector<T>::iterator end2,
-           typename std::vector<T> &result_vector) {
-  auto it1 = begin1;
-  auto it2 = begin2;
-  while (!((it1 == end1) && (it2 == end2))) {
-    if (it1 == end1) {
-      // Only it2 makes sense
-      result_vector.push_back(*it2);
-      it2++;
-    } else if (it2 == end2) {
-      // Only it1 makes sense
-      result_vector.push_back(*it1);
-      it1++;
-    } else {
-      // Both iterators are valid. Which is smaller?
-      if (*it1 < *it2) {
-        result_vector.push_back(*it1);
-        it1++;
-      } else {
-        result_vector.push_back(*it2);
-        it2++;
-      }
-    }
-  }
+/// Maps a TOF to an unsigned integer with the same order.
+inline uint64_t tofSortKey(const double tof) {
+  uint64_t bits;
+  std::memcpy(&bits, &tof, sizeof(bits));
+  // Negative numbers are ordered backwards by their bits
+  return (bits & SIGN_BIT) ? ~bits : (bits | SIGN_BIT);
+}
+
+/// Maps a time in nanoseconds to an unsigned integer with the same order.
+inline uint64_t timeSortKey(const int64_t nanoseconds) {
+  return static_cast<uint64_t>(nanoseconds) ^ SIGN_BIT;
 }
 
 //----------------------------------------------------------------------------------------------------
-/** Perform a parallelized sort on a provided vector, using 2 threads.
- * NOTE: Will temporarily use twice the memory used by the incoming vector.
+/** Stable LSD radix sort of a range of events by 64-bit unsigned keys,
+ * RADIX_BITS bits per pass. The passes over bits that are the same for all
+ * events (e.g. the high bits of the pulse times of a run) are skipped.
+ * NOTE: Will temporarily use twice the memory used by the events.
  *
- * @param vec :: a vector, by refe/rence, that will be sorted-in place.
+ * @param first :: pointer to the first event to sort.
+ * @param last :: pointer past the last event to sort.
+ * @param key :: function returning the key of an event.
+ * @param numThreads :: number of threads to use. Long ranges are split into
+ *blocks that are counted and moved by different threads.
  */
-template <typename T> void parallel_sort2(typename std::vector<T> &vec) {
-  size_t size = vec.size();
-
-  auto begin = vec.begin();
-  auto middle = begin + size / 2;
-  auto end = vec.end();
-
-  PRAGMA_OMP(parallel sections) {
-    PRAGMA_OMP(section) {
-      std::sort(begin, middle);
-      // std::cout << " ----------- Part 1 --------------\n"; for (typename
-      // std::vector<T>::iterator it = begin; it != middle; it++) std::cout <<
-      // *it << "\n";
-    }
-    PRAGMA_OMP(section) {
-      std::sort(middle, end);
-      // std::cout << " ----------- Part 2 --------------\n";for (typename
-      // std::vector<T>::iterator it = middle; it != end; it++) std::cout << *it
-      // << "\n";
+template <typename T, typename KEY>
+void radixSort(T *first, T *last, KEY key, const size_t numThreads) {
+  const size_t numEvents = static_cast<size_t>(last - first);
+  const size_t numBlocks = std::max(
+      size_t(1), std::min(numThreads, numEvents / NUM_EVENTS_PER_SORT_BLOCK));
+  auto blockBegin = [numEvents, numBlocks](const size_t block) {
+    return numEvents * block / numBlocks;
+  };
+  typedef std::array<size_t, RADIX_SIZE> Histogram;
+
+  // Histograms of all digits of the keys of each block
+  std::vector<std::array<Histogram, RADIX_PASSES>> counts(numBlocks);
+  PARALLEL_FOR_IF(numBlocks > 1)
+  for (int64_t block = 0; block < static_cast<int64_t>(numBlocks); ++block) {
+    auto &count = counts[block];
+    for (size_t i = blockBegin(block); i < blockBegin(block + 1); ++i) {
+      uint64_t k = key(first[i]);
+      for (size_t pass = 0; pass < RADIX_PASSES; ++pass) {
+        ++count[pass][k & RADIX_MASK];
+        k >>= RADIX_BITS;
+      }
     }
   }
 
-  // Now merge back
-  typename std::vector<T> temp;
-  merge(begin, middle, middle, end, temp);
+  std::vector<T> buffer;
+  T *source = first;
+  T *destination = nullptr;
+  std::vector<Histogram> offsets(numBlocks);
+  for (size_t pass = 0; pass < RADIX_PASSES; ++pass) {
+    // Skip the digits that are the same for all events
+    bool allSame = false;
+    for (size_t digit = 0; digit < RADIX_SIZE && !allSame; ++digit) {
+      size_t total = 0;
+      for (size_t block = 0; block < numBlocks; ++block)
+        total += counts[block][pass][digit];
+      allSame = (total == numEvents);
+    }
+    if (allSame)
+      continue;
+
+    const size_t shift = pass * RADIX_BITS;
+    if (!destination) {
+      buffer.resize(numEvents);
+      destination = buffer.data();
+    } else if (numBlocks > 1) {
+      // The events have moved between the blocks since they were counted
+      PARALLEL_FOR_NO_WSP_CHECK()
+      for (int64_t block = 0; block < static_cast<int64_t>(numBlocks);
+           ++block) {
+        auto &count = counts[block][pass];
+        count.fill(0);
+        for (size_t i = blockBegin(block); i < blockBegin(block + 1); ++i)
+          ++count[(key(source[i]) >> shift) & RADIX_MASK];
+      }
+    }
 
-  // std::cout << " ----------- Part 1+2 --------------\n"; for (typename
-  // std::vector<T>::iterator it = temp.begin(); it != temp.end(); it++)
-  // std::cout << *it << "\n";
-  // Swap storage with the temp vector
-  vec.swap(temp);
-  // Which we can now clear
-  temp.clear();
-}
+    // Where the events of each digit and block go
+    size_t offset = 0;
+    for (size_t digit = 0; digit < RADIX_SIZE; ++digit)
+      for (size_t block = 0; block < numBlocks; ++block) {
+        offsets[block][digit] = offset;
+        offset += counts[block][pass][digit];
+      }
 
-//----------------------------------------------------------------------------------------------------
-/** Perform a parallelized sort on a provided vector, using 4 threads.
- * NOTE: Will temporarily use twice the memory used by the incoming vector.
- *
- * @param vec :: a vector, by reference, that will be sorted-in place.
- */
-template <typename T> void parallel_sort4(std::vector<T> &vec) {
-  // int num_cores = PARALLEL_NUMBER_OF_THREADS;
-  size_t size = vec.size();
-
-  auto begin = vec.begin();
-  auto middle1 = begin + size / 4;
-  auto middle2 = begin + size / 2;
-  auto middle3 = begin + 3 * size / 4;
-  auto end = vec.end();
-
-  PRAGMA_OMP(parallel sections) {
-    PRAGMA_OMP(section) { std::sort(begin, middle1); }
-    PRAGMA_OMP(section) { std::sort(middle1, middle2); }
-    PRAGMA_OMP(section) { std::sort(middle2, middle3); }
-    PRAGMA_OMP(section) { std::sort(middle3, end); }
+    PARALLEL_FOR_IF(numBlocks > 1)
+    for (int64_t block = 0; block < static_cast<int64_t>(numBlocks); ++block) {
+      auto &offset = offsets[block];
+      for (size_t i = blockBegin(block); i < blockBegin(block + 1); ++i)
+        destination[offset[(key(source[i]) >> shift) & RADIX_MASK]++] =
+            source[i];
+    }
+    std::swap(source, destination);
   }
+  if (source != first)
+    std::copy(source, source + numEvents, first);
+}
 
-  // Now merge back
-  typename std::vector<T> temp1, temp2;
-  // PRAGMA_OMP(parallel sections)
-  {
-    // PRAGMA_OMP(section)
-    { merge(begin, middle1, middle1, middle2, temp1); }
-    // PRAGMA_OMP(section)
-    { merge(middle2, middle3, middle3, end, temp2); }
-  }
+/// Radix sorts a range of events by TOF.
+template <typename T>
+void radixSortTof(T *first, T *last, const size_t numThreads) {
+  radixSort(first, last,
+            [](const T &event) { return tofSortKey(event.tof()); }, numThreads);
+}
 
-  // We can clear the incoming vector to free up memory now,
-  //  because it is copied already in temp1, temp2
-  vec.clear();
+/// Radix sorts a range of events by pulse time.
+template <typename T>
+void radixSortPulseTime(T *first, T *last, const size_t numThreads) {
+  radixSort(first, last, [](const T &event) {
+    return timeSortKey(event.pulseTime().totalNanoseconds());
+  }, numThreads);
+}
 
-  // Final merge
-  std::vector<T> temp;
-  merge(temp1.begin(), temp1.end(), temp2.begin(), temp2.end(), temp);
+/// Radix sorts a range of events by pulse time, then TOF.
+template <typename T>
+void radixSortPulseTimeTof(T *first, T *last, const size_t numThreads) {
+  // The sort is stable, so sorting by pulse time keeps the order of the TOFs
+  radixSortTof(first, last, numThreads);
+  radixSortPulseTime(first, last, numThreads);
+}
 
-  // Clear out this temporary storage
-  temp1.clear();
-  temp2.clear();
-  std::vector<T>().swap(temp1);
-  std::vector<T>().swap(temp2);
+/// Radix sorts a range of events by time at sample, see CompareTimeAtSample.
+template <typename T> class RadixSortTimeAtSample {
+public:
+  RadixSortTimeAtSample(const double tofFactor, const double tofShift)
+      : m_tofFactor(tofFactor), m_tofShift(tofShift) {}
 
-  // Swap storage with the temp vector
-  vec.swap(temp);
-  // Which we can now clear
-  temp.clear();
-}
+  void operator()(T *first, T *last, const size_t numThreads) const {
+    const double tofFactor = m_tofFactor;
+    const double tofShift = m_tofShift;
+    radixSort(first, last, [tofFactor, tofShift](const T &event) {
+      return timeSortKey(
+          calculateCorrectedFullTime(event.pulseTime().totalNanoseconds(),
+                                     event.tof(), tofFactor, tofShift));
+    }, numThreads);
+  }
 
-// --------------------------------------------------------------------------
-/** Sort events by TOF in one thread */
-void EventList::sortTof() const {
-  if (this->order == TOF_SORT)
-    return; // nothing to do
+private:
+  const double m_tofFactor;
+  const double m_tofShift;
+};
 
-  // Avoid sorting from multiple threads
-  std::lock_guard<std::mutex> _lock(m_sortMutex);
-  // If the list was sorted while waiting for the lock, return.
-  if (this->order == TOF_SORT)
+//----------------------------------------------------------------------------------------------------
+/** Sort a vector of events.
+ *
+ * Vectors that are sorted already (e.g. by pulse time after loading) are
+ * detected in one pass. If only events at the end are out of order (e.g.
+ * after events were appended to a sorted list), only those are sorted and
+ * then merged with the others. Long ranges are radix sorted, short ones with
+ * std::sort.
+ *
+ * @param events :: vector to sort in place.
+ * @param compare :: the order to sort in.
+ * @param radix :: function radix sorting a range of events in the same order.
+ * @param numThreads :: number of threads used to sort long vectors.
+ */
+template <typename T, typename COMPARE, typename RADIX>
+void sortEvents(std::vector<T> &events, COMPARE compare, RADIX radix,
+                const size_t numThreads) {
+  auto unsorted = std::is_sorted_until(events.begin(), events.end(), compare);
+  if (unsorted == events.end())
     return;
+  auto first = events.begin();
+  // Sort only the events at the end if the others are in order
+  if (unsorted - events.begin() >= events.end() - unsorted)
+    first = unsorted;
+
+  const size_t offset = static_cast<size_t>(first - events.begin());
+  if (events.size() - offset < NUM_EVENTS_RADIX_SORT_THRESHOLD)
+    std::sort(first, events.end(), compare);
+  else
+    radix(events.data() + offset, events.data() + events.size(), numThreads);
 
-  switch (eventType) {
-  case TOF:
-    std::sort(events.begin(), events.end(), compareEventTof<TofEvent>);
-    break;
-  case WEIGHTED:
-    std::sort(weightedEvents.begin(), weightedEvents.end(),
-              compareEventTof<WeightedEvent>);
-    break;
-  case WEIGHTED_NOTIME:
-    std::sort(weightedEventsNoTime.begin(), weightedEventsNoTime.end(),
-              compareEventTof<WeightedEventNoTime>);
-    break;
-  }
-  // Save the order to avoid unnecessary re-sorting.
-  this->order = TOF_SORT;
+  if (first != events.begin())
+    std::inplace_merge(events.begin(), first, events.end(), compare);
 }
 
-// --------------------------------------------------------------------------
-/** Sort events by TOF, using two threads.
+//----------------------------------------------------------------------------------------------------
+/** Sort events held in columnar storage. A permutation of the event indices
+ * is sorted, and the columns are then reordered in place by following its
+ * cycles, so no vector of TofEvent is created. The sort runs on one thread.
  *
- * Performance for 5e7 events:
- *  - 40.5 secs with sortTof() (one thread)
- *  - 21.1 secs with sortTof2() (two threads)
- *  - 18.2 secs with sortTof4() (four threads)
- * Performance gain tends to go up with longer event lists.
- * */
-void EventList::sortTof2() const {
-  if (this->order == TOF_SORT)
-    return; // nothing to do
-
-  // Avoid sorting from multiple threads
-  std::lock_guard<std::mutex> _lock(m_sortMutex);
-  // If the list was sorted while waiting for the lock, return.
-  if (this->order == TOF_SORT)
-    return;
-
-  switch (eventType) {
-  case TOF:
-    parallel_sort2(events);
-    break;
-  case WEIGHTED:
-    parallel_sort2(weightedEvents);
-    break;
-  case WEIGHTED_NOTIME:
-    parallel_sort2(weightedEventsNoTime);
-    break;
+ * @param tofs :: TOF column, sorted in place.
+ * @param pulseTimes :: pulse time column (in nanoseconds), sorted in place.
+ * @param compare :: comparison of two TofEvent's.
+ */
+template <typename COMPARE>
+void sortColumnar(std::vector<double> &tofs, std::vector<int64_t> &pulseTimes,
+                  COMPARE compare) {
+  const size_t numEvents = tofs.size();
+  std::vector<size_t> permutation(numEvents);
+  std::iota(permutation.begin(), permutation.end(), size_t(0));
+  std::sort(permutation.begin(), permutation.end(),
+            [&tofs, &pulseTimes, &compare](const size_t a, const size_t b) {
+              return compare(TofEvent(tofs[a], DateAndTime(pulseTimes[a])),
+                             TofEvent(tofs[b], DateAndTime(pulseTimes[b])));
+            });
+
+  // Event i of the sorted columns is event permutation[i] of the unsorted
+  // ones. Each cycle is moved along once, and marked as done in permutation.
+  for (size_t start = 0; start < numEvents; ++start) {
+    if (permutation[start] == start)
+      continue;
+    const double tof = tofs[start];
+    const int64_t pulseTime = pulseTimes[start];
+    size_t i = start;
+    while (permutation[i] != start) {
+      const size_t next = permutation[i];
+      tofs[i] = tofs[next];
+      pulseTimes[i] = pulseTimes[next];
+      permutation[i] = i;
+      i = next;
+    }
+    tofs[i] = tof;
+    pulseTimes[i] = pulseTime;
+    permutation[i] = i;
   }
-  // Save the order to avoid unnecessary re-sorting.
-  this->order = TOF_SORT;
 }
 
 // --------------------------------------------------------------------------
-/** Sort events by TOF, using two threads.
- *
- * Performance for 5e7 events:
- *  - 40.5 secs with sortTof() (one thread)
- *  - 21.1 secs with sortTof2() (two threads)
- *  - 18.2 secs with sortTof4() (four threads)
- * Performance gain tends to go up with longer event lists.
- * */
-void EventList::sortTof4() const {
+/** Sort events by TOF
+ * @param numThreads :: number of threads used to sort long lists.
+ */
+void EventList::sortTof(const size_t numThreads) const {
   if (this->order == TOF_SORT)
     return; // nothing to do
 
@@ -1195,19 +1544,34 @@ void EventList::sortTof4() const {
 
   switch (eventType) {
   case TOF:
-    parallel_sort4(events);
+    if (m_columnar)
+      sortColumnar(m_tofs, m_pulseTimes, compareEventTof<TofEvent>);
+    else
+      sortEvents(events, compareEventTof<TofEvent>, radixSortTof<TofEvent>,
+                 numThreads);
     break;
   case WEIGHTED:
-    parallel_sort4(weightedEvents);
+    sortEvents(weightedEvents, compareEventTof<WeightedEvent>,
+               radixSortTof<WeightedEvent>, numThreads);
     break;
   case WEIGHTED_NOTIME:
-    parallel_sort4(weightedEventsNoTime);
+    sortEvents(weightedEventsNoTime, compareEventTof<WeightedEventNoTime>,
+               radixSortTof<WeightedEventNoTime>, numThreads);
     break;
   }
   // Save the order to avoid unnecessary re-sorting.
   this->order = TOF_SORT;
+  clearPulseIndex();
 }
 
+// --------------------------------------------------------------------------
+/** Sort events by TOF, using two threads. */
+void EventList::sortTof2() const { this->sortTof(2); }
+
+// --------------------------------------------------------------------------
+/** Sort events by TOF, using four threads. */
+void EventList::sortTof4() const { this->sortTof(4); }
+
 // --------------------------------------------------------------------------
 /**
  * Sort events by time at sample
@@ -1234,25 +1598,33 @@ void EventList::sortTimeAtSample(const double &tofFactor,
   switch (eventType) {
   case TOF: {
     CompareTimeAtSample<TofEvent> comparitor(tofFactor, tofShift);
-    std::sort(events.begin(), events.end(), comparitor);
+    RadixSortTimeAtSample<TofEvent> radix(tofFactor, tofShift);
+    if (m_columnar)
+      sortColumnar(m_tofs, m_pulseTimes, comparitor);
+    else
+      sortEvents(events, comparitor, radix, 1);
   } break;
   case WEIGHTED: {
     CompareTimeAtSample<WeightedEvent> comparitor(tofFactor, tofShift);
-    std::sort(weightedEvents.begin(), weightedEvents.end(), comparitor);
+    RadixSortTimeAtSample<WeightedEvent> radix(tofFactor, tofShift);
+    sortEvents(weightedEvents, comparitor, radix, 1);
   } break;
   case WEIGHTED_NOTIME: {
     CompareTimeAtSample<WeightedEventNoTime> comparitor(tofFactor, tofShift);
-    std::sort(weightedEventsNoTime.begin(), weightedEventsNoTime.end(),
-              comparitor);
+    RadixSortTimeAtSample<WeightedEventNoTime> radix(tofFactor, tofShift);
+    sortEvents(weightedEventsNoTime, comparitor, radix, 1);
   } break;
   }
   // Save the order to avoid unnecessary re-sorting.
   this->order = TIMEATSAMPLE_SORT;
+  clearPulseIndex();
 }
 
 // --------------------------------------------------------------------------
-/** Sort events by Frame */
-void EventList::sortPulseTime() const {
+/** Sort events by Frame
+ * @param numThreads :: number of threads used to sort long lists.
+ */
+void EventList::sortPulseTime(const size_t numThreads) const {
   if (this->order == PULSETIME_SORT)
     return; // nothing to do
 
@@ -1265,16 +1637,23 @@ void EventList::sortPulseTime() const {
   // Perform sort.
   switch (eventType) {
   case TOF:
-    std::sort(events.begin(), events.end(), compareEventPulseTime);
+    if (m_columnar)
+      sortColumnar(m_tofs, m_pulseTimes, compareEventPulseTime);
+    else
+      sortEvents(events, compareEventPulseTime, radixSortPulseTime<TofEvent>,
+                 numThreads);
     break;
   case WEIGHTED:
-    std::sort(weightedEvents.begin(), weightedEvents.end(),
-              compareEventPulseTime);
+    sortEvents(weightedEvents, compareEventPulseTime,
+               radixSortPulseTime<WeightedEvent>, numThreads);
     break;
   case WEIGHTED_NOTIME:
     // Do nothing; there is no time to sort
     break;
   }
+  // The pulses of a list sorted by pulse time + TOF keep their offsets
+  if (this->order != PULSETIMETOF_SORT)
+    clearPulseIndex();
   // Save the order to avoid unnecessary re-sorting.
   this->order = PULSETIME_SORT;
 }
@@ -1282,8 +1661,9 @@ void EventList::sortPulseTime() const {
 /*
  * Sort events by pulse time + TOF
  * (the absolute time)
+ * @param numThreads :: number of threads used to sort long lists.
  */
-void EventList::sortPulseTimeTOF() const {
+void EventList::sortPulseTimeTOF(const size_t numThreads) const {
   if (this->order == PULSETIMETOF_SORT)
     return; // already ordered.
 
@@ -1295,17 +1675,24 @@ void EventList::sortPulseTimeTOF() const {
 
   switch (eventType) {
   case TOF:
-    std::sort(events.begin(), events.end(), compareEventPulseTimeTOF);
+    if (m_columnar)
+      sortColumnar(m_tofs, m_pulseTimes, compareEventPulseTimeTOF);
+    else
+      sortEvents(events, compareEventPulseTimeTOF,
+                 radixSortPulseTimeTof<TofEvent>, numThreads);
     break;
   case WEIGHTED:
-    std::sort(weightedEvents.begin(), weightedEvents.end(),
-              compareEventPulseTimeTOF);
+    sortEvents(weightedEvents, compareEventPulseTimeTOF,
+               radixSortPulseTimeTof<WeightedEvent>, numThreads);
     break;
   case WEIGHTED_NOTIME:
     // Do nothing; there is no time to sort
     break;
   }
 
+  // The pulses of a list sorted by pulse time keep their offsets
+  if (this->order != PULSETIME_SORT)
+    clearPulseIndex();
   // Save
   this->order = PULSETIMETOF_SORT;
 }
@@ -1334,7 +1721,12 @@ void EventList::reverse() {
   if (this->isSortedByTof()) {
     switch (eventType) {
     case TOF:
-      std::reverse(this->events.begin(), this->events.end());
+      if (m_columnar) {
+        std::reverse(m_tofs.begin(), m_tofs.end());
+        std::reverse(m_pulseTimes.begin(), m_pulseTimes.end());
+      } else {
+        std::reverse(this->events.begin(), this->events.end());
+      }
       break;
     case WEIGHTED:
       std::reverse(this->weightedEvents.begin(), this->weightedEvents.end());
@@ -1360,7 +1752,7 @@ void EventList::reverse() {
 size_t EventList::getNumberEvents() const {
   switch (eventType) {
   case TOF:
-    return this->events.size();
+    return m_columnar ? m_tofs.size() : this->events.size();
   case WEIGHTED:
     return this->weightedEvents.size();
   case WEIGHTED_NOTIME:
@@ -1375,7 +1767,7 @@ size_t EventList::getNumberEvents() const {
 bool EventList::empty() const {
   switch (eventType) {
   case TOF:
-    return this->events.empty();
+    return m_columnar ? m_tofs.empty() : this->events.empty();
   case WEIGHTED:
     return this->weightedEvents.empty();
   case WEIGHTED_NOTIME:
@@ -1392,15 +1784,23 @@ bool EventList::empty() const {
  * @return :: the memory used by the EventList, in bytes.
  * */
 size_t EventList::getMemorySize() const {
+  const size_t indexSize = m_indexPulseTimes.capacity() * sizeof(int64_t) +
+                           m_indexOffsets.capacity() * sizeof(size_t);
   switch (eventType) {
   case TOF:
-    return this->events.capacity() * sizeof(TofEvent) + sizeof(EventList);
+    if (m_columnar)
+      return m_tofs.capacity() * sizeof(double) +
+             m_pulseTimes.capacity() * sizeof(int64_t) + sizeof(EventList) +
+             indexSize;
+    return this->events.capacity() * sizeof(TofEvent) + sizeof(EventList) +
+           indexSize;
   case WEIGHTED:
     return this->weightedEvents.capacity() * sizeof(WeightedEvent) +
-           sizeof(EventList);
+           sizeof(EventList) + indexSize;
   case WEIGHTED_NOTIME:
     return this->weightedEventsNoTime.capacity() * sizeof(WeightedEventNoTime) +
-           sizeof(EventList);
+           m_groupStarts.capacity() * sizeof(double) + sizeof(EventList) +
+           indexSize;
   }
   throw std::runtime_error("EventList: invalid event type value was found.");
 }
@@ -1508,37 +1908,7 @@ const MantidVec &EventList::constDataY() const {
   if (!mru)
     throw std::runtime_error(
         "EventList::constDataY() called with no MRU set. This is not allowed.");
-
-  // This is the thread number from which this function was called.
-  int thread = PARALLEL_THREAD_NUMBER;
-  mru->ensureEnoughBuffersY(thread);
-
-  // Is the data in the mrulist?
-  MantidVecWithMarker *yData;
-  yData = mru->findY(thread, this->m_specNo);
-
-  if (yData == nullptr) {
-    // Create the MRU object
-    yData = new MantidVecWithMarker(this->m_specNo);
-
-    // prepare to update the uncertainties
-    auto eData = new MantidVecWithMarker(this->m_specNo);
-    mru->ensureEnoughBuffersE(thread);
-
-    // see if E should be calculated;
-    bool skipErrors = (eventType == TOF);
-
-    // Set the Y data in it
-    this->generateHistogram(*refX, yData->m_data, eData->m_data, skipErrors);
-
-    // Lets save it in the MRU
-    mru->insertY(thread, yData);
-    if (!skipErrors) {
-      mru->insertE(thread, eData);
-    } else
-      delete eData; // Need to clear up this memory if it wasn't put into MRU
-  }
-  return yData->m_data;
+  return cachedHistogram().m_y;
 }
 
 /** Look in the MRU to see if the E histogram has been generated before.
@@ -1550,95 +1920,164 @@ const MantidVec &EventList::constDataE() const {
   if (!mru)
     throw std::runtime_error(
         "EventList::constDataE() called with no MRU set. This is not allowed.");
+  return cachedHistogram().m_e;
+}
 
-  // This is the thread number from which this function was called.
-  int thread = PARALLEL_THREAD_NUMBER;
-  mru->ensureEnoughBuffersE(thread);
-
-  // Is the data in the mrulist?
-  MantidVecWithMarker *eData;
-  eData = mru->findE(thread, this->m_specNo);
-
-  if (eData == nullptr) {
-    // Create the MRU object
-    eData = new MantidVecWithMarker(this->m_specNo);
-
-    // Now use that to get E -- Y values are generated from another function
-    MantidVec Y_ignored;
-    this->generateHistogram(*refX, Y_ignored, eData->m_data);
-
-    // Lets save it in the MRU
-    mru->insertE(thread, eData);
+/** Return the histogram for the current X from the MRU, generating and
+ * caching it if it is not there. The MRU keeps the histogram in memory until
+ * at least EventWorkspaceMRU::NUM_RETAINED more histograms were returned to
+ * the calling thread, even if it is dropped from the cache.
+ *
+ * @return reference to the cached histogram.
+ */
+const CachedHistogram &EventList::cachedHistogram() const {
+  const size_t index = static_cast<size_t>(this->m_specNo);
+  auto histogram = mru->find(index, *refX);
+  if (!histogram) {
+    auto generated = boost::make_shared<CachedHistogram>(index, refX);
+    this->generateHistogram(*refX, generated->m_y, generated->m_e);
+    histogram = mru->insert(generated);
   }
-  return eData->m_data;
+  return *histogram;
 }
 
 // --------------------------------------------------------------------------
-/** Compress the event list by grouping events with the same TOF.
+/** Group the events of a TOF-sorted vector whose TOFs are within a tolerance
+ * of the first event of the group, and call
+ * emit(tof, weight, errorSquared, firstTof) with the average TOF, the summed
+ * weights and squared errors and the TOF of the first event of each group. A
+ * group is emitted only after all of its events were read.
  *
- * @param events :: input event list.
- * @param out :: output WeightedEventNoTime vector.
+ * @param events :: TOF-sorted event vector.
  * @param tolerance :: how close do two event's TOF have to be to be considered
- *the same.
+ *the same. If negative, the tolerance is relative to the TOF of the first
+ *event of a group (logarithmic compression).
+ * @param weightedTof :: if true, the average TOF is weighted by the weights of
+ *the events, unless a weight is not positive. This is needed to compress
+ *events that were compressed before.
+ * @param emit :: function called for each group.
  */
-
-template <class T>
-inline void
-EventList::compressEventsHelper(const std::vector<T> &events,
-                                std::vector<WeightedEventNoTime> &out,
-                                double tolerance) {
-  // Clear the output. We can't know ahead of time how much space to reserve :(
-  out.clear();
-  // We will make a starting guess of 1/20th of the number of input events.
-  out.reserve(events.size() / 20);
-
-  // The last TOF to which we are comparing.
+template <class T, class EMIT>
+inline void groupEventsByTof(const std::vector<T> &events,
+                             const double tolerance, const bool weightedTof,
+                             EMIT emit) {
+  const bool logarithmic = tolerance < 0;
+  // The first TOF of the group, and how close events have to be to it
   double lastTof = -std::numeric_limits<double>::max();
+  double groupTolerance = 0;
   // For getting an accurate average TOF
   double totalTof = 0;
+  double totalWeightedTof = 0;
+  bool positiveWeights = true;
   int num = 0;
   // Carrying weight and error
   double weight = 0;
   double errorSquared = 0;
 
+  auto emitGroup = [&]() {
+    if (weightedTof && positiveWeights)
+      emit(totalWeightedTof / weight, weight, errorSquared, lastTof);
+    else
+      emit(totalTof / num, weight, errorSquared, lastTof);
+  };
+
   for (auto it = events.cbegin(); it != events.cend(); it++) {
-    if ((it->m_tof - lastTof) <= tolerance) {
+    if (num > 0 && (it->tof() - lastTof) <= groupTolerance) {
       // Carry the error and weight
       weight += it->weight();
       errorSquared += it->errorSquared();
       // Track the average tof
       num++;
-      totalTof += it->m_tof;
+      totalTof += it->tof();
+      if (weightedTof) {
+        totalWeightedTof += it->tof() * it->weight();
+        positiveWeights = positiveWeights && it->weight() > 0;
+      }
     } else {
       // We exceeded the tolerance
-      if (num > 0) {
-        // Create a new event with the average TOF and summed weights and
-        // squared errors.
-        out.push_back(
-            WeightedEventNoTime(totalTof / num, weight, errorSquared));
-      }
+      if (num > 0)
+        emitGroup();
       // Start a new combined object
       num = 1;
-      totalTof = it->m_tof;
+      totalTof = it->tof();
       weight = it->weight();
       errorSquared = it->errorSquared();
-      lastTof = it->m_tof;
+      if (weightedTof) {
+        totalWeightedTof = it->tof() * it->weight();
+        positiveWeights = it->weight() > 0;
+      }
+      lastTof = it->tof();
+      groupTolerance = logarithmic ? -tolerance * std::abs(lastTof) : tolerance;
     }
   }
 
   // Put the last event in there too.
-  if (num > 0) {
-    // Create a new event with the average TOF and summed weights and squared
-    // errors.
-    out.push_back(WeightedEventNoTime(totalTof / num, weight, errorSquared));
-  }
+  if (num > 0)
+    emitGroup();
+}
 
-  // If you have over-allocated by more than 5%, reduce the size.
-  size_t excess_limit = out.size() / 20;
-  if ((out.capacity() - out.size()) > excess_limit) {
-    // Note: This forces a copy!
-    std::vector<WeightedEventNoTime>(out).swap(out);
+// --------------------------------------------------------------------------
+/** Compress the event list by grouping events with the same TOF.
+ *
+ * The output is allocated once with its final size. If events and out are the
+ * same vector, the events are compressed in place without a temporary copy.
+ *
+ * @param events :: input event list, sorted by TOF.
+ * @param out :: output WeightedEventNoTime vector.
+ * @param tolerance :: how close do two event's TOF have to be to be considered
+ *the same. If negative, the tolerance is relative to the TOF (logarithmic
+ *compression).
+ * @param weightedTof :: if true, average TOFs weighted by the event weights.
+ * @param groupStarts :: if not NULL, filled with the TOF of the first event of
+ *each group.
+ */
+
+template <class T>
+inline void EventList::compressEventsHelper(
+    const std::vector<T> &events, std::vector<WeightedEventNoTime> &out,
+    double tolerance, bool weightedTof, std::vector<double> *groupStarts) {
+  if (groupStarts)
+    groupStarts->clear();
+  const auto addStart = [groupStarts](const double firstTof) {
+    if (groupStarts)
+      groupStarts->push_back(firstTof);
+  };
+  if (static_cast<const void *>(&events) == static_cast<const void *>(&out)) {
+    // Each group is written over events that were already read.
+    auto outIt = out.begin();
+    groupEventsByTof(events, tolerance, weightedTof,
+                     [&outIt, &addStart](const double tof, const double weight,
+                                         const double errorSquared,
+                                         const double firstTof) {
+                       *outIt++ = WeightedEventNoTime(tof, weight, errorSquared);
+                       addStart(firstTof);
+                     });
+    out.erase(outIt, out.end());
+    // If the compression freed more than 5% of the memory, release it.
+    if ((out.capacity() - out.size()) > out.size() / 20)
+      out.shrink_to_fit();
+    return;
   }
+
+  // Count the groups first, so that the output does not need to be
+  // re-allocated or shrunk
+  size_t numGroups = 0;
+  groupEventsByTof(
+      events, tolerance, weightedTof,
+      [&numGroups](double, double, double, double) { ++numGroups; });
+  out.clear();
+  if (out.capacity() > numGroups)
+    std::vector<WeightedEventNoTime>().swap(out);
+  out.reserve(numGroups);
+  if (groupStarts)
+    groupStarts->reserve(numGroups);
+  groupEventsByTof(events, tolerance, weightedTof,
+                   [&out, &addStart](const double tof, const double weight,
+                                     const double errorSquared,
+                                     const double firstTof) {
+                     out.emplace_back(tof, weight, errorSquared);
+                     addStart(firstTof);
+                   });
 }
 
 // --------------------------------------------------------------------------
@@ -1737,8 +2176,14 @@ void EventList::compressEventsParallelHelper(
  * TOF (within a given tolerance). PulseTime is ignored.
  * The event list will be switched to WeightedEventNoTime.
  *
+ * A list of WeightedEventNoTime is compressed in place. If events were
+ * appended to a list that was compressed before, only the appended events are
+ * sorted before they are merged with the others.
+ *
  * @param tolerance :: how close do two event's TOF have to be to be considered
- *the same.
+ *the same. If negative, events are grouped if their TOFs are within
+ *|tolerance| times the TOF of the first event of the group (logarithmic
+ *compression).
  * @param destination :: EventList that will receive the compressed events. Can
  *be == this.
  * @param parallel :: if true, the compression will be done with all available
@@ -1750,50 +2195,25 @@ void EventList::compressEventsParallelHelper(
  */
 void EventList::compressEvents(double tolerance, EventList *destination,
                                bool parallel) {
+  toRowStorage();
   // Must have a sorted list
-  if (parallel)
-    this->sortTof4();
-  else
-    this->sortTof();
+  this->sortTof(parallel ? Kernel::threadsForParallelRegion() : 1);
   switch (eventType) {
   case TOF:
-    //      if (parallel)
-    //        compressEventsParallelHelper(this->events,
-    //        destination->weightedEventsNoTime, tolerance);
-    //      else
     compressEventsHelper(this->events, destination->weightedEventsNoTime,
                          tolerance);
     break;
 
   case WEIGHTED:
-    //      if (parallel)
-    //        compressEventsParallelHelper(this->weightedEvents,
-    //        destination->weightedEventsNoTime, tolerance);
-    //      else
     compressEventsHelper(this->weightedEvents,
                          destination->weightedEventsNoTime, tolerance);
 
     break;
 
   case WEIGHTED_NOTIME:
-    if (destination == this) {
-      // Put results in a temp output
-      std::vector<WeightedEventNoTime> out;
-      //        if (parallel)
-      //          compressEventsParallelHelper(this->weightedEventsNoTime, out,
-      //          tolerance);
-      //        else
-      compressEventsHelper(this->weightedEventsNoTime, out, tolerance);
-      // Put it back
-      this->weightedEventsNoTime.swap(out);
-    } else {
-      //        if (parallel)
-      //          compressEventsParallelHelper(this->weightedEventsNoTime,
-      //          destination->weightedEventsNoTime, tolerance);
-      //        else
-      compressEventsHelper(this->weightedEventsNoTime,
-                           destination->weightedEventsNoTime, tolerance);
-    }
+    // In place if destination == this
+    compressEventsHelper(this->weightedEventsNoTime,
+                         destination->weightedEventsNoTime, tolerance);
     break;
   }
   // In all cases, you end up WEIGHTED_NOTIME.
@@ -1804,6 +2224,185 @@ void EventList::compressEvents(double tolerance, EventList *destination,
   destination->clearUnused();
 }
 
+// --------------------------------------------------------------------------
+/** Compress the events that were appended to a compressed list and merge them
+ * into its groups. Events within the tolerance of the first TOF of a group
+ * are added to that group. The others are grouped among themselves, but a new
+ * group never reaches the first TOF of the next existing one, so the existing
+ * groups are never merged with each other.
+ *
+ * @param events :: appended events; emptied on return.
+ * @param tolerance :: see compressEvents().
+ */
+template <class T>
+void EventList::mergeAppendedEventsHelper(std::vector<T> &events,
+                                          double tolerance) {
+  if (events.empty())
+    return;
+  sortEvents(events, compareEventTof<T>, radixSortTof<T>, 1);
+
+  const bool logarithmic = tolerance < 0;
+  const auto groupEnd = [logarithmic, tolerance](const double firstTof) {
+    return firstTof +
+           (logarithmic ? -tolerance * std::abs(firstTof) : tolerance);
+  };
+  const std::vector<WeightedEventNoTime> &compressed = weightedEventsNoTime;
+  const std::vector<double> &groupStarts = m_groupStarts;
+  const size_t numCompressed = compressed.size();
+
+  // Walk through the groups and the appended events in the order of their
+  // TOFs, calling emit(tof, weight, errorSquared, firstTof) for every group.
+  const auto mergeGroups = [&](const std::function<void(
+                                   double, double, double, double)> &emit) {
+    size_t group = 0;
+    auto it = events.cbegin();
+    while (it != events.cend()) {
+      const double tof = it->tof();
+      for (; group < numCompressed && groupEnd(groupStarts[group]) < tof;
+           ++group)
+        emit(compressed[group].tof(), compressed[group].weight(),
+             compressed[group].errorSquared(), groupStarts[group]);
+
+      // The events of the group, or the events of a new one before it
+      const bool existing = group < numCompressed && tof >= groupStarts[group];
+      const double firstTof = existing ? groupStarts[group] : tof;
+      const double end = groupEnd(firstTof);
+      const double nextStart = (!existing && group < numCompressed)
+                                   ? groupStarts[group]
+                                   : std::numeric_limits<double>::max();
+      double weight = 0, errorSquared = 0, totalTof = 0, totalWeightedTof = 0;
+      bool positiveWeights = true;
+      size_t num = 0;
+      if (existing) {
+        const auto &event = compressed[group];
+        weight = event.weight();
+        errorSquared = event.errorSquared();
+        totalTof = event.tof();
+        totalWeightedTof = event.tof() * event.weight();
+        positiveWeights = event.weight() > 0;
+        num = 1;
+        ++group;
+      }
+      for (; it != events.cend() && it->tof() <= end && it->tof() < nextStart;
+           ++it) {
+        weight += it->weight();
+        errorSquared += it->errorSquared();
+        totalTof += it->tof();
+        totalWeightedTof += it->tof() * it->weight();
+        positiveWeights = positiveWeights && it->weight() > 0;
+        ++num;
+      }
+      emit(positiveWeights ? totalWeightedTof / weight
+                           : totalTof / static_cast<double>(num),
+           weight, errorSquared, firstTof);
+    }
+    for (; group < numCompressed; ++group)
+      emit(compressed[group].tof(), compressed[group].weight(),
+           compressed[group].errorSquared(), groupStarts[group]);
+  };
+
+  // Count the groups first, so that the output is allocated once
+  size_t numGroups = 0;
+  mergeGroups([&numGroups](double, double, double, double) { ++numGroups; });
+  std::vector<WeightedEventNoTime> merged;
+  std::vector<double> mergedStarts;
+  merged.reserve(numGroups);
+  mergedStarts.reserve(numGroups);
+  mergeGroups([&merged, &mergedStarts](const double tof, const double weight,
+                                       const double errorSquared,
+                                       const double firstTof) {
+    merged.emplace_back(tof, weight, errorSquared);
+    mergedStarts.push_back(firstTof);
+  });
+  std::vector<T>().swap(events); // STL Trick to release memory
+  weightedEventsNoTime.swap(merged);
+  m_groupStarts.swap(mergedStarts);
+}
+
+// --------------------------------------------------------------------------
+/** Compress the list in place while events are still being added to it, e.g.
+ * while loading or accumulating live data, so that the uncompressed events
+ * never have to be held in memory all at once.
+ *
+ * The first call compresses the list like compressEvents(), with TOFs
+ * averaged by weight. Events may still be added afterwards, through
+ * references to the vectors returned by getEvents() or getWeightedEvents()
+ * before the first call (as done while loading), or with operator+=(). The
+ * next call sorts and compresses only the added events: events within the
+ * tolerance of the first TOF of a group are added to it, and the others form
+ * new groups. Groups compressed before are never merged with each other, so
+ * the result can have more events than compressing all events at once.
+ *
+ * The list remembers the first TOF of each group between the calls. If the
+ * compressed events were changed otherwise in the meantime, so that they no
+ * longer lie within the tolerance of those, they are all compressed again
+ * like appended ones.
+ *
+ * @param tolerance :: how close do two event's TOF have to be to be considered
+ *the same. If negative, the compression is logarithmic, see compressEvents().
+ */
+void EventList::compressAppendedEvents(double tolerance) {
+  toRowStorage();
+  if (eventType != WEIGHTED_NOTIME) {
+    this->sortTof();
+    switch (eventType) {
+    case TOF:
+      compressEventsHelper(this->events, weightedEventsNoTime, tolerance, true,
+                           &m_groupStarts);
+      break;
+    case WEIGHTED:
+      compressEventsHelper(this->weightedEvents, weightedEventsNoTime,
+                           tolerance, true, &m_groupStarts);
+      break;
+    case WEIGHTED_NOTIME:
+      break;
+    }
+    eventType = WEIGHTED_NOTIME;
+    order = TOF_SORT;
+    clearUnused();
+    return;
+  }
+  // If the list was compressed by other means, or changed since the last
+  // call, all of its events are compressed again
+  if (!groupStartsMatch(tolerance))
+    m_groupStarts.clear();
+
+  // Events added with operator+= follow the compressed ones
+  std::vector<WeightedEventNoTime> appended(
+      weightedEventsNoTime.begin() + m_groupStarts.size(),
+      weightedEventsNoTime.end());
+  weightedEventsNoTime.resize(m_groupStarts.size());
+  mergeAppendedEventsHelper(events, tolerance);
+  mergeAppendedEventsHelper(weightedEvents, tolerance);
+  mergeAppendedEventsHelper(appended, tolerance);
+  order = TOF_SORT;
+  // Release the TofEvent's and WeightedEvent's added since the last call
+  clearUnused();
+}
+
+/** Return true if the first TOFs remembered by compressAppendedEvents() still
+ * match the compressed events at the start of the list: each of them must be
+ * within the tolerance of the first TOF of its group, and the groups in
+ * order.
+ * @param tolerance :: see compressAppendedEvents().
+ */
+bool EventList::groupStartsMatch(const double tolerance) const {
+  if (m_groupStarts.size() > weightedEventsNoTime.size())
+    return false;
+  for (size_t i = 0; i < m_groupStarts.size(); ++i) {
+    const double start = m_groupStarts[i];
+    // Allow for the rounding of the average TOF of the group
+    const double slack = 1e-12 * std::abs(start);
+    const double end =
+        start + (tolerance < 0 ? -tolerance * std::abs(start) : tolerance);
+    const double tof = weightedEventsNoTime[i].tof();
+    if (tof < start - slack || tof > end + slack ||
+        (i > 0 && start < m_groupStarts[i - 1]))
+      return false;
+  }
+  return true;
+}
+
 // --------------------------------------------------------------------------
 /** Utility function:
  * Returns the iterator into events of the first TofEvent with
@@ -1920,9 +2519,10 @@ EventList::findFirstEvent(std::vector<T> &events, const double seek_tof) {
  * @throw runtime_error if the EventList does not have weighted events
  */
 template <class T>
-void EventList::histogramForWeightsHelper(const std::vector<T> &events,
-                                          const MantidVec &X, MantidVec &Y,
-                                          MantidVec &E) {
+void EventList::histogramForWeightsHelper(
+    const std::vector<T> &events, const Kernel::HistogramBinner &binner,
+    MantidVec &Y, MantidVec &E) {
+  const MantidVec &X = binner.binEdges();
   // For slight speed=up.
   size_t x_size = X.size();
 
@@ -1947,11 +2547,26 @@ void EventList::histogramForWeightsHelper(const std::vector<T> &events,
     std::fill(E.begin(), E.end(), 0.0);
   }
 
-  //---------------------- Histogram without weights
-  //---------------------------------
-
-  // Do we even have any events to do?
-  if (!events.empty()) {
+  if (binner.spacing() != Kernel::HistogramBinner::Spacing::Irregular) {
+    // The bin can be computed from the tof, the events need not be sorted.
+    const size_t numberOfBins = binner.numberOfBins();
+    double tofs[HISTOGRAM_CHUNK_SIZE];
+    size_t indices[HISTOGRAM_CHUNK_SIZE];
+    for (size_t start = 0; start < events.size();
+         start += HISTOGRAM_CHUNK_SIZE) {
+      const size_t count = std::min(HISTOGRAM_CHUNK_SIZE, events.size() - start);
+      for (size_t i = 0; i < count; ++i)
+        tofs[i] = events[start + i].tof();
+      binner.binIndices(tofs, count, indices);
+      for (size_t i = 0; i < count; ++i) {
+        if (indices[i] == numberOfBins)
+          continue;
+        const auto &event = events[start + i];
+        Y[indices[i]] += double(event.m_weight);
+        E[indices[i]] += double(event.m_errorSquared);
+      }
+    }
+  } else if (!events.empty()) {
     // Iterate through all events (sorted by tof)
     auto itev = findFirstEvent(events, X[0]);
     auto itev_end = events.cend();
@@ -2086,35 +2701,30 @@ void EventList::generateHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
  */
 void EventList::generateHistogram(const MantidVec &X, MantidVec &Y,
                                   MantidVec &E, bool skipError) const {
-  // All types of weights need to be sorted by TOF
-
-  size_t numEvents = getNumberEvents();
-  if (numEvents > NUM_EVENTS_PARALLEL_THRESHOLD &&
-      PARALLEL_GET_MAX_THREADS >= 4)
-    // Four-core sort
-    this->sortTof4();
-  else if (numEvents > NUM_EVENTS_PARALLEL_THRESHOLD &&
-           PARALLEL_GET_MAX_THREADS >= 2)
-    // Two-core sort
-    this->sortTof2();
-  else
-    // One-core sort
-    this->sortTof();
+  const Kernel::HistogramBinner binner(X);
+
+  // For linear or logarithmic bins the bin of each event is computed directly
+  // from its TOF. Only irregular bins need the events sorted by TOF.
+  if (binner.spacing() == Kernel::HistogramBinner::Spacing::Irregular) {
+    this->sortTof(getNumberEvents() > NUM_EVENTS_PARALLEL_THRESHOLD
+                      ? Kernel::threadsForParallelRegion()
+                      : 1);
+  }
 
   switch (eventType) {
   case TOF:
     // Make the single ones
-    this->generateCountsHistogram(X, Y);
+    this->generateCountsHistogram(binner, Y);
     if (!skipError)
       this->generateErrorsHistogram(Y, E);
     break;
 
   case WEIGHTED:
-    histogramForWeightsHelper(this->weightedEvents, X, Y, E);
+    histogramForWeightsHelper(this->weightedEvents, binner, Y, E);
     break;
 
   case WEIGHTED_NOTIME:
-    histogramForWeightsHelper(this->weightedEventsNoTime, X, Y, E);
+    histogramForWeightsHelper(this->weightedEventsNoTime, binner, Y, E);
     break;
   }
 }
@@ -2145,10 +2755,12 @@ void EventList::generateCountsHistogramPulseTime(const MantidVec &X,
   //---------------------- Histogram without weights
   //---------------------------------
 
-  if (!this->events.empty()) {
+  std::vector<TofEvent> rowBuffer;
+  const std::vector<TofEvent> &tofEvents = rowEvents(rowBuffer);
+  if (!tofEvents.empty()) {
     // Iterate through all events (sorted by pulse time)
-    auto itev = findFirstPulseEvent(this->events, X[0]);
-    auto itev_end = events.cend(); // cache for speed
+    auto itev = findFirstPulseEvent(tofEvents, X[0]);
+    auto itev_end = tofEvents.cend(); // cache for speed
     // The above can still take you to end() if no events above X[0], so check
     // again.
     if (itev == itev_end)
@@ -2217,12 +2829,14 @@ void EventList::generateCountsHistogramTimeAtSample(
   //---------------------- Histogram without weights
   //---------------------------------
 
-  if (!this->events.empty()) {
+  std::vector<TofEvent> rowBuffer;
+  const std::vector<TofEvent> &tofEvents = rowEvents(rowBuffer);
+  if (!tofEvents.empty()) {
     // Iterate through all events (sorted by pulse time)
     auto itev =
-        findFirstTimeAtSampleEvent(this->events, X[0], tofFactor, tofOffset);
+        findFirstTimeAtSampleEvent(tofEvents, X[0], tofFactor, tofOffset);
     std::vector<TofEvent>::const_iterator itev_end =
-        events.end(); // cache for speed
+        tofEvents.end(); // cache for speed
     // The above can still take you to end() if no events above X[0], so check
     // again.
     if (itev == itev_end)
@@ -2266,11 +2880,12 @@ void EventList::generateCountsHistogramTimeAtSample(
 // --------------------------------------------------------------------------
 /** Fill a histogram given specified histogram bounds. Does not modify
  * the eventlist (const method).
- * @param X :: The x bins
+ * @param binner :: Bin lookup for the x bins
  * @param Y :: The generated counts histogram
  */
-void EventList::generateCountsHistogram(const MantidVec &X,
+void EventList::generateCountsHistogram(const Kernel::HistogramBinner &binner,
                                         MantidVec &Y) const {
+  const MantidVec &X = binner.binEdges();
   // For slight speed=up.
   size_t x_size = X.size();
 
@@ -2280,16 +2895,59 @@ void EventList::generateCountsHistogram(const MantidVec &X,
     return;
   }
 
-  // Sort the events by tof
-  this->sortTof();
   // Clear the Y data, assign all to 0.
   Y.resize(x_size - 1, 0);
 
+  if (binner.spacing() != Kernel::HistogramBinner::Spacing::Irregular) {
+    // The bin can be computed from the tof, the events need not be sorted.
+    // Columnar TOFs are used in place, otherwise they are gathered in chunks.
+    const size_t numberOfBins = binner.numberOfBins();
+    const size_t numEvents = getNumberEvents();
+    double tofs[HISTOGRAM_CHUNK_SIZE];
+    size_t indices[HISTOGRAM_CHUNK_SIZE];
+    for (size_t start = 0; start < numEvents; start += HISTOGRAM_CHUNK_SIZE) {
+      const size_t count = std::min(HISTOGRAM_CHUNK_SIZE, numEvents - start);
+      const double *chunk = tofs;
+      if (m_columnar) {
+        chunk = m_tofs.data() + start;
+      } else {
+        for (size_t i = 0; i < count; ++i)
+          tofs[i] = this->events[start + i].m_tof;
+      }
+      binner.binIndices(chunk, count, indices);
+      for (size_t i = 0; i < count; ++i) {
+        if (indices[i] != numberOfBins)
+          Y[indices[i]]++;
+      }
+    }
+    return;
+  }
+
+  // Sort the events by tof
+  this->sortTof();
+
   //---------------------- Histogram without weights
   //---------------------------------
 
-  // Do we even have any events to do?
-  if (!this->events.empty()) {
+  if (m_columnar) {
+    // Only the TOF column needs to be read. It is sorted, so skip to X[0]
+    // with a binary search and walk through the bins from there.
+    auto itev = std::lower_bound(m_tofs.cbegin(), m_tofs.cend(), X[0]);
+    const auto itev_end = m_tofs.cend();
+    size_t bin = 0;
+    for (; (itev != itev_end) && (bin < x_size - 1); ++itev) {
+      const double tof = *itev;
+      while (bin < x_size - 1) {
+        // Within range?
+        if ((tof >= X[bin]) && (tof < X[bin + 1])) {
+          Y[bin]++;
+          break;
+        }
+        ++bin;
+      }
+    }
+  } else if (!this->events.empty()) {
+    // Do we even have any events to do?
     // Iterate through all events (sorted by tof)
     std::vector<TofEvent>::const_iterator itev =
         findFirstEvent(this->events, X[0]);
@@ -2457,7 +3115,21 @@ void EventList::integrate(const double minX, const double maxX,
   // Convert the list
   switch (eventType) {
   case TOF:
-    integrateHelper(this->events, minX, maxX, entireRange, sum, error);
+    if (m_columnar) {
+      // Every TofEvent has a weight and squared error of 1: only count them.
+      auto lowit = m_tofs.cbegin();
+      auto highit = m_tofs.cend();
+      if (!entireRange) {
+        if (maxX < minX)
+          break;
+        lowit = std::lower_bound(m_tofs.cbegin(), m_tofs.cend(), minX);
+        highit = std::upper_bound(lowit, m_tofs.cend(), maxX);
+      }
+      sum = static_cast<double>(std::distance(lowit, highit));
+      error = std::sqrt(sum);
+    } else {
+      integrateHelper(this->events, minX, maxX, entireRange, sum, error);
+    }
     break;
   case WEIGHTED:
     integrateHelper(this->weightedEvents, minX, maxX, entireRange, sum, error);
@@ -2501,7 +3173,10 @@ void EventList::convertTof(std::function<double(double)> func,
   // Convert the list
   switch (eventType) {
   case TOF:
-    this->convertTofHelper(this->events, func);
+    if (m_columnar)
+      std::transform(m_tofs.begin(), m_tofs.end(), m_tofs.begin(), func);
+    else
+      this->convertTofHelper(this->events, func);
     break;
   case WEIGHTED:
     this->convertTofHelper(this->weightedEvents, func);
@@ -2548,7 +3223,11 @@ void EventList::convertTof(const double factor, const double offset) {
   // Convert the list
   switch (eventType) {
   case TOF:
-    this->convertTofHelper(this->events, factor, offset);
+    if (m_columnar)
+      for (auto &tof : m_tofs)
+        tof = tof * factor + offset;
+    else
+      this->convertTofHelper(this->events, factor, offset);
     break;
   case WEIGHTED:
     this->convertTofHelper(this->weightedEvents, factor, offset);
@@ -2616,11 +3295,21 @@ void EventList::addPulsetimeHelper(std::vector<T> &events,
 void EventList::addPulsetime(const double seconds) {
   if (this->getNumberEvents() <= 0)
     return;
+  clearPulseIndex();
 
   // Convert the list
   switch (eventType) {
   case TOF:
-    this->addPulsetimeHelper(this->events, seconds);
+    if (m_columnar) {
+      const int64_t shift = DateAndTime::nanosecondsFromSeconds(seconds);
+      for (auto &pulseTime : m_pulseTimes) {
+        DateAndTime shifted(pulseTime);
+        shifted += shift;
+        pulseTime = shifted.totalNanoseconds();
+      }
+    } else {
+      this->addPulsetimeHelper(this->events, seconds);
+    }
     break;
   case WEIGHTED:
     this->addPulsetimeHelper(this->weightedEvents, seconds);
@@ -2689,6 +3378,7 @@ void EventList::maskTof(const double tofMin, const double tofMax) {
   // don't do anything with an emply list
   if (this->getNumberEvents() == 0)
     return;
+  clearPulseIndex();
 
   // Start by sorting by tof
   this->sortTof();
@@ -2698,8 +3388,22 @@ void EventList::maskTof(const double tofMin, const double tofMax) {
   size_t numDel = 0;
   switch (eventType) {
   case TOF:
-    numOrig = this->events.size();
-    numDel = this->maskTofHelper(this->events, tofMin, tofMax);
+    if (m_columnar) {
+      numOrig = m_tofs.size();
+      auto it_first = std::lower_bound(m_tofs.begin(), m_tofs.end(), tofMin);
+      if ((it_first != m_tofs.end()) && (*it_first < tofMax)) {
+        auto it_last = std::upper_bound(it_first, m_tofs.end(), tofMax);
+        const auto first = std::distance(m_tofs.begin(), it_first);
+        const auto last = std::distance(m_tofs.begin(), it_last);
+        m_tofs.erase(it_first, it_last);
+        m_pulseTimes.erase(m_pulseTimes.begin() + first,
+                           m_pulseTimes.begin() + last);
+        numDel = static_cast<size_t>(last - first);
+      }
+    } else {
+      numOrig = this->events.size();
+      numDel = this->maskTofHelper(this->events, tofMin, tofMax);
+    }
     break;
   case WEIGHTED:
     numOrig = this->weightedEvents.size();
@@ -2739,7 +3443,10 @@ void EventList::getTofs(std::vector<double> &tofs) const {
   // Convert the list
   switch (eventType) {
   case TOF:
-    this->getTofsHelper(this->events, tofs);
+    if (m_columnar)
+      tofs.assign(m_tofs.begin(), m_tofs.end());
+    else
+      this->getTofsHelper(this->events, tofs);
     break;
   case WEIGHTED:
     this->getTofsHelper(this->weightedEvents, tofs);
@@ -2882,7 +3589,11 @@ std::vector<Mantid::Kernel::DateAndTime> EventList::getPulseTimes() const {
   // Convert the list
   switch (eventType) {
   case TOF:
-    this->getPulseTimesHelper(this->events, times);
+    if (m_columnar)
+      for (const auto pulseTime : m_pulseTimes)
+        times.emplace_back(pulseTime);
+    else
+      this->getPulseTimesHelper(this->events, times);
     break;
   case WEIGHTED:
     this->getPulseTimesHelper(this->weightedEvents, times);
@@ -2906,6 +3617,11 @@ double EventList::getTofMin() const {
   if (this->empty())
     return tMin;
 
+  if (m_columnar)
+    return this->order == TOF_SORT
+               ? m_tofs.front()
+               : *std::min_element(m_tofs.begin(), m_tofs.end());
+
   // when events are ordered by tof just need the first value
   if (this->order == TOF_SORT) {
     switch (eventType) {
@@ -2952,6 +3668,11 @@ double EventList::getTofMax() const {
   if (this->empty())
     return tMax;
 
+  if (m_columnar)
+    return this->order == TOF_SORT
+               ? m_tofs.back()
+               : *std::max_element(m_tofs.begin(), m_tofs.end());
+
   // when events are ordered by tof just need the first value
   if (this->order == TOF_SORT) {
     switch (eventType) {
@@ -2997,6 +3718,11 @@ DateAndTime EventList::getPulseTimeMin() const {
   if (this->empty())
     return tMin;
 
+  if (m_columnar)
+    return this->order == PULSETIME_SORT
+               ? m_pulseTimes.front()
+               : *std::min_element(m_pulseTimes.begin(), m_pulseTimes.end());
+
   // when events are ordered by pulse time just need the first value
   if (this->order == PULSETIME_SORT) {
     switch (eventType) {
@@ -3041,6 +3767,11 @@ DateAndTime EventList::getPulseTimeMax() const {
   if (this->empty())
     return tMax;
 
+  if (m_columnar)
+    return this->order == PULSETIME_SORT
+               ? m_pulseTimes.back()
+               : *std::max_element(m_pulseTimes.begin(), m_pulseTimes.end());
+
   // when events are ordered by pulse time just need the first value
   if (this->order == PULSETIME_SORT) {
     switch (eventType) {
@@ -3083,13 +3814,15 @@ DateAndTime EventList::getTimeAtSampleMax(const double &tofFactor,
   if (this->empty())
     return tMax;
 
+  std::vector<TofEvent> rowBuffer;
+  const std::vector<TofEvent> &tofEvents = rowEvents(rowBuffer);
   // when events are ordered by time at sample just need the first value
   if (this->order == TIMEATSAMPLE_SORT) {
     switch (eventType) {
     case TOF:
       return calculateCorrectedFullTime(
-          this->events.rbegin()->pulseTime().totalNanoseconds(),
-          this->events.rbegin()->tof(), tofFactor, tofOffset);
+          tofEvents.rbegin()->pulseTime().totalNanoseconds(),
+          tofEvents.rbegin()->tof(), tofFactor, tofOffset);
     case WEIGHTED:
       return calculateCorrectedFullTime(
           this->weightedEvents.rbegin()->pulseTime().totalNanoseconds(),
@@ -3108,7 +3841,7 @@ DateAndTime EventList::getTimeAtSampleMax(const double &tofFactor,
     switch (eventType) {
     case TOF:
       temp = calculateCorrectedFullTime(
-          this->events[i].pulseTime().totalNanoseconds(), this->events[i].tof(),
+          tofEvents[i].pulseTime().totalNanoseconds(), tofEvents[i].tof(),
           tofFactor, tofOffset);
       break;
     case WEIGHTED:
@@ -3137,13 +3870,15 @@ DateAndTime EventList::getTimeAtSampleMin(const double &tofFactor,
   if (this->empty())
     return tMin;
 
+  std::vector<TofEvent> rowBuffer;
+  const std::vector<TofEvent> &tofEvents = rowEvents(rowBuffer);
   // when events are ordered by time at sample just need the first value
   if (this->order == TIMEATSAMPLE_SORT) {
     switch (eventType) {
     case TOF:
       return calculateCorrectedFullTime(
-          this->events.begin()->pulseTime().totalNanoseconds(),
-          this->events.begin()->tof(), tofFactor, tofOffset);
+          tofEvents.begin()->pulseTime().totalNanoseconds(),
+          tofEvents.begin()->tof(), tofFactor, tofOffset);
     case WEIGHTED:
       return calculateCorrectedFullTime(
           this->weightedEvents.begin()->pulseTime().totalNanoseconds(),
@@ -3162,7 +3897,7 @@ DateAndTime EventList::getTimeAtSampleMin(const double &tofFactor,
     switch (eventType) {
     case TOF:
       temp = calculateCorrectedFullTime(
-          this->events[i].pulseTime().totalNanoseconds(), this->events[i].tof(),
+          tofEvents[i].pulseTime().totalNanoseconds(), tofEvents[i].tof(),
           tofFactor, tofOffset);
       break;
     case WEIGHTED:
@@ -3195,9 +3930,6 @@ void EventList::setTofsHelper(std::vector<T> &events,
     return;
 
   size_t x_size = tofs.size();
-  if (events.size() != x_size)
-    return; // should this throw an exception?
-
   for (size_t i = 0; i < x_size; ++i)
     events[i].m_tof = tofs[i];
 }
@@ -3207,14 +3939,23 @@ void EventList::setTofsHelper(std::vector<T> &events,
  * Set a list of TOFs to the current event list. Modify the units if necessary.
  *
  * @param tofs :: The vector of doubles to set the tofs to.
+ * @throw std::invalid_argument if tofs is not empty and its size does not
+ * match the number of events
  */
 void EventList::setTofs(const MantidVec &tofs) {
+  if (!tofs.empty() && tofs.size() != this->getNumberEvents())
+    throw std::invalid_argument("EventList::setTofs: the number of TOFs does "
+                                "not match the number of events.");
   this->order = UNSORTED;
+  clearPulseIndex();
 
   // Convert the list
   switch (eventType) {
   case TOF:
-    this->setTofsHelper(this->events, tofs);
+    if (!m_columnar)
+      this->setTofsHelper(this->events, tofs);
+    else if (!tofs.empty())
+      m_tofs.assign(tofs.begin(), tofs.end());
     break;
   case WEIGHTED:
     this->setTofsHelper(this->weightedEvents, tofs);
@@ -3637,33 +4378,148 @@ void EventList::divide(const double value, const double error) {
 // ==============================================================================================
 // ----------- SPLITTING AND FILTERING ---------------------------------------
 // ==============================================================================================
-/** Filter a vector of events into another based on pulse time.
- * TODO: Make this more efficient using STL-fu.
- * @param events :: input events
+/** Sort the events by pulse time and index the pulses, so that the events of
+ * a range of pulse times can be found with a binary search over the pulses
+ * instead of over the events.
+ *
+ * The index holds the offset of the first event of every pulse, so it is only
+ * kept if there are, on average, several events per pulse; otherwise the
+ * binary search is done over the events themselves. The index is used by
+ * filterByPulseTime() and filterByTimeAtSample() for as long as the list
+ * stays sorted by pulse time and its pulse times are not changed.
+ */
+void EventList::buildPulseIndex() const {
+  if (eventType == WEIGHTED_NOTIME)
+    throw std::runtime_error("EventList::buildPulseIndex() called on an "
+                             "EventList that no longer has time information.");
+  if (order != PULSETIME_SORT && order != PULSETIMETOF_SORT)
+    this->sortPulseTime();
+
+  // Avoid indexing from multiple threads
+  std::lock_guard<std::mutex> _lock(m_sortMutex);
+  if (pulseIndexIsCurrent())
+    return;
+
+  // Index lists with at least this many events per pulse
+  const size_t minEventsPerPulse = 4;
+  const size_t numEvents = this->getNumberEvents();
+  const size_t maxPulses = numEvents / minEventsPerPulse;
+  std::vector<int64_t> pulseTimes;
+  std::vector<size_t> offsets;
+  for (size_t i = 0; i < numEvents; ++i) {
+    const int64_t pulseTime = pulseTimeOfEvent(i);
+    if (pulseTimes.empty() || pulseTime != pulseTimes.back()) {
+      if (pulseTimes.size() == maxPulses) {
+        // Too sparse: remember that, but search the events directly
+        pulseTimes.clear();
+        offsets.clear();
+        break;
+      }
+      pulseTimes.push_back(pulseTime);
+      offsets.push_back(i);
+    }
+  }
+  offsets.push_back(numEvents);
+  pulseTimes.shrink_to_fit();
+  offsets.shrink_to_fit();
+  m_indexPulseTimes.swap(pulseTimes);
+  m_indexOffsets.swap(offsets);
+}
+
+/** Return true if the list has an up-to-date pulse index.
+ * @see buildPulseIndex()
+ */
+bool EventList::hasPulseIndex() const {
+  std::lock_guard<std::mutex> _lock(m_sortMutex);
+  return !m_indexPulseTimes.empty() && pulseIndexIsCurrent();
+}
+
+/** Release the memory of the pulse index. Every method that reorders the
+ * events or changes their number or pulse times calls this, except
+ * addEventQuickly(): a list it was used on is unsorted, so the index is
+ * dropped when the list is sorted by pulse time again.
+ */
+void EventList::clearPulseIndex() const {
+  if (m_indexOffsets.empty())
+    return;
+  std::vector<int64_t>().swap(m_indexPulseTimes);
+  std::vector<size_t>().swap(m_indexOffsets);
+}
+
+/** Return true if buildPulseIndex() was called since the events were last
+ * changed, even if no index was kept because the list is too sparse. Must be
+ * called with m_sortMutex locked.
+ */
+bool EventList::pulseIndexIsCurrent() const {
+  return !m_indexOffsets.empty() && eventType != WEIGHTED_NOTIME &&
+         (order == PULSETIME_SORT || order == PULSETIMETOF_SORT);
+}
+
+/// Return the pulse time (in nanoseconds) of the i-th event of a list with
+/// pulse times.
+int64_t EventList::pulseTimeOfEvent(const size_t i) const {
+  if (eventType == WEIGHTED)
+    return weightedEvents[i].pulseTime().totalNanoseconds();
+  if (m_columnar)
+    return m_pulseTimes[i];
+  return events[i].pulseTime().totalNanoseconds();
+}
+
+/** Returns the offset of the first event with a pulse time >= pulseTime in
+ * events sorted by pulse time. Uses the pulse index if the list has one and
+ * a binary search over the events otherwise.
+ * @param events :: events sorted by pulse time
+ * @param pulseTime :: pulse time to find (in nanoseconds)
+ * @return offset of the first matching event, or events.size() if there is
+ * none.
+ */
+template <class T>
+size_t EventList::findPulseOffset(const std::vector<T> &events,
+                                  const int64_t pulseTime) const {
+  {
+    // buildPulseIndex() may be swapping the index in from another thread
+    std::lock_guard<std::mutex> _lock(m_sortMutex);
+    if (!m_indexPulseTimes.empty()) {
+      auto it = std::lower_bound(m_indexPulseTimes.cbegin(),
+                                 m_indexPulseTimes.cend(), pulseTime);
+      return m_indexOffsets[static_cast<size_t>(
+          std::distance(m_indexPulseTimes.cbegin(), it))];
+    }
+  }
+  auto it = std::lower_bound(events.cbegin(), events.cend(), pulseTime,
+                             [](const T &event, const int64_t time) {
+                               return event.pulseTime().totalNanoseconds() <
+                                      time;
+                             });
+  return static_cast<size_t>(std::distance(events.cbegin(), it));
+}
+
+/** Filter a vector of events sorted by pulse time into another based on pulse
+ * time.
+ * @param events :: input events, sorted by pulse time
  * @param start :: start time (absolute)
  * @param stop :: end time (absolute)
  * @param output :: reference to an event list that will be output.
  */
 template <class T>
-void EventList::filterByPulseTimeHelper(std::vector<T> &events,
+void EventList::filterByPulseTimeHelper(const std::vector<T> &events,
                                         DateAndTime start, DateAndTime stop,
-                                        std::vector<T> &output) {
-  auto itev = events.begin();
-  auto itev_end = events.end();
-  // Find the first event with m_pulsetime >= start
-  while ((itev != itev_end) && (itev->m_pulsetime < start))
-    itev++;
-
-  while ((itev != itev_end) && (itev->m_pulsetime < stop)) {
-    // Add the copy to the output
-    output.push_back(*itev);
-    ++itev;
-  }
+                                        std::vector<T> &output) const {
+  const size_t first = findPulseOffset(events, start.totalNanoseconds());
+  const size_t last =
+      std::max(first, findPulseOffset(events, stop.totalNanoseconds()));
+  output.assign(events.begin() + first, events.begin() + last);
 }
 
-/** Filter a vector of events into another based on time at sample.
- * TODO: Make this more efficient using STL-fu.
- * @param events :: input events
+/** Filter a vector of events sorted by pulse time into another based on time
+ * at sample.
+ *
+ * As the TOF correction of every event lies between the corrections of the
+ * shortest and of the longest TOF, only the events of the pulses within the
+ * range of the correction from start or stop need to be checked; the events
+ * of the pulses in between are copied as a block.
+ *
+ * @param events :: input events, sorted by pulse time
  * @param start :: start time (absolute)
  * @param stop :: end time (absolute)
  * @param tofFactor :: scaling factor for tof
@@ -3671,27 +4527,52 @@ void EventList::filterByPulseTimeHelper(std::vector<T> &events,
  * @param output :: reference to an event list that will be output.
  */
 template <class T>
-void EventList::filterByTimeAtSampleHelper(std::vector<T> &events,
+void EventList::filterByTimeAtSampleHelper(const std::vector<T> &events,
                                            DateAndTime start, DateAndTime stop,
                                            double tofFactor, double tofOffset,
-                                           std::vector<T> &output) {
-  auto itev = events.begin();
-  auto itev_end = events.end();
-  // Find the first event with m_pulsetime >= start
-  while ((itev != itev_end) &&
-         (calculateCorrectedFullTime(itev->m_pulsetime.totalNanoseconds(),
-                                     itev->tof(), tofFactor,
-                                     tofOffset) < start.totalNanoseconds()))
-    itev++;
-
-  while ((itev != itev_end) &&
-         (calculateCorrectedFullTime(itev->m_pulsetime.totalNanoseconds(),
-                                     itev->tof(), tofFactor,
-                                     tofOffset) < stop.totalNanoseconds())) {
-    // Add the copy to the output
-    output.push_back(*itev);
-    ++itev;
-  }
+                                           std::vector<T> &output) const {
+  output.clear();
+  if (events.empty())
+    return;
+  const int64_t startTime = start.totalNanoseconds();
+  const int64_t stopTime = stop.totalNanoseconds();
+
+  // Range of the corrections of the TOF's of the list
+  const int64_t correctionOfTofMin =
+      calculateCorrectedFullTime(0, getTofMin(), tofFactor, tofOffset);
+  const int64_t correctionOfTofMax =
+      calculateCorrectedFullTime(0, getTofMax(), tofFactor, tofOffset);
+  const int64_t minCorrection =
+      std::min(correctionOfTofMin, correctionOfTofMax);
+  const int64_t maxCorrection =
+      std::max(correctionOfTofMin, correctionOfTofMax);
+
+  // Events in [first, last) may be in the time range, the ones in
+  // [sureFirst, sureLast) are in it.
+  const size_t first = findPulseOffset(events, startTime - maxCorrection);
+  const size_t last =
+      std::max(first, findPulseOffset(events, stopTime - minCorrection));
+  const size_t sureFirst = std::min(
+      last,
+      std::max(first, findPulseOffset(events, startTime - minCorrection)));
+  const size_t sureLast = std::min(
+      last,
+      std::max(sureFirst, findPulseOffset(events, stopTime - maxCorrection)));
+
+  auto copyIfInRange = [&](const size_t from, const size_t to) {
+    for (size_t i = from; i < to; ++i) {
+      const int64_t time =
+          calculateCorrectedFullTime(events[i].m_pulsetime.totalNanoseconds(),
+                                     events[i].tof(), tofFactor, tofOffset);
+      if (time >= startTime && time < stopTime)
+        output.push_back(events[i]);
+    }
+  };
+  output.reserve(sureLast - sureFirst);
+  copyIfInRange(first, sureFirst);
+  output.insert(output.end(), events.begin() + sureFirst,
+                events.begin() + sureLast);
+  copyIfInRange(sureLast, last);
 }
 
 //------------------------------------------------------------------------------------------------
@@ -3710,30 +4591,37 @@ void EventList::filterByPulseTime(DateAndTime start, DateAndTime stop,
     throw std::invalid_argument("In-place filtering is not allowed");
   }
 
-  // Start by sorting the event list by pulse time.
-  this->sortPulseTime();
+  if (eventType == WEIGHTED_NOTIME)
+    throw std::runtime_error("EventList::filterByPulseTime() called on an "
+                             "EventList that no longer has time information.");
+
+  // Start by sorting the event list by pulse time and indexing the pulses.
+  this->buildPulseIndex();
   // Clear the output
   output.clear();
+  output.toRowStorage();
   // Has to match the given type
   output.switchTo(eventType);
   // Copy the detector IDs
   output.detectorIDs = this->detectorIDs;
   output.refX = this->refX;
 
-  // Iterate through all events (sorted by pulse time)
+  std::vector<TofEvent> rowBuffer;
+  const std::vector<TofEvent> &tofEvents = rowEvents(rowBuffer);
+  // Copy the events of the pulses in the range (sorted by pulse time)
   switch (eventType) {
   case TOF:
-    filterByPulseTimeHelper(this->events, start, stop, output.events);
+    filterByPulseTimeHelper(tofEvents, start, stop, output.events);
     break;
   case WEIGHTED:
     filterByPulseTimeHelper(this->weightedEvents, start, stop,
                             output.weightedEvents);
     break;
   case WEIGHTED_NOTIME:
-    throw std::runtime_error("EventList::filterByPulseTime() called on an "
-                             "EventList that no longer has time information.");
     break;
   }
+  // A range of the sorted events is still sorted
+  output.order = this->order;
 }
 
 void EventList::filterByTimeAtSample(Kernel::DateAndTime start,
@@ -3744,20 +4632,28 @@ void EventList::filterByTimeAtSample(Kernel::DateAndTime start,
     throw std::invalid_argument("In-place filtering is not allowed");
   }
 
-  // Start by sorting
-  this->sortTimeAtSample(tofFactor, tofOffset);
+  if (eventType == WEIGHTED_NOTIME)
+    throw std::runtime_error("EventList::filterByTimeAtSample() called on an "
+                             "EventList that no longer has full time "
+                             "information.");
+
+  // Start by sorting the event list by pulse time and indexing the pulses.
+  this->buildPulseIndex();
   // Clear the output
   output.clear();
+  output.toRowStorage();
   // Has to match the given type
   output.switchTo(eventType);
   // Copy the detector IDs
   output.detectorIDs = this->detectorIDs;
   output.refX = this->refX;
 
+  std::vector<TofEvent> rowBuffer;
+  const std::vector<TofEvent> &tofEvents = rowEvents(rowBuffer);
   // Iterate through all events (sorted by pulse time)
   switch (eventType) {
   case TOF:
-    filterByTimeAtSampleHelper(this->events, start, stop, tofFactor, tofOffset,
+    filterByTimeAtSampleHelper(tofEvents, start, stop, tofFactor, tofOffset,
                                output.events);
     break;
   case WEIGHTED:
@@ -3765,11 +4661,11 @@ void EventList::filterByTimeAtSample(Kernel::DateAndTime start,
                                tofOffset, output.weightedEvents);
     break;
   case WEIGHTED_NOTIME:
-    throw std::runtime_error("EventList::filterByTimeAtSample() called on an "
-                             "EventList that no longer has full time "
-                             "information.");
     break;
   }
+  // The events are copied in pulse time order; return them sorted by time at
+  // sample, the order the filter used to leave them in
+  output.sortTimeAtSample(tofFactor, tofOffset, true);
 }
 
 //------------------------------------------------------------------------------------------------
@@ -3855,6 +4751,8 @@ void EventList::filterInPlaceHelper(Kernel::TimeSplitterType &splitter,
  *     that will be kept. Any other events will be deleted.
  */
 void EventList::filterInPlace(Kernel::TimeSplitterType &splitter) {
+  toRowStorage();
+  clearPulseIndex();
   // Start by sorting the event list by pulse time.
   this->sortPulseTime();
 
@@ -3888,7 +4786,7 @@ void EventList::filterInPlace(Kernel::TimeSplitterType &splitter) {
 template <class T>
 void EventList::splitByTimeHelper(Kernel::TimeSplitterType &splitter,
                                   std::vector<EventList *> outputs,
-                                  typename std::vector<T> &events) const {
+                                  const std::vector<T> &events) const {
   size_t numOutputs = outputs.size();
 
   // Iterate through the splitter at the same time
@@ -3967,9 +4865,11 @@ void EventList::splitByTime(Kernel::TimeSplitterType &splitter,
   if (splitter.empty())
     return;
 
+  std::vector<TofEvent> rowBuffer;
+  const std::vector<TofEvent> &tofEvents = rowEvents(rowBuffer);
   switch (eventType) {
   case TOF:
-    splitByTimeHelper(splitter, outputs, this->events);
+    splitByTimeHelper(splitter, outputs, tofEvents);
     break;
   case WEIGHTED:
     splitByTimeHelper(splitter, outputs, this->weightedEvents);
@@ -3998,7 +4898,7 @@ void EventList::splitByTime(Kernel::TimeSplitterType &splitter,
 template <class T>
 void EventList::splitByFullTimeHelper(Kernel::TimeSplitterType &splitter,
                                       std::map<int, EventList *> outputs,
-                                      typename std::vector<T> &events,
+                                      const std::vector<T> &events,
                                       bool docorrection, double toffactor,
                                       double tofshift) const {
   // 1. Prepare to Iterate through the splitter at the same time
@@ -4108,6 +5008,8 @@ void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter,
     opeventlist->switchTo(eventType);
   }
 
+  std::vector<TofEvent> rowBuffer;
+  const std::vector<TofEvent> &tofEvents = rowEvents(rowBuffer);
   // Do nothing if there are no entries
   if (splitter.empty()) {
     // 3A. Copy all events to group workspace = -1
@@ -4117,7 +5019,7 @@ void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter,
     // 3B. Split
     switch (eventType) {
     case TOF:
-      splitByFullTimeHelper(splitter, outputs, this->events, docorrection,
+      splitByFullTimeHelper(splitter, outputs, tofEvents, docorrection,
                             toffactor, tofshift);
       break;
     case WEIGHTED:
@@ -4155,11 +5057,11 @@ void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter,
 template <class T>
 std::string EventList::splitByFullTimeVectorSplitterHelper(
     const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
-    std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
+    std::map<int, EventList *> outputs, const std::vector<T> &vecEvents,
     bool docorrection, double toffactor, double tofshift) const {
   // Define variables for events
   // size_t numevents = events.size();
-  typename std::vector<T>::iterator eviter;
+  typename std::vector<T>::const_iterator eviter;
   std::stringstream msgss;
 
   // Loop through events
@@ -4240,6 +5142,8 @@ std::string EventList::splitByFullTimeMatrixSplitter(
 
   std::string debugmessage("");
 
+  std::vector<TofEvent> rowBuffer;
+  const std::vector<TofEvent> &tofEvents = rowEvents(rowBuffer);
   // Do nothing if there are no entries
   if (vecgroups.empty()) {
     // Copy all events to group workspace = -1
@@ -4250,7 +5154,7 @@ std::string EventList::splitByFullTimeMatrixSplitter(
     switch (eventType) {
     case TOF:
       debugmessage = splitByFullTimeVectorSplitterHelper(
-          vectimes, vecgroups, vec_outputEventList, this->events, docorrection,
+          vectimes, vecgroups, vec_outputEventList, tofEvents, docorrection,
           toffactor, tofshift);
       break;
     case WEIGHTED:
@@ -4274,7 +5178,7 @@ std::string EventList::splitByFullTimeMatrixSplitter(
 template <class T>
 void EventList::splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter,
                                        std::map<int, EventList *> outputs,
-                                       typename std::vector<T> &events) const {
+                                       const std::vector<T> &events) const {
   // Prepare to TimeSplitter Iterate through the splitter at the same time
   auto itspl = splitter.begin();
   auto itspl_end = splitter.end();
@@ -4360,6 +5264,8 @@ void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter,
     opeventlist->switchTo(eventType);
   }
 
+  std::vector<TofEvent> rowBuffer;
+  const std::vector<TofEvent> &tofEvents = rowEvents(rowBuffer);
   // Split
   if (splitter.empty()) {
     // No splitter: copy all events to group workspace = -1
@@ -4368,7 +5274,7 @@ void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter,
     // Split
     switch (eventType) {
     case TOF:
-      splitByPulseTimeHelper(splitter, outputs, this->events);
+      splitByPulseTimeHelper(splitter, outputs, tofEvents);
       break;
     case WEIGHTED:
       splitByPulseTimeHelper(splitter, outputs, this->weightedEvents);
@@ -4381,6 +5287,123 @@ void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter,
   return;
 }
 
+//----------------------------------------------------------------------------------------------
+/** Split a vector of either TofEvent's or WeightedEvent's, sorted by pulse
+ * time, in one sweep. The destinations of all events are found first, so that
+ * the outputs can be allocated at their final sizes.
+ *
+ * @param index :: the splitting intervals and their destinations
+ * @param outputs :: the output event lists, by destination
+ * @param events :: either this->events or this->weightedEvents.
+ * @param pulseTimeOnly :: split by the pulse time instead of the full time
+ * @param toffactor :: factor to correct TOF in formula toffactor*tof+tofshift
+ * @param tofshift :: amount to shift (in SECOND) to correct TOF
+ * @return the number of events without a destination
+ */
+template <class T>
+size_t EventList::splitByTimeIndexHelper(
+    const Kernel::TimeSplitterIndex &index,
+    const std::vector<EventList *> &outputs, const std::vector<T> &events,
+    bool pulseTimeOnly, double toffactor, double tofshift) const {
+  // 1. Find the destination of every event
+  std::vector<int> destinations(events.size());
+  std::vector<size_t> counts(outputs.size(), 0);
+  size_t numDropped = 0;
+  size_t interval = 0;
+  for (size_t i = 0; i < events.size(); ++i) {
+    const auto &event = events[i];
+    const int64_t time =
+        pulseTimeOnly
+            ? event.m_pulsetime.totalNanoseconds()
+            : calculateCorrectedFullTime(event.m_pulsetime.totalNanoseconds(),
+                                         event.m_tof, toffactor, tofshift);
+    int destination = index.destination(time, interval);
+    if (destination < 0 || static_cast<size_t>(destination) >= outputs.size() ||
+        !outputs[destination])
+      destination = Kernel::TimeSplitterIndex::NO_DESTINATION;
+    destinations[i] = destination;
+    if (destination == Kernel::TimeSplitterIndex::NO_DESTINATION)
+      ++numDropped;
+    else
+      ++counts[destination];
+  }
+
+  // 2. Copy the events into outputs of the right size
+  std::vector<std::vector<T> *> outputEvents(outputs.size(), nullptr);
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    if (outputs[i] && counts[i] > 0) {
+      getEventsFrom(*outputs[i], outputEvents[i]);
+      outputEvents[i]->reserve(counts[i]);
+    }
+  }
+  for (size_t i = 0; i < events.size(); ++i) {
+    if (destinations[i] != Kernel::TimeSplitterIndex::NO_DESTINATION)
+      outputEvents[destinations[i]]->push_back(events[i]);
+  }
+  return numDropped;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Split the event list into n outputs, by the full time (pulse time plus
+ * corrected TOF) or the pulse time of each event, looking up the destination
+ * of each event in a TimeSplitterIndex. The events of each output stay sorted
+ * by pulse time.
+ *
+ * @param index :: the splitting intervals and their destinations
+ * @param outputs :: the output event lists, by destination. Destinations
+ * without an output (NULL) drop their events.
+ * @param pulseTimeOnly :: split by the pulse time instead of the full time
+ * @param toffactor :: factor to correct TOF in formula toffactor*tof+tofshift
+ * @param tofshift :: amount to shift (in SECOND) to correct TOF in formula:
+ *toffactor*tof+tofshift
+ * @return the number of events that were dropped
+ */
+size_t EventList::splitByTimeIndex(const Kernel::TimeSplitterIndex &index,
+                                   const std::vector<EventList *> &outputs,
+                                   bool pulseTimeOnly, double toffactor,
+                                   double tofshift) const {
+  if (eventType == WEIGHTED_NOTIME)
+    throw std::runtime_error("EventList::splitByTimeIndex() called on an "
+                             "EventList that no longer has time information.");
+
+  // Sorted events keep the lookups of their destinations local
+  this->sortPulseTimeTOF();
+
+  // Initialize all the outputs
+  for (auto opeventlist : outputs) {
+    if (!opeventlist)
+      continue;
+    opeventlist->clear();
+    opeventlist->detectorIDs = this->detectorIDs;
+    opeventlist->refX = this->refX;
+    // Match the output event type.
+    opeventlist->switchTo(eventType);
+  }
+
+  size_t numDropped = 0;
+  std::vector<TofEvent> rowBuffer;
+  const std::vector<TofEvent> &tofEvents = rowEvents(rowBuffer);
+  switch (eventType) {
+  case TOF:
+    numDropped = splitByTimeIndexHelper(index, outputs, tofEvents,
+                                        pulseTimeOnly, toffactor, tofshift);
+    break;
+  case WEIGHTED:
+    numDropped = splitByTimeIndexHelper(index, outputs, this->weightedEvents,
+                                        pulseTimeOnly, toffactor, tofshift);
+    break;
+  case WEIGHTED_NOTIME:
+    break;
+  }
+
+  // Subsets of the sorted events are sorted too
+  for (auto opeventlist : outputs)
+    if (opeventlist)
+      opeventlist->setSortOrder(PULSETIMETOF_SORT);
+
+  return numDropped;
+}
+
 //--------------------------------------------------------------------------
 /** Get the vector of events contained in an EventList;
  * this is overloaded by event type.
@@ -4446,13 +5469,18 @@ template <class T>
 void EventList::convertUnitsViaTofHelper(typename std::vector<T> &events,
                                          Mantid::Kernel::Unit *fromUnit,
                                          Mantid::Kernel::Unit *toUnit) {
-  auto itev = events.begin();
-  auto itev_end = events.end();
-  for (; itev != itev_end; itev++) {
-    // Conver to TOF
-    double tof = fromUnit->singleToTOF(itev->m_tof);
-    // And back from TOF to whatever
-    itev->m_tof = toUnit->singleFromTOF(tof);
+  // Convert blocks of values, that fit in the cache, with one call each
+  const size_t blockSize = 1024;
+  double tofs[blockSize];
+  for (size_t start = 0; start < events.size(); start += blockSize) {
+    const size_t num = std::min(blockSize, events.size() - start);
+    for (size_t i = 0; i < num; ++i)
+      tofs[i] = events[start + i].m_tof;
+    // Convert to TOF, and back from TOF to whatever
+    fromUnit->rangeToTOF(tofs, tofs + num);
+    toUnit->rangeFromTOF(tofs, tofs + num);
+    for (size_t i = 0; i < num; ++i)
+      events[start + i].m_tof = tofs[i];
   }
 }
 
@@ -4479,7 +5507,11 @@ void EventList::convertUnitsViaTof(Mantid::Kernel::Unit *fromUnit,
 
   switch (eventType) {
   case TOF:
-    convertUnitsViaTofHelper(this->events, fromUnit, toUnit);
+    if (m_columnar) {
+      fromUnit->rangeToTOF(m_tofs.data(), m_tofs.data() + m_tofs.size());
+      toUnit->rangeFromTOF(m_tofs.data(), m_tofs.data() + m_tofs.size());
+    } else
+      convertUnitsViaTofHelper(this->events, fromUnit, toUnit);
     break;
   case WEIGHTED:
     convertUnitsViaTofHelper(this->weightedEvents, fromUnit, toUnit);
@@ -4516,7 +5548,11 @@ void EventList::convertUnitsQuicklyHelper(typename std::vector<T> &events,
 void EventList::convertUnitsQuickly(const double &factor, const double &power) {
   switch (eventType) {
   case TOF:
-    convertUnitsQuicklyHelper(this->events, factor, power);
+    if (m_columnar)
+      for (auto &tof : m_tofs)
+        tof = factor * std::pow(tof, power);
+    else
+      convertUnitsQuicklyHelper(this->events, factor, power);
     break;
   case WEIGHTED:
     convertUnitsQuicklyHelper(this->weightedEvents, factor, power);
@@ -4,6 +4,7 @@
 #include "MantidAPI/WorkspaceProperty.h"
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/LazyEventCache.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/IDetector.h"
 #include "MantidKernel/Exception.h"
@@ -12,6 +13,8 @@
 #include "MantidKernel/FunctionTask.h"
 #include "MantidKernel/ThreadPool.h"
 #include "MantidKernel/DateAndTime.h"
+#include "MantidKernel/make_unique.h"
+#include <boost/make_shared.hpp>
 #include <limits>
 #include <numeric>
 #include "MantidAPI/ISpectrum.h"
@@ -127,11 +130,9 @@ void EventWorkspace::copyDataFrom(const EventWorkspace &source,
   this->clearData(); // properly de-allocates memory!
 
   // Copy the vector of EventLists
-  EventListVector source_data = source.data;
-  EventListVector::iterator it;
-  auto it_start = source_data.begin();
-  auto it_end = source_data.end();
-  size_t source_data_size = source_data.size();
+  size_t index_start = 0;
+  size_t source_data_size = source.data.size();
+  size_t index_end = source_data_size;
 
   // Do we copy only a range?
   if (sourceEndWorkspaceIndex == size_t(-1))
@@ -139,13 +140,14 @@ void EventWorkspace::copyDataFrom(const EventWorkspace &source,
   if ((sourceStartWorkspaceIndex < source_data_size) &&
       (sourceEndWorkspaceIndex < source_data_size) &&
       (sourceEndWorkspaceIndex >= sourceStartWorkspaceIndex)) {
-    it_start += sourceStartWorkspaceIndex;
-    it_end = source_data.begin() + sourceEndWorkspaceIndex + 1;
+    index_start = sourceStartWorkspaceIndex;
+    index_end = sourceEndWorkspaceIndex + 1;
   }
 
-  for (it = it_start; it != it_end; ++it) {
-    // Create a new event list, copying over the events
-    auto newel = new EventList(**it);
+  for (size_t i = index_start; i < index_end; ++i) {
+    // Create a new event list, copying over the events. Events of a lazily
+    // loaded source are read here, the copy holds all of them in memory.
+    auto newel = new EventList(source.getSpectrum(i));
     // Make sure to update the MRU to point to THIS event workspace.
     newel->setMRU(this->mru);
     this->data.push_back(newel);
@@ -187,8 +189,12 @@ size_t EventWorkspace::getNumberHistograms() const { return this->data.size(); }
 /// Return const reference to EventList at the given workspace index.
 EventList &EventWorkspace::getSpectrum(const size_t index) {
   invalidateCommonBinsFlag();
-  return const_cast<EventList &>(
-      static_cast<const EventWorkspace &>(*this).getSpectrum(index));
+  if (index >= m_noVectors)
+    throw std::range_error(
+        "EventWorkspace::getSpectrum, workspace index out of range");
+  if (m_lazyCache)
+    m_lazyCache->access(index, true, data);
+  return *data[index];
 }
 
 /// Return const reference to EventList at the given workspace index.
@@ -196,6 +202,8 @@ const EventList &EventWorkspace::getSpectrum(const size_t index) const {
   if (index >= m_noVectors)
     throw std::range_error(
         "EventWorkspace::getSpectrum, workspace index out of range");
+  if (m_lazyCache)
+    m_lazyCache->access(index, false, data);
   return *data[index];
 }
 
@@ -374,10 +382,10 @@ void EventWorkspace::getEventXMinMax(double &xmin, double &xmax) const {
 /// The total number of events across all of the spectra.
 /// @returns The total number of events
 size_t EventWorkspace::getNumberEvents() const {
-  return std::accumulate(data.begin(), data.end(), size_t{0},
-                         [](size_t total, EventList *list) {
-                           return total + list->getNumberEvents();
-                         });
+  size_t total = 0;
+  for (size_t i = 0; i < data.size(); ++i)
+    total += getSpectrum(i).getNumberEvents();
+  return total;
 }
 
 //-----------------------------------------------------------------------------
@@ -387,8 +395,8 @@ size_t EventWorkspace::getNumberEvents() const {
  */
 Mantid::API::EventType EventWorkspace::getEventType() const {
   Mantid::API::EventType out = Mantid::API::TOF;
-  for (auto list : this->data) {
-    Mantid::API::EventType thisType = list->getEventType();
+  for (size_t i = 0; i < this->data.size(); ++i) {
+    Mantid::API::EventType thisType = getSpectrum(i).getEventType();
     if (static_cast<int>(out) < static_cast<int>(thisType)) {
       out = thisType;
       // This is the most-specialized it can get.
@@ -405,12 +413,30 @@ Mantid::API::EventType EventWorkspace::getEventType() const {
  * @param type :: EventType to switch to
  */
 void EventWorkspace::switchEventType(const Mantid::API::EventType type) {
-  for (EventListVector::const_iterator it = this->data.begin();
-       it != this->data.end(); ++it) {
-    (*it)->switchTo(type);
+  for (size_t i = 0; i < this->data.size(); ++i) {
+    getSpectrum(i).switchTo(type);
   }
 }
 
+//-----------------------------------------------------------------------------
+/** Select the storage layout of the TofEvent's in all event lists: a vector of
+ * TofEvent (the default) or separate TOF and pulse time columns.
+ * Lists added to the workspace later on use the default layout.
+ *
+ * @param columnar :: true to use columnar storage
+ * @see EventList::setColumnarStorage()
+ */
+void EventWorkspace::setColumnarStorage(const bool columnar) {
+  // Parts of a lazily loaded workspace that are read later use it as well
+  if (m_lazyCache) {
+    m_lazyCache->setColumnarStorage(columnar, data);
+    return;
+  }
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < static_cast<int64_t>(this->data.size()); ++i)
+    this->data[i]->setColumnarStorage(columnar);
+}
+
 //-----------------------------------------------------------------------------
 /// Returns true always - an EventWorkspace always represents histogramm-able
 /// data
@@ -418,8 +444,8 @@ void EventWorkspace::switchEventType(const Mantid::API::EventType type) {
 bool EventWorkspace::isHistogramData() const { return true; }
 
 //-----------------------------------------------------------------------------
-/** Return how many entries in the Y MRU list are used.
- * Only used in tests. It only returns the 0-th MRU list size.
+/** Return how many histograms are cached in the MRU.
+ * Only used in tests.
  * @return :: number of entries in the MRU list.
  */
 size_t EventWorkspace::MRUSize() const { return mru->MRUSize(); }
@@ -428,11 +454,21 @@ size_t EventWorkspace::MRUSize() const { return mru->MRUSize(); }
 /** Clears the MRU lists */
 void EventWorkspace::clearMRU() const { mru->clear(); }
 
+//-----------------------------------------------------------------------------
+/** Set the memory limit of the histograms cached in the MRU. The default is
+ * set by the EventWorkspace.MRUMemoryMB setting.
+ * @param memoryLimit :: memory limit in bytes.
+ */
+void EventWorkspace::setMRUMemoryLimit(const std::size_t memoryLimit) {
+  mru->setMemoryLimit(memoryLimit);
+}
+
 //-----------------------------------------------------------------------------
 /** Clear the data[] vector and delete
  * any EventList objects in it
  */
 void EventWorkspace::clearData() {
+  m_lazyCache.reset();
   m_noVectors = data.size();
   for (size_t i = 0; i < m_noVectors; i++) {
     delete data[i];
@@ -491,8 +527,9 @@ EventWorkspace::getOrAddEventList(const std::size_t workspace_index) {
   if (!result)
     throw std::runtime_error(
         "EventWorkspace::getOrAddEventList: NULL EventList found.");
-  else
-    return *result;
+  if (m_lazyCache)
+    m_lazyCache->access(workspace_index, true, data);
+  return *result;
 }
 
 /** Resizes the workspace to contain the number of spectra/events lists given.
@@ -560,6 +597,9 @@ void EventWorkspace::padSpectra(const std::vector<int32_t> &specList) {
 }
 
 void EventWorkspace::deleteEmptyLists() {
+  // Indices change, so all events need to be in memory
+  loadAllEvents();
+
   // figure out how much data to copy
   size_t orig_length = this->data.size();
   size_t new_length = 0;
@@ -677,7 +717,18 @@ void EventWorkspace::generateHistogram(const std::size_t index,
   if (index >= this->m_noVectors)
     throw std::range_error(
         "EventWorkspace::generateHistogram, histogram number out of range");
-  this->data[index]->generateHistogram(X, Y, E, skipError);
+  const EventList &spectrum = getSpectrum(index);
+
+  // The histogram for the bin edges of the spectrum is the one cached for
+  // dataY(). Histograms for other bin edges are not cached, as nothing drops
+  // them when the events are changed.
+  if (X == spectrum.readX()) {
+    Y = spectrum.readY();
+    if (!skipError)
+      E = spectrum.readE();
+    return;
+  }
+  spectrum.generateHistogram(X, Y, E, skipError);
 }
 
 //---------------------------------------------------------------------------
@@ -698,7 +749,7 @@ void EventWorkspace::generateHistogramPulseTime(const std::size_t index,
   if (index >= this->m_noVectors)
     throw std::range_error("EventWorkspace::generateHistogramPulseTime, "
                            "histogram number out of range");
-  this->data[index]->generateHistogramPulseTime(X, Y, E, skipError);
+  getSpectrum(index).generateHistogramPulseTime(X, Y, E, skipError);
 }
 
 //-----------------------------------------------------------------------------
@@ -706,10 +757,14 @@ void EventWorkspace::generateHistogramPulseTime(const std::size_t index,
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-/*** Set all histogram X vectors.
+/*** Set all histogram X vectors. Lists of a lazily loaded workspace that are
+ * not in memory yet keep the X vector when their events are read, and the X
+ * vector of the loader is no longer used.
  * @param x :: The X vector of histogram bins to use.
  */
 void EventWorkspace::setAllX(Kernel::cow_ptr<MantidVec> &x) {
+  if (m_lazyCache)
+    m_lazyCache->discardDeferredX();
   // int counter=0;
   auto i = this->data.begin();
   for (; i != this->data.end(); ++i) {
@@ -750,17 +805,7 @@ public:
     if (!m_WS)
       return;
     for (size_t wi = m_wiStart; wi < m_wiStop; wi++) {
-      if (m_sortType != TOF_SORT)
-        m_WS->getSpectrum(wi).sort(m_sortType);
-      else {
-        if (m_howManyCores == 1) {
-          m_WS->getSpectrum(wi).sort(m_sortType);
-        } else if (m_howManyCores == 2) {
-          m_WS->getSpectrum(wi).sortTof2();
-        } else if (m_howManyCores == 4) {
-          m_WS->getSpectrum(wi).sortTof4();
-        }
-      }
+      m_WS->getSpectrum(wi).sort(m_sortType, m_howManyCores);
       // Report progress
       if (prog)
         prog->report("Sorting");
@@ -787,8 +832,12 @@ private:
 /*
  * Review each event list to get the sort type
  * If any 2 have different order type, then be unsorted
+ * The order of events that have not been loaded yet is not known, so a
+ * lazily loaded workspace is unsorted until all of its parts are in memory.
  */
 EventSortType EventWorkspace::getSortType() const {
+  if (m_lazyCache && !m_lazyCache->allLoaded())
+    return UNSORTED;
   size_t size = this->data.size();
   EventSortType order = data[0]->getSortType();
   for (size_t i = 1; i < size; i++) {
@@ -878,13 +927,87 @@ void EventWorkspace::getIntegratedSpectra(std::vector<double> &out,
   for (int wksp_index = 0; wksp_index < int(this->getNumberHistograms());
        wksp_index++) {
     // Get Handle to data
-    EventList *el = this->data[wksp_index];
+    const EventList &el = this->getSpectrum(wksp_index);
 
     // Let the eventList do the integration
-    out[wksp_index] = el->integrate(minX, maxX, entireRange);
+    out[wksp_index] = el.integrate(minX, maxX, entireRange);
   }
 }
 
+//---------------------------------------------------------------------------------------
+/** Read the events of the spectra on demand instead of holding all of them
+ * in memory.
+ *
+ * The event lists must have been created (and be empty) for all spectra. Each
+ * part of the loader is read on the first access to one of its spectra. Parts
+ * accessed through the non-const getSpectrum() stay in memory. The others are
+ * cleared again, least recently used first, once they use more than
+ * memoryLimit, unless they are pinned with pinSpectrum().
+ *
+ * @param loader :: Reads the events of a part of the spectra.
+ * @param memoryLimit :: Memory in bytes the unmodified parts may use, 0 to
+ * keep all parts in memory once they are read.
+ */
+void EventWorkspace::setLazyLoader(boost::shared_ptr<LazyEventLoader> loader,
+                                   const size_t memoryLimit) {
+  if (!loader) {
+    m_lazyCache.reset();
+    return;
+  }
+  m_lazyCache = Kernel::make_unique<LazyEventCache>(
+      std::move(loader), this->data.size(), memoryLimit);
+  this->clearMRU();
+}
+
+/** Keep the events of a spectrum in memory until unpinSpectrum() is called,
+ * so a const reference to its EventList stays valid while other spectra are
+ * accessed. Does nothing unless the workspace is loaded lazily.
+ * @param index :: The workspace index.
+ */
+void EventWorkspace::pinSpectrum(const size_t index) const {
+  if (index >= m_noVectors)
+    throw std::range_error(
+        "EventWorkspace::pinSpectrum, workspace index out of range");
+  if (m_lazyCache)
+    m_lazyCache->pin(index, data);
+}
+
+/** Release a spectrum pinned with pinSpectrum().
+ * @param index :: The workspace index.
+ */
+void EventWorkspace::unpinSpectrum(const size_t index) const {
+  if (index >= m_noVectors)
+    throw std::range_error(
+        "EventWorkspace::unpinSpectrum, workspace index out of range");
+  if (m_lazyCache)
+    m_lazyCache->unpin(index);
+}
+
+/// Returns true if the events are read on demand.
+bool EventWorkspace::isLazilyLoaded() const {
+  return static_cast<bool>(m_lazyCache);
+}
+
+/** Returns true if the events of a spectrum are in memory. This is always the
+ * case unless the workspace is loaded lazily.
+ * @param index :: The workspace index.
+ */
+bool EventWorkspace::isLoaded(const size_t index) const {
+  if (index >= m_noVectors)
+    throw std::range_error(
+        "EventWorkspace::isLoaded, workspace index out of range");
+  return !m_lazyCache || m_lazyCache->isLoaded(index);
+}
+
+/// Read all events that are not in memory yet and stop loading on demand.
+void EventWorkspace::loadAllEvents() {
+  if (!m_lazyCache)
+    return;
+  for (size_t i = 0; i < this->data.size(); ++i)
+    m_lazyCache->access(i, true, data);
+  m_lazyCache.reset();
+}
+
 } // namespace DataObjects
 } // namespace Mantid
 
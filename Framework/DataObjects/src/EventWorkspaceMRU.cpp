@@ -1,146 +1,292 @@
 #include "MantidDataObjects/EventWorkspaceMRU.h"
+#include "MantidKernel/ConfigService.h"
 #include "MantidKernel/System.h"
 
+#include <boost/functional/hash.hpp>
+#include <boost/make_shared.hpp>
+#include <cmath>
+#include <iterator>
+#include <thread>
+
 namespace Mantid {
 namespace DataObjects {
 
+const size_t EventWorkspaceMRU::NUM_SHARDS;
+const size_t EventWorkspaceMRU::NUM_RETAINED;
+
+namespace {
+/// Memory limit of the cache if none is configured, in megabytes
+const size_t DEFAULT_MEMORY_LIMIT_MB = 256;
+
+/** Find the positions of the coarse bin edges in the fine bin edges.
+ * @param fine :: bin edges of a cached histogram
+ * @param coarse :: requested bin edges
+ * @param positions :: filled with the index in fine of each coarse edge
+ * @return true if all coarse edges are fine edges
+ */
+bool findEdges(const MantidVec &fine, const MantidVec &coarse,
+               std::vector<size_t> &positions) {
+  if (coarse.size() < 2 || coarse.size() > fine.size())
+    return false;
+  positions.clear();
+  positions.reserve(coarse.size());
+  size_t j = 0;
+  for (const double edge : coarse) {
+    while (j < fine.size() && fine[j] < edge)
+      ++j;
+    if (j == fine.size() || fine[j] != edge)
+      return false;
+    positions.push_back(j);
+  }
+  return true;
+}
+}
+
 //----------------------------------------------------------------------------------------------
 /** Constructor
+ * @param index :: spectrum number of the histogrammed spectrum
+ * @param x :: bin edges
  */
-EventWorkspaceMRU::EventWorkspaceMRU() {}
+CachedHistogram::CachedHistogram(const size_t index,
+                                 const Kernel::cow_ptr<MantidVec> &x)
+    : m_index(index), m_x(x),
+      m_binningHash(EventWorkspaceMRU::binningHash(*x)) {}
+
+/// Returns the memory used by the counts and errors, in bytes.
+size_t CachedHistogram::getMemorySize() const {
+  return (m_y.capacity() + m_e.capacity()) * sizeof(double) +
+         sizeof(CachedHistogram);
+}
 
 //----------------------------------------------------------------------------------------------
-/** Destructor
+/** Constructor. The memory limit is read from the EventWorkspace.MRUMemoryMB
+ * setting, in megabytes.
  */
-EventWorkspaceMRU::~EventWorkspaceMRU() {
-  // Make sure you free up the memory in the MRUs
-  for (auto &data : m_bufferedDataY) {
-    if (data) {
-      data->clear();
-      delete data;
-    }
+EventWorkspaceMRU::EventWorkspaceMRU()
+    : m_memoryLimit(DEFAULT_MEMORY_LIMIT_MB * 1024 * 1024) {
+  int limit = 0;
+  if (Kernel::ConfigService::Instance().getValue("EventWorkspace.MRUMemoryMB",
+                                                 limit) &&
+      limit >= 0)
+    m_memoryLimit = static_cast<size_t>(limit) * 1024 * 1024;
+}
+
+/** Constructor
+ * @param memoryLimit :: memory limit of all cached histograms, in bytes
+ */
+EventWorkspaceMRU::EventWorkspaceMRU(const size_t memoryLimit)
+    : m_memoryLimit(memoryLimit) {}
+
+//---------------------------------------------------------------------------
+/** Find the histogram of a spectrum for the given bin edges.
+ *
+ * If it is not cached but a histogram with finer bins is, whose edges
+ * include all the given edges, the histogram is computed from that and
+ * cached.
+ *
+ * @param index :: spectrum number of the spectrum
+ * @param x :: bin edges
+ * @return the histogram; null if it is not cached.
+ */
+EventWorkspaceMRU::histogram_ptr
+EventWorkspaceMRU::find(const size_t index, const MantidVec &x) {
+  Shard &shard = shardOf(index);
+  std::lock_guard<std::mutex> _lock(shard.m_mutex);
+
+  // The bin edges are usually the ones the histogram was generated for, so
+  // look for those before hashing and comparing them
+  auto range = shard.m_byIndex.equal_range(index);
+  for (auto it = range.first; it != range.second; ++it) {
+    if ((*it->second)->m_x.get() == &x)
+      return useCached(shard, it->second);
   }
 
-  for (auto &data : m_bufferedDataE) {
-    if (data) {
-      data->clear();
-      delete data;
+  const size_t hash = binningHash(x);
+  // Once a finer histogram is found, positions holds its edges
+  auto finer = shard.m_histograms.end();
+  std::vector<size_t> positions;
+  for (auto it = range.first; it != range.second; ++it) {
+    const CachedHistogram &cached = **it->second;
+    if (cached.m_binningHash == hash && *cached.m_x == x)
+      return useCached(shard, it->second);
+    if (finer == shard.m_histograms.end() &&
+        findEdges(*cached.m_x, x, positions))
+      finer = it->second;
+  }
+  if (finer == shard.m_histograms.end())
+    return histogram_ptr();
+
+  // Sum the counts and the squared errors of the finer bins
+  const CachedHistogram &fine = **finer;
+  auto coarse = boost::make_shared<CachedHistogram>(
+      index, Kernel::cow_ptr<MantidVec>(boost::make_shared<MantidVec>(x)));
+  const size_t numBins = positions.size() - 1;
+  coarse->m_y.resize(numBins, 0.0);
+  coarse->m_e.resize(numBins, 0.0);
+  for (size_t i = 0; i < numBins; ++i) {
+    double errorSquared = 0.0;
+    for (size_t j = positions[i]; j < positions[i + 1]; ++j) {
+      coarse->m_y[i] += fine.m_y[j];
+      errorSquared += fine.m_e[j] * fine.m_e[j];
     }
+    coarse->m_e[i] = std::sqrt(errorSquared);
   }
+  addCached(shard, coarse);
+  return coarse;
 }
 
-//---------------------------------------------------------------------------
-/** This function makes sure that there are enough data
- * buffers (MRU's) for E for the number of threads requested.
- * @param thread_num :: thread number that wants a MRU buffer
+/** Insert a new histogram into the MRU. If another thread cached the same
+ * histogram in the meantime, that one is kept and returned.
+ *
+ * @param histogram :: the new histogram
+ * @return the cached histogram.
  */
-void EventWorkspaceMRU::ensureEnoughBuffersE(size_t thread_num) const {
-  std::lock_guard<std::mutex> _lock(m_changeMruListsMutexE);
-  if (m_bufferedDataE.size() <= thread_num) {
-    m_bufferedDataE.resize(thread_num + 1, nullptr);
-    for (auto &data : m_bufferedDataE) {
-      if (!data)
-        data = new mru_list(50); // Create a MRU list with this many entries.
-    }
+EventWorkspaceMRU::histogram_ptr
+EventWorkspaceMRU::insert(const histogram_ptr &histogram) {
+  Shard &shard = shardOf(histogram->m_index);
+  std::lock_guard<std::mutex> _lock(shard.m_mutex);
+
+  auto range = shard.m_byIndex.equal_range(histogram->m_index);
+  for (auto it = range.first; it != range.second; ++it) {
+    const CachedHistogram &cached = **it->second;
+    if (cached.m_x.get() == histogram->m_x.get() ||
+        (cached.m_binningHash == histogram->m_binningHash &&
+         *cached.m_x == *histogram->m_x))
+      return useCached(shard, it->second);
   }
+  addCached(shard, histogram);
+  return histogram;
 }
-//---------------------------------------------------------------------------
-/** This function makes sure that there are enough data
- * buffers (MRU's) for Y for the number of threads requested.
- * @param thread_num :: thread number that wants a MRU buffer
+
+/// Move a cached histogram to the front of its shard and retain it.
+EventWorkspaceMRU::histogram_ptr
+EventWorkspaceMRU::useCached(Shard &shard,
+                             const histogram_list::iterator &it) const {
+  // Splicing keeps the iterators in m_byIndex valid
+  shard.m_histograms.splice(shard.m_histograms.begin(), shard.m_histograms,
+                            it);
+  retain(*it);
+  return *it;
+}
+
+/** Keep a histogram returned to the calling thread in memory until the thread
+ * was returned NUM_RETAINED more histograms, so that references to its data
+ * stay valid for a while after it is dropped from the cache. Each thread has
+ * its own list, so that other threads reading many histograms in the meantime
+ * do not shorten it. The lists are freed with the MRU.
+ * @param histogram :: the histogram that is returned
  */
-void EventWorkspaceMRU::ensureEnoughBuffersY(size_t thread_num) const {
-  std::lock_guard<std::mutex> _lock(m_changeMruListsMutexY);
-  if (m_bufferedDataY.size() <= thread_num) {
-    m_bufferedDataY.resize(thread_num + 1, nullptr);
-    for (auto &data : m_bufferedDataY) {
-      if (!data)
-        data = new mru_list(50); // Create a MRU list with this many entries.
+void EventWorkspaceMRU::retain(const histogram_ptr &histogram) const {
+  const auto thread = std::this_thread::get_id();
+  Retained &retained =
+      m_retained[std::hash<std::thread::id>()(thread) % NUM_SHARDS];
+  std::lock_guard<std::mutex> _lock(retained.m_mutex);
+  auto &histograms = retained.m_byThread[thread];
+  histograms.push_back(histogram);
+  if (histograms.size() > NUM_RETAINED)
+    histograms.pop_front();
+}
+
+/// Add a histogram to the front of a shard, dropping the least recently used
+/// ones if the shard exceeds its share of the memory limit.
+void EventWorkspaceMRU::addCached(Shard &shard,
+                                  const histogram_ptr &histogram) const {
+  shard.m_histograms.push_front(histogram);
+  shard.m_byIndex.emplace(histogram->m_index, shard.m_histograms.begin());
+  shard.m_memorySize += histogram->getMemorySize();
+  retain(histogram);
+
+  // Always keep the new histogram, even if it exceeds the limit on its own
+  const size_t shardLimit = m_memoryLimit / NUM_SHARDS;
+  while (shard.m_memorySize > shardLimit && shard.m_histograms.size() > 1)
+    dropOldest(shard);
+}
+
+/// Drop the least recently used histogram of a shard.
+void EventWorkspaceMRU::dropOldest(Shard &shard) const {
+  auto oldest = std::prev(shard.m_histograms.end());
+  auto range = shard.m_byIndex.equal_range((*oldest)->m_index);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == oldest) {
+      shard.m_byIndex.erase(it);
+      break;
     }
   }
+  shard.m_memorySize -= (*oldest)->getMemorySize();
+  shard.m_histograms.erase(oldest);
 }
 
 //---------------------------------------------------------------------------
 /// Clear all the data in the MRU buffers
 void EventWorkspaceMRU::clear() {
-  // Make sure you free up the memory in the MRUs
-  for (auto &data : m_bufferedDataY)
-    if (data) {
-      data->clear();
-    };
-
-  for (auto &data : m_bufferedDataE)
-    if (data) {
-      data->clear();
-    };
+  for (auto &shard : m_shards) {
+    std::lock_guard<std::mutex> _lock(shard.m_mutex);
+    shard.m_byIndex.clear();
+    shard.m_histograms.clear();
+    shard.m_memorySize = 0;
+  }
 }
 
-//---------------------------------------------------------------------------
-/** Find a Y histogram in the MRU
+/** Delete the cached histograms of a spectrum, for all bin edges.
  *
- * @param thread_num :: number of the thread in which this is run
- * @param index :: index of the data to return
- * @return pointer to the MantidVecWithMarker that has the data; NULL if not
- *found.
+ * @param index :: spectrum number of the spectrum.
  */
-MantidVecWithMarker *EventWorkspaceMRU::findY(size_t thread_num, size_t index) {
-  std::lock_guard<std::mutex> _lock(m_changeMruListsMutexY);
-  return m_bufferedDataY[thread_num]->find(index);
+void EventWorkspaceMRU::deleteIndex(size_t index) {
+  Shard &shard = shardOf(index);
+  std::lock_guard<std::mutex> _lock(shard.m_mutex);
+  auto range = shard.m_byIndex.equal_range(index);
+  for (auto it = range.first; it != range.second; ++it) {
+    shard.m_memorySize -= (*it->second)->getMemorySize();
+    shard.m_histograms.erase(it->second);
+  }
+  shard.m_byIndex.erase(range.first, range.second);
 }
 
-/** Find a Y histogram in the MRU
- *
- * @param thread_num :: number of the thread in which this is run
- * @param index :: index of the data to return
- * @return pointer to the MantidVecWithMarker that has the data; NULL if not
- *found.
+//---------------------------------------------------------------------------
+/** Set the memory limit of the cached histograms. Each of the NUM_SHARDS
+ * shards may use an equal part of it.
+ * @param memoryLimit :: memory limit in bytes.
  */
-MantidVecWithMarker *EventWorkspaceMRU::findE(size_t thread_num, size_t index) {
-  std::lock_guard<std::mutex> _lock(m_changeMruListsMutexE);
-  return m_bufferedDataE[thread_num]->find(index);
+void EventWorkspaceMRU::setMemoryLimit(const size_t memoryLimit) {
+  m_memoryLimit = memoryLimit;
+  const size_t shardLimit = memoryLimit / NUM_SHARDS;
+  for (auto &shard : m_shards) {
+    std::lock_guard<std::mutex> _lock(shard.m_mutex);
+    while (shard.m_memorySize > shardLimit && shard.m_histograms.size() > 1)
+      dropOldest(shard);
+  }
 }
 
-/** Insert a new histogram into the MRU
- *
- * @param thread_num :: thread being accessed
- * @param data :: the new data
- * @return a MantidVecWithMarker * that needs to be deleted, or NULL if nothing
- *needs to be deleted.
- */
-void EventWorkspaceMRU::insertY(size_t thread_num, MantidVecWithMarker *data) {
-  std::lock_guard<std::mutex> _lock(m_changeMruListsMutexY);
-  MantidVecWithMarker *oldData = m_bufferedDataY[thread_num]->insert(data);
-  // And clear up the memory of the old one, if it is dropping out.
-  delete oldData;
+/// Returns the memory limit of the cached histograms, in bytes.
+size_t EventWorkspaceMRU::getMemoryLimit() const { return m_memoryLimit; }
+
+/// Returns the memory used by the cached histograms, in bytes.
+size_t EventWorkspaceMRU::getMemorySize() const {
+  size_t memorySize = 0;
+  for (auto &shard : m_shards) {
+    std::lock_guard<std::mutex> _lock(shard.m_mutex);
+    memorySize += shard.m_memorySize;
+  }
+  return memorySize;
 }
 
-/** Insert a new histogram into the MRU
- *
- * @param thread_num :: thread being accessed
- * @param data :: the new data
- * @return a MantidVecWithMarker * that needs to be deleted, or NULL if nothing
- *needs to be deleted.
- */
-void EventWorkspaceMRU::insertE(size_t thread_num, MantidVecWithMarker *data) {
-  std::lock_guard<std::mutex> _lock(m_changeMruListsMutexE);
-  MantidVecWithMarker *oldData = m_bufferedDataE[thread_num]->insert(data);
-  // And clear up the memory of the old one, if it is dropping out.
-  delete oldData;
+/** Return how many histograms are cached.
+ * @return :: number of entries in the MRU list. */
+size_t EventWorkspaceMRU::MRUSize() const {
+  size_t size = 0;
+  for (auto &shard : m_shards) {
+    std::lock_guard<std::mutex> _lock(shard.m_mutex);
+    size += shard.m_histograms.size();
+  }
+  return size;
 }
 
-/** Delete any entries in the MRU at the given index
- *
- * @param index :: index to delete.
+/** Returns a hash of bin edges, used to look up the histogram of a spectrum
+ * for the bin edges.
+ * @param x :: bin edges
  */
-void EventWorkspaceMRU::deleteIndex(size_t index) {
-  std::lock_guard<std::mutex> _lock1(m_changeMruListsMutexE);
-  for (auto &data : m_bufferedDataE)
-    if (data)
-      data->deleteIndex(index);
-  std::lock_guard<std::mutex> _lock2(m_changeMruListsMutexY);
-  for (auto &data : m_bufferedDataY)
-    if (data)
-      data->deleteIndex(index);
+size_t EventWorkspaceMRU::binningHash(const MantidVec &x) {
+  return boost::hash_range(x.begin(), x.end());
 }
 
 } // namespace Mantid
@@ -0,0 +1,246 @@
+#include "MantidDataObjects/LazyEventCache.h"
+#include "MantidDataObjects/EventList.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/cow_ptr.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** Constructor
+ *
+ * @param loader :: Reads the events of a part.
+ * @param numberOfHistograms :: Number of spectra of the workspace.
+ * @param memoryLimit :: Memory in bytes the unmodified parts may use before
+ * the least recently used ones are cleared, 0 for no limit.
+ */
+LazyEventCache::LazyEventCache(boost::shared_ptr<LazyEventLoader> loader,
+                               const size_t numberOfHistograms,
+                               const size_t memoryLimit)
+    : m_loader(std::move(loader)), m_numLoaded(0), m_xPending(true),
+      m_memoryLimit(memoryLimit), m_memoryInUse(0), m_accessCount(0),
+      m_columnar(false) {
+  const size_t numParts = m_loader->numberOfParts();
+  m_partOfIndex.resize(numberOfHistograms, numParts);
+  m_indicesOfPart.resize(numParts);
+  for (size_t part = 0; part < numParts; ++part) {
+    m_indicesOfPart[part] = m_loader->workspaceIndices(part);
+    for (const auto index : m_indicesOfPart[part]) {
+      if (index >= numberOfHistograms)
+        throw std::out_of_range("LazyEventCache: workspace index of part is "
+                                "out of range.");
+      m_partOfIndex[index] = part;
+    }
+  }
+  m_loaded.reset(new std::atomic<bool>[numParts]);
+  for (size_t part = 0; part < numParts; ++part)
+    m_loaded[part] = false;
+  m_memory.resize(numParts, 0);
+  m_modified.resize(numParts, false);
+  m_pins.resize(numParts, 0);
+  m_lastAccess.resize(numParts, 0);
+}
+
+/// Returns the part of a workspace index, or the number of parts if the
+/// spectrum is not loaded lazily.
+size_t LazyEventCache::partOf(const size_t workspaceIndex) const {
+  // Lists added after the loader was set are not loaded lazily
+  if (workspaceIndex >= m_partOfIndex.size())
+    return m_indicesOfPart.size();
+  return m_partOfIndex[workspaceIndex];
+}
+
+/** Make sure the events of a spectrum are in memory, loading the part
+ * containing the spectrum if necessary.
+ *
+ * @param workspaceIndex :: Index of the spectrum that is accessed.
+ * @param modify :: true if the events may be changed. The part of the
+ * spectrum is then never cleared again.
+ * @param eventLists :: All event lists of the workspace.
+ */
+void LazyEventCache::access(const size_t workspaceIndex, const bool modify,
+                            const std::vector<EventList *> &eventLists) {
+  if (m_xPending.load(std::memory_order_acquire))
+    readX(eventLists);
+  const size_t part = partOf(workspaceIndex);
+  if (part == m_indicesOfPart.size())
+    return;
+  if (m_memoryLimit == 0) {
+    if (!m_loaded[part].load(std::memory_order_acquire)) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      loadPart(part, eventLists);
+    }
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_threadParts[std::this_thread::get_id()] = part;
+  m_lastAccess[part] = ++m_accessCount;
+  loadPart(part, eventLists);
+  if (modify && !m_modified[part]) {
+    m_modified[part] = true;
+    m_memoryInUse -= m_memory[part];
+  }
+  if (m_memoryInUse > m_memoryLimit)
+    evictParts(eventLists);
+}
+
+/** Load a part and keep it in memory until unpin() is called for the same
+ * spectrum, even if the memory limit is exceeded.
+ *
+ * @param workspaceIndex :: Index of the spectrum to pin.
+ * @param eventLists :: All event lists of the workspace.
+ */
+void LazyEventCache::pin(const size_t workspaceIndex,
+                         const std::vector<EventList *> &eventLists) {
+  if (m_xPending.load(std::memory_order_acquire))
+    readX(eventLists);
+  const size_t part = partOf(workspaceIndex);
+  if (part == m_indicesOfPart.size())
+    return;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  ++m_pins[part];
+  m_lastAccess[part] = ++m_accessCount;
+  loadPart(part, eventLists);
+}
+
+/** Release a pin set by pin().
+ *
+ * @param workspaceIndex :: Index of the pinned spectrum.
+ */
+void LazyEventCache::unpin(const size_t workspaceIndex) {
+  const size_t part = partOf(workspaceIndex);
+  if (part == m_indicesOfPart.size())
+    return;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_pins[part] == 0)
+    throw std::logic_error("LazyEventCache::unpin: spectrum is not pinned.");
+  --m_pins[part];
+}
+
+/** Set the X vector provided by the loader on all event lists, unless
+ * another thread did so while waiting for the lock.
+ *
+ * @param eventLists :: All event lists of the workspace.
+ */
+void LazyEventCache::readX(const std::vector<EventList *> &eventLists) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_xPending.load(std::memory_order_relaxed))
+    return;
+  Kernel::cow_ptr<MantidVec> axis;
+  if (m_loader->readX(axis.access()))
+    for (auto eventList : eventLists)
+      eventList->setX(axis);
+  m_xPending.store(false, std::memory_order_release);
+}
+
+/// The X vector was set explicitly, do not replace it with the one of the
+/// loader.
+void LazyEventCache::discardDeferredX() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_xPending.store(false, std::memory_order_release);
+}
+
+/** Load a part unless it is in memory already. Must be called with the lock
+ * held.
+ *
+ * Loading holds the lock: other threads would otherwise have to wait for the
+ * same part anyway, and the file is read sequentially.
+ *
+ * @param part :: The part to load.
+ * @param eventLists :: All event lists of the workspace.
+ */
+void LazyEventCache::loadPart(const size_t part,
+                              const std::vector<EventList *> &eventLists) {
+  if (m_loaded[part].load(std::memory_order_relaxed))
+    return;
+  m_loader->load(part, eventLists);
+  size_t memory = 0;
+  for (const auto index : m_indicesOfPart[part]) {
+    if (m_columnar)
+      eventLists[index]->setColumnarStorage(true);
+    memory += eventLists[index]->getMemorySize();
+  }
+  m_memory[part] = memory;
+  if (!m_modified[part])
+    m_memoryInUse += memory;
+  m_loaded[part].store(true, std::memory_order_release);
+  ++m_numLoaded;
+}
+
+/** Clear the least recently used parts until the unmodified parts fit into
+ * the memory limit. Parts that are pinned, modified, or accessed last by a
+ * thread are kept. Must be called with the lock held.
+ *
+ * @param eventLists :: All event lists of the workspace.
+ */
+void LazyEventCache::evictParts(const std::vector<EventList *> &eventLists) {
+  std::vector<bool> inUse(m_indicesOfPart.size(), false);
+  for (const auto &threadPart : m_threadParts)
+    inUse[threadPart.second] = true;
+  std::vector<size_t> candidates;
+  for (size_t part = 0; part < m_indicesOfPart.size(); ++part)
+    if (m_loaded[part].load(std::memory_order_relaxed) && !m_modified[part] &&
+        m_pins[part] == 0 && !inUse[part])
+      candidates.push_back(part);
+  std::sort(candidates.begin(), candidates.end(),
+            [this](const size_t a, const size_t b) {
+              return m_lastAccess[a] < m_lastAccess[b];
+            });
+
+  for (const auto part : candidates) {
+    if (m_memoryInUse <= m_memoryLimit)
+      break;
+    m_loaded[part].store(false, std::memory_order_release);
+    for (const auto index : m_indicesOfPart[part]) {
+      eventLists[index]->clear(false);
+      eventLists[index]->setSortOrder(UNSORTED);
+    }
+    m_memoryInUse -= m_memory[part];
+    m_memory[part] = 0;
+    --m_numLoaded;
+  }
+}
+
+/// Returns true if the events of the spectrum are currently in memory.
+bool LazyEventCache::isLoaded(const size_t workspaceIndex) const {
+  const size_t part = partOf(workspaceIndex);
+  if (part == m_indicesOfPart.size())
+    return true;
+  return m_loaded[part].load(std::memory_order_acquire);
+}
+
+/// Returns true if all parts are in memory.
+bool LazyEventCache::allLoaded() const {
+  return m_numLoaded == m_indicesOfPart.size();
+}
+
+/// Returns the memory in bytes the unmodified parts may use, 0 for no limit.
+size_t LazyEventCache::memoryLimit() const { return m_memoryLimit; }
+
+/// Returns the memory in bytes used by the unmodified parts in memory.
+size_t LazyEventCache::memoryInUse() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_memoryInUse;
+}
+
+/** Select the storage layout of the TofEvent's of all event lists, including
+ * those of the parts that are loaded later.
+ *
+ * @param columnar :: true to use columnar storage
+ * @param eventLists :: All event lists of the workspace.
+ * @see EventList::setColumnarStorage()
+ */
+void LazyEventCache::setColumnarStorage(
+    const bool columnar, const std::vector<EventList *> &eventLists) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_columnar = columnar;
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < static_cast<int64_t>(eventLists.size()); ++i)
+    eventLists[i]->setColumnarStorage(columnar);
+}
+
+} // namespace DataObjects
+} // namespace Mantid
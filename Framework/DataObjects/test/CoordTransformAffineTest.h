@@ -207,6 +207,32 @@ public:
                                ct.buildOrthogonal(origin, bases, scale));
   }
 
+  /** applyBlock() gives exactly the same coordinates as apply() */
+  void test_applyBlock() {
+    CoordTransformAffine ct(3, 2);
+    VMD origin(1.0, 1.0, 1.0);
+    double angle = 0.1;
+    std::vector<VMD> bases{{cos(angle), sin(angle), 0.0},
+                           {-sin(angle), cos(angle), 0.0}};
+    ct.buildOrthogonal(origin, bases, VMD(2.0, 3.0));
+
+    // Coordinate d of point i is at [d * numPoints + i]
+    const size_t numPoints = 3;
+    coord_t inputs[3 * numPoints] = {1.2f,   -1.4f,  0.0f,  // x
+                                      1.0f,   6.6f,   0.0f,  // y
+                                      3.456f, 8.987f, -1.0f}; // z
+    coord_t outputs[2 * numPoints];
+    ct.applyBlock(inputs, outputs, numPoints);
+    for (size_t i = 0; i < numPoints; i++) {
+      coord_t in[3] = {inputs[i], inputs[numPoints + i],
+                       inputs[2 * numPoints + i]};
+      coord_t out[2];
+      ct.apply(in, out);
+      TS_ASSERT_EQUALS(outputs[i], out[0]);
+      TS_ASSERT_EQUALS(outputs[numPoints + i], out[1]);
+    }
+  }
+
   //-----------------------------------------------------------------------------------------------
   /** Test a case of a rotation 0.1 radians around +Z,
    * and a projection into the XY plane,
@@ -418,6 +444,18 @@ public:
       ct.apply(in, out);
     }
   }
+  void test_applyBlock_4D_performance() {
+    CoordTransformAffine ct(4, 4);
+    coord_t translation[4] = {2.0, 3.0, 4.0, 5.0};
+    ct.addTranslation(translation);
+    const size_t numPoints = 1000;
+    std::vector<coord_t> in(4 * numPoints, 1.5);
+    std::vector<coord_t> out(4 * numPoints);
+
+    for (size_t i = 0; i < 1000 * 10; ++i) {
+      ct.applyBlock(in.data(), out.data(), numPoints);
+    }
+  }
 };
 
 #endif /* MANTID_DATAOBJECTS_COORDTRANSFORMAFFINETEST_H_ */
@@ -70,6 +70,24 @@ public:
     TS_ASSERT_DELTA(output[2], 3.0, 1e-6);
   }
 
+  void test_applyBlock() {
+    size_t dimToBinFrom[3] = {3, 1, 0};
+    coord_t origin[3] = {5, 10, 15};
+    coord_t scaling[3] = {1, 2, 3};
+    CoordTransformAligned ct(4, 3, dimToBinFrom, origin, scaling);
+
+    // Coordinate d of point i is at [d * 2 + i]
+    coord_t inputs[8] = {16, 17, 11, 12, 11111111, 11111111, 6, 7};
+    coord_t outputs[6] = {0, 0, 0, 0, 0, 0};
+    ct.applyBlock(inputs, outputs, 2);
+    TS_ASSERT_DELTA(outputs[0], 1.0, 1e-6);
+    TS_ASSERT_DELTA(outputs[1], 2.0, 1e-6);
+    TS_ASSERT_DELTA(outputs[2], 2.0, 1e-6);
+    TS_ASSERT_DELTA(outputs[3], 4.0, 1e-6);
+    TS_ASSERT_DELTA(outputs[4], 3.0, 1e-6);
+    TS_ASSERT_DELTA(outputs[5], 6.0, 1e-6);
+  }
+
   /// Clone the transform, check that it still works
   void test_clone() {
     size_t dimToBinFrom[3] = {3, 1, 0};
@@ -173,5 +191,18 @@ public:
       ct.apply(in, out);
     }
   }
+  void test_applyBlock_4D_performance() {
+    size_t dimToBinFrom[4] = {0, 1, 2, 3};
+    coord_t origin[4] = {5, 10, 15, 20};
+    coord_t scaling[4] = {1, 2, 3, 4};
+    CoordTransformAligned ct(4, 4, dimToBinFrom, origin, scaling);
+    const size_t numPoints = 1000;
+    std::vector<coord_t> in(4 * numPoints, 1.5);
+    std::vector<coord_t> out(4 * numPoints);
+
+    for (size_t i = 0; i < 1000 * 10; ++i) {
+      ct.applyBlock(in.data(), out.data(), numPoints);
+    }
+  }
 };
 #endif /* MANTID_DATAOBJECTS_COORDTRANSFORMALIGNEDTEST_H_ */
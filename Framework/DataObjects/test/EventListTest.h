@@ -201,6 +201,65 @@ public:
     TS_ASSERT(!el2.hasDetectorID(0));
   }
 
+  void test_addEventLists_merges_sorted_lists() {
+    EventList el1, el2, el3, empty;
+    for (int i = 0; i < 10; ++i) {
+      el1.addEventQuickly(TofEvent(3.0 * i, 10 - i));
+      el2.addEventQuickly(TofEvent(3.0 * i + 1.0, 20 - i));
+      el3.addEventQuickly(TofEvent(3.0 * i + 2.0, 30 - i));
+    }
+    el2.addDetectorID(2);
+    el3.addDetectorID(3);
+    el1.sortTof();
+    el2.sortTof();
+    el3.sortTof();
+
+    el1.addEventLists({&el2, &empty, &el3});
+    TS_ASSERT_EQUALS(el1.getNumberEvents(), 30);
+    TS_ASSERT_EQUALS(el1.getSortType(), TOF_SORT);
+    const auto &events = el1.getEvents();
+    for (size_t i = 0; i < events.size(); ++i)
+      TS_ASSERT_EQUALS(events[i].tof(), static_cast<double>(i));
+    TS_ASSERT(el1.hasDetectorID(2));
+    TS_ASSERT(el1.hasDetectorID(3));
+
+    // By pulse time
+    EventList byPulse;
+    byPulse.addEventQuickly(TofEvent(1.0, 15));
+    byPulse.sortPulseTime();
+    el2.sortPulseTime();
+    byPulse.addEventLists({&el2});
+    TS_ASSERT_EQUALS(byPulse.getSortType(), PULSETIME_SORT);
+    TS_ASSERT_EQUALS(byPulse.getNumberEvents(), 11);
+    TS_ASSERT(std::is_sorted(byPulse.getEvents().begin(),
+                             byPulse.getEvents().end(),
+                             [](const TofEvent &e1, const TofEvent &e2) {
+                               return e1.pulseTime() < e2.pulseTime();
+                             }));
+  }
+
+  void test_addEventLists_appends_unsorted_lists() {
+    EventList el1, el2, el3;
+    el1.addEventQuickly(TofEvent(5.0));
+    el1.addEventQuickly(TofEvent(1.0));
+    el2.addEventQuickly(TofEvent(3.0));
+    el3.addEventQuickly(TofEvent(2.0));
+    el3 *= 2.0;
+
+    // Switches to the type of the sum, as operator+=()
+    el1.addEventLists({&el2, &el3});
+    TS_ASSERT_EQUALS(el1.getEventType(), WEIGHTED);
+    TS_ASSERT_EQUALS(el1.getSortType(), UNSORTED);
+    const auto &events = el1.getWeightedEvents();
+    TS_ASSERT_EQUALS(events.size(), 4);
+    if (events.size() == 4) {
+      TS_ASSERT_EQUALS(events[0].tof(), 5.0);
+      TS_ASSERT_EQUALS(events[2].tof(), 3.0);
+      TS_ASSERT_EQUALS(events[3].tof(), 2.0);
+      TS_ASSERT_EQUALS(events[3].weight(), 2.0);
+    }
+  }
+
   //==================================================================================
   //--- Switching to Weighted Events ----
   //==================================================================================
@@ -714,6 +773,76 @@ public:
     }
   }
 
+  /// Long lists are radix sorted, in several threads if asked to
+  void test_sort_long_lists_gives_same_order_as_std_sort() {
+    std::vector<TofEvent> events;
+    srand(1234);
+    for (int i = 0; i < 300000; i++)
+      // Some negative TOFs, and pulse times that are close together
+      events.emplace_back(1e4 * (rand() * 1.0 / RAND_MAX) - 100.0,
+                          1000000000 + rand() % 1000);
+    std::vector<TofEvent> byTof(events);
+    std::sort(byTof.begin(), byTof.end(),
+              [](const TofEvent &e1, const TofEvent &e2) {
+                return e1.tof() < e2.tof();
+              });
+    std::vector<TofEvent> byPulseTimeTof(events);
+    std::sort(byPulseTimeTof.begin(), byPulseTimeTof.end(),
+              [](const TofEvent &e1, const TofEvent &e2) {
+                return e1.pulseTime() < e2.pulseTime() ||
+                       (e1.pulseTime() == e2.pulseTime() &&
+                        e1.tof() < e2.tof());
+              });
+
+    for (size_t numThreads = 1; numThreads <= 4; numThreads += 3) {
+      for (int this_type = 0; this_type < 3; this_type++) {
+        for (int columnar = 0; columnar < 2; columnar++) {
+          if (columnar && this_type != TOF)
+            continue;
+          EventList list;
+          list.setColumnarStorage(columnar != 0);
+          list += events;
+          list.switchTo(static_cast<EventType>(this_type));
+          list.sort(TOF_SORT, numThreads);
+          TS_ASSERT_EQUALS(list.getNumberEvents(), events.size());
+          for (size_t i = 0; i < events.size(); i++)
+            if (list.getEvent(i).tof() != byTof[i].tof()) {
+              TSM_ASSERT("TOF order differs", false);
+              break;
+            }
+
+          if (this_type == WEIGHTED_NOTIME)
+            continue;
+          list.sort(PULSETIMETOF_SORT, numThreads);
+          for (size_t i = 0; i < events.size(); i++)
+            if (list.getEvent(i).tof() != byPulseTimeTof[i].tof() ||
+                list.getEvent(i).pulseTime() !=
+                    byPulseTimeTof[i].pulseTime()) {
+              TSM_ASSERT("Pulse time and TOF order differs", false);
+              break;
+            }
+        }
+      }
+    }
+  }
+
+  /// Only the events appended to a sorted list need to be sorted
+  void test_sort_sorted_list_with_appended_events() {
+    el = EventList();
+    for (int i = 0; i < 10000; i++)
+      el += TofEvent(static_cast<double>(i), i);
+    el.sortTof();
+    TS_ASSERT(el.isSortedByTof());
+    srand(1234);
+    for (int i = 0; i < 5000; i++)
+      el += TofEvent(1e4 * (rand() * 1.0 / RAND_MAX), i);
+    TS_ASSERT(!el.isSortedByTof());
+    el.sortTof();
+    TS_ASSERT_EQUALS(el.getNumberEvents(), 15000);
+    for (size_t i = 1; i < el.getNumberEvents(); i++)
+      TS_ASSERT_LESS_THAN_EQUALS(el.getEvent(i - 1).tof(), el.getEvent(i).tof());
+  }
+
   //-----------------------------------------------------------------------------------------------
   void test_reverse_allTypes() {
     // Go through each possible EventType as the input
@@ -1148,6 +1277,33 @@ public:
     TS_ASSERT_EQUALS(this->el.ptrX()->size(), NUMBINS + 1);
   }
 
+  void test_histogram_linear_and_log_bins_without_sorting() {
+    MantidVec linearX = makeX(BIN_DELTA, NUMBINS);
+    MantidVec logX;
+    for (double tof = 100.0; tof < 2e7; tof *= 1.1)
+      logX.push_back(tof);
+    for (const auto &X : {linearX, logX}) {
+      for (int this_type = 0; this_type < 3; this_type++) {
+        fake_data();
+        el.switchTo(static_cast<EventType>(this_type));
+        // Brute force reference
+        MantidVec refY(X.size() - 1, 0.0);
+        for (size_t i = 0; i < el.getNumberEvents(); ++i) {
+          const double tof = el.getEvent(i).tof();
+          for (size_t bin = 0; bin < refY.size(); ++bin)
+            if (tof >= X[bin] && tof < X[bin + 1])
+              refY[bin] += 1.0;
+        }
+        MantidVec Y, E;
+        el.generateHistogram(X, Y, E);
+        TS_ASSERT_EQUALS(Y, refY);
+        TS_ASSERT_EQUALS(E.size(), Y.size());
+        // The bins are computed directly, the events are not sorted
+        TS_ASSERT_EQUALS(el.getSortType(), UNSORTED);
+      }
+    }
+  }
+
   //  void test_histogram_static_function()
   //  {
   //    std::vector<WeightedEvent> events;
@@ -1375,6 +1531,9 @@ public:
       // Original tofs were 100, 5100, 10100, etc.). This becomes x * 200.
       TSM_ASSERT_EQUALS(this_type, this->el.getEvent(0).tof(), 100 * 200.);
       TSM_ASSERT_EQUALS(this_type, this->el.getEvent(1).tof(), 5100 * 200.);
+      // The events are converted in blocks, check one past the first block
+      TSM_ASSERT_EQUALS(this_type, this->el.getEvent(1500).tof(),
+                        7500100 * 200.);
     }
   }
 
@@ -1693,6 +1852,131 @@ public:
     }
   }
 
+  void test_buildPulseIndex() {
+    // 10000 events over 1000 pulses
+    this->fake_uniform_data(10);
+    TS_ASSERT(!el.hasPulseIndex());
+    el.buildPulseIndex();
+    TS_ASSERT(el.hasPulseIndex());
+    TS_ASSERT_EQUALS(el.getSortType(), PULSETIME_SORT);
+    for (size_t i = 1; i < el.getNumberEvents(); i++)
+      TS_ASSERT_LESS_THAN_EQUALS(el.getEvent(i - 1).pulseTime(),
+                                 el.getEvent(i).pulseTime());
+
+    // Still valid after a sort that keeps the pulses in order
+    el.sortPulseTimeTOF();
+    TS_ASSERT(el.hasPulseIndex());
+    EventList copy(el);
+    TS_ASSERT(copy.hasPulseIndex());
+
+    // Invalidated by changing the pulse times or the order
+    el.addPulsetime(1.0);
+    TS_ASSERT(!el.hasPulseIndex());
+    copy.sortTof();
+    TS_ASSERT(!copy.hasPulseIndex());
+
+    // Invalidated by access to the events, even if their number and first
+    // and last pulse times stay the same
+    copy.buildPulseIndex();
+    TS_ASSERT(copy.hasPulseIndex());
+    copy.getEvents();
+    TS_ASSERT(!copy.hasPulseIndex());
+
+    // Invalidated by appending events, even once sorted by pulse time again
+    copy.buildPulseIndex();
+    copy.addEventQuickly(TofEvent(1.0, copy.getEvent(0).pulseTime()));
+    copy.sortPulseTime();
+    TS_ASSERT(!copy.hasPulseIndex());
+  }
+
+  void test_buildPulseIndex_is_not_kept_for_sparse_lists() {
+    // One event per pulse
+    this->fake_uniform_time_data();
+    el.buildPulseIndex();
+    TS_ASSERT(!el.hasPulseIndex());
+    TS_ASSERT_EQUALS(el.getSortType(), PULSETIME_SORT);
+
+    el.switchTo(WEIGHTED_NOTIME);
+    TS_ASSERT_THROWS(el.buildPulseIndex(), std::runtime_error);
+  }
+
+  void test_filterByPulseTime_with_pulse_index() {
+    for (int this_type = 0; this_type < 2; this_type++) {
+      this->fake_uniform_data(10);
+      el.switchTo(static_cast<EventType>(this_type));
+      el.buildPulseIndex();
+      TS_ASSERT(el.hasPulseIndex());
+
+      const int64_t ranges[][2] = {
+          {100, 200}, {-10, 5}, {999, 2000}, {0, 1000}, {500, 500}, {600, 400}};
+      for (const auto &range : ranges) {
+        EventList out;
+        el.filterByPulseTime(range[0], range[1], out);
+        size_t numGood = 0;
+        for (std::size_t i = 0; i < el.getNumberEvents(); i++)
+          if ((el.getEvent(i).pulseTime() >= range[0]) &&
+              (el.getEvent(i).pulseTime() < range[1]))
+            numGood++;
+        TS_ASSERT_EQUALS(numGood, out.getNumberEvents());
+        TS_ASSERT_EQUALS(out.getSortType(), PULSETIME_SORT);
+        for (std::size_t i = 0; i < out.getNumberEvents(); i++) {
+          TS_ASSERT_LESS_THAN_EQUALS(DateAndTime(range[0]),
+                                     out.getEvent(i).pulseTime());
+          TS_ASSERT_LESS_THAN(out.getEvent(i).pulseTime(),
+                              DateAndTime(range[1]));
+        }
+      }
+    }
+  }
+
+  void test_filterByTimeAtSample_with_pulse_index() {
+    const double tofFactor = 0.5;
+    const double tofOffset = 2e-6;
+    for (int this_type = 0; this_type < 2; this_type++) {
+      // 200 pulses, 100 microseconds apart, of 10 events with TOF's up to 1 ms
+      el = EventList();
+      srand(1234);
+      for (int64_t pulse = 0; pulse < 200; pulse++)
+        for (int i = 0; i < 10; i++)
+          el += TofEvent(1000. * rand() / RAND_MAX,
+                         DateAndTime(pulse * 100000));
+      el.switchTo(static_cast<EventType>(this_type));
+      el.buildPulseIndex();
+      TS_ASSERT(el.hasPulseIndex());
+
+      const int64_t ranges[][2] = {{2000000, 5000000},
+                                   {1234567, 1300000},
+                                   {-1000000, 300000},
+                                   {19000000, 30000000}};
+      for (const auto &range : ranges) {
+        EventList out;
+        el.filterByTimeAtSample(range[0], range[1], tofFactor, tofOffset, out);
+        size_t numGood = 0;
+        for (std::size_t i = 0; i < el.getNumberEvents(); i++) {
+          const int64_t tAtSample =
+              el.getEvent(i).pulseTime().totalNanoseconds() +
+              static_cast<int64_t>(tofFactor * el.getEvent(i).tof() * 1e3 +
+                                   tofOffset * 1e9);
+          if (tAtSample >= range[0] && tAtSample < range[1])
+            numGood++;
+        }
+        TS_ASSERT(numGood > 0);
+        TS_ASSERT_EQUALS(numGood, out.getNumberEvents());
+        TS_ASSERT_EQUALS(out.getSortType(), TIMEATSAMPLE_SORT);
+        int64_t previous = range[0];
+        for (std::size_t i = 0; i < out.getNumberEvents(); i++) {
+          const int64_t tAtSample =
+              out.getEvent(i).pulseTime().totalNanoseconds() +
+              static_cast<int64_t>(tofFactor * out.getEvent(i).tof() * 1e3 +
+                                   tofOffset * 1e9);
+          TS_ASSERT_LESS_THAN_EQUALS(previous, tAtSample);
+          TS_ASSERT_LESS_THAN(tAtSample, range[1]);
+          previous = tAtSample;
+        }
+      }
+    }
+  }
+
   //-----------------------------------------------------------------------------------------------
   /** Test method to split events by full time (pulse + tof) withtout correction
    * on TOF
@@ -1801,6 +2085,62 @@ public:
     return;
   }
 
+  //-----------------------------------------------------------------------------------------------
+  void test_splitByTimeIndex() {
+    for (int this_type = 0; this_type < 2; this_type++) {
+      // 1000 events in pulses 1 ms apart, with TOFs of less than a ms
+      fake_uniform_time_sns_data();
+      el.switchTo(static_cast<EventType>(this_type));
+
+      // Outputs 0-9, and 10 for the unfiltered events
+      std::vector<EventList *> outputs;
+      for (int i = 0; i <= 10; i++)
+        outputs.push_back(new EventList());
+
+      // Keep the even ms from 2 to 8, drop the odd ones
+      std::vector<int64_t> boundaries;
+      std::vector<int> destinations{10};
+      for (int i = 1; i < 10; i++) {
+        boundaries.push_back(i * 1000000);
+        destinations.push_back(i % 2 == 0 ? i
+                                          : TimeSplitterIndex::NO_DESTINATION);
+      }
+      destinations.back() = 10;
+      TimeSplitterIndex index(boundaries, destinations);
+
+      TS_ASSERT_EQUALS(el.splitByTimeIndex(index, outputs, false, 1.0, 0.0),
+                       4);
+      for (int i = 0; i < 10; i++)
+        TS_ASSERT_EQUALS(outputs[i]->getNumberEvents(),
+                         (i % 2 == 0 && i > 0) ? 1 : 0);
+      TS_ASSERT_EQUALS(outputs[2]->getEvent(0).pulseTime(),
+                       DateAndTime(int64_t(2000000)));
+      TS_ASSERT_EQUALS(outputs[2]->getEventType(), el.getEventType());
+      TS_ASSERT_EQUALS(outputs[10]->getNumberEvents(), 992);
+      TS_ASSERT_EQUALS(outputs[10]->getSortType(), PULSETIMETOF_SORT);
+
+      // A TOF shift of 2 ms moves the events by two outputs, unless only the
+      // pulse time is used
+      TS_ASSERT_EQUALS(el.splitByTimeIndex(index, outputs, false, 1.0, 2.0E-3),
+                       3);
+      TS_ASSERT_EQUALS(outputs[2]->getEvent(0).pulseTime(), DateAndTime(0));
+      TS_ASSERT_EQUALS(outputs[4]->getEvent(0).pulseTime(),
+                       DateAndTime(int64_t(2000000)));
+      el.splitByTimeIndex(index, outputs, true, 1.0, 2.0E-3);
+      TS_ASSERT_EQUALS(outputs[2]->getEvent(0).pulseTime(),
+                       DateAndTime(int64_t(2000000)));
+
+      // Events of destinations without an output are dropped
+      delete outputs[10];
+      outputs[10] = nullptr;
+      TS_ASSERT_EQUALS(el.splitByTimeIndex(index, outputs, false, 1.0, 0.0),
+                       996);
+
+      for (auto output : outputs)
+        delete output;
+    }
+  }
+
   //-----------------------------------------------------------------------------------------------
   void test_splitByTime_allTypes() {
     // Go through each possible EventType as the input
@@ -2049,6 +2389,142 @@ public:
     }   // starting event type
   }
 
+  void test_compressEvents_logarithmic() {
+    el = EventList();
+    for (const double tof : {100.0, 100.5, 101.5, 1000.0, 1004.0, 1012.0})
+      el.addEventQuickly(TofEvent(tof));
+    EventList linear;
+    el.compressEvents(1.0, &linear);
+    TS_ASSERT_EQUALS(linear.getNumberEvents(), 5);
+
+    // Within 1% of the first event of each group
+    el.compressEvents(-0.01, &el);
+    TS_ASSERT_EQUALS(el.getNumberEvents(), 4);
+    if (el.getNumberEvents() == 4) {
+      TS_ASSERT_DELTA(el.getEvent(0).tof(), 100.25, 1e-5);
+      TS_ASSERT_DELTA(el.getEvent(0).weight(), 2.0, 1e-5);
+      TS_ASSERT_DELTA(el.getEvent(1).tof(), 101.5, 1e-5);
+      TS_ASSERT_DELTA(el.getEvent(2).tof(), 1002.0, 1e-5);
+      TS_ASSERT_DELTA(el.getEvent(2).weight(), 2.0, 1e-5);
+      TS_ASSERT_DELTA(el.getEvent(3).tof(), 1012.0, 1e-5);
+    }
+  }
+
+  void test_compressAppendedEvents() {
+    // Events at 10 * i + 0.1 * j are compressed into 10 * i + 0.1
+    auto addEvents = [](std::vector<TofEvent> &events, const int j) {
+      for (int i = 99; i >= 0; i -= 3)
+        events.emplace_back(10.0 * i + 0.1 * j, 0);
+    };
+    EventList all;
+    for (int j = 0; j < 3; ++j)
+      addEvents(all.getEvents(), j);
+    all.compressEvents(0.5, &all);
+
+    // The vector is filled while the list is compressed, as when loading
+    el = EventList();
+    std::vector<TofEvent> &events = el.getEvents();
+    addEvents(events, 0);
+    el.compressAppendedEvents(0.5);
+    TS_ASSERT_EQUALS(el.getEventType(), WEIGHTED_NOTIME);
+    TS_ASSERT_EQUALS(el.getNumberEvents(), 34);
+    addEvents(events, 1);
+    el.compressAppendedEvents(0.5);
+    // Events added as when accumulating live data
+    EventList more;
+    addEvents(more.getEvents(), 2);
+    el += more;
+    el.compressAppendedEvents(0.5);
+
+    TS_ASSERT(events.empty());
+    TS_ASSERT(el.isSortedByTof());
+    TS_ASSERT_EQUALS(el.getNumberEvents(), all.getNumberEvents());
+    const auto &compressed = el.getWeightedEventsNoTime();
+    const auto &expected = all.getWeightedEventsNoTime();
+    for (size_t i = 0; i < std::min(compressed.size(), expected.size()); ++i) {
+      TS_ASSERT_DELTA(compressed[i].tof(), expected[i].tof(), 1e-9);
+      TS_ASSERT_DELTA(compressed[i].weight(), 3.0, 1e-9);
+      TS_ASSERT_DELTA(compressed[i].errorSquared(), 3.0, 1e-9);
+    }
+  }
+
+  void test_compressAppendedEvents_does_not_merge_adjacent_groups() {
+    // Compressed at once, {0, 1} and {1.01} are two groups
+    el = EventList();
+    el.getEvents().emplace_back(0.0, 0);
+    el.getEvents().emplace_back(1.0, 0);
+    el.compressAppendedEvents(1.0);
+    TS_ASSERT_EQUALS(el.getNumberEvents(), 1);
+    el += TofEvent(1.01, 0);
+    el.compressAppendedEvents(1.0);
+
+    TS_ASSERT_EQUALS(el.getNumberEvents(), 2);
+    const auto &events = el.getWeightedEventsNoTime();
+    if (events.size() == 2) {
+      TS_ASSERT_DELTA(events[0].tof(), 0.5, 1e-9);
+      TS_ASSERT_DELTA(events[0].weight(), 2.0, 1e-9);
+      TS_ASSERT_DELTA(events[1].tof(), 1.01, 1e-9);
+      TS_ASSERT_DELTA(events[1].weight(), 1.0, 1e-9);
+    }
+
+    // Events within the tolerance of the first event of a group are added to
+    // it, the others before the next group form a new one
+    el += TofEvent(0.9, 0);
+    el += TofEvent(1.005, 0);
+    el += TofEvent(1.8, 0);
+    el.compressAppendedEvents(1.0);
+    TS_ASSERT_EQUALS(el.getNumberEvents(), 3);
+    if (events.size() == 3) {
+      TS_ASSERT_DELTA(events[0].tof(), (0.0 + 1.0 + 0.9) / 3, 1e-9);
+      TS_ASSERT_DELTA(events[0].weight(), 3.0, 1e-9);
+      TS_ASSERT_DELTA(events[1].tof(), 1.005, 1e-9);
+      TS_ASSERT_DELTA(events[2].tof(), (1.01 + 1.8) / 2, 1e-9);
+      TS_ASSERT_DELTA(events[2].weight(), 2.0, 1e-9);
+    }
+  }
+
+  void test_compressAppendedEvents_logarithmic() {
+    // Groups span 10% of the TOF of their first event
+    el = EventList();
+    el.getEvents().emplace_back(100.0, 0);
+    el.getEvents().emplace_back(109.0, 0);
+    el.getEvents().emplace_back(1000.0, 0);
+    el.compressAppendedEvents(-0.1);
+    TS_ASSERT_EQUALS(el.getNumberEvents(), 2);
+    el += TofEvent(1090.0, 0);
+    el += TofEvent(111.0, 0);
+    el.compressAppendedEvents(-0.1);
+
+    const auto &events = el.getWeightedEventsNoTime();
+    TS_ASSERT_EQUALS(events.size(), 3);
+    if (events.size() == 3) {
+      TS_ASSERT_DELTA(events[0].weight(), 2.0, 1e-9);
+      TS_ASSERT_DELTA(events[1].tof(), 111.0, 1e-9);
+      TS_ASSERT_DELTA(events[2].tof(), 1045.0, 1e-9);
+      TS_ASSERT_DELTA(events[2].weight(), 2.0, 1e-9);
+    }
+  }
+
+  void test_compressAppendedEvents_after_other_changes() {
+    // A list that was compressed otherwise is compressed again as a whole
+    el = EventList();
+    el.getEvents().emplace_back(1.0, 0);
+    el.getEvents().emplace_back(3.0, 0);
+    el.compressEvents(1.0, &el);
+    TS_ASSERT_EQUALS(el.getNumberEvents(), 2);
+    el += TofEvent(1.5, 0);
+    el.compressAppendedEvents(1.0);
+    TS_ASSERT_EQUALS(el.getNumberEvents(), 2);
+    TS_ASSERT_DELTA(el.getWeightedEventsNoTime()[0].weight(), 2.0, 1e-9);
+
+    // ... as is one whose events were moved since the last call
+    el.addTof(100.0);
+    el += TofEvent(101.2, 0);
+    el.compressAppendedEvents(1.0);
+    TS_ASSERT_EQUALS(el.getNumberEvents(), 2);
+    TS_ASSERT_DELTA(el.getWeightedEventsNoTime()[0].weight(), 3.0, 1e-9);
+  }
+
   void test_getEventsFrom() {
     std::vector<TofEvent> *rel;
     TS_ASSERT_THROWS_NOTHING(getEventsFrom(el, rel));
@@ -2320,6 +2796,126 @@ public:
     return;
   }
 
+  //==================================================================================
+  //--- Columnar storage ---
+  //==================================================================================
+
+  void test_columnar_storage_round_trip() {
+    fake_data();
+    const std::vector<TofEvent> original = el.getEvents();
+    TS_ASSERT(!el.hasColumnarStorage());
+    el.setColumnarStorage(true);
+    TS_ASSERT(el.hasColumnarStorage());
+    TS_ASSERT_EQUALS(el.getNumberEvents(), NUMEVENTS);
+    TS_ASSERT(!el.empty());
+    // Accessing the events goes back to a vector of TofEvent
+    TS_ASSERT_EQUALS(el.getEvents(), original);
+    TS_ASSERT(!el.hasColumnarStorage());
+  }
+
+  void test_columnar_storage_does_nothing_for_weighted_events() {
+    fake_uniform_data_weights();
+    el.setColumnarStorage(true);
+    TS_ASSERT(!el.hasColumnarStorage());
+  }
+
+  void test_columnar_storage_add_events() {
+    EventList columnar;
+    columnar.setColumnarStorage(true);
+    columnar += TofEvent(12.5, 100);
+    columnar.addEventQuickly(TofEvent(2.5, 200));
+    TS_ASSERT(columnar.hasColumnarStorage());
+    TS_ASSERT_EQUALS(columnar.getNumberEvents(), 2);
+    TS_ASSERT_EQUALS(columnar.getEvent(1).tof(), 2.5);
+    TS_ASSERT_EQUALS(columnar.getEvent(1).pulseTime(), 200);
+  }
+
+  void test_columnar_storage_sortTof_keeps_pulse_times() {
+    fake_data();
+    EventList reference(el);
+    el.setColumnarStorage(true);
+    el.sortTof();
+    reference.sortTof();
+    TS_ASSERT(el.hasColumnarStorage());
+    TS_ASSERT_EQUALS(el.getTofs(), reference.getTofs());
+    TS_ASSERT_EQUALS(el.getPulseTimes(), reference.getPulseTimes());
+  }
+
+  void test_columnar_storage_histogram() {
+    fake_data();
+    EventList reference(el);
+    el.setColumnarStorage(true);
+    const MantidVec X = makeX(BIN_DELTA, NUMBINS);
+    MantidVec Y, E, refY, refE;
+    el.generateHistogram(X, Y, E);
+    reference.generateHistogram(X, refY, refE);
+    TS_ASSERT(el.hasColumnarStorage());
+    TS_ASSERT_EQUALS(Y, refY);
+    TS_ASSERT_EQUALS(E, refE);
+  }
+
+  void test_columnar_storage_tof_operations() {
+    fake_uniform_data();
+    EventList reference(el);
+    el.setColumnarStorage(true);
+
+    el.convertTof(2.0, 5.0);
+    reference.convertTof(2.0, 5.0);
+    el.maskTof(MAX_TOF * 0.5, MAX_TOF);
+    reference.maskTof(MAX_TOF * 0.5, MAX_TOF);
+    TS_ASSERT_EQUALS(el.getNumberEvents(), reference.getNumberEvents());
+    TS_ASSERT_EQUALS(el.getTofMin(), reference.getTofMin());
+    TS_ASSERT_EQUALS(el.getTofMax(), reference.getTofMax());
+    TS_ASSERT_EQUALS(el.getPulseTimeMin(), reference.getPulseTimeMin());
+    TS_ASSERT_EQUALS(el.getPulseTimeMax(), reference.getPulseTimeMax());
+    TS_ASSERT_DELTA(el.integrate(MAX_TOF * 0.1, MAX_TOF * 0.3, false),
+                    reference.integrate(MAX_TOF * 0.1, MAX_TOF * 0.3, false),
+                    1e-10);
+    el.addPulsetime(1.5);
+    reference.addPulsetime(1.5);
+    TS_ASSERT(el.hasColumnarStorage());
+    TS_ASSERT_EQUALS(el, reference);
+  }
+
+  void test_columnar_storage_switchTo_weighted() {
+    fake_data();
+    EventList reference(el);
+    el.setColumnarStorage(true);
+    el.switchTo(WEIGHTED);
+    reference.switchTo(WEIGHTED);
+    TS_ASSERT(!el.hasColumnarStorage());
+    TS_ASSERT_EQUALS(el.getWeightedEvents(), reference.getWeightedEvents());
+  }
+
+  void test_columnar_storage_const_readers_keep_the_layout() {
+    fake_data();
+    EventList reference(el);
+    el.setColumnarStorage(true);
+    const EventList &constEl = el;
+    TS_ASSERT_THROWS(constEl.getEvents(), std::runtime_error);
+    TS_ASSERT(constEl == reference);
+    TS_ASSERT(constEl.equals(reference, 0.0, 0.0, 0));
+    MantidVec X{0., 1e9, 1e12}, Y, refY;
+    constEl.generateCountsHistogramPulseTime(X, Y);
+    reference.generateCountsHistogramPulseTime(X, refY);
+    TS_ASSERT_EQUALS(Y, refY);
+    EventList sum;
+    sum += constEl;
+    TS_ASSERT_EQUALS(sum.getEvents().size(), el.getNumberEvents());
+    TS_ASSERT(el.hasColumnarStorage());
+  }
+
+  void test_setTofs_size_mismatch_throws() {
+    fake_data();
+    MantidVec tofs(el.getNumberEvents() + 1, 1.0);
+    TS_ASSERT_THROWS(el.setTofs(tofs), std::invalid_argument);
+    el.setColumnarStorage(true);
+    TS_ASSERT_THROWS(el.setTofs(tofs), std::invalid_argument);
+    tofs.pop_back();
+    TS_ASSERT_THROWS_NOTHING(el.setTofs(tofs));
+    TS_ASSERT_EQUALS(el.getTofs(), tofs);
+  }
+
   //==================================================================================
   // Mocking functions
   //==================================================================================
@@ -2573,6 +3169,22 @@ public:
     el_sorted_weighted.generateHistogram(coarseX, Y, E);
   }
 
+  void test_histogram_fine_columnar() {
+    el_sorted.setColumnarStorage(true);
+    MantidVec Y, E;
+    el_sorted.generateHistogram(fineX, Y, E);
+  }
+
+  void test_convertTof_columnar() {
+    el_sorted.setColumnarStorage(true);
+    el_sorted.convertTof(2.5, 6.78);
+  }
+
+  void test_sort_tof_columnar() {
+    el_random.setColumnarStorage(true);
+    el_random.sortTof();
+  }
+
   void test_maskTof() {
     TS_ASSERT_EQUALS(el_sorted.getNumberEvents(), 10000000);
     el_sorted.maskTof(25e3, 75e3);
@@ -7,11 +7,177 @@
 
 #include "MantidDataObjects/EventWorkspaceMRU.h"
 
+#include <boost/make_shared.hpp>
+#include <boost/weak_ptr.hpp>
+#include <cmath>
+#include <thread>
+
 using namespace Mantid::DataObjects;
+using Mantid::MantidVec;
+using Mantid::Kernel::cow_ptr;
 
 class EventWorkspaceMRUTest : public CxxTest::TestSuite {
 public:
-  void test_Something() {}
+  void test_find_and_insert() {
+    EventWorkspaceMRU mru(1024 * 1024);
+    const auto x = makeX(0.0, 1.0, 10);
+    TS_ASSERT(!mru.find(3, *x));
+
+    auto histogram = makeHistogram(3, x);
+    TS_ASSERT_EQUALS(mru.insert(histogram), histogram);
+    TS_ASSERT_EQUALS(mru.MRUSize(), 1);
+    TS_ASSERT_EQUALS(mru.getMemorySize(), histogram->getMemorySize());
+
+    // Found for equal bin edges of the same spectrum only
+    TS_ASSERT_EQUALS(mru.find(3, *x), histogram);
+    TS_ASSERT_EQUALS(mru.find(3, *makeX(0.0, 1.0, 10)), histogram);
+    TS_ASSERT(!mru.find(3, *makeX(0.0, 1.5, 10)));
+    TS_ASSERT(!mru.find(4, *x));
+
+    // Inserting the same histogram again keeps the cached one
+    TS_ASSERT_EQUALS(mru.insert(makeHistogram(3, x)), histogram);
+    TS_ASSERT_EQUALS(mru.MRUSize(), 1);
+  }
+
+  void test_several_binnings_of_a_spectrum() {
+    EventWorkspaceMRU mru(1024 * 1024);
+    auto fine = makeHistogram(7, makeX(0.0, 1.0, 10));
+    auto other = makeHistogram(7, makeX(0.5, 1.0, 10));
+    mru.insert(fine);
+    mru.insert(other);
+    TS_ASSERT_EQUALS(mru.MRUSize(), 2);
+    TS_ASSERT_EQUALS(mru.find(7, *fine->m_x), fine);
+    TS_ASSERT_EQUALS(mru.find(7, *other->m_x), other);
+
+    mru.deleteIndex(7);
+    TS_ASSERT_EQUALS(mru.MRUSize(), 0);
+    TS_ASSERT_EQUALS(mru.getMemorySize(), 0);
+  }
+
+  void test_coarser_binning_is_summed_from_finer_one() {
+    EventWorkspaceMRU mru(1024 * 1024);
+    mru.insert(makeHistogram(2, makeX(0.0, 1.0, 10)));
+
+    const MantidVec coarseX = {2.0, 4.0, 5.0, 10.0};
+    auto coarse = mru.find(2, coarseX);
+    TS_ASSERT(coarse);
+    if (!coarse)
+      return;
+    TS_ASSERT_EQUALS(*coarse->m_x, coarseX);
+    // Bin i of the fine histogram holds i counts
+    const MantidVec expectedY = {2.0 + 3.0, 4.0, 5.0 + 6.0 + 7.0 + 8.0 + 9.0};
+    TS_ASSERT_EQUALS(coarse->m_y, expectedY);
+    for (size_t i = 0; i < expectedY.size(); ++i)
+      TS_ASSERT_DELTA(coarse->m_e[i], std::sqrt(expectedY[i]), 1e-12);
+    // The coarse histogram is cached as well
+    TS_ASSERT_EQUALS(mru.MRUSize(), 2);
+    TS_ASSERT_EQUALS(mru.find(2, coarseX), coarse);
+
+    // Edges that are not edges of the fine histogram
+    const MantidVec shiftedX = {2.5, 4.0};
+    TS_ASSERT(!mru.find(2, shiftedX));
+    const MantidVec widerX = {0.0, 11.0};
+    TS_ASSERT(!mru.find(2, widerX));
+  }
+
+  void test_memory_limit() {
+    const auto x = makeX(0.0, 1.0, 10);
+    const size_t size = makeHistogram(0, x)->getMemorySize();
+    const size_t shards = EventWorkspaceMRU::NUM_SHARDS;
+    EventWorkspaceMRU mru(2 * size * shards);
+
+    // Spectra 0, shards, 2 * shards, ... are in the same shard
+    for (size_t i = 0; i < 3; ++i)
+      mru.insert(makeHistogram(i * shards, x));
+    TS_ASSERT_EQUALS(mru.MRUSize(), 2);
+    TS_ASSERT(!mru.find(0, *x));
+    TS_ASSERT(mru.find(shards, *x));
+
+    // Other shards have their own part of the memory
+    for (size_t i = 1; i < shards; ++i)
+      mru.insert(makeHistogram(i, x));
+    TS_ASSERT_EQUALS(mru.MRUSize(), shards + 1);
+
+    // Lowering the limit drops the least recently used histograms, but keeps
+    // the last one of each shard
+    mru.setMemoryLimit(0);
+    TS_ASSERT_EQUALS(mru.getMemoryLimit(), 0);
+    TS_ASSERT_EQUALS(mru.MRUSize(), shards);
+    TS_ASSERT(mru.find(shards, *x));
+    TS_ASSERT(!mru.find(2 * shards, *x));
+
+    mru.clear();
+    TS_ASSERT_EQUALS(mru.MRUSize(), 0);
+    TS_ASSERT_EQUALS(mru.getMemorySize(), 0);
+  }
+
+  void test_dropped_histograms_are_retained_for_a_while() {
+    const auto x = makeX(0.0, 1.0, 10);
+    EventWorkspaceMRU mru(0);
+    boost::weak_ptr<const CachedHistogram> first =
+        mru.insert(makeHistogram(0, x));
+    const size_t shards = EventWorkspaceMRU::NUM_SHARDS;
+
+    // Histograms returned to other threads do not count
+    std::thread other([this, &mru, &x] {
+      for (size_t i = 1; i <= 2 * EventWorkspaceMRU::NUM_RETAINED; ++i)
+        mru.insert(makeHistogram(i * shards, x));
+    });
+    other.join();
+    TS_ASSERT(!mru.find(0, *x));
+    TS_ASSERT(!first.expired());
+
+    for (size_t i = 1; i < EventWorkspaceMRU::NUM_RETAINED; ++i)
+      mru.insert(makeHistogram(i, x));
+    TS_ASSERT(!first.expired());
+
+    mru.insert(makeHistogram(EventWorkspaceMRU::NUM_RETAINED, x));
+    TS_ASSERT(first.expired());
+  }
+
+  void test_retained_histograms_are_freed_with_the_mru() {
+    const auto x = makeX(0.0, 1.0, 10);
+    boost::weak_ptr<const CachedHistogram> histogram;
+    {
+      EventWorkspaceMRU mru(0);
+      histogram = mru.insert(makeHistogram(0, x));
+      mru.clear();
+      TS_ASSERT(!histogram.expired());
+    }
+    TS_ASSERT(histogram.expired());
+  }
+
+  void test_find_by_identical_bin_edges_after_they_changed() {
+    EventWorkspaceMRU mru(1024 * 1024);
+    auto x = makeX(0.0, 1.0, 10);
+    auto histogram = makeHistogram(3, x);
+    mru.insert(histogram);
+    // Changing shared bin edges copies them, the cached ones stay the same
+    x.access()[0] = -1.0;
+    TS_ASSERT(!mru.find(3, *x));
+    TS_ASSERT_EQUALS(mru.find(3, *histogram->m_x), histogram);
+  }
+
+private:
+  /// Bin edges start, start + step, ...
+  cow_ptr<MantidVec> makeX(const double start, const double step,
+                           const size_t numBins) {
+    auto x = boost::make_shared<MantidVec>(numBins + 1);
+    for (size_t i = 0; i <= numBins; ++i)
+      (*x)[i] = start + step * static_cast<double>(i);
+    return cow_ptr<MantidVec>(x);
+  }
+
+  /// A histogram with i counts in bin i
+  boost::shared_ptr<CachedHistogram> makeHistogram(const size_t index,
+                                                   const cow_ptr<MantidVec> &x) {
+    auto histogram = boost::make_shared<CachedHistogram>(index, x);
+    for (size_t i = 0; i + 1 < x->size(); ++i) {
+      histogram->m_y.push_back(static_cast<double>(i));
+      histogram->m_e.push_back(std::sqrt(static_cast<double>(i)));
+    }
+    return histogram;
+  }
 };
 
 #endif /* MANTID_DATAOBJECTS_EVENTWORKSPACEMRUTEST_H_ */
@@ -446,8 +446,13 @@ public:
     data1 = ew2->dataY(0);
     TS_ASSERT_DELTA(ew2->dataY(0)[1], 2.0, 1e-6);
     TS_ASSERT_DELTA(data1[1], 2.0, 1e-6);
-    // Cache should now be full
-    TS_ASSERT_EQUALS(ew2->MRUSize(), 50);
+    // All fit within the default memory limit
+    TS_ASSERT_EQUALS(ew2->MRUSize(), 100);
+
+    // Without memory, each shard of the cache keeps its last histogram
+    ew->setMRUMemoryLimit(0);
+    const size_t full = EventWorkspaceMRU::NUM_SHARDS;
+    TS_ASSERT_EQUALS(ew2->MRUSize(), full);
 
     int last = 100;
     // Read more;
@@ -455,7 +460,7 @@ public:
       data1 = ew2->dataY(i);
 
     // Cache should now be full still
-    TS_ASSERT_EQUALS(ew2->MRUSize(), 50);
+    TS_ASSERT_EQUALS(ew2->MRUSize(), full);
 
     // Do it some more
     last = 200;
@@ -465,8 +470,8 @@ public:
     //----- Now we test that setAllX clears the memory ----
 
     // Yes, our eventworkspace MRU is full
-    TS_ASSERT_EQUALS(ew->MRUSize(), 50);
-    TS_ASSERT_EQUALS(ew2->MRUSize(), 50);
+    TS_ASSERT_EQUALS(ew->MRUSize(), full);
+    TS_ASSERT_EQUALS(ew2->MRUSize(), full);
     Kernel::cow_ptr<MantidVec> axis;
     MantidVec &xRef = axis.access();
     xRef.resize(10);
@@ -655,6 +660,9 @@ public:
     EventWorkspace_const_sptr ew2 =
         boost::dynamic_pointer_cast<const EventWorkspace>(ew);
 
+    // Keep only the last histogram of each shard of the MRU
+    ew->setMRUMemoryLimit(0);
+
     // OK, we grab data0 from the MRU.
     const auto &inSpec = ew2->getSpectrum(0);
     const auto &inSpec300 = ew2->getSpectrum(300);
@@ -667,12 +675,12 @@ public:
     for (size_t i = 0; i < 200; i++)
       MantidVec otherData = ew2->readY(i);
 
-    // data0 and e300 are now invalid references!
+    // data0 dropped off, so reading it again generates a new histogram
     TS_ASSERT_DIFFERS(&data0, &inSpec.readY());
     TS_ASSERT_DIFFERS(&e300, &inSpec.readE());
 
     // MRU is full
-    TS_ASSERT_EQUALS(ew2->MRUSize(), 50);
+    TS_ASSERT_EQUALS(ew2->MRUSize(), EventWorkspaceMRU::NUM_SHARDS);
   }
 
   //------------------------------------------------------------------------------
@@ -692,6 +700,24 @@ public:
     }
   }
 
+  void test_sortAll_TOF_columnar() {
+    EventWorkspace_sptr test_in =
+        WorkspaceCreationHelper::CreateRandomEventWorkspace(NUMBINS, NUMPIXELS);
+    const size_t numberEvents = test_in->getNumberEvents();
+    test_in->setColumnarStorage(true);
+    TS_ASSERT_EQUALS(test_in->getNumberEvents(), numberEvents);
+
+    test_in->sortAll(TOF_SORT, nullptr);
+
+    for (int wi = 0; wi < NUMPIXELS; wi++) {
+      const EventList &el = test_in->getSpectrum(wi);
+      TS_ASSERT(el.hasColumnarStorage());
+      const std::vector<double> tofs = el.getTofs();
+      TS_ASSERT_EQUALS(tofs.size(), NUMBINS);
+      TS_ASSERT(std::is_sorted(tofs.begin(), tofs.end()));
+    }
+  }
+
   /** Test sortAll() when there are more cores available than pixels.
    * This test will only work on machines with 2 cores at least.
    */
@@ -0,0 +1,224 @@
+#ifndef MANTID_DATAOBJECTS_LAZYEVENTCACHETEST_H_
+#define MANTID_DATAOBJECTS_LAZYEVENTCACHETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/EventList.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/LazyEventCache.h"
+
+#include <boost/make_shared.hpp>
+
+using namespace Mantid::DataObjects;
+
+namespace {
+/// Each part holds two spectra, spectrum i gets i+1 events.
+class FakeLazyEventLoader : public LazyEventLoader {
+public:
+  explicit FakeLazyEventLoader(size_t numParts) : m_numParts(numParts) {}
+  size_t numberOfParts() const override { return m_numParts; }
+  std::vector<size_t> workspaceIndices(const size_t part) const override {
+    return {2 * part, 2 * part + 1};
+  }
+  void load(const size_t part,
+            const std::vector<EventList *> &eventLists) const override {
+    loads.push_back(part);
+    for (const auto index : workspaceIndices(part))
+      for (size_t i = 0; i <= index; ++i)
+        eventLists[index]->addEventQuickly(
+            TofEvent(static_cast<double>(i), 0));
+  }
+  bool readX(std::vector<double> &xOut) const override {
+    xOut = x;
+    return !x.empty();
+  }
+  mutable std::vector<size_t> loads;
+  std::vector<double> x;
+
+private:
+  size_t m_numParts;
+};
+
+EventWorkspace_sptr createWorkspace(size_t numParts) {
+  auto ws = boost::make_shared<EventWorkspace>();
+  ws->initialize(2 * numParts + 1, 2, 1);
+  return ws;
+}
+}
+
+class LazyEventCacheTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static LazyEventCacheTest *createSuite() { return new LazyEventCacheTest(); }
+  static void destroySuite(LazyEventCacheTest *suite) { delete suite; }
+
+  void test_parts_are_loaded_on_first_access() {
+    auto ws = createWorkspace(3);
+    auto loader = boost::make_shared<FakeLazyEventLoader>(3);
+    ws->setLazyLoader(loader);
+    TS_ASSERT(ws->isLazilyLoaded());
+    TS_ASSERT(loader->loads.empty());
+    TS_ASSERT(!ws->isLoaded(3));
+
+    const auto &constWs = *ws;
+    TS_ASSERT_EQUALS(constWs.getSpectrum(3).getNumberEvents(), 4);
+    TS_ASSERT_EQUALS(constWs.getSpectrum(2).getNumberEvents(), 3);
+    TS_ASSERT_EQUALS(loader->loads, std::vector<size_t>{1});
+    TS_ASSERT(ws->isLoaded(2));
+    TS_ASSERT(!ws->isLoaded(0));
+    // The last spectrum belongs to no part
+    TS_ASSERT(ws->isLoaded(6));
+
+    TS_ASSERT_EQUALS(ws->getNumberEvents(), 21);
+    TS_ASSERT_EQUALS(loader->loads.size(), 3);
+  }
+
+  void test_loaded_parts_stay_in_memory() {
+    auto ws = createWorkspace(3);
+    auto loader = boost::make_shared<FakeLazyEventLoader>(3);
+    ws->setLazyLoader(loader);
+
+    const auto &constWs = *ws;
+    const EventList &first = constWs.getSpectrum(0);
+    ws->getSpectrum(1).addEventQuickly(TofEvent(10., 0));
+    constWs.getSpectrum(2);
+    constWs.getSpectrum(4);
+    TS_ASSERT(ws->isLoaded(0));
+    TS_ASSERT_EQUALS(first.getNumberEvents(), 1);
+    TS_ASSERT_EQUALS(constWs.getSpectrum(1).getNumberEvents(), 3);
+    TS_ASSERT_EQUALS(loader->loads, (std::vector<size_t>{0, 1, 2}));
+  }
+
+  void test_sort_type_is_unsorted_until_all_parts_are_loaded() {
+    auto ws = createWorkspace(2);
+    for (size_t i = 0; i < ws->getNumberHistograms(); ++i)
+      ws->getSpectrum(i).setSortOrder(TOF_SORT);
+    ws->setLazyLoader(boost::make_shared<FakeLazyEventLoader>(2));
+    TS_ASSERT_EQUALS(ws->getSortType(), UNSORTED);
+    ws->sortAll(TOF_SORT, nullptr);
+    TS_ASSERT(ws->isLoaded(0));
+    TS_ASSERT(ws->isLoaded(2));
+    TS_ASSERT_EQUALS(ws->getSortType(), TOF_SORT);
+  }
+
+  void test_columnar_storage_applies_to_parts_loaded_later() {
+    auto ws = createWorkspace(2);
+    ws->setLazyLoader(boost::make_shared<FakeLazyEventLoader>(2));
+    const auto &constWs = *ws;
+    constWs.getSpectrum(0);
+    ws->setColumnarStorage(true);
+    TS_ASSERT(constWs.getSpectrum(0).hasColumnarStorage());
+    TS_ASSERT(!ws->isLoaded(2));
+    TS_ASSERT(constWs.getSpectrum(3).hasColumnarStorage());
+    TS_ASSERT_EQUALS(constWs.getSpectrum(3).getNumberEvents(), 4);
+  }
+
+  void test_X_is_kept_when_a_part_is_loaded() {
+    auto ws = createWorkspace(2);
+    ws->setLazyLoader(boost::make_shared<FakeLazyEventLoader>(2));
+    Mantid::Kernel::cow_ptr<Mantid::MantidVec> axis;
+    axis.access() = {-1., 5.};
+    ws->setAllX(axis);
+    const auto &constWs = *ws;
+    TS_ASSERT_EQUALS(constWs.getSpectrum(3).readX(), axis.access());
+    TS_ASSERT_EQUALS(constWs.getSpectrum(3).readY()[0], 4.);
+  }
+
+  void test_X_of_loader_is_set_on_first_access() {
+    auto ws = createWorkspace(2);
+    auto loader = boost::make_shared<FakeLazyEventLoader>(2);
+    loader->x = {-2., 7.};
+    ws->setLazyLoader(loader);
+    const auto &constWs = *ws;
+    TS_ASSERT_EQUALS(constWs.getSpectrum(4).readX(), loader->x);
+    TS_ASSERT_EQUALS(constWs.getSpectrum(0).readX(), loader->x);
+  }
+
+  void test_X_set_explicitly_replaces_X_of_loader() {
+    auto ws = createWorkspace(2);
+    auto loader = boost::make_shared<FakeLazyEventLoader>(2);
+    loader->x = {-2., 7.};
+    ws->setLazyLoader(loader);
+    Mantid::Kernel::cow_ptr<Mantid::MantidVec> axis;
+    axis.access() = {-1., 5.};
+    ws->setAllX(axis);
+    const auto &constWs = *ws;
+    TS_ASSERT_EQUALS(constWs.getSpectrum(0).readX(), axis.access());
+  }
+
+  void test_least_recently_used_parts_are_cleared_beyond_memory_limit() {
+    auto ws = createWorkspace(3);
+    auto loader = boost::make_shared<FakeLazyEventLoader>(3);
+    ws->setLazyLoader(loader, 1);
+    const auto &constWs = *ws;
+    constWs.getSpectrum(0);
+    constWs.getSpectrum(2);
+    // The part accessed last is kept
+    TS_ASSERT(!ws->isLoaded(0));
+    TS_ASSERT(ws->isLoaded(2));
+    TS_ASSERT_EQUALS(constWs.getSpectrum(1).getNumberEvents(), 2);
+    TS_ASSERT(!ws->isLoaded(2));
+    TS_ASSERT_EQUALS(loader->loads, (std::vector<size_t>{0, 1, 0}));
+    TS_ASSERT_EQUALS(ws->getSortType(), UNSORTED);
+    TS_ASSERT_EQUALS(ws->getNumberEvents(), 21);
+  }
+
+  void test_pinned_parts_are_not_cleared() {
+    auto ws = createWorkspace(3);
+    auto loader = boost::make_shared<FakeLazyEventLoader>(3);
+    ws->setLazyLoader(loader, 1);
+    const auto &constWs = *ws;
+    ws->pinSpectrum(1);
+    const EventList &pinned = constWs.getSpectrum(1);
+    constWs.getSpectrum(2);
+    constWs.getSpectrum(4);
+    TS_ASSERT(ws->isLoaded(0));
+    TS_ASSERT(!ws->isLoaded(2));
+    TS_ASSERT_EQUALS(pinned.getNumberEvents(), 2);
+    ws->unpinSpectrum(1);
+    constWs.getSpectrum(2);
+    TS_ASSERT(!ws->isLoaded(0));
+    TS_ASSERT_THROWS(ws->unpinSpectrum(1), std::logic_error);
+  }
+
+  void test_modified_parts_are_not_cleared() {
+    auto ws = createWorkspace(3);
+    auto loader = boost::make_shared<FakeLazyEventLoader>(3);
+    ws->setLazyLoader(loader, 1);
+    const auto &constWs = *ws;
+    ws->getSpectrum(1).addEventQuickly(TofEvent(10., 0));
+    constWs.getSpectrum(2);
+    constWs.getSpectrum(4);
+    TS_ASSERT(ws->isLoaded(0));
+    TS_ASSERT_EQUALS(constWs.getSpectrum(1).getNumberEvents(), 3);
+    TS_ASSERT_EQUALS(loader->loads, (std::vector<size_t>{0, 1, 2}));
+  }
+
+  void test_clone_reads_all_events() {
+    auto ws = createWorkspace(2);
+    ws->setLazyLoader(boost::make_shared<FakeLazyEventLoader>(2));
+    auto clone = ws->clone();
+    TS_ASSERT(!clone->isLazilyLoaded());
+    for (size_t i = 0; i < 4; ++i)
+      TS_ASSERT_EQUALS(clone->getSpectrum(i).getNumberEvents(), i + 1);
+  }
+
+  void test_deleteEmptyLists_reads_all_events() {
+    auto ws = createWorkspace(2);
+    ws->setLazyLoader(boost::make_shared<FakeLazyEventLoader>(2));
+    ws->deleteEmptyLists();
+    TS_ASSERT(!ws->isLazilyLoaded());
+    TS_ASSERT_EQUALS(ws->getNumberHistograms(), 4);
+    TS_ASSERT_EQUALS(ws->getNumberEvents(), 10);
+  }
+
+  void test_index_out_of_range_in_part_throws() {
+    auto ws = createWorkspace(1);
+    TS_ASSERT_THROWS(
+        ws->setLazyLoader(boost::make_shared<FakeLazyEventLoader>(2)),
+        std::out_of_range);
+  }
+};
+
+#endif /* MANTID_DATAOBJECTS_LAZYEVENTCACHETEST_H_ */
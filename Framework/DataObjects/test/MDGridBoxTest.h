@@ -863,6 +863,46 @@ public:
     delete bcc;
   }
 
+  //-------------------------------------------------------------------------------------
+  /** Add events in one go to a recursively gridded box, the children adding
+   * their events in parallel */
+  void test_addEventsUnsafe_recursive() {
+    auto b = MDEventsTestHelper::makeRecursiveMDGridBox<2>(3, 1);
+    b->getBoxController()->setAddingEvents_eventsPerTask(1);
+    std::vector<MDLeanEvent<2>> events;
+
+    // Make two events in the middle of each of the 9x9 leaf boxes
+    for (size_t i = 0; i < 2; i++)
+      for (double x = 0.5; x < 9; x += 1.0)
+        for (double y = 0.5; y < 9; y += 1.0) {
+          coord_t centers[2] = {static_cast<coord_t>(x / 3.0),
+                                static_cast<coord_t>(y / 3.0)};
+          events.push_back(MDLeanEvent<2>(2.0, 2.0, centers));
+        }
+    // This one is out of bounds
+    coord_t outside[2] = {10.0, 10.0};
+    events.push_back(MDLeanEvent<2>(2.0, 2.0, outside));
+
+    size_t numbad = 0;
+    TS_ASSERT_THROWS_NOTHING(numbad = b->addEventsUnsafe(events););
+    b->refreshCache(NULL);
+    TS_ASSERT_EQUALS(numbad, 1);
+    TS_ASSERT_EQUALS(b->getNPoints(), 162);
+    TS_ASSERT_EQUALS(b->getSignal(), 162 * 2.0);
+
+    std::vector<API::IMDNode *> boxes;
+    b->getBoxes(boxes, 2, true);
+    TS_ASSERT_EQUALS(boxes.size(), 81);
+    for (auto box : boxes) {
+      TS_ASSERT_EQUALS(box->getNPoints(), 2);
+      TS_ASSERT_EQUALS(box->getSignal(), 4.0);
+    }
+
+    BoxController *const bcc = b->getBoxController();
+    delete b;
+    delete bcc;
+  }
+
   //-------------------------------------------------------------------------------------
   void
   test_addEvents_min_event_boundary_kept_and_on_max_boxboundary_thrown_away() {
@@ -132,6 +132,8 @@ public:
 
   /// return reference to detector cache
   void getDetectors(detid2det_map &out_map) const;
+  /// Caches the positions of all detectors in the parameter map
+  void cacheDetectorPositions() const;
 
   std::vector<detid_t> getDetectorIDs(bool skipMonitors = false) const;
 
@@ -57,6 +57,10 @@ MANTID_GEOMETRY_DLL void moveComponent(const IComponent &comp,
                                        ParameterMap &pmap,
                                        const Kernel::V3D &pos,
                                        const TransformType positionType);
+/// Position of a component relative to its parent after moving it
+MANTID_GEOMETRY_DLL Kernel::V3D
+getRelativePosition(const IComponent &comp, const Kernel::V3D &pos,
+                    const TransformType positionType);
 /// Rotate a component
 MANTID_GEOMETRY_DLL void rotateComponent(const IComponent &comp,
                                          ParameterMap &pmap,
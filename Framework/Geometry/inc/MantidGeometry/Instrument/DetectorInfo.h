@@ -0,0 +1,97 @@
+#ifndef MANTID_GEOMETRY_DETECTORINFO_H_
+#define MANTID_GEOMETRY_DETECTORINFO_H_
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidGeometry/IDTypes.h"
+#include "MantidKernel/V3D.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace Geometry {
+class Instrument;
+
+/** DetectorInfo : Flat, index-addressable snapshot of the per-detector
+  geometry of a (parametrized) instrument.
+
+  The constructor walks all detectors of the instrument exactly once and
+  stores their position, mask flag and monitor flag in contiguous arrays,
+  together with the source and sample positions. Subsequent access is a
+  plain array lookup and does not touch the ParameterMap, so this is suitable
+  for hot loops over many detectors. Detectors are indexed in order of
+  increasing detector ID; use indexOf() to translate an ID into an index.
+
+  The snapshot is not updated if the instrument or its parameters change
+  after construction.
+
+  Copyright &copy; 2016 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_GEOMETRY_DLL DetectorInfo {
+public:
+  explicit DetectorInfo(const Instrument &instrument);
+
+  /// Returns the number of detectors (including monitors).
+  size_t size() const { return m_detectorIDs.size(); }
+  /// Returns the sorted list of detector IDs. Position in this list is the
+  /// detector index.
+  const std::vector<detid_t> &detectorIDs() const { return m_detectorIDs; }
+  size_t indexOf(const detid_t detectorID) const;
+  bool contains(const detid_t detectorID) const;
+
+  /// Returns true if the detector with the given index is a monitor.
+  bool isMonitor(const size_t index) const { return m_isMonitor[index] != 0; }
+  /// Returns true if the detector with the given index is masked.
+  bool isMasked(const size_t index) const { return m_isMasked[index] != 0; }
+  /// Returns the absolute position of the detector with the given index.
+  const Kernel::V3D &position(const size_t index) const {
+    return m_positions[index];
+  }
+
+  /// Returns true if the instrument defines both a source and a sample.
+  bool hasSourceAndSample() const { return m_hasSourceAndSample; }
+  const Kernel::V3D &sourcePosition() const;
+  const Kernel::V3D &samplePosition() const;
+  double l1() const;
+  /// Returns the instrument up direction of the reference frame.
+  const Kernel::V3D &upDirection() const { return m_upDirection; }
+
+private:
+  void checkSourceAndSample() const;
+
+  std::vector<detid_t> m_detectorIDs;
+  std::vector<Kernel::V3D> m_positions;
+  // uint8_t instead of bool so that concurrent writes during construction to
+  // neighbouring elements are safe.
+  std::vector<uint8_t> m_isMonitor;
+  std::vector<uint8_t> m_isMasked;
+  bool m_hasSourceAndSample;
+  Kernel::V3D m_sourcePosition;
+  Kernel::V3D m_samplePosition;
+  Kernel::V3D m_upDirection;
+  double m_l1;
+};
+
+} // namespace Geometry
+} // namespace Mantid
+
+#endif /* MANTID_GEOMETRY_DETECTORINFO_H_ */
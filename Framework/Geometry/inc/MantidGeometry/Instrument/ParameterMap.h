@@ -7,10 +7,14 @@
 #include "MantidGeometry/IDTypes.h" //For specnum_t
 #include "MantidGeometry/Instrument/Parameter.h"
 #include "MantidGeometry/Instrument/ParameterFactory.h"
+#include "MantidGeometry/Instrument/ParameterName.h"
 #include "MantidGeometry/Objects/BoundingBox.h"
-#include "MantidKernel/Cache.h"
+#include "MantidKernel/SnapshotCache.h"
+
+#include <boost/functional/hash.hpp>
 
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <typeinfo>
 
@@ -71,8 +75,16 @@ public:
   /// Parameter map iterator typedef
   typedef std::multimap<const ComponentID,
                         boost::shared_ptr<Parameter>>::const_iterator pmap_cit;
+  /// A parameter and the component it is attached to, for adding many
+  /// parameters at once
+  typedef std::pair<const IComponent *, boost::shared_ptr<Parameter>>
+      ComponentParameter;
   /// Default constructor
   ParameterMap();
+  /// Copy constructor
+  ParameterMap(const ParameterMap &other);
+  /// Copy assignment operator
+  ParameterMap &operator=(const ParameterMap &other);
   /// Returns true if the map is empty, false otherwise
   inline bool empty() const { return m_map.empty(); }
   /// Return the size of the map
@@ -104,12 +116,14 @@ public:
   /// Clears the map
   inline void clear() {
     m_map.clear();
+    m_index.clear();
     clearPositionSensitiveCaches();
   }
   /// method swaps two parameter maps contents  each other. All caches contents
   /// is nullified (TO DO: it can be efficiently swapped too)
   void swap(ParameterMap &other) {
     m_map.swap(other.m_map);
+    m_index.swap(other.m_index);
     clearPositionSensitiveCaches();
   }
   /// Clear any parameters with the given name
@@ -140,17 +154,44 @@ public:
   void add(const std::string &type, const IComponent *comp,
            const std::string &name, const T &value,
            const std::string *const pDescription = nullptr) {
-    auto param = ParameterFactory::create(type, name);
-    auto typedParam = boost::dynamic_pointer_cast<ParameterType<T>>(param);
-    assert(typedParam); // If not true the factory has created the wrong type
-    typedParam->setValue(value);
-
-    this->add(comp, param, pDescription);
+    this->add(comp, makeParameter<T>(type, name, value), pDescription);
   }
   /// Method for adding a parameter providing shared pointer to it. The class
   /// stores share pointer and increment ref count to it
   void add(const IComponent *comp, const boost::shared_ptr<Parameter> &par,
            const std::string *const pDescription = nullptr);
+  /// Add or replace many parameters at once
+  void add(const std::vector<ComponentParameter> &params);
+
+  /**
+   * Create a parameter of a particular type, e.g. to add it with other
+   * parameters using add(const std::vector<ComponentParameter> &)
+   * @tparam T The concrete type
+   * @param type :: A string denoting the type, e.g. double, string, fitting
+   * @param name :: The name of the parameter
+   * @param value :: The parameter's value
+   * @param pDescription :: if present, the constant pointer to a constant
+   * string, containing parameter's description.
+   * @return the new parameter
+   */
+  template <class T>
+  static boost::shared_ptr<Parameter>
+  makeParameter(const std::string &type, const std::string &name,
+                const T &value,
+                const std::string *const pDescription = nullptr) {
+    auto param = ParameterFactory::create(type, name);
+    auto typedParam = boost::dynamic_pointer_cast<ParameterType<T>>(param);
+    assert(typedParam); // If not true the factory has created the wrong type
+    typedParam->setValue(value);
+    if (pDescription)
+      param->setDescription(*pDescription);
+    return param;
+  }
+  /// Create a parameter providing its value as a string
+  static boost::shared_ptr<Parameter>
+  makeParameter(const std::string &type, const std::string &name,
+                const std::string &value,
+                const std::string *const pDescription = nullptr);
 
   /** @name Helper methods for adding and updating parameter types  */
   /// Create or adjust "pos" parameter for a component
@@ -216,6 +257,10 @@ public:
   /// Get a parameter with a given name and type (c-string version)
   boost::shared_ptr<Parameter> get(const IComponent *comp, const char *name,
                                    const char *type = "") const;
+  /// Get a parameter with a given interned name and type
+  boost::shared_ptr<Parameter> get(const IComponent *comp,
+                                   const ParameterName &name,
+                                   const std::string &type = "") const;
   /// Finds the parameter in the map via the parameter type.
   boost::shared_ptr<Parameter> getByType(const IComponent *comp,
                                          const std::string &type) const;
@@ -229,6 +274,11 @@ public:
   boost::shared_ptr<Parameter> getRecursive(const IComponent *comp,
                                             const char *name,
                                             const char *type = "") const;
+  /// Use get() recursively to see if can find param in all parents of comp and
+  /// given type (interned name version)
+  boost::shared_ptr<Parameter> getRecursive(const IComponent *comp,
+                                            const ParameterName &name,
+                                            const std::string &type = "") const;
   /// Looks recursively upwards in the component tree for the first instance of
   /// a parameter with a specified type.
   boost::shared_ptr<Parameter>
@@ -318,6 +368,18 @@ public:
                             const BoundingBox &box) const;
   /// Attempts to retrieve a bounding box from the cache
   bool getCachedBoundingBox(const IComponent *comp, BoundingBox &box) const;
+  /// Caches the locations and rotations of many components at once
+  void cachePositions(const std::vector<const IComponent *> &components,
+                      const std::vector<Kernel::V3D> &locations,
+                      const std::vector<Kernel::Quat> &rotations) const;
+  /// Returns true if cachePositions() was called since the last change
+  bool hasCachedPositions() const;
+  /// Attempts to retrieve a location given to cachePositions(), without locking
+  bool getPrecomputedLocation(const IComponent *comp,
+                              Kernel::V3D &location) const;
+  /// Attempts to retrieve a rotation given to cachePositions(), without locking
+  bool getPrecomputedRotation(const IComponent *comp,
+                              Kernel::Quat &rotation) const;
   /// Persist a representation of the Parameter map to the open Nexus file
   void saveNexus(::NeXus::File *file, const std::string &group) const;
   /// Copy pairs (oldComp->id,Parameter) to the m_map assigning the new
@@ -348,18 +410,42 @@ private:
   /// the parameter map
   component_map_cit positionOf(const IComponent *comp, const char *name,
                                const char *type) const;
+  /// internal function to get position of a parameter by name id
+  component_map_it findIndexed(const ComponentID id, const size_t nameId,
+                               const char *type) const;
+  /// add or replace a parameter, without locking
+  void addUnlocked(const IComponent *comp,
+                   const boost::shared_ptr<Parameter> &par);
+  /// erase a parameter from the map and the index
+  component_map_it erase(component_map_it it);
+  /// rebuild the index of m_map
+  void rebuildIndex();
+
+  /// Key of the index: a component and the id of a parameter name
+  typedef std::pair<ComponentID, size_t> IndexKey;
+  /// Hash of an IndexKey
+  struct IndexKeyHash {
+    size_t operator()(const IndexKey &key) const {
+      size_t seed = 0;
+      boost::hash_combine(seed, key.first);
+      boost::hash_combine(seed, key.second);
+      return seed;
+    }
+  };
 
   /// internal list of parameter files loaded
   std::vector<std::string> m_parameterFileNames;
 
   /// internal parameter map instance
   pmap m_map;
+  /// index of the first parameter of each name of each component in m_map
+  std::unordered_map<IndexKey, pmap_it, IndexKeyHash> m_index;
   /// internal cache map instance for cached position values
-  mutable Kernel::Cache<const ComponentID, Kernel::V3D> m_cacheLocMap;
+  mutable Kernel::SnapshotCache<ComponentID, Kernel::V3D> m_cacheLocMap;
   /// internal cache map instance for cached rotation values
-  mutable Kernel::Cache<const ComponentID, Kernel::Quat> m_cacheRotMap;
+  mutable Kernel::SnapshotCache<ComponentID, Kernel::Quat> m_cacheRotMap;
   /// internal cache map for cached bounding boxes
-  mutable Kernel::Cache<const ComponentID, BoundingBox> m_boundingBoxMap;
+  mutable Kernel::SnapshotCache<ComponentID, BoundingBox> m_boundingBoxMap;
 };
 
 /// ParameterMap shared pointer typedef
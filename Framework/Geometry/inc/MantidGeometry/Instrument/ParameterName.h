@@ -0,0 +1,68 @@
+#ifndef MANTID_GEOMETRY_PARAMETERNAME_H_
+#define MANTID_GEOMETRY_PARAMETERNAME_H_
+
+#include "MantidGeometry/DllConfig.h"
+
+#include <string>
+
+namespace Mantid {
+namespace Geometry {
+
+/** ParameterName : An interned name of a parameter of the ParameterMap.
+
+  ParameterMap compares parameter names case-insensitively, so all names that
+  only differ in case share the same id. Looking a name up once and passing
+  the ParameterName to ParameterMap::get() avoids string comparisons when the
+  same parameter is read for many components. Looking up a name that was
+  interned before does not lock, so string lookups from many threads do not
+  contend.
+
+  Copyright &copy; 2016 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_GEOMETRY_DLL ParameterName {
+public:
+  explicit ParameterName(const std::string &name);
+
+  /// Returns the id of the name
+  size_t id() const { return m_id; }
+  const std::string &name() const;
+
+  bool operator==(const ParameterName &other) const {
+    return m_id == other.m_id;
+  }
+  bool operator!=(const ParameterName &other) const {
+    return m_id != other.m_id;
+  }
+
+  static bool find(const char *name, size_t &id);
+
+private:
+  /// Index of the name in the table of all names
+  size_t m_id;
+  /// The name as first interned, owned by the table of all names
+  const std::string *m_name;
+};
+
+} // namespace Geometry
+} // namespace Mantid
+
+#endif /* MANTID_GEOMETRY_PARAMETERNAME_H_ */
@@ -4,6 +4,7 @@
 #include "MantidGeometry/Instrument/ReferenceFrame.h"
 #include "MantidGeometry/Instrument/RectangularDetector.h"
 #include "MantidKernel/Exception.h"
+#include "MantidKernel/MultiThreaded.h"
 
 #include <boost/make_shared.hpp>
 #include <queue>
@@ -194,6 +195,38 @@ void Instrument::getDetectors(detid2det_map &out_map) const {
   }
 }
 
+//------------------------------------------------------------------------------------------
+/** Computes the positions and rotations of all detectors in one pass and
+ * caches them in the parameter map. Afterwards, getPos() and getRotation() of
+ * the detectors look them up without locking, e.g. in parallel loops over the
+ * spectra of a workspace. Does nothing if the instrument is not parametrized,
+ * as the detectors then store their positions themselves, or if the positions
+ * were cached already and the parameters have not changed since.
+ */
+void Instrument::cacheDetectorPositions() const {
+  if (!m_map || m_map->hasCachedPositions())
+    return;
+  const detid2det_map &baseDets =
+      static_cast<const Instrument *>(m_base)->m_detectorCache;
+  std::vector<const IDetector *> detectors;
+  detectors.reserve(baseDets.size());
+  for (const auto &det : baseDets)
+    detectors.push_back(det.second.get());
+
+  const int64_t numDetectors = static_cast<int64_t>(detectors.size());
+  std::vector<V3D> locations(detectors.size());
+  std::vector<Quat> rotations(detectors.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < numDetectors; ++i) {
+    auto det = ParComponentFactory::createDetector(detectors[i], m_map);
+    locations[i] = det->getPos();
+    rotations[i] = det->getRotation();
+  }
+  m_map->cachePositions(std::vector<const IComponent *>(detectors.begin(),
+                                                        detectors.end()),
+                        locations, rotations);
+}
+
 //------------------------------------------------------------------------------------------
 /** Return a vector of detector IDs in this instrument */
 std::vector<detid_t> Instrument::getDetectorIDs(bool skipMonitors) const {
@@ -315,6 +315,10 @@ V3D Component::getScaleFactor() const {
 */
 V3D Component::getPos() const {
   if (this->m_map) {
+    // The positions of detectors may have been computed in advance
+    V3D precomputed;
+    if (m_map->getPrecomputedLocation(m_base, precomputed))
+      return precomputed;
     // Avoid instantiation of the parent's parameterized object if possible
     const IComponent *baseParent = m_base->m_parent;
     if (!baseParent) {
@@ -368,6 +372,9 @@ const Quat &Component::getRelativeRot() const {
 */
 const Quat Component::getRotation() const {
   if (m_map) {
+    Quat precomputed;
+    if (m_map->getPrecomputedRotation(m_base, precomputed))
+      return precomputed;
     // Avoid instantiation of the parent's parameterized object if possible
     const IComponent *baseParent = m_base->m_parent;
     if (!baseParent) {
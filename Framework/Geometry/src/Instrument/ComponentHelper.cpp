@@ -29,6 +29,22 @@ using Kernel::Quat;
  */
 void moveComponent(const IComponent &comp, ParameterMap &pmap,
                    const Kernel::V3D &pos, const TransformType positionType) {
+  // Add a parameter for the new position
+  pmap.addV3D(comp.getComponentID(), "pos",
+              getRelativePosition(comp, pos, positionType));
+}
+
+/**
+ * Compute the position of a component relative to its parent, which is the
+ * value of its "pos" parameter, when moving it to a new position
+ * @param comp A reference to the component to move
+ * @param pos The new position
+ * @param positionType Defines how the given position should be interpreted @see
+ * TransformType enumeration
+ * @return the position relative to the parent of the component
+ */
+Kernel::V3D getRelativePosition(const IComponent &comp, const Kernel::V3D &pos,
+                                const TransformType positionType) {
   //
   // This behaviour was copied from how MoveInstrumentComponent worked
   //
@@ -54,9 +70,7 @@ void moveComponent(const IComponent &comp, ParameterMap &pmap,
     rot.inverse();
     rot.rotate(newPos);
   }
-
-  // Add a parameter for the new position
-  pmap.addV3D(comp.getComponentID(), "pos", newPos);
+  return newPos;
 }
 
 /**
@@ -0,0 +1,95 @@
+#include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/ReferenceFrame.h"
+#include "MantidKernel/Exception.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
+
+namespace Mantid {
+namespace Geometry {
+
+/** Build the flat detector arrays for the given instrument.
+ *
+ * @param instrument :: A (usually parametrized) instrument. Positions and mask
+ * flags are taken including the parameter map.
+ */
+DetectorInfo::DetectorInfo(const Instrument &instrument)
+    : m_detectorIDs(instrument.getDetectorIDs(false)),
+      m_positions(m_detectorIDs.size()), m_isMonitor(m_detectorIDs.size(), 0),
+      m_isMasked(m_detectorIDs.size(), 0), m_hasSourceAndSample(false),
+      m_upDirection(0.0, 1.0, 0.0), m_l1(0.0) {
+  // getDetectorIDs() returns the keys of the detector cache, which are
+  // sorted. Make sure this stays true since indexOf() relies on it.
+  if (!std::is_sorted(m_detectorIDs.begin(), m_detectorIDs.end()))
+    std::sort(m_detectorIDs.begin(), m_detectorIDs.end());
+
+  const int64_t numberOfDetectors = static_cast<int64_t>(m_detectorIDs.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < numberOfDetectors; ++i) {
+    const auto det = instrument.getDetector(m_detectorIDs[i]);
+    m_positions[i] = det->getPos();
+    m_isMonitor[i] = det->isMonitor();
+    m_isMasked[i] = det->isMasked();
+  }
+
+  const auto source = instrument.getSource();
+  const auto sample = instrument.getSample();
+  if (source && sample) {
+    m_hasSourceAndSample = true;
+    m_sourcePosition = source->getPos();
+    m_samplePosition = sample->getPos();
+    m_l1 = source->getDistance(*sample);
+  }
+  if (const auto frame = instrument.getReferenceFrame())
+    m_upDirection = frame->vecPointingUp();
+}
+
+/** Returns the index of a detector.
+ *
+ * @param detectorID :: ID of the detector.
+ * @return The index of the detector in the flat arrays.
+ * @throw Kernel::Exception::NotFoundError if there is no such detector.
+ */
+size_t DetectorInfo::indexOf(const detid_t detectorID) const {
+  const auto it =
+      std::lower_bound(m_detectorIDs.begin(), m_detectorIDs.end(), detectorID);
+  if (it == m_detectorIDs.end() || *it != detectorID)
+    throw Kernel::Exception::NotFoundError(
+        "DetectorInfo::indexOf(): Unknown detector ID", detectorID);
+  return std::distance(m_detectorIDs.begin(), it);
+}
+
+/// Returns true if the instrument contains a detector with the given ID.
+bool DetectorInfo::contains(const detid_t detectorID) const {
+  return std::binary_search(m_detectorIDs.begin(), m_detectorIDs.end(),
+                            detectorID);
+}
+
+/// Returns the source position.
+const Kernel::V3D &DetectorInfo::sourcePosition() const {
+  checkSourceAndSample();
+  return m_sourcePosition;
+}
+
+/// Returns the sample position.
+const Kernel::V3D &DetectorInfo::samplePosition() const {
+  checkSourceAndSample();
+  return m_samplePosition;
+}
+
+/// Returns L1 (distance from source to sample).
+double DetectorInfo::l1() const {
+  checkSourceAndSample();
+  return m_l1;
+}
+
+void DetectorInfo::checkSourceAndSample() const {
+  if (!m_hasSourceAndSample)
+    throw Kernel::Exception::InstrumentDefinitionError(
+        "Instrument not sufficiently defined: failed to get source and/or "
+        "sample");
+}
+
+} // namespace Geometry
+} // namespace Mantid
@@ -5,6 +5,7 @@
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidGeometry/Instrument.h"
 #include <cstring>
+#include <stdexcept>
 #include <boost/algorithm/string.hpp>
 
 namespace Mantid {
@@ -42,6 +43,34 @@ Kernel::Logger g_log("ParameterMap");
  */
 ParameterMap::ParameterMap() : m_parameterFileNames(), m_map() {}
 
+/**
+ * Copy constructor. The index is rebuilt for the new map.
+ * @param other :: The map to copy
+ */
+ParameterMap::ParameterMap(const ParameterMap &other)
+    : m_parameterFileNames(other.m_parameterFileNames), m_map(other.m_map),
+      m_cacheLocMap(other.m_cacheLocMap), m_cacheRotMap(other.m_cacheRotMap),
+      m_boundingBoxMap(other.m_boundingBoxMap) {
+  rebuildIndex();
+}
+
+/**
+ * Copy assignment operator. The index is rebuilt for the new map.
+ * @param other :: The map to copy
+ * @return this map
+ */
+ParameterMap &ParameterMap::operator=(const ParameterMap &other) {
+  if (this != &other) {
+    m_parameterFileNames = other.m_parameterFileNames;
+    m_map = other.m_map;
+    m_cacheLocMap = other.m_cacheLocMap;
+    m_cacheRotMap = other.m_cacheRotMap;
+    m_boundingBoxMap = other.m_boundingBoxMap;
+    rebuildIndex();
+  }
+  return *this;
+}
+
 /**
 * Return string to be inserted into the parameter map
 */
@@ -261,7 +290,7 @@ void ParameterMap::clearParametersByName(const std::string &name) {
   // Key is component ID so have to search through whole lot
   for (auto itr = m_map.begin(); itr != m_map.end();) {
     if (itr->second->name() == name) {
-      m_map.erase(itr++);
+      itr = erase(itr);
     } else {
       ++itr;
     }
@@ -279,15 +308,9 @@ void ParameterMap::clearParametersByName(const std::string &name) {
 void ParameterMap::clearParametersByName(const std::string &name,
                                          const IComponent *comp) {
   if (!m_map.empty()) {
-    const ComponentID id = comp->getComponentID();
-    auto it_found = m_map.find(id);
-    if (it_found != m_map.end()) {
-      if (it_found->second->name() == name) {
-        m_map.erase(it_found++);
-      } else {
-        ++it_found;
-      }
-    }
+    auto it_found = positionOf(comp, name.c_str(), "");
+    if (it_found != m_map.end() && it_found->second->name() == name)
+      erase(it_found);
 
     // Check if the caches need invalidating
     if (name == pos() || name == rot())
@@ -310,9 +333,27 @@ void ParameterMap::clearParametersByName(const std::string &name,
 void ParameterMap::add(const std::string &type, const IComponent *comp,
                        const std::string &name, const std::string &value,
                        const std::string *const pDescription) {
+  this->add(comp, makeParameter(type, name, value), pDescription);
+}
+
+/**
+ * Create a parameter providing its value as a string
+ * @param type :: A string denoting the type, e.g. double, string, fitting
+ * @param name :: The name of the parameter
+ * @param value :: The parameter's value
+ * @param pDescription :: a pointer (may be NULL) to a string, containing
+ * parameter's description.
+ * @return the new parameter
+ */
+boost::shared_ptr<Parameter>
+ParameterMap::makeParameter(const std::string &type, const std::string &name,
+                            const std::string &value,
+                            const std::string *const pDescription) {
   auto param = ParameterFactory::create(type, name);
   param->fromString(value);
-  this->add(comp, param, pDescription);
+  if (pDescription)
+    param->setDescription(*pDescription);
+  return param;
 }
 
 /** Method for adding/replacing a parameter providing shared pointer to it.
@@ -334,19 +375,85 @@ void ParameterMap::add(const IComponent *comp,
   if (pDescription)
     par->setDescription(*pDescription);
 
+  PARALLEL_CRITICAL(m_mapAccess) { addUnlocked(comp, par); }
+  // Cached positions of the component and its children may be out of date
+  if (par->name() == pos() || par->name() == rot())
+    clearPositionSensitiveCaches();
+}
+
+/** Add or replace many parameters at once, e.g. when loading the parameters of
+ * an instrument. This is equivalent to adding them one by one, but the map is
+ * only locked once and the position caches are only cleared once.
+ * @param params :: The parameters and the components they are attached to
+ */
+void ParameterMap::add(const std::vector<ComponentParameter> &params) {
+  bool positionSensitive(false);
   PARALLEL_CRITICAL(m_mapAccess) {
-    auto existing_par = positionOf(comp, par->name().c_str(), "");
-    // As this is only an add method it should really throw if it already
-    // exists.
-    // However, this is old behavior and many things rely on this actually be
-    // an
-    // add/replace-style function
-    if (existing_par != m_map.end()) {
-      existing_par->second = par;
-    } else {
-      m_map.emplace(comp->getComponentID(), par);
+    m_index.reserve(m_index.size() + params.size());
+    for (const auto &param : params) {
+      if (!param.second)
+        continue;
+      addUnlocked(param.first, param.second);
+      const std::string &type = param.second->type();
+      positionSensitive = positionSensitive || type == pV3D() || type == pQuat();
     }
   }
+  if (positionSensitive)
+    clearPositionSensitiveCaches();
+}
+
+/** Add or replace a parameter. The caller must hold the map lock.
+ * @param comp :: A pointer to the component that this parameter is attached to
+ * @param par  :: a shared pointer to the parameter
+ */
+void ParameterMap::addUnlocked(const IComponent *comp,
+                               const boost::shared_ptr<Parameter> &par) {
+  const ComponentID id = comp->getComponentID();
+  const IndexKey key(id, ParameterName(par->name()).id());
+  auto existing_par = m_index.find(key);
+  // As this is only an add method it should really throw if it already
+  // exists.
+  // However, this is old behavior and many things rely on this actually be
+  // an
+  // add/replace-style function
+  if (existing_par != m_index.end()) {
+    existing_par->second->second = par;
+  } else {
+    m_index.emplace(key, m_map.emplace(id, par));
+  }
+}
+
+/** Erase a parameter from the map and the index
+ * @param it :: Position of the parameter in the map
+ * @return the position following the erased parameter
+ */
+component_map_it ParameterMap::erase(component_map_it it) {
+  const Parameter &param = *(it->second);
+  const IndexKey key(it->first, ParameterName(param.name()).id());
+  auto indexed = m_index.find(key);
+  if (indexed != m_index.end() && indexed->second == it) {
+    m_index.erase(indexed);
+    // Index the next parameter of the component with the same name, if any
+    auto range = m_map.equal_range(it->first);
+    for (auto other = range.first; other != range.second; ++other) {
+      if (other != it && boost::iequals(other->second->name(), param.name())) {
+        m_index.emplace(key, other);
+        break;
+      }
+    }
+  }
+  return m_map.erase(it);
+}
+
+/// Rebuild the index from the contents of the map
+void ParameterMap::rebuildIndex() {
+  m_index.clear();
+  m_index.reserve(m_map.size());
+  for (auto it = m_map.begin(); it != m_map.end(); ++it) {
+    // emplace keeps the first parameter of each name
+    m_index.emplace(IndexKey(it->first, ParameterName(it->second->name()).id()),
+                    it);
+  }
 }
 
 /** Create or adjust "pos" parameter for a component
@@ -659,17 +766,7 @@ bool ParameterMap::contains(const IComponent *comp, const char *name,
                             const char *type) const {
   if (m_map.empty())
     return false;
-  const ComponentID id = comp->getComponentID();
-  std::pair<pmap_cit, pmap_cit> components = m_map.equal_range(id);
-  bool anytype = (strlen(type) == 0);
-  for (auto itr = components.first; itr != components.second; ++itr) {
-    boost::shared_ptr<Parameter> param = itr->second;
-    if (boost::iequals(param->name(), name) &&
-        (anytype || param->type() == type)) {
-      return true;
-    }
-  }
-  return false;
+  return positionOf(comp, name, type) != m_map.end();
 }
 
 /**
@@ -733,6 +830,29 @@ boost::shared_ptr<Parameter> ParameterMap::get(const IComponent *comp,
   return result;
 }
 
+/** Return a parameter of a given type by its interned name. This avoids
+ * comparing the name with the names of the parameters of the component.
+ * @param comp :: Component to which parameter is related
+ * @param name :: Parameter name
+ * @param type :: An optional type string
+ * @returns The named parameter of the given type if it exists or a NULL shared
+ * pointer if not
+ */
+Parameter_sptr ParameterMap::get(const IComponent *comp,
+                                 const ParameterName &name,
+                                 const std::string &type) const {
+  Parameter_sptr result;
+  if (!comp)
+    return result;
+
+  PARALLEL_CRITICAL(m_mapAccess) {
+    auto itr = findIndexed(comp->getComponentID(), name.id(), type.c_str());
+    if (itr != m_map.end())
+      result = itr->second;
+  }
+  return result;
+}
+
 /**Return an iterator pointing to a named parameter of a given type.
  * @param comp :: Component to which parameter is related
  * @param name :: Parameter name
@@ -742,27 +862,10 @@ boost::shared_ptr<Parameter> ParameterMap::get(const IComponent *comp,
 */
 component_map_it ParameterMap::positionOf(const IComponent *comp,
                                           const char *name, const char *type) {
-  auto result = m_map.end();
-  if (!comp)
-    return result;
-  const bool anytype = (strlen(type) == 0);
-  if (!m_map.empty()) {
-    const ComponentID id = comp->getComponentID();
-    auto it_found = m_map.find(id);
-    if (it_found != m_map.end()) {
-      auto itr = m_map.lower_bound(id);
-      auto itr_end = m_map.upper_bound(id);
-      for (; itr != itr_end; ++itr) {
-        Parameter_sptr param = itr->second;
-        if (boost::iequals(param->nameAsCString(), name) &&
-            (anytype || param->type() == type)) {
-          result = itr;
-          break;
-        }
-      }
-    }
-  }
-  return result;
+  size_t nameId;
+  if (!comp || m_map.empty() || !ParameterName::find(name, nameId))
+    return m_map.end();
+  return findIndexed(comp->getComponentID(), nameId, type);
 }
 
 /**Return a const iterator pointing to a named parameter of a given type.
@@ -775,27 +878,39 @@ component_map_it ParameterMap::positionOf(const IComponent *comp,
 component_map_cit ParameterMap::positionOf(const IComponent *comp,
                                            const char *name,
                                            const char *type) const {
-  auto result = m_map.end();
-  if (!comp)
-    return result;
-  const bool anytype = (strlen(type) == 0);
-  if (!m_map.empty()) {
-    const ComponentID id = comp->getComponentID();
-    auto it_found = m_map.find(id);
-    if (it_found != m_map.end()) {
-      auto itr = m_map.lower_bound(id);
-      auto itr_end = m_map.upper_bound(id);
-      for (; itr != itr_end; ++itr) {
-        Parameter_sptr param = itr->second;
-        if (boost::iequals(param->nameAsCString(), name) &&
-            (anytype || param->type() == type)) {
-          result = itr;
-          break;
-        }
-      }
-    }
+  size_t nameId;
+  if (!comp || m_map.empty() || !ParameterName::find(name, nameId))
+    return m_map.end();
+  return findIndexed(comp->getComponentID(), nameId, type);
+}
+
+/**Return an iterator pointing to a named parameter of a given type.
+ * @param id :: Component to which parameter is related
+ * @param nameId :: Id of the parameter name, see ParameterName
+ * @param type :: An optional type string. If empty, any type is returned
+ * @returns The iterator parameter of the given type if it exists or end()
+ * if not
+*/
+component_map_it ParameterMap::findIndexed(const ComponentID id,
+                                           const size_t nameId,
+                                           const char *type) const {
+  // Iterators in the index are not const, and neither is the result
+  auto &map = const_cast<pmap &>(m_map);
+  auto indexed = m_index.find(IndexKey(id, nameId));
+  if (indexed == m_index.end())
+    return map.end();
+  const auto &param = indexed->second->second;
+  if (type[0] == '\0' || param->type() == type)
+    return indexed->second;
+
+  // A later parameter of the same name may have the requested type
+  auto range = map.equal_range(id);
+  for (auto itr = range.first; itr != range.second; ++itr) {
+    if (boost::iequals(itr->second->name(), param->name()) &&
+        itr->second->type() == type)
+      return itr;
   }
-  return result;
+  return map.end();
 }
 
 /** Look for a parameter in the given component by the type of the parameter.
@@ -887,6 +1002,31 @@ Parameter_sptr ParameterMap::getRecursive(const IComponent *comp,
   return result;
 }
 
+/**
+ * Find a parameter by its interned name, recursively going up the component
+ * tree to higher parents.
+ * @param comp :: The component to start the search with
+ * @param name :: Parameter name
+ * @param type :: An optional type string
+ * @returns the first matching parameter.
+ */
+Parameter_sptr ParameterMap::getRecursive(const IComponent *comp,
+                                          const ParameterName &name,
+                                          const std::string &type) const {
+  Parameter_sptr result = this->get(comp->getComponentID(), name, type);
+  if (result)
+    return result;
+
+  auto parent = comp->getParent();
+  while (parent) {
+    result = this->get(parent->getComponentID(), name, type);
+    if (result)
+      return result;
+    parent = parent->getParent();
+  }
+  return result;
+}
+
 /**
  * Return the value of a parameter as a string
  * @param comp :: Component to which parameter is related
@@ -971,10 +1111,7 @@ void ParameterMap::clearPositionSensitiveCaches() {
 /// @param location :: The location
 void ParameterMap::setCachedLocation(const IComponent *comp,
                                      const V3D &location) const {
-  // Call to setCachedLocation is a write so not thread-safe
-  PARALLEL_CRITICAL(positionCache) {
-    m_cacheLocMap.setCache(comp->getComponentID(), location);
-  }
+  m_cacheLocMap.setCache(comp->getComponentID(), location);
 }
 
 /// Attempts to retrieve a location from the location cache
@@ -983,11 +1120,7 @@ void ParameterMap::setCachedLocation(const IComponent *comp,
 /// @returns true if the location is in the map, otherwise false
 bool ParameterMap::getCachedLocation(const IComponent *comp,
                                      V3D &location) const {
-  bool inMap(false);
-  PARALLEL_CRITICAL(positionCache) {
-    inMap = m_cacheLocMap.getCache(comp->getComponentID(), location);
-  }
-  return inMap;
+  return m_cacheLocMap.getCache(comp->getComponentID(), location);
 }
 
 /// Sets a cached rotation on the rotation cache
@@ -995,10 +1128,7 @@ bool ParameterMap::getCachedLocation(const IComponent *comp,
 /// @param rotation :: The rotation as a quaternion
 void ParameterMap::setCachedRotation(const IComponent *comp,
                                      const Quat &rotation) const {
-  // Call to setCachedRotation is a write so not thread-safe
-  PARALLEL_CRITICAL(rotationCache) {
-    m_cacheRotMap.setCache(comp->getComponentID(), rotation);
-  }
+  m_cacheRotMap.setCache(comp->getComponentID(), rotation);
 }
 
 /// Attempts to retrieve a rotation from the rotation cache
@@ -1007,11 +1137,7 @@ void ParameterMap::setCachedRotation(const IComponent *comp,
 /// @returns true if the rotation is in the map, otherwise false
 bool ParameterMap::getCachedRotation(const IComponent *comp,
                                      Quat &rotation) const {
-  bool inMap(false);
-  PARALLEL_CRITICAL(rotationCache) {
-    inMap = m_cacheRotMap.getCache(comp->getComponentID(), rotation);
-  }
-  return inMap;
+  return m_cacheRotMap.getCache(comp->getComponentID(), rotation);
 }
 
 /// Sets a cached bounding box
@@ -1019,10 +1145,7 @@ bool ParameterMap::getCachedRotation(const IComponent *comp,
 /// @param box :: A reference to the bounding box
 void ParameterMap::setCachedBoundingBox(const IComponent *comp,
                                         const BoundingBox &box) const {
-  // Call to setCachedRotation is a write so not thread-safe
-  PARALLEL_CRITICAL(boundingBoxCache) {
-    m_boundingBoxMap.setCache(comp->getComponentID(), box);
-  }
+  m_boundingBoxMap.setCache(comp->getComponentID(), box);
 }
 
 /// Attempts to retrieve a bounding box from the cache
@@ -1034,6 +1157,62 @@ bool ParameterMap::getCachedBoundingBox(const IComponent *comp,
   return m_boundingBoxMap.getCache(comp->getComponentID(), box);
 }
 
+/**
+ * Caches the locations and rotations of many components, e.g. all detectors,
+ * that were computed in one pass. Unlike values set with setCachedLocation()
+ * and setCachedRotation() they are read without locking, so threads reading
+ * the positions do not wait for each other. They are kept until the position
+ * caches are cleared.
+ * @param components :: The components
+ * @param locations :: The absolute location of each component
+ * @param rotations :: The absolute rotation of each component
+ */
+void ParameterMap::cachePositions(
+    const std::vector<const IComponent *> &components,
+    const std::vector<V3D> &locations,
+    const std::vector<Quat> &rotations) const {
+  if (components.size() != locations.size() ||
+      components.size() != rotations.size())
+    throw std::invalid_argument("ParameterMap::cachePositions() - The number "
+                                "of locations and rotations must match the "
+                                "number of components.");
+  Kernel::SnapshotCache<ComponentID, V3D>::Map newLocations;
+  Kernel::SnapshotCache<ComponentID, Quat>::Map newRotations;
+  newLocations.reserve(components.size());
+  newRotations.reserve(components.size());
+  for (size_t i = 0; i < components.size(); ++i) {
+    const ComponentID id = components[i]->getComponentID();
+    newLocations.emplace(id, locations[i]);
+    newRotations.emplace(id, rotations[i]);
+  }
+  m_cacheLocMap.publish(newLocations);
+  m_cacheRotMap.publish(newRotations);
+}
+
+/// @returns true if cachePositions() was called since the position sensitive
+/// caches were last cleared, i.e. since the parameters last changed
+bool ParameterMap::hasCachedPositions() const {
+  return m_cacheLocMap.hasSnapshot() && m_cacheRotMap.hasSnapshot();
+}
+
+/// Attempts to retrieve a location given to cachePositions(), without locking
+/// @param comp :: The Component to find the location of
+/// @param location :: If the location is found it's value will be set here
+/// @returns true if the location was precomputed, otherwise false
+bool ParameterMap::getPrecomputedLocation(const IComponent *comp,
+                                          V3D &location) const {
+  return m_cacheLocMap.getSnapshot(comp->getComponentID(), location);
+}
+
+/// Attempts to retrieve a rotation given to cachePositions(), without locking
+/// @param comp :: The Component to find the rotation of
+/// @param rotation :: If the rotation is found it's value will be set here
+/// @returns true if the rotation was precomputed, otherwise false
+bool ParameterMap::getPrecomputedRotation(const IComponent *comp,
+                                          Quat &rotation) const {
+  return m_cacheRotMap.getSnapshot(comp->getComponentID(), rotation);
+}
+
 /**
  * Copy pairs (oldComp->id,Parameter) to the m_map
  * assigning the new newComp->id
@@ -1049,7 +1228,9 @@ void ParameterMap::copyFromParameterMap(const IComponent *oldComp,
   for (const auto &oldParameterName : oldParameterNames) {
     Parameter_sptr thisParameter = oldPMap->get(oldComp, oldParameterName);
     // Insert the fetched parameter in the m_map
-    m_map.emplace(newComp->getComponentID(), thisParameter);
+    auto it = m_map.emplace(newComp->getComponentID(), thisParameter);
+    m_index.emplace(
+        IndexKey(it->first, ParameterName(thisParameter->name()).id()), it);
   }
 }
 
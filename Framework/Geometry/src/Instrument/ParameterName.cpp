@@ -0,0 +1,167 @@
+#include "MantidGeometry/Instrument/ParameterName.h"
+
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+namespace Mantid {
+namespace Geometry {
+
+namespace {
+/// An interned name. Never changes or moves once it is in the table.
+struct Entry {
+  /// The name as first interned
+  std::string name;
+  /// Hash of the lower case name
+  size_t hash;
+  /// Index of the entry in NameTable::entries
+  size_t id;
+};
+
+/// Open addressing hash set of entries. Slots are only ever filled, so a
+/// reader that finds an entry can use it without a lock.
+struct Slots {
+  explicit Slots(const size_t size)
+      : entries(new std::atomic<const Entry *>[size]), capacity(size) {
+    for (size_t i = 0; i < capacity; ++i)
+      entries[i].store(nullptr, std::memory_order_relaxed);
+  }
+  std::unique_ptr<std::atomic<const Entry *>[]> entries;
+  const size_t capacity;
+};
+
+/** All names that were interned. Lookups read the current Slots without a
+ * lock. Inserting takes the mutex; when the slots fill up, a table twice the
+ * size is published and the old one is kept, as readers may still probe it.
+ */
+struct NameTable {
+  NameTable() {
+    slots.emplace_back(64);
+    current.store(&slots.back());
+  }
+  std::mutex mutex;
+  /// The entries by id. A deque does not move them.
+  std::deque<Entry> entries;
+  /// All tables that were published, the last one is current
+  std::deque<Slots> slots;
+  std::atomic<const Slots *> current;
+};
+
+NameTable &nameTable() {
+  static NameTable table;
+  return table;
+}
+
+/// Case folds a character as boost::algorithm::to_lower does in the C locale
+inline char fold(const char c) {
+  return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+/// FNV-1a hash of the lower case version of a name
+size_t foldedHash(const char *name, const size_t length) {
+  uint64_t hash = 14695981039346656037ull;
+  for (size_t i = 0; i < length; ++i) {
+    hash ^= static_cast<unsigned char>(fold(name[i]));
+    hash *= 1099511628211ull;
+  }
+  return static_cast<size_t>(hash);
+}
+
+/// Returns true if the names only differ in case
+bool equalFolded(const std::string &interned, const char *name,
+                 const size_t length) {
+  if (interned.size() != length)
+    return false;
+  for (size_t i = 0; i < length; ++i)
+    if (fold(interned[i]) != fold(name[i]))
+      return false;
+  return true;
+}
+
+/// Look up a name in a table without locking, nullptr if it is not there
+const Entry *lookup(const Slots &slots, const char *name, const size_t length,
+                    const size_t hash) {
+  for (size_t i = hash % slots.capacity;; i = (i + 1) % slots.capacity) {
+    const Entry *entry = slots.entries[i].load(std::memory_order_acquire);
+    if (!entry)
+      return nullptr;
+    if (entry->hash == hash && equalFolded(entry->name, name, length))
+      return entry;
+  }
+}
+
+/// Put an entry into the first free slot of its probe sequence. Must be called
+/// with the mutex held.
+void place(const Slots &slots, const Entry &entry) {
+  size_t i = entry.hash % slots.capacity;
+  while (slots.entries[i].load(std::memory_order_relaxed))
+    i = (i + 1) % slots.capacity;
+  slots.entries[i].store(&entry, std::memory_order_release);
+}
+
+/// Look up a name, interning it if it has not been seen before
+const Entry &intern(const std::string &name) {
+  auto &table = nameTable();
+  const size_t hash = foldedHash(name.c_str(), name.size());
+  if (const Entry *entry =
+          lookup(*table.current.load(std::memory_order_acquire), name.c_str(),
+                 name.size(), hash))
+    return *entry;
+
+  std::lock_guard<std::mutex> lock(table.mutex);
+  const Slots *slots = table.current.load(std::memory_order_relaxed);
+  if (const Entry *entry = lookup(*slots, name.c_str(), name.size(), hash))
+    return *entry;
+  table.entries.push_back(Entry{name, hash, table.entries.size()});
+  const Entry &entry = table.entries.back();
+  // Keep the load factor at most one half
+  if (2 * table.entries.size() > slots->capacity) {
+    table.slots.emplace_back(2 * slots->capacity);
+    const Slots &grown = table.slots.back();
+    for (const auto &other : table.entries)
+      place(grown, other);
+    table.current.store(&grown, std::memory_order_release);
+  } else {
+    place(*slots, entry);
+  }
+  return entry;
+}
+}
+
+/** Constructor. Interns the name if it has not been seen before. Names that
+ * were interned before are found without locking or allocating memory.
+ * @param name :: Name of a parameter
+ */
+ParameterName::ParameterName(const std::string &name) {
+  const Entry &entry = intern(name);
+  m_id = entry.id;
+  m_name = &entry.name;
+}
+
+/// Returns the name as it was first interned
+const std::string &ParameterName::name() const { return *m_name; }
+
+/** Look up the id of a name without interning it. Does not lock or allocate
+ * memory.
+ * @param name :: Name of a parameter
+ * @param id :: Set to the id of the name if it was found
+ * @return false if the name was never interned, in which case no parameter
+ * can have it
+ */
+bool ParameterName::find(const char *name, size_t &id) {
+  const size_t length = std::strlen(name);
+  const Entry *entry =
+      lookup(*nameTable().current.load(std::memory_order_acquire), name,
+             length, foldedHash(name, length));
+  if (!entry)
+    return false;
+  id = entry->id;
+  return true;
+}
+
+} // namespace Geometry
+} // namespace Mantid
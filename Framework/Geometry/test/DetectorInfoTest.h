@@ -0,0 +1,94 @@
+#ifndef MANTID_GEOMETRY_DETECTORINFOTEST_H_
+#define MANTID_GEOMETRY_DETECTORINFOTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Instrument/ParameterMap.h"
+#include "MantidKernel/Exception.h"
+#include "MantidTestHelpers/ComponentCreationHelper.h"
+
+#include <boost/make_shared.hpp>
+
+using namespace Mantid::Geometry;
+using Mantid::Kernel::V3D;
+
+class DetectorInfoTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static DetectorInfoTest *createSuite() { return new DetectorInfoTest(); }
+  static void destroySuite(DetectorInfoTest *suite) { delete suite; }
+
+  void test_size_and_ids() {
+    auto instrument =
+        ComponentCreationHelper::createTestInstrumentCylindrical(2);
+    DetectorInfo info(*instrument);
+    TS_ASSERT_EQUALS(info.size(), 18);
+    const auto &ids = info.detectorIDs();
+    for (size_t i = 0; i < ids.size(); ++i)
+      TS_ASSERT_EQUALS(ids[i], static_cast<Mantid::detid_t>(i + 1));
+  }
+
+  void test_indexOf() {
+    auto instrument =
+        ComponentCreationHelper::createTestInstrumentCylindrical(1);
+    DetectorInfo info(*instrument);
+    TS_ASSERT_EQUALS(info.indexOf(1), 0);
+    TS_ASSERT_EQUALS(info.indexOf(9), 8);
+    TS_ASSERT(info.contains(5));
+    TS_ASSERT(!info.contains(10));
+    TS_ASSERT_THROWS(info.indexOf(10),
+                     Mantid::Kernel::Exception::NotFoundError);
+  }
+
+  void test_positions_match_instrument() {
+    auto instrument =
+        ComponentCreationHelper::createTestInstrumentCylindrical(2);
+    DetectorInfo info(*instrument);
+    for (size_t i = 0; i < info.size(); ++i) {
+      const auto det = instrument->getDetector(info.detectorIDs()[i]);
+      TS_ASSERT_EQUALS(info.position(i), det->getPos());
+      TS_ASSERT_EQUALS(info.isMonitor(i), false);
+      TS_ASSERT_EQUALS(info.isMasked(i), false);
+    }
+  }
+
+  void test_source_and_sample() {
+    auto instrument = ComponentCreationHelper::createMinimalInstrument(
+        V3D(-10, 0, 0), V3D(0, 0, 0), V3D(2, 2, 0));
+    DetectorInfo info(*instrument);
+    TS_ASSERT(info.hasSourceAndSample());
+    TS_ASSERT_EQUALS(info.sourcePosition(), V3D(-10, 0, 0));
+    TS_ASSERT_EQUALS(info.samplePosition(), V3D(0, 0, 0));
+    TS_ASSERT_DELTA(info.l1(), 10.0, 1e-12);
+    TS_ASSERT_EQUALS(info.upDirection(), V3D(0, 1, 0));
+    TS_ASSERT_EQUALS(info.position(0), V3D(2, 2, 0));
+  }
+
+  void test_no_source_throws_on_access() {
+    auto instrument = boost::make_shared<Instrument>("empty");
+    DetectorInfo info(*instrument);
+    TS_ASSERT_EQUALS(info.size(), 0);
+    TS_ASSERT(!info.hasSourceAndSample());
+    TS_ASSERT_THROWS(info.l1(),
+                     Mantid::Kernel::Exception::InstrumentDefinitionError);
+  }
+
+  void test_parametrized_instrument() {
+    auto base = ComponentCreationHelper::createMinimalInstrument(
+        V3D(-10, 0, 0), V3D(0, 0, 0), V3D(2, 2, 0));
+    auto pmap = boost::make_shared<ParameterMap>();
+    auto det = base->getDetector(1);
+    pmap->addBool(det.get(), "masked", true);
+    pmap->addV3D(det.get(), "pos", V3D(3, 3, 0));
+    Instrument instrument(base, pmap);
+
+    DetectorInfo info(instrument);
+    TS_ASSERT_EQUALS(info.isMasked(0), true);
+    TS_ASSERT_EQUALS(info.position(0), V3D(3, 3, 0));
+  }
+};
+
+#endif /* MANTID_GEOMETRY_DETECTORINFOTEST_H_ */
@@ -508,6 +508,55 @@ public:
                      Instrument::ContainsState::Partial);
   }
 
+  void test_cacheDetectorPositions() {
+    Instrument_sptr baseInstrument =
+        ComponentCreationHelper::createTestInstrumentRectangular(2, 4);
+    auto pmap = boost::make_shared<ParameterMap>();
+    // Move one of the banks
+    auto bank = baseInstrument->getComponentByName("bank1");
+    pmap->addV3D(bank.get(), ParameterMap::pos(), V3D(1, 2, 3));
+    auto instrument = boost::make_shared<Instrument>(baseInstrument, pmap);
+
+    const auto detIDs = instrument->getDetectorIDs();
+    std::vector<V3D> positions;
+    for (const auto detID : detIDs)
+      positions.push_back(instrument->getDetector(detID)->getPos());
+
+    instrument->cacheDetectorPositions();
+    for (size_t i = 0; i < detIDs.size(); ++i) {
+      V3D cached;
+      TS_ASSERT(pmap->getPrecomputedLocation(
+          baseInstrument->getBaseDetector(detIDs[i]), cached));
+      TS_ASSERT_EQUALS(cached, positions[i]);
+      TS_ASSERT_EQUALS(instrument->getDetector(detIDs[i])->getPos(),
+                       positions[i]);
+    }
+
+    TS_ASSERT(pmap->hasCachedPositions());
+
+    // Moving a component clears the cached positions
+    pmap->addV3D(bank.get(), ParameterMap::pos(), V3D(4, 5, 6));
+    TS_ASSERT(!pmap->hasCachedPositions());
+    V3D cached;
+    TS_ASSERT(!pmap->getPrecomputedLocation(
+        baseInstrument->getBaseDetector(detIDs[0]), cached));
+
+    // ... and the next call computes them again
+    instrument->cacheDetectorPositions();
+    TS_ASSERT(pmap->hasCachedPositions());
+    TS_ASSERT(pmap->getPrecomputedLocation(
+        baseInstrument->getBaseDetector(detIDs[0]), cached));
+    TS_ASSERT_EQUALS(cached, instrument->getDetector(detIDs[0])->getPos());
+  }
+
+  void test_cacheDetectorPositions_does_nothing_if_not_parametrized() {
+    Instrument_sptr inst =
+        ComponentCreationHelper::createTestInstrumentRectangular(1, 2);
+    TS_ASSERT_THROWS_NOTHING(inst->cacheDetectorPositions());
+    TS_ASSERT_EQUALS(inst->getDetector(inst->getDetectorIDs()[0])->getPos(),
+                     inst->getBaseDetector(inst->getDetectorIDs()[0])->getPos());
+  }
+
 private:
   Instrument_sptr createInstrumentWithSource() {
     using Mantid::Kernel::V3D;
@@ -565,6 +614,19 @@ public:
     }
   }
 
+  void test_access_parameterized_with_cached_positions() {
+    auto map = boost::make_shared<ParameterMap>();
+    auto instrument =
+        boost::make_shared<Instrument>(m_instrumentNotParameterized, map);
+    instrument->cacheDetectorPositions();
+
+    const detid_t nPixels = 100 * 100 * 6;
+    double pos_x = 0;
+    for (detid_t i = 1; i <= nPixels; i++) {
+      pos_x += instrument->getDetector(i)->getPos().X();
+    }
+  }
+
 private:
   Instrument_sptr m_instrumentParameterized;
   Instrument_sptr m_instrumentNotParameterized;
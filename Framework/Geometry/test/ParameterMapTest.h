@@ -12,6 +12,7 @@
 #include <boost/make_shared.hpp>
 
 using Mantid::Geometry::ParameterMap;
+using Mantid::Geometry::ParameterName;
 using Mantid::Geometry::ParameterMap_sptr;
 using Mantid::Geometry::Parameter_sptr;
 using Mantid::Geometry::Instrument_sptr;
@@ -629,6 +630,106 @@ public:
     TS_ASSERT_EQUALS(oldA->value<bool>(), false);
   }
 
+  void test_ParameterName_ignores_case() {
+    const ParameterName name("TestName");
+    TS_ASSERT_EQUALS(name, ParameterName("testname"));
+    TS_ASSERT_DIFFERS(name, ParameterName("OtherName"));
+    TS_ASSERT_EQUALS(name.name(), "TestName");
+    size_t id(0);
+    TS_ASSERT(ParameterName::find("TESTNAME", id));
+    TS_ASSERT_EQUALS(id, name.id());
+    TS_ASSERT(!ParameterName::find("NeverUsedAsAParameterName", id));
+  }
+
+  void test_get_and_getRecursive_with_ParameterName() {
+    IComponent_sptr comp = m_testInstrument->getChild(0);
+    ParameterMap pmap;
+    pmap.addDouble(m_testInstrument.get(), "Efixed", 1.5);
+    pmap.addInt(comp.get(), "Count", 3);
+    const ParameterName efixed("EFIXED");
+    const ParameterName count("Count");
+
+    TS_ASSERT(!pmap.get(comp.get(), efixed));
+    auto fetched = pmap.getRecursive(comp.get(), efixed);
+    TS_ASSERT(fetched);
+    TS_ASSERT_EQUALS(fetched->value<double>(), 1.5);
+    fetched = pmap.get(comp.get(), count);
+    TS_ASSERT(fetched);
+    TS_ASSERT_EQUALS(fetched->value<int>(), 3);
+    TS_ASSERT(pmap.get(comp.get(), count, ParameterMap::pInt()));
+    TS_ASSERT(!pmap.get(comp.get(), count, ParameterMap::pDouble()));
+  }
+
+  void test_makeParameter() {
+    const std::string descr("A description");
+    auto param = ParameterMap::makeParameter<double>(ParameterMap::pDouble(),
+                                                     "P", 2.5, &descr);
+    TS_ASSERT_EQUALS(param->name(), "P");
+    TS_ASSERT_EQUALS(param->value<double>(), 2.5);
+    TS_ASSERT_EQUALS(param->getDescription(), descr);
+    param = ParameterMap::makeParameter(ParameterMap::pInt(), "Q", "7");
+    TS_ASSERT_EQUALS(param->value<int>(), 7);
+  }
+
+  void test_add_many_parameters_at_once() {
+    IComponent_sptr comp = m_testInstrument->getChild(0);
+    ParameterMap pmap;
+    pmap.addDouble(comp.get(), "A", 1.0);
+    std::vector<ParameterMap::ComponentParameter> params;
+    params.emplace_back(
+        comp.get(), ParameterMap::makeParameter(ParameterMap::pDouble(), "A",
+                                                std::string("2.0")));
+    params.emplace_back(m_testInstrument.get(),
+                        ParameterMap::makeParameter<int>(ParameterMap::pInt(),
+                                                         "B", 3));
+    pmap.add(params);
+
+    TS_ASSERT_EQUALS(pmap.size(), 2);
+    TS_ASSERT_EQUALS(pmap.get(comp.get(), "A")->value<double>(), 2.0);
+    TS_ASSERT_EQUALS(pmap.getRecursive(comp.get(), "B")->value<int>(), 3);
+  }
+
+  void test_add_many_parameters_clears_position_caches() {
+    using Mantid::Kernel::V3D;
+    ParameterMap pmap;
+    const V3D cached(1, 2, 3);
+    pmap.setCachedLocation(m_testInstrument.get(), cached);
+    V3D location;
+    TS_ASSERT(pmap.getCachedLocation(m_testInstrument.get(), location));
+
+    // Parameters that do not move components keep the cache
+    std::vector<ParameterMap::ComponentParameter> params;
+    params.emplace_back(m_testInstrument.get(),
+                        ParameterMap::makeParameter<double>(
+                            ParameterMap::pDouble(), "D", 1.0));
+    pmap.add(params);
+    TS_ASSERT(pmap.getCachedLocation(m_testInstrument.get(), location));
+
+    params.clear();
+    params.emplace_back(m_testInstrument.get(),
+                        ParameterMap::makeParameter<V3D>(
+                            ParameterMap::pV3D(), ParameterMap::pos(), cached));
+    pmap.add(params);
+    TS_ASSERT(!pmap.getCachedLocation(m_testInstrument.get(), location));
+  }
+
+  void test_copy_keeps_lookups_working() {
+    ParameterMap pmap;
+    pmap.addDouble(m_testInstrument.get(), "A", 1.0);
+    ParameterMap copy(pmap);
+    pmap.clear();
+    TS_ASSERT(!pmap.get(m_testInstrument.get(), "A"));
+    auto fetched = copy.get(m_testInstrument.get(), "A");
+    TS_ASSERT(fetched);
+    TS_ASSERT_EQUALS(fetched->value<double>(), 1.0);
+
+    ParameterMap assigned;
+    assigned = copy;
+    copy.addDouble(m_testInstrument.get(), "A", 2.0);
+    TS_ASSERT_EQUALS(assigned.get(m_testInstrument.get(), "A")->value<double>(),
+                     1.0);
+  }
+
 private:
   template <typename ValueType>
   void doCopyAndUpdateTestUsingGenericAdd(const std::string &type,
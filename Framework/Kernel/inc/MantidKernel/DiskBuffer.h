@@ -12,11 +12,14 @@
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index/sequenced_index.hpp>
 #endif
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <limits>
 #include <list>
 #include <map>
 #include <mutex>
+#include <thread>
 #include <vector>
 
 namespace Mantid {
@@ -31,6 +34,12 @@ namespace Kernel {
   It also stores a list of "free" blocks in the output file,
   to allow new blocks to fill them later.
 
+  With background I/O (see setBackgroundIO()), a thread loads the objects
+  given to prefetch() before they are needed. The buffered objects are always
+  written out by the thread that fills the buffer, in the order of their
+  position in the file, so that adjacent blocks are written one after the
+  other. Background I/O is off by default.
+
   @date 2011-12-30
 
   Copyright &copy; 2011 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
@@ -77,12 +86,19 @@ public:
   DiskBuffer(uint64_t m_writeBufferSize);
   DiskBuffer(const DiskBuffer &) = delete;
   DiskBuffer &operator=(const DiskBuffer &) = delete;
-  virtual ~DiskBuffer() = default;
+  virtual ~DiskBuffer();
 
   void toWrite(ISaveable *item);
   void flushCache();
   void objectDeleted(ISaveable *item);
 
+  // Background I/O
+  void setBackgroundIO(const bool background);
+  /// @return true if the objects given to prefetch() are loaded by a
+  /// background thread
+  bool getBackgroundIO() const { return m_backgroundIO; }
+  void prefetch(ISaveable *item);
+
   // Free space map methods
   void freeBlock(uint64_t const pos, uint64_t const size);
   void defragFreeBlocks();
@@ -133,6 +149,11 @@ public:
 
 protected:
   inline void writeOldObjects();
+  bool addToBuffer(ISaveable *item);
+  void writeBatch(std::list<ISaveable *> &batch);
+  void startBackgroundIO();
+  void stopBackgroundIO();
+  void runBackgroundIO();
 
   // ----------------------- To-write buffer
   // --------------------------------------
@@ -152,6 +173,25 @@ protected:
   /// Mutex for modifying the the toWrite buffer.
   std::mutex m_mutex;
 
+  // ----------------------- Background I/O
+  // --------------------------------------
+  /// Are the objects prefetched by m_thread?
+  bool m_backgroundIO;
+  /// Is a batch of objects, taken from the to-write buffer, being written?
+  bool m_writing;
+  /// Should m_thread return?
+  bool m_stopThread;
+  /// Objects to load in the background, in order
+  std::deque<ISaveable *> m_toLoad;
+  /// Object being loaded in the background, if any
+  ISaveable *m_loading;
+  /// Signals m_thread that there is something to do
+  std::condition_variable m_workToDo;
+  /// Signals that a batch was written or an object loaded
+  std::condition_variable m_workDone;
+  /// Thread loading in the background
+  std::thread m_thread;
+
   // ----------------------- Free space map
   // --------------------------------------
   /// Map of the free blocks in the file
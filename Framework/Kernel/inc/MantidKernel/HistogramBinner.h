@@ -0,0 +1,117 @@
+#ifndef MANTID_KERNEL_HISTOGRAMBINNER_H_
+#define MANTID_KERNEL_HISTOGRAMBINNER_H_
+
+#include "MantidKernel/DllConfig.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** HistogramBinner : Finds the histogram bin of values for a given set of bin
+  edges.
+
+  Bin i contains the values x with edges[i] <= x < edges[i+1]. If the edges are
+  equidistant (linear binning) or have a constant ratio (logarithmic binning),
+  the bin index is computed arithmetically instead of by searching the edges,
+  so histogramming does not require the values to be sorted. Only the last bin
+  may be wider than the others, as produced by Rebin. Other edges are searched
+  by bisection and must be in ascending order.
+
+  The binner keeps a reference to the bin edges, which must outlive it.
+
+  Copyright &copy; 2016 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_KERNEL_DLL HistogramBinner {
+public:
+  /// Spacing of the bin edges
+  enum class Spacing { Linear, Logarithmic, Irregular };
+
+  explicit HistogramBinner(const std::vector<double> &binEdges);
+
+  /// Returns the spacing of the bin edges.
+  Spacing spacing() const { return m_spacing; }
+  /// Returns the number of bins. This is also the index returned for values
+  /// outside of the histogram.
+  size_t numberOfBins() const { return m_numberOfBins; }
+  /// Returns the bin edges.
+  const std::vector<double> &binEdges() const { return m_edges; }
+
+  /// Returns the index of the bin containing x, or numberOfBins() if x is
+  /// outside of the histogram.
+  size_t binIndex(const double x) const {
+    if (!(x >= m_front && x < m_back))
+      return m_numberOfBins;
+    if (m_spacing == Spacing::Irregular)
+      return static_cast<size_t>(std::distance(
+                 m_edges.begin(),
+                 std::upper_bound(m_edges.begin(), m_edges.end(), x))) -
+             1;
+    const double position = m_spacing == Spacing::Linear
+                                ? (x - m_offset) * m_inverseStep
+                                : (std::log(x) - m_offset) * m_inverseStep;
+    return correctIndex(x, clampIndex(position));
+  }
+
+  void binIndices(const double *x, const size_t count, size_t *indices) const;
+
+private:
+  bool isLinear();
+  bool isLogarithmic();
+
+  /// Truncates a bin position to the range of valid bin indices.
+  size_t clampIndex(double position) const {
+    // Written such that NaN ends up in the first bin.
+    position = position > 0.0 ? position : 0.0;
+    position = position < m_maxIndex ? position : m_maxIndex;
+    return static_cast<size_t>(static_cast<int64_t>(position));
+  }
+  /// Moves an arithmetically computed index into the neighbouring bin if
+  /// rounding put a value next to a bin edge on the wrong side.
+  size_t correctIndex(const double x, const size_t index) const {
+    if (x < m_edges[index])
+      return index - 1;
+    if (x >= m_edges[index + 1])
+      return index + 1;
+    return index;
+  }
+
+  const std::vector<double> &m_edges;
+  size_t m_numberOfBins;
+  Spacing m_spacing;
+  double m_front;
+  double m_back;
+  double m_maxIndex;
+  /// First edge (linear) or its logarithm (logarithmic)
+  double m_offset;
+  /// Inverse of the bin width (linear) or of the log of the ratio of two
+  /// consecutive edges (logarithmic)
+  double m_inverseStep;
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_HISTOGRAMBINNER_H_ */
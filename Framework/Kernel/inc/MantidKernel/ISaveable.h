@@ -2,6 +2,7 @@
 #define MANTID_KERNEL_ISAVEABLE_H_
 
 #include "MantidKernel/System.h"
+#include <atomic>
 #include <list>
 #include <vector>
 #include <algorithm>
@@ -87,6 +88,8 @@ public:
   /// @ set the data busy to prevent from removing them from memory. The process
   /// which does that should clean the data when finished with them
   void setBusy(bool On) { m_Busy = On; }
+  /// Load the data if needed and mark them busy
+  void loadAndSetBusy();
 
   // protected?
 
@@ -137,7 +140,7 @@ protected:
   //--------------
   /// a user needs to set this variable to true preventing from deleting data
   /// from buffer
-  bool m_Busy;
+  std::atomic<bool> m_Busy;
   /** a user needs to set this variable to true to allow DiskBuffer saving the
      object to HDD
       when it decides it suitable,  if the size of iSavable object in cache is
@@ -191,6 +194,9 @@ private:
 
   // the mutex to protect changes in this memory
   std::mutex m_setter;
+  /// the mutex held while the data are loaded, saved or cleared, so that the
+  /// DiskBuffer can do it in the background
+  std::mutex m_dataMutex;
 };
 
 } // namespace Kernel
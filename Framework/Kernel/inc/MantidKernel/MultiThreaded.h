@@ -1,10 +1,15 @@
 #ifndef MANTID_KERNEL_MULTITHREADED_H_
 #define MANTID_KERNEL_MULTITHREADED_H_
 
+#include "MantidKernel/DllConfig.h"
+
 #include <mutex>
 
 namespace Mantid {
-namespace Kernel {} // namespace
+namespace Kernel {
+/// Number of threads for a parallel region, limited within TaskGraph tasks
+MANTID_KERNEL_DLL int threadsForParallelRegion();
+} // namespace
 } // namespace
 
 // The syntax used to define a pragma within a macro is different on windows and
@@ -55,20 +60,28 @@ namespace Kernel {} // namespace
 
 #include <omp.h>
 
+/* Within the tasks of a TaskGraph, parallel regions take their number of
+ * threads from the budget shared with the graphs (see
+ * threadsForParallelRegion()), so that they do not oversubscribe the cores.
+ * Elsewhere they start the usual number of threads.
+ */
+
 /** Includes code to add OpenMP commands to run the next for loop in parallel.
 *   This includes an arbirary check: condition.
 *   "condition" must evaluate to TRUE in order for the
 *   code to be executed in parallel
 */
 #define PARALLEL_FOR_IF(condition)                                             \
-    PRAGMA(omp parallel for if (condition) )
+    PRAGMA(omp parallel for if (condition) \
+    num_threads(Mantid::Kernel::threadsForParallelRegion()))
 
 /** Includes code to add OpenMP commands to run the next for loop in parallel.
 *   This includes no checks to see if workspaces are suitable
 *   and therefore should not be used in any loops that access workspaces.
 */
 #define PARALLEL_FOR_NO_WSP_CHECK()                                            \
-    PRAGMA(omp parallel for)
+    PRAGMA(omp parallel for \
+    num_threads(Mantid::Kernel::threadsForParallelRegion()))
 
 /** Includes code to add OpenMP commands to run the next for loop in parallel.
  *  and declare the varialbes to be firstprivate.
@@ -76,10 +89,12 @@ namespace Kernel {} // namespace
  *  and therefore should not be used in any loops that access workspace.
  */
 #define PARALLEL_FOR_NOWS_CHECK_FIRSTPRIVATE(variable)                         \
-  PRAGMA(omp parallel for firstprivate(variable) )
+  PRAGMA(omp parallel for firstprivate(variable) \
+    num_threads(Mantid::Kernel::threadsForParallelRegion()))
 
 #define PARALLEL_FOR_NO_WSP_CHECK_FIRSTPRIVATE2(variable1, variable2)          \
-  PRAGMA(omp parallel for firstprivate(variable1, variable2) )
+  PRAGMA(omp parallel for firstprivate(variable1, variable2) \
+    num_threads(Mantid::Kernel::threadsForParallelRegion()))
 
 /** Includes code to add OpenMP commands to run the next for loop in parallel.
 *		The workspace is checked to ensure it is suitable for
@@ -87,7 +102,8 @@ namespace Kernel {} // namespace
 *   NULL workspaces are assumed suitable
 */
 #define PARALLEL_FOR1(workspace1)                                              \
-    PRAGMA(omp parallel for if ( !workspace1 || workspace1->threadSafe() ) )
+    PRAGMA(omp parallel for if ( !workspace1 || workspace1->threadSafe() ) \
+    num_threads(Mantid::Kernel::threadsForParallelRegion()))
 
 /** Includes code to add OpenMP commands to run the next for loop in parallel.
 *	 Both workspaces are checked to ensure they suitable for multithreaded
@@ -96,7 +112,8 @@ namespace Kernel {} // namespace
 */
 #define PARALLEL_FOR2(workspace1, workspace2)                                   \
     PRAGMA(omp parallel for if ( ( !workspace1 || workspace1->threadSafe() ) && \
-    ( !workspace2 || workspace2->threadSafe() ) ))
+    ( !workspace2 || workspace2->threadSafe() ) ) \
+    num_threads(Mantid::Kernel::threadsForParallelRegion()))
 
 /** Includes code to add OpenMP commands to run the next for loop in parallel.
 *	 All three workspaces are checked to ensure they are suitable for
@@ -106,7 +123,8 @@ namespace Kernel {} // namespace
 #define PARALLEL_FOR3(workspace1, workspace2, workspace3)                      \
     PRAGMA(omp parallel for if ( (!workspace1 || workspace1->threadSafe()) && \
     ( !workspace2 || workspace2->threadSafe() ) && \
-    ( !workspace3 || workspace3->threadSafe() ) ))
+    ( !workspace3 || workspace3->threadSafe() ) ) \
+    num_threads(Mantid::Kernel::threadsForParallelRegion()))
 
 /** Ensures that the next execution line or block is only executed if
 * there are multple threads execting in this region
@@ -143,7 +161,8 @@ namespace Kernel {} // namespace
 
 #define PARALLEL_THREAD_NUMBER omp_get_thread_num()
 
-#define PARALLEL PRAGMA(omp parallel)
+#define PARALLEL                                                               \
+  PRAGMA(omp parallel num_threads(Mantid::Kernel::threadsForParallelRegion()))
 
 #define PARALLEL_SECTIONS PRAGMA(omp sections nowait)
 
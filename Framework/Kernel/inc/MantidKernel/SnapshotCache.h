@@ -0,0 +1,216 @@
+#ifndef MANTID_KERNEL_SNAPSHOTCACHE_H_
+#define MANTID_KERNEL_SNAPSHOTCACHE_H_
+
+#include "MantidKernel/DllConfig.h"
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+/** SnapshotCache : A cache for values that are read by many threads at once,
+  e.g. the positions of the components of an instrument.
+
+  Values are looked up in an immutable snapshot without taking a mutex. Values that
+  are set after the snapshot was published go into one of a number of shards,
+  each guarded by its own mutex, so that threads that miss the snapshot rarely
+  wait for each other. publish() merges the shards, and optionally values that
+  were computed in one pass, into a new snapshot. A value that is in the
+  snapshot is looked up from there, even if it was set again since, until the
+  next publish().
+
+  The snapshot is published through an atomic raw pointer, so a lookup does
+  not touch any shared reference count. Replaced snapshots are kept until
+  clear(), as a reader may still be looking up in them. clear() and the copy
+  assignment must not run while other threads use the cache; all other
+  methods may be called from any number of threads.
+
+  Copyright &copy; 2016 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+template <class KEYTYPE, class VALUETYPE, class HASH = std::hash<KEYTYPE>>
+class DLLExport SnapshotCache {
+public:
+  typedef std::unordered_map<KEYTYPE, VALUETYPE, HASH> Map;
+
+  SnapshotCache() : m_snapshot(nullptr) {}
+  /// Copy constructor. The copy has a snapshot of all values of src.
+  SnapshotCache(const SnapshotCache &src) : m_snapshot(nullptr) {
+    setSnapshot(src.values());
+  }
+  /// Copy assignment, see the copy constructor
+  SnapshotCache &operator=(const SnapshotCache &rhs) {
+    if (this != &rhs) {
+      Map values = rhs.values();
+      clear();
+      setSnapshot(std::move(values));
+    }
+    return *this;
+  }
+
+  /// Remove all values and free the snapshots. Must not be called while
+  /// other threads use the cache.
+  void clear() {
+    m_snapshot.store(nullptr, std::memory_order_release);
+    {
+      std::lock_guard<std::mutex> lock(m_snapshotsMutex);
+      m_snapshots.clear();
+    }
+    for (auto &shard : m_shards) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      shard.values.clear();
+    }
+  }
+
+  /// Returns the number of values in the cache
+  size_t size() const { return values().size(); }
+  /// Returns true if a snapshot was published since the last clear()
+  bool hasSnapshot() const {
+    return m_snapshot.load(std::memory_order_acquire) != nullptr;
+  }
+
+  /**
+   * Inserts/updates a cached value with the given key. If the key is in the
+   * snapshot, the new value is only returned after the next publish().
+   * @param key The key
+   * @param value The new value for the key
+   */
+  void setCache(const KEYTYPE &key, const VALUETYPE &value) {
+    Shard &shard = shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.values[key] = value;
+  }
+
+  /**
+   * Attempts to retrieve a value from the cache, first from the snapshot
+   * without locking and then from the values set since it was published.
+   * @param key The key for the requested value
+   * @param value An output reference for the value, set to the current value
+   * if found, otherwise it is untouched
+   * @returns True if the value was found, false otherwise
+   */
+  bool getCache(const KEYTYPE &key, VALUETYPE &value) const {
+    if (getSnapshot(key, value))
+      return true;
+    const Shard &shard = shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.values.find(key);
+    if (it == shard.values.end())
+      return false;
+    value = it->second;
+    return true;
+  }
+
+  /**
+   * Attempts to retrieve a value from the snapshot only, which takes no mutex
+   * @param key The key for the requested value
+   * @param value An output reference for the value, set to the current value
+   * if found, otherwise it is untouched
+   * @returns True if the value was found, false otherwise
+   */
+  bool getSnapshot(const KEYTYPE &key, VALUETYPE &value) const {
+    const Map *snapshot = m_snapshot.load(std::memory_order_acquire);
+    if (!snapshot)
+      return false;
+    auto it = snapshot->find(key);
+    if (it == snapshot->end())
+      return false;
+    value = it->second;
+    return true;
+  }
+
+  /**
+   * Merge the values set since the last snapshot into a new snapshot
+   * @param newValues :: Further values to add to the snapshot, replacing any
+   * current values of the same keys
+   */
+  void publish(const Map &newValues = Map()) {
+    Map all = values();
+    for (const auto &value : newValues)
+      all[value.first] = value.second;
+    setSnapshot(std::move(all));
+  }
+
+  /**
+   * Replace the snapshot, and drop the values set since the last one. The
+   * old snapshot is freed by clear().
+   * @param snapshot :: The new contents of the cache
+   */
+  void setSnapshot(Map snapshot) {
+    for (auto &shard : m_shards) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      shard.values.clear();
+    }
+    std::lock_guard<std::mutex> lock(m_snapshotsMutex);
+    m_snapshots.emplace_back(new Map(std::move(snapshot)));
+    m_snapshot.store(m_snapshots.back().get(), std::memory_order_release);
+  }
+
+private:
+  /// Values set since the last snapshot, with a key of a given hash
+  struct Shard {
+    mutable std::mutex mutex;
+    Map values;
+  };
+  static const size_t NUM_SHARDS = 16;
+
+  const Shard &shardOf(const KEYTYPE &key) const {
+    // Mix the bits, as e.g. the hash of a pointer is the aligned address
+    size_t hash = HASH()(key);
+    hash ^= hash >> 17;
+    hash *= 0x9E3779B1u;
+    return m_shards[(hash >> 8) % NUM_SHARDS];
+  }
+  Shard &shardOf(const KEYTYPE &key) {
+    return const_cast<Shard &>(
+        static_cast<const SnapshotCache *>(this)->shardOf(key));
+  }
+
+  /// Returns all values, the ones set since the snapshot replacing its values
+  Map values() const {
+    const Map *snapshot = m_snapshot.load(std::memory_order_acquire);
+    Map all = snapshot ? *snapshot : Map();
+    for (const auto &shard : m_shards) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      for (const auto &value : shard.values)
+        all[value.first] = value.second;
+    }
+    return all;
+  }
+
+  /// The values at the time of the last publish(), or NULL
+  std::atomic<const Map *> m_snapshot;
+  /// The current and all replaced snapshots, freed by clear()
+  std::vector<std::unique_ptr<const Map>> m_snapshots;
+  /// Guards m_snapshots
+  std::mutex m_snapshotsMutex;
+  std::array<Shard, NUM_SHARDS> m_shards;
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_SNAPSHOTCACHE_H_ */
@@ -0,0 +1,84 @@
+#ifndef MANTID_KERNEL_TASKGRAPH_H_
+#define MANTID_KERNEL_TASKGRAPH_H_
+
+#include "MantidKernel/DllConfig.h"
+
+#include <functional>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** TaskGraph : A set of functions with dependencies between them, executed by
+ * a ThreadPool with a ThreadSchedulerWorkStealing. A task is scheduled as soon
+ * as all of the tasks it depends on have finished, by the thread that
+ * finished the last of them.
+ *
+ * All TaskGraphs, and the OpenMP parallel regions within their tasks (see the
+ * PARALLEL_* macros of MultiThreaded.h), share a budget of threads, the number
+ * of cores. A graph executed within a task of another graph, e.g. by a child
+ * algorithm, only gets the threads that are not in use, and runs in the
+ * calling thread if there are none, so that nested parallel regions do not
+ * oversubscribe the cores.
+ *
+ * Usage:
+ * @code
+ *   TaskGraph graph;
+ *   auto load = graph.addTask([&] { ... });
+ *   auto monitors = graph.addTask([&] { ... });
+ *   graph.addTask([&] { ... }, {load, monitors});
+ *   graph.execute();
+ * @endcode
+
+  Copyright &copy; 2016 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+ */
+class MANTID_KERNEL_DLL TaskGraph {
+public:
+  size_t addTask(std::function<void()> func,
+                 const std::vector<size_t> &dependencies = {});
+  /// Returns the number of tasks in the graph
+  size_t size() const { return m_nodes.size(); }
+
+  void execute(size_t maxThreads = 0);
+
+  static size_t threadsInUse();
+  static bool inTask();
+
+private:
+  /// A task and the tasks depending on it
+  struct Node {
+    std::function<void()> func;
+    std::vector<size_t> dependents;
+    size_t numDependencies;
+  };
+  friend class TaskGraphScheduler;
+
+  void executeSerially();
+
+  /// All tasks, in the order they were added
+  std::vector<Node> m_nodes;
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_TASKGRAPH_H_ */
@@ -104,11 +104,11 @@ public:
 
   //-------------------------------------------------------------------------------
   /// Returns the total cost of all Task's in the queue.
-  double totalCost() { return m_cost; }
+  virtual double totalCost() { return m_cost; }
 
   //-------------------------------------------------------------------------------
   /// Returns the total cost of all Task's in the queue.
-  double totalCostExecuted() { return m_costExecuted; }
+  virtual double totalCostExecuted() { return m_costExecuted; }
 
   //-------------------------------------------------------------------------------
   /// Returns the exception that was caught, if any.
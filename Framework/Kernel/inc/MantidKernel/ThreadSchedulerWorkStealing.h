@@ -0,0 +1,96 @@
+#ifndef MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_
+#define MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_
+
+#include "MantidKernel/DllConfig.h"
+#include "MantidKernel/ThreadScheduler.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** ThreadSchedulerWorkStealing : A ThreadScheduler with one queue per
+ * thread instead of a single queue shared by all threads.
+ *
+ * A task pushed by a thread of the pool (e.g., a task that creates more
+ * tasks) goes to the back of the queue of that thread, and each thread pops
+ * from the back of its own queue first. Tasks pushed from outside of the pool
+ * are distributed over the queues in turn. A thread whose queue is empty
+ * steals the oldest task from the front of the queue of another thread,
+ * starting with a randomly chosen one. Threads therefore only contend for a
+ * queue when stealing.
+ *
+ * Task costs are ignored and Task mutexes are not taken into account: a
+ * thread popping a task whose mutex is in use waits for it. Use
+ * ThreadSchedulerMutexes for tasks that share mutexes. Each queue adds up
+ * the costs of its tasks, which totalCost() and totalCostExecuted() sum.
+
+  Copyright &copy; 2016 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+ */
+class MANTID_KERNEL_DLL ThreadSchedulerWorkStealing : public ThreadScheduler {
+public:
+  explicit ThreadSchedulerWorkStealing(size_t numQueues = 0);
+  ~ThreadSchedulerWorkStealing() override;
+
+  void push(Task *newTask) override;
+  Task *pop(size_t threadnum) override;
+  size_t size() override;
+  bool empty() override;
+  void clear() override;
+  double totalCost() override;
+  double totalCostExecuted() override;
+
+  /// Returns the number of queues, one per thread.
+  size_t numberOfQueues() const { return m_queues.size(); }
+  size_t queueSize(size_t queue);
+
+private:
+  /// The tasks of one thread
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task *> tasks;
+    /// Cost of the tasks pushed to the queue
+    double cost = 0.;
+    /// Cost of the tasks popped from the queue
+    double costExecuted = 0.;
+  };
+
+  Task *steal(size_t thief);
+
+  /// Unique ID of this scheduler, remembered by the threads popping from it
+  const size_t m_id;
+  /// One queue for each thread
+  std::vector<std::unique_ptr<Queue>> m_queues;
+  /// Number of tasks in all queues
+  std::atomic<size_t> m_size;
+  /// Queue for the next task pushed from outside of the pool
+  std::atomic<size_t> m_nextQueue;
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_ */
@@ -9,6 +9,7 @@
 #include "MantidKernel/ITimeSeriesProperty.h"
 #include "MantidKernel/Property.h"
 #include "MantidKernel/Statistics.h"
+#include <memory>
 #include <utility>
 
 namespace Mantid {
@@ -319,6 +320,10 @@ private:
   mutable std::vector<std::pair<size_t, size_t>> m_filterQuickRef;
   /// True if a filter has been applied
   mutable bool m_filterApplied;
+  /// Time-weighted sums of the values of consecutive chunks of the sorted
+  /// entries, built on demand. Only replaced with std::atomic_store, and reset
+  /// whenever the values change.
+  mutable std::shared_ptr<const std::vector<double>> m_chunkIntegrals;
 };
 
 /// Function filtering double TimeSeriesProperties according to the requested
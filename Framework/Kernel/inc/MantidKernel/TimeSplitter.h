@@ -3,6 +3,9 @@
 
 #include "MantidKernel/DateAndTime.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace Mantid {
 namespace Kernel {
 
@@ -64,6 +67,61 @@ MANTID_KERNEL_DLL TimeSplitterType
 operator|(const TimeSplitterType &a, const TimeSplitterType &b);
 MANTID_KERNEL_DLL TimeSplitterType operator~(const TimeSplitterType &a);
 
+/**
+ * The intervals of a splitter compiled into sorted boundary times, and the
+ * destination of the times between each pair of boundaries. Looking up the
+ * destination of times that are (mostly) sorted takes constant time per time,
+ * however many intervals there are.
+ *
+ * Interval i holds the times t with boundary(i-1) <= t < boundary(i), where
+ * the first interval starts at -infinity and the last one ends at +infinity,
+ * so there is one more destination than there are boundaries. Destinations are
+ * indices into a list of outputs, or NO_DESTINATION for times that are
+ * dropped.
+ */
+class MANTID_KERNEL_DLL TimeSplitterIndex {
+public:
+  /// Destination of the times that are not kept
+  static const int NO_DESTINATION = -1;
+
+  TimeSplitterIndex(std::vector<int64_t> boundaries,
+                    std::vector<int> destinations);
+
+  /// Number of intervals, including the ones before the first and after the
+  /// last boundary
+  size_t numberOfIntervals() const { return m_destinations.size(); }
+
+  /**
+   * Returns the destination of a time
+   * @param time :: Time in nanoseconds
+   * @param interval :: [in,out] the interval of the previous time, updated to
+   * the interval of this one. Start a sweep with 0.
+   */
+  int destination(const int64_t time, size_t &interval) const {
+    const size_t numBoundaries = m_boundaries.size();
+    if (interval > numBoundaries ||
+        (interval > 0 && time < m_boundaries[interval - 1]) ||
+        (interval < numBoundaries && time >= m_boundaries[interval])) {
+      // The next interval is the most likely, search for any other one
+      if (interval < numBoundaries && time >= m_boundaries[interval] &&
+          (interval + 1 == numBoundaries ||
+           time < m_boundaries[interval + 1]))
+        ++interval;
+      else
+        interval = std::upper_bound(m_boundaries.begin(), m_boundaries.end(),
+                                    time) -
+                   m_boundaries.begin();
+    }
+    return m_destinations[interval];
+  }
+
+private:
+  /// Sorted times in nanoseconds at which the intervals change
+  std::vector<int64_t> m_boundaries;
+  /// The destination of each interval
+  std::vector<int> m_destinations;
+};
+
 } // Namespace Kernel
 } // Namespace Mantid
 
@@ -182,6 +182,22 @@ public:
    */
   virtual double singleFromTOF(const double tof) const = 0;
 
+  /** Convert many X values to TOF in place, with the same results as
+   * singleToTOF(). Units override this to convert without a virtual call per
+   * value. A unit that overrides singleToTOF() of a unit that overrides this
+   * must override this as well.
+   * @param first :: The first value to convert
+   * @param last :: One past the last value to convert
+   */
+  virtual void rangeToTOF(double *first, double *last) const;
+
+  /** Convert many tof values to this unit in place, with the same results as
+   * singleFromTOF(), see rangeToTOF().
+   * @param first :: The first value to convert
+   * @param last :: One past the last value to convert
+   */
+  virtual void rangeFromTOF(double *first, double *last) const;
+
   /// @return true if the unit was initialized and so can use singleToTOF()
   bool isInitialized() const { return initialized; }
 
@@ -300,6 +316,8 @@ public:
   void init() override;
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void rangeToTOF(double *first, double *last) const override;
+  void rangeFromTOF(double *first, double *last) const override;
   Unit *clone() const override;
   ///@return -DBL_MAX as ToF convertible to TOF for in any time range
   double conversionTOFMin() const override;
@@ -317,6 +335,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void rangeToTOF(double *first, double *last) const override;
+  void rangeFromTOF(double *first, double *last) const override;
   void init() override;
   Unit *clone() const override;
 
@@ -344,6 +364,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void rangeToTOF(double *first, double *last) const override;
+  void rangeFromTOF(double *first, double *last) const override;
   void init() override;
   Unit *clone() const override;
 
@@ -368,6 +390,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void rangeToTOF(double *first, double *last) const override;
+  void rangeFromTOF(double *first, double *last) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -391,6 +415,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void rangeToTOF(double *first, double *last) const override;
+  void rangeFromTOF(double *first, double *last) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -414,6 +440,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void rangeToTOF(double *first, double *last) const override;
+  void rangeFromTOF(double *first, double *last) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -436,6 +464,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void rangeToTOF(double *first, double *last) const override;
+  void rangeFromTOF(double *first, double *last) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -459,6 +489,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void rangeToTOF(double *first, double *last) const override;
+  void rangeFromTOF(double *first, double *last) const override;
   void init() override;
   Unit *clone() const override;
 
@@ -502,6 +534,8 @@ public:
 
   double singleToTOF(const double ki) const override;
   double singleFromTOF(const double tof) const override;
+  void rangeToTOF(double *first, double *last) const override;
+  void rangeFromTOF(double *first, double *last) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -528,6 +562,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void rangeToTOF(double *first, double *last) const override;
+  void rangeFromTOF(double *first, double *last) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -547,6 +583,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void rangeToTOF(double *first, double *last) const override;
+  void rangeFromTOF(double *first, double *last) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -1,4 +1,6 @@
 #include "MantidKernel/DiskBuffer.h"
+#include <algorithm>
+#include <iterator>
 #include <sstream>
 
 using namespace Mantid::Kernel;
@@ -11,7 +13,9 @@ namespace Kernel {
  */
 DiskBuffer::DiskBuffer()
     : m_writeBufferSize(50), m_writeBufferUsed(0), m_nObjectsToWrite(0),
-      m_free(), m_free_bySize(m_free.get<1>()), m_fileLength(0) {
+      m_backgroundIO(false), m_writing(false), m_stopThread(false),
+      m_loading(nullptr), m_free(), m_free_bySize(m_free.get<1>()),
+      m_fileLength(0) {
   m_free.clear();
 }
 
@@ -24,17 +28,30 @@ DiskBuffer::DiskBuffer()
  */
 DiskBuffer::DiskBuffer(uint64_t m_writeBufferSize)
     : m_writeBufferSize(m_writeBufferSize), m_writeBufferUsed(0),
-      m_nObjectsToWrite(0), m_free(), m_free_bySize(m_free.get<1>()),
-      m_fileLength(0) {
+      m_nObjectsToWrite(0), m_backgroundIO(false), m_writing(false),
+      m_stopThread(false), m_loading(nullptr), m_free(),
+      m_free_bySize(m_free.get<1>()), m_fileLength(0) {
   m_free.clear();
 }
 
+//----------------------------------------------------------------------------------------------
+/** Destructor. Stops the background thread, if any, without writing out the
+ * buffer.
+ */
+DiskBuffer::~DiskBuffer() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_toLoad.clear();
+  }
+  stopBackgroundIO();
+}
+
 //---------------------------------------------------------------------------------------------
 /** Call this method when an object is ready to be written
  * out to disk.
  *
  * When the to-write buffer is full, all of it gets written
- * out to disk using writeOldObjects()
+ * out to disk using writeOldObjects().
  *
  * @param item :: item that can be written to disk.
  */
@@ -43,27 +60,37 @@ void DiskBuffer::toWrite(ISaveable *item) {
     return;
   //    if (!m_useWriteBuffer) return;
 
+  std::unique_lock<std::mutex> uniqueLock(m_mutex);
+  if (!addToBuffer(item))
+    return;
+  uniqueLock.unlock();
+  writeOldObjects();
+}
+
+/** Add an object to the to-write buffer, or update its size if it is in it
+ * already. Call with m_mutex locked.
+ *
+ * @param item :: item that can be written to disk.
+ * @return true if the buffer is full, and should be written out.
+ */
+bool DiskBuffer::addToBuffer(ISaveable *item) {
   if (item->getBufPostion()) // already in the buffer and probably have changed
                              // its size in memory
   {
     // forget old memory size
-    std::unique_lock<std::mutex> uniqueLock(m_mutex);
     m_writeBufferUsed -= item->getBufferSize();
     // add new size
     size_t newMemorySize = item->getDataMemorySize();
     m_writeBufferUsed += newMemorySize;
-    uniqueLock.unlock();
     item->setBufferSize(newMemorySize);
   } else {
-    std::lock_guard<std::mutex> lock(m_mutex);
     m_toWriteBuffer.push_front(item);
     m_writeBufferUsed += item->setBufferPosition(m_toWriteBuffer.begin());
     m_nObjectsToWrite++;
   }
 
   // Should we now write out the old data?
-  if (m_writeBufferUsed > m_writeBufferSize)
-    writeOldObjects();
+  return m_writeBufferUsed > m_writeBufferSize;
 }
 
 //---------------------------------------------------------------------------------------------
@@ -77,12 +104,18 @@ void DiskBuffer::toWrite(ISaveable *item) {
 void DiskBuffer::objectDeleted(ISaveable *item) {
   if (item == nullptr)
     return;
-  // have it ever been in the buffer?
   std::unique_lock<std::mutex> uniqueLock(m_mutex);
+  // It may be in the batch being written, or being loaded, in the background
+  m_toLoad.erase(std::remove(m_toLoad.begin(), m_toLoad.end(), item),
+                 m_toLoad.end());
+  m_workDone.wait(uniqueLock,
+                  [this, item] { return !m_writing && m_loading != item; });
+  // have it ever been in the buffer?
   auto opt2it = item->getBufPostion();
   if (opt2it) {
     m_writeBufferUsed -= item->getBufferSize();
     m_toWriteBuffer.erase(*opt2it);
+    m_nObjectsToWrite--;
   } else {
     return;
   }
@@ -101,72 +134,90 @@ void DiskBuffer::objectDeleted(ISaveable *item) {
  * stored in the "toWrite" buffer.
  */
 void DiskBuffer::writeOldObjects() {
+  std::unique_lock<std::mutex> uniqueLock(m_mutex);
+  // Only one batch is written at a time
+  m_workDone.wait(uniqueLock, [this] { return !m_writing; });
+  // The iterators stored in the objects now point into the batch
+  std::list<ISaveable *> batch;
+  batch.swap(m_toWriteBuffer);
+  m_writing = true;
+  uniqueLock.unlock();
+
+  writeBatch(batch);
+}
 
-  std::lock_guard<std::mutex> _lock(m_mutex);
+//---------------------------------------------------------------------------------------------
+/** Write out a batch of objects taken from the "toWrite" buffer. Busy objects
+ * are put back into the buffer. Each object is locked until the batch is
+ * written, so that it is not loaded or used meanwhile. The new file positions
+ * are allocated in the order of the batch, but the objects are saved in the
+ * order of their file positions.
+ *
+ * Call with m_writing set; it is cleared at the end.
+ *
+ * @param batch :: the objects to write out
+ */
+void DiskBuffer::writeBatch(std::list<ISaveable *> &batch) {
   // Holder for any objects that you were NOT able to write.
   std::list<ISaveable *> couldNotWrite;
-  size_t objectsNotWritten(0);
-  size_t memoryNotWritten(0);
-
-  // Iterate through the list
-  auto it = m_toWriteBuffer.begin();
-  auto it_end = m_toWriteBuffer.end();
+  // Objects written out or cleared from memory, locked
+  std::vector<ISaveable *> done;
+  std::vector<std::unique_lock<std::mutex>> locks;
+  // Objects to save, with their new position and size in the file
+  struct Block {
+    uint64_t position;
+    uint64_t size;
+    ISaveable *obj;
+  };
+  std::vector<Block> toSave;
 
   ISaveable *obj = nullptr;
-
-  for (; it != it_end; ++it) {
+  for (auto it = batch.begin(); it != batch.end(); ++it) {
     obj = *it;
-    if (!obj->isBusy()) {
-      uint64_t NumObjEvents = obj->getTotalDataSize();
-      uint64_t fileIndexStart;
-      if (!obj->wasSaved()) {
-        fileIndexStart = this->allocate(NumObjEvents);
-        // Write to the disk; this will call the object specific save function;
-        // Prevent simultaneous file access (e.g. write while loading)
-        obj->saveAt(fileIndexStart, NumObjEvents);
-      } else {
-        uint64_t NumFileEvents = obj->getFileSize();
-        if (NumObjEvents != NumFileEvents) {
-          // Event list changed size. The MRU can tell us where it best fits
-          // now.
-          fileIndexStart = this->relocate(obj->getFilePosition(), NumFileEvents,
-                                          NumObjEvents);
-          // Write to the disk; this will call the object specific save
-          // function;
-          obj->saveAt(fileIndexStart, NumObjEvents);
-        } else // despite object size have not been changed, it can be modified
-               // other way. In this case, the method which changed the data
-               // should set dataChanged ID
-        {
-          if (obj->isDataChanged()) {
-            fileIndexStart = obj->getFilePosition();
-            // Write to the disk; this will call the object specific save
-            // function;
-            obj->saveAt(fileIndexStart, NumObjEvents);
-            // this is questionable operation, which adjust file size in case
-            // when the file postions were allocated externaly
-            if (fileIndexStart + NumObjEvents > m_fileLength)
-              m_fileLength = fileIndexStart + NumObjEvents;
-          } else // just clean the object up -- it just occupies memory
-            obj->clearDataFromMemory();
-        }
-      }
-      // tell the object that it has been removed from the buffer
-      obj->clearBufferState();
-    } else // object busy
-    {
+    std::unique_lock<std::mutex> dataLock(obj->m_dataMutex);
+    if (obj->isBusy()) {
       // The object is busy, can't write. Save it for later
       couldNotWrite.push_back(obj);
-      // When a prefix or postfix operator is applied to a function argument,
-      // the value of the argument is
-      // NOT GUARANTEED to be incremented or decremented before it is passed to
-      // the function.
-      auto it = --couldNotWrite.end();
-      memoryNotWritten += obj->setBufferPosition(it);
-      objectsNotWritten++;
+      continue;
+    }
+    uint64_t NumObjEvents = obj->getTotalDataSize();
+    if (!obj->wasSaved()) {
+      toSave.push_back({this->allocate(NumObjEvents), NumObjEvents, obj});
+    } else {
+      uint64_t NumFileEvents = obj->getFileSize();
+      if (NumObjEvents != NumFileEvents) {
+        // Event list changed size. The MRU can tell us where it best fits
+        // now.
+        toSave.push_back({this->relocate(obj->getFilePosition(), NumFileEvents,
+                                         NumObjEvents),
+                          NumObjEvents, obj});
+      } else if (obj->isDataChanged()) {
+        // despite object size have not been changed, it can be modified
+        // other way. In this case, the method which changed the data
+        // should set dataChanged ID
+        uint64_t fileIndexStart = obj->getFilePosition();
+        toSave.push_back({fileIndexStart, NumObjEvents, obj});
+        // this is questionable operation, which adjust file size in case
+        // when the file postions were allocated externaly
+        std::lock_guard<std::mutex> freeLock(m_freeMutex);
+        if (fileIndexStart + NumObjEvents > m_fileLength)
+          m_fileLength = fileIndexStart + NumObjEvents;
+      } else // just clean the object up -- it just occupies memory
+        obj->clearDataFromMemory();
     }
+    done.push_back(obj);
+    locks.push_back(std::move(dataLock));
   }
 
+  // Write to the disk in file order; this will call the object specific save
+  // function
+  std::sort(toSave.begin(), toSave.end(),
+            [](const Block &a, const Block &b) {
+              return a.position < b.position;
+            });
+  for (const auto &block : toSave)
+    block.obj->saveAt(block.position, block.size);
+
   // use last object to clear NeXus buffer and actually write data to HDD
   if (obj) {
     // NXS needs to flush the writes to file by closing and re-opening the data
@@ -176,20 +227,129 @@ void DiskBuffer::writeOldObjects() {
     obj->flushData();
   }
 
-  // Exchange with the new map you built out of the not-written blocks.
-  m_toWriteBuffer.swap(couldNotWrite);
-  m_writeBufferUsed = memoryNotWritten;
-  m_nObjectsToWrite = objectsNotWritten;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  // tell the objects that they have been removed from the buffer, before
+  // unlocking them
+  for (auto written : done) {
+    m_writeBufferUsed -= written->getBufferSize();
+    written->clearBufferState();
+  }
+  m_nObjectsToWrite -= done.size();
+  locks.clear();
+  // Put the busy objects back at the end of the buffer, in the same order
+  for (auto notWritten : couldNotWrite) {
+    m_writeBufferUsed -= notWritten->getBufferSize();
+    m_toWriteBuffer.push_back(notWritten);
+    m_writeBufferUsed +=
+        notWritten->setBufferPosition(std::prev(m_toWriteBuffer.end()));
+  }
+  m_writing = false;
+  m_workDone.notify_all();
 }
 
 //---------------------------------------------------------------------------------------------
 /** Flush out all the data in the memory; and writes out everything in the
- * to-write cache. */
+ * to-write cache. The objects not yet prefetched are dropped and the
+ * background thread, if any, is stopped. */
 void DiskBuffer::flushCache() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_toLoad.clear();
+  }
+  stopBackgroundIO();
   // Now write everything out.
   writeOldObjects();
 }
 
+//---------------------------------------------------------------------------------------------
+/** Prefetch objects in a background thread, or not. The to-write buffer is
+ * always written out by the threads that fill it, so turning background I/O
+ * off only drops the objects not yet prefetched and stops the thread.
+ *
+ * @param background :: true to use a background thread. If false,
+ * prefetch() does nothing.
+ */
+void DiskBuffer::setBackgroundIO(const bool background) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_backgroundIO = background;
+    if (!background)
+      m_toLoad.clear();
+  }
+  if (!background)
+    stopBackgroundIO();
+}
+
+//---------------------------------------------------------------------------------------------
+/** Load an object in the background thread, ahead of its use. Call it for
+ * the objects that will be used soon, in the order they will be used. The
+ * object is then added to the to-write buffer, so that it can be cleared from
+ * memory again if it is not used.
+ *
+ * Does nothing without background I/O.
+ *
+ * @param item :: object to load.
+ */
+void DiskBuffer::prefetch(ISaveable *item) {
+  if (item == nullptr || !item->wasSaved() || item->isLoaded())
+    return;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_backgroundIO)
+    return;
+  m_toLoad.push_back(item);
+  startBackgroundIO();
+  m_workToDo.notify_all();
+}
+
+/// Start the background thread, if it is not running. Call with m_mutex
+/// locked.
+void DiskBuffer::startBackgroundIO() {
+  if (!m_thread.joinable())
+    m_thread = std::thread(&DiskBuffer::runBackgroundIO, this);
+}
+
+/// Stop the background thread, if it is running, once it has finished the
+/// object or batch it is working on.
+void DiskBuffer::stopBackgroundIO() {
+  std::unique_lock<std::mutex> uniqueLock(m_mutex);
+  if (!m_thread.joinable())
+    return;
+  m_stopThread = true;
+  m_workToDo.notify_all();
+  uniqueLock.unlock();
+  m_thread.join();
+  uniqueLock.lock();
+  m_stopThread = false;
+}
+
+/// The loop of the background thread: load the objects to prefetch, in
+/// order.
+void DiskBuffer::runBackgroundIO() {
+  std::unique_lock<std::mutex> uniqueLock(m_mutex);
+  while (true) {
+    m_workToDo.wait(uniqueLock,
+                    [this] { return m_stopThread || !m_toLoad.empty(); });
+    if (m_stopThread)
+      return;
+
+    m_loading = m_toLoad.front();
+    m_toLoad.pop_front();
+    uniqueLock.unlock();
+    ISaveable *item = m_loading;
+    {
+      std::lock_guard<std::mutex> dataLock(item->m_dataMutex);
+      if (item->wasSaved() && !item->isLoaded())
+        item->load();
+    }
+    uniqueLock.lock();
+    // A full buffer is written out by the next other caller of toWrite(), so
+    // that this thread only ever loads objects
+    addToBuffer(item);
+    m_loading = nullptr;
+    m_workDone.notify_all();
+  }
+}
+
 //---------------------------------------------------------------------------------------------
 /** This method is called by this->relocate when object that has shrunk
  * and so has left a bit of free space after itself on the file;
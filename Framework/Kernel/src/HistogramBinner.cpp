@@ -0,0 +1,110 @@
+#include "MantidKernel/HistogramBinner.h"
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// Tolerance, relative to the bin width, for edges to count as equidistant or
+/// logarithmic. It only has to be small enough that the arithmetic bin index
+/// is off by at most one bin, which is corrected by comparing with the edges.
+const double SPACING_TOLERANCE = 1e-6;
+}
+
+/** Constructor. Determines the spacing of the bin edges.
+ *
+ * @param binEdges :: The bin edges. The binner keeps a reference to them.
+ */
+HistogramBinner::HistogramBinner(const std::vector<double> &binEdges)
+    : m_edges(binEdges),
+      m_numberOfBins(binEdges.size() < 2 ? 0 : binEdges.size() - 1),
+      m_spacing(Spacing::Irregular), m_front(0.0), m_back(0.0),
+      m_maxIndex(0.0), m_offset(0.0), m_inverseStep(0.0) {
+  if (m_numberOfBins == 0)
+    return;
+  m_front = binEdges.front();
+  m_back = binEdges.back();
+  m_maxIndex = static_cast<double>(m_numberOfBins - 1);
+  if (isLinear())
+    m_spacing = Spacing::Linear;
+  else if (isLogarithmic())
+    m_spacing = Spacing::Logarithmic;
+}
+
+/** Find the bins of an array of values.
+ *
+ * For linear and logarithmic bins this first estimates the bin index of all
+ * values in a loop without branches or table lookups, which the compiler can
+ * vectorize, and then checks the estimates against the bin edges.
+ *
+ * @param x :: Pointer to the values.
+ * @param count :: Number of values.
+ * @param indices :: Output, must have space for count entries. Set to the bin
+ * index of each value, or numberOfBins() if it is outside of the histogram.
+ */
+void HistogramBinner::binIndices(const double *x, const size_t count,
+                                 size_t *indices) const {
+  switch (m_spacing) {
+  case Spacing::Linear:
+    for (size_t i = 0; i < count; ++i)
+      indices[i] = clampIndex((x[i] - m_offset) * m_inverseStep);
+    break;
+  case Spacing::Logarithmic:
+    for (size_t i = 0; i < count; ++i)
+      indices[i] = clampIndex((std::log(x[i]) - m_offset) * m_inverseStep);
+    break;
+  case Spacing::Irregular:
+    for (size_t i = 0; i < count; ++i)
+      indices[i] = binIndex(x[i]);
+    return;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    if (x[i] >= m_front && x[i] < m_back)
+      indices[i] = correctIndex(x[i], indices[i]);
+    else
+      indices[i] = m_numberOfBins;
+  }
+}
+
+/// Returns true if all edges but the last are equidistant. The last bin may be
+/// wider or narrower.
+bool HistogramBinner::isLinear() {
+  const double step = m_edges[1] - m_edges[0];
+  if (!(step > 0.0))
+    return false;
+  const double tolerance = SPACING_TOLERANCE * step;
+  for (size_t i = 2; i < m_numberOfBins; ++i)
+    if (std::abs(m_edges[i] - (m_front + static_cast<double>(i) * step)) >
+        tolerance)
+      return false;
+  if (!(m_back > m_edges[m_numberOfBins - 1]))
+    return false;
+  m_offset = m_front;
+  m_inverseStep = 1.0 / step;
+  return true;
+}
+
+/// Returns true if the ratio of all consecutive edges but the last is the
+/// same. The last bin may be wider or narrower.
+bool HistogramBinner::isLogarithmic() {
+  if (!(m_front > 0.0))
+    return false;
+  const double ratio = m_edges[1] / m_edges[0];
+  if (!(ratio > 1.0))
+    return false;
+  double expected = m_edges[1];
+  for (size_t i = 2; i < m_numberOfBins; ++i) {
+    const double previous = expected;
+    expected *= ratio;
+    if (std::abs(m_edges[i] - expected) >
+        SPACING_TOLERANCE * (expected - previous))
+      return false;
+  }
+  if (!(m_back > m_edges[m_numberOfBins - 1]))
+    return false;
+  m_offset = std::log(m_front);
+  m_inverseStep = 1.0 / std::log(ratio);
+  return true;
+}
+
+} // namespace Kernel
+} // namespace Mantid
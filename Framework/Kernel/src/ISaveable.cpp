@@ -16,7 +16,7 @@ ISaveable::ISaveable()
     Note setting isLoaded to false to break connection with the file object
    which is not copyale */
 ISaveable::ISaveable(const ISaveable &other)
-    : m_Busy(other.m_Busy), m_dataChanged(other.m_dataChanged),
+    : m_Busy(other.m_Busy.load()), m_dataChanged(other.m_dataChanged),
       m_wasSaved(other.m_wasSaved), m_isLoaded(false),
       m_BufPosition(other.m_BufPosition),
       m_BufMemorySize(other.m_BufMemorySize),
@@ -40,6 +40,18 @@ void ISaveable::setFilePosition(uint64_t newPos, size_t newSize,
   m_wasSaved = wasSaved;
 }
 
+/** Load the data if they were saved and mark them busy, so that the
+ * DiskBuffer does not write them out or clear them from memory until
+ * setBusy(false) is called. Waits for the DiskBuffer if it is writing out or
+ * loading this object in the background.
+ */
+void ISaveable::loadAndSetBusy() {
+  std::lock_guard<std::mutex> lock(m_dataMutex);
+  if (this->wasSaved())
+    this->load();
+  m_Busy = true;
+}
+
 // ----------- PRIVATE, only DB availible
 
 /** private function which used by the disk buffer to save the contents of the
@@ -0,0 +1,193 @@
+#include "MantidKernel/TaskGraph.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/ThreadPool.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <stdexcept>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// Number of threads running tasks of all TaskGraphs
+std::atomic<size_t> g_threadsInUse(0);
+/// True in a thread that is running a task of a TaskGraph
+thread_local bool g_inTask = false;
+
+/// Reserves threads of the budget shared by all TaskGraphs while in scope
+class ThreadReservation {
+public:
+  explicit ThreadReservation(const size_t wanted) : m_reserved(0) {
+    const size_t total = ThreadPool::getNumPhysicalCores();
+    size_t inUse = g_threadsInUse.load();
+    do {
+      m_reserved = inUse < total ? std::min(wanted, total - inUse) : 0;
+    } while (!g_threadsInUse.compare_exchange_weak(inUse, inUse + m_reserved));
+  }
+  ~ThreadReservation() { g_threadsInUse -= m_reserved; }
+  size_t reserved() const { return m_reserved; }
+
+private:
+  size_t m_reserved;
+};
+
+/// Marks the calling thread as running a task while in scope
+class InTaskScope {
+public:
+  InTaskScope() : m_wasInTask(g_inTask) { g_inTask = true; }
+  ~InTaskScope() { g_inTask = m_wasInTask; }
+
+private:
+  const bool m_wasInTask;
+};
+
+/// Runs one node of a TaskGraph
+class GraphTask : public Task {
+public:
+  GraphTask(std::function<void()> func, const size_t node)
+      : Task(), m_func(std::move(func)), m_node(node) {}
+  void run() override {
+    InTaskScope scope;
+    m_func();
+  }
+  size_t node() const { return m_node; }
+
+private:
+  const std::function<void()> m_func;
+  const size_t m_node;
+};
+}
+
+/** Schedules the tasks of a TaskGraph once their dependencies have finished.
+ * The pool is only empty once all tasks have run, so that its threads wait
+ * for tasks that are not ready yet instead of exiting.
+ */
+class TaskGraphScheduler : public ThreadSchedulerWorkStealing {
+public:
+  TaskGraphScheduler(const std::vector<TaskGraph::Node> &nodes,
+                     const size_t numThreads)
+      : ThreadSchedulerWorkStealing(numThreads), m_nodes(nodes),
+        m_remaining(nodes.size()),
+        m_numDependencies(new std::atomic<size_t>[nodes.size()]) {
+    for (size_t i = 0; i < nodes.size(); ++i)
+      m_numDependencies[i] = nodes[i].numDependencies;
+  }
+
+  /// Schedule the tasks that do not depend on other tasks
+  void pushReadyTasks() {
+    for (size_t i = 0; i < m_nodes.size(); ++i)
+      if (m_nodes[i].numDependencies == 0)
+        push(new GraphTask(m_nodes[i].func, i));
+  }
+
+  bool empty() override { return m_remaining == 0 || getAborted(); }
+
+  void finished(Task *task, size_t threadnum) override {
+    ThreadSchedulerWorkStealing::finished(task, threadnum);
+    if (getAborted())
+      return;
+    // Schedule the dependents before counting the task as done, so that the
+    // scheduler never looks empty while tasks are left.
+    const size_t node = static_cast<GraphTask *>(task)->node();
+    for (const auto dependent : m_nodes[node].dependents)
+      if (--m_numDependencies[dependent] == 0)
+        push(new GraphTask(m_nodes[dependent].func, dependent));
+    --m_remaining;
+  }
+
+private:
+  const std::vector<TaskGraph::Node> &m_nodes;
+  /// Number of tasks that have not finished
+  std::atomic<size_t> m_remaining;
+  /// Number of unfinished dependencies of each task
+  std::unique_ptr<std::atomic<size_t>[]> m_numDependencies;
+};
+
+/** Add a task to the graph
+ *
+ * @param func :: Function to run
+ * @param dependencies :: Tasks that must finish before this one starts. They
+ * must have been added before.
+ * @return the index of the task, used to refer to it in the dependencies of
+ * other tasks
+ * @throw std::invalid_argument if a dependency has not been added yet
+ */
+size_t TaskGraph::addTask(std::function<void()> func,
+                          const std::vector<size_t> &dependencies) {
+  const size_t index = m_nodes.size();
+  for (const auto dependency : dependencies)
+    if (dependency >= index)
+      throw std::invalid_argument("TaskGraph::addTask(): the dependencies of "
+                                  "a task must be added before it.");
+  m_nodes.push_back(Node{std::move(func), {}, dependencies.size()});
+  for (const auto dependency : dependencies)
+    m_nodes[dependency].dependents.push_back(index);
+  return index;
+}
+
+/** Run all tasks, and wait for them to finish. The graph can be executed
+ * again afterwards.
+ *
+ * @param maxThreads :: Maximum number of threads to use. 0 uses at most the
+ * number of cores.
+ * @throw std::runtime_error if a task threw, after the tasks that were
+ * running have finished. Tasks that were not started yet are skipped.
+ */
+void TaskGraph::execute(size_t maxThreads) {
+  if (m_nodes.empty())
+    return;
+  if (maxThreads == 0)
+    maxThreads = ThreadPool::getNumPhysicalCores();
+  maxThreads = std::min(maxThreads, m_nodes.size());
+
+  // A thread running a task of another graph lends its own thread while it
+  // waits for this one.
+  const size_t ownThread = g_inTask ? 1 : 0;
+  ThreadReservation reservation(maxThreads > ownThread ? maxThreads - ownThread
+                                                       : 0);
+  const size_t numThreads = reservation.reserved() + ownThread;
+  if (numThreads <= 1) {
+    executeSerially();
+    return;
+  }
+
+  auto scheduler = new TaskGraphScheduler(m_nodes, numThreads);
+  ThreadPool pool(scheduler, numThreads);
+  scheduler->pushReadyTasks();
+  pool.joinAll();
+}
+
+/// Run all tasks in the calling thread, in the order they were added
+void TaskGraph::executeSerially() {
+  InTaskScope scope;
+  for (const auto &node : m_nodes)
+    node.func();
+}
+
+/// Returns the number of threads running tasks of all TaskGraphs
+size_t TaskGraph::threadsInUse() { return g_threadsInUse; }
+
+/// Returns true if the calling thread is running a task of a TaskGraph
+bool TaskGraph::inTask() { return g_inTask; }
+
+/** Number of threads for an OpenMP parallel region started by the calling
+ * thread. Within a task of a TaskGraph, it is the number of threads that are
+ * not used by TaskGraphs, plus the calling thread. Elsewhere it is the usual
+ * number, even while a TaskGraph is running.
+ */
+int threadsForParallelRegion() {
+  const int maxThreads = PARALLEL_GET_MAX_THREADS;
+  const size_t inUse = g_threadsInUse;
+  if (!g_inTask || inUse == 0)
+    return maxThreads;
+  const size_t total = ThreadPool::getNumPhysicalCores();
+  const size_t available = (inUse < total ? total - inUse : 0) + 1;
+  return std::max(1, std::min(maxThreads, static_cast<int>(available)));
+}
+
+} // namespace Kernel
+} // namespace Mantid
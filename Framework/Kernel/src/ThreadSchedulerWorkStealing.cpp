@@ -0,0 +1,167 @@
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+#include "MantidKernel/ThreadPool.h"
+
+#include <random>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// Source of the IDs of the schedulers. 0 is never used, so that it can mark
+/// a thread that never popped a task.
+std::atomic<size_t> g_nextSchedulerId(1);
+
+/// The scheduler (by ID, since the thread may outlive it) and queue of the
+/// pool thread running in this thread, set when the thread pops a task.
+struct WorkerQueue {
+  size_t schedulerId;
+  size_t queue;
+};
+thread_local WorkerQueue g_workerQueue = {0, 0};
+}
+
+/** Constructor
+ *
+ * @param numQueues :: Number of queues, which should be the number of threads
+ * of the ThreadPool. 0 uses the number of cores.
+ */
+ThreadSchedulerWorkStealing::ThreadSchedulerWorkStealing(size_t numQueues)
+    : ThreadScheduler(), m_id(g_nextSchedulerId++), m_size(0),
+      m_nextQueue(0) {
+  if (numQueues == 0)
+    numQueues = ThreadPool::getNumPhysicalCores();
+  if (numQueues == 0)
+    numQueues = 1;
+  m_queues.reserve(numQueues);
+  for (size_t i = 0; i < numQueues; ++i)
+    m_queues.emplace_back(new Queue);
+}
+
+ThreadSchedulerWorkStealing::~ThreadSchedulerWorkStealing() { clear(); }
+
+//-------------------------------------------------------------------------------
+/** Add a Task to the queue of the calling thread, or to the next queue in
+ * turn if the caller is not a thread of the pool.
+ * @param newTask :: Task to add
+ */
+void ThreadSchedulerWorkStealing::push(Task *newTask) {
+  size_t queue;
+  if (g_workerQueue.schedulerId == m_id)
+    queue = g_workerQueue.queue % m_queues.size();
+  else
+    queue = m_nextQueue++ % m_queues.size();
+
+  Queue &q = *m_queues[queue];
+  std::lock_guard<std::mutex> lock(q.mutex);
+  q.tasks.push_back(newTask);
+  q.cost += newTask->cost();
+  ++m_size;
+}
+
+//-------------------------------------------------------------------------------
+/** Pop the newest task of the queue of the thread, or steal one from another
+ * thread if that is empty.
+ * @param threadnum :: ID of the calling thread.
+ * @return the Task, or NULL if no tasks are left.
+ */
+Task *ThreadSchedulerWorkStealing::pop(size_t threadnum) {
+  const size_t own = threadnum % m_queues.size();
+  g_workerQueue.schedulerId = m_id;
+  g_workerQueue.queue = own;
+
+  Task *task = nullptr;
+  Queue &q = *m_queues[own];
+  {
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (!q.tasks.empty()) {
+      task = q.tasks.back();
+      q.tasks.pop_back();
+      q.costExecuted += task->cost();
+      --m_size;
+    }
+  }
+  if (!task)
+    task = steal(own);
+  return task;
+}
+
+//-------------------------------------------------------------------------------
+/** Take the oldest task of another queue.
+ * @param thief :: Queue of the calling thread, which is empty.
+ * @return the Task, or NULL if all queues are empty.
+ */
+Task *ThreadSchedulerWorkStealing::steal(size_t thief) {
+  const size_t numQueues = m_queues.size();
+  if (numQueues < 2 || m_size == 0)
+    return nullptr;
+
+  thread_local std::minstd_rand generator(
+      static_cast<std::minstd_rand::result_type>(thief + 1));
+  const size_t first = generator() % numQueues;
+  for (size_t i = 0; i < numQueues; ++i) {
+    const size_t victim = (first + i) % numQueues;
+    if (victim == thief)
+      continue;
+    Queue &q = *m_queues[victim];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (!q.tasks.empty()) {
+      Task *task = q.tasks.front();
+      q.tasks.pop_front();
+      q.costExecuted += task->cost();
+      --m_size;
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+//-------------------------------------------------------------------------------
+/// Returns the number of tasks in all queues
+size_t ThreadSchedulerWorkStealing::size() { return m_size; }
+
+/// @return true if all queues are empty
+bool ThreadSchedulerWorkStealing::empty() { return m_size == 0; }
+
+/// Returns the total cost of the tasks pushed to all queues
+double ThreadSchedulerWorkStealing::totalCost() {
+  double cost = 0.;
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    cost += queue->cost;
+  }
+  return cost;
+}
+
+/// Returns the total cost of the tasks popped from all queues
+double ThreadSchedulerWorkStealing::totalCostExecuted() {
+  double cost = 0.;
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    cost += queue->costExecuted;
+  }
+  return cost;
+}
+
+/// Returns the number of tasks in one queue
+size_t ThreadSchedulerWorkStealing::queueSize(size_t queue) {
+  Queue &q = *m_queues[queue];
+  std::lock_guard<std::mutex> lock(q.mutex);
+  return q.tasks.size();
+}
+
+//-------------------------------------------------------------------------------
+/// Empty out all queues and delete the tasks
+void ThreadSchedulerWorkStealing::clear() {
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    for (auto &task : queue->tasks)
+      delete task;
+    m_size -= queue->tasks.size();
+    queue->tasks.clear();
+    queue->cost = 0.;
+    queue->costExecuted = 0.;
+  }
+}
+
+} // namespace Kernel
+} // namespace Mantid
@@ -7,6 +7,8 @@
 
 #include <boost/regex.hpp>
 
+#include <algorithm>
+
 using namespace std;
 
 namespace Mantid {
@@ -14,6 +16,68 @@ namespace Kernel {
 namespace {
 /// static Logger definition
 Logger g_log("TimeSeriesProperty");
+
+/// Number of entries summed up in each element of the integral cache
+const size_t INTEGRAL_CHUNK_SIZE = 256;
+
+/// The value of an entry multiplied with the time until the next entry, in
+/// seconds
+template <typename TYPE>
+double integrateEntry(const std::vector<TimeValueUnit<TYPE>> &values,
+                      const size_t index) {
+  return DateAndTime::secondsFromDuration(values[index + 1].time() -
+                                          values[index].time()) *
+         static_cast<double>(values[index].value());
+}
+
+/**
+ * Time-weighted sums of the values of consecutive chunks of sorted entries.
+ * @param values :: the sorted entries of a time series
+ * @return the sum in value * seconds of each whole chunk of entries before the
+ * last entry
+ */
+template <typename TYPE>
+std::vector<double>
+integrateChunks(const std::vector<TimeValueUnit<TYPE>> &values) {
+  const size_t numChunks = (values.size() - 1) / INTEGRAL_CHUNK_SIZE;
+  std::vector<double> chunkIntegrals;
+  chunkIntegrals.reserve(numChunks);
+  for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+    double sum(0.0);
+    for (size_t i = chunk * INTEGRAL_CHUNK_SIZE;
+         i < (chunk + 1) * INTEGRAL_CHUNK_SIZE; ++i)
+      sum += integrateEntry(values, i);
+    chunkIntegrals.push_back(sum);
+  }
+  return chunkIntegrals;
+}
+
+/**
+ * Time-weighted sum of the values of a range of sorted entries, each value
+ * multiplied with the time until the next entry. Whole chunks of entries are
+ * summed up from a cache.
+ * @param values :: the sorted entries of a time series
+ * @param chunkIntegrals :: the sums of whole chunks, from integrateChunks()
+ * @param first :: the first entry
+ * @param last :: the entry after the last one, before the last entry of values
+ * @return the sum in value * seconds
+ */
+template <typename TYPE>
+double integrateEntries(const std::vector<TimeValueUnit<TYPE>> &values,
+                        const std::vector<double> &chunkIntegrals,
+                        size_t first, const size_t last) {
+  double sum(0.0);
+  // Single entries up to the start of a chunk
+  for (; first < last && first % INTEGRAL_CHUNK_SIZE != 0; ++first)
+    sum += integrateEntry(values, first);
+  // Whole chunks
+  for (; first + INTEGRAL_CHUNK_SIZE <= last; first += INTEGRAL_CHUNK_SIZE)
+    sum += chunkIntegrals[first / INTEGRAL_CHUNK_SIZE];
+  // The rest
+  for (; first < last; ++first)
+    sum += integrateEntry(values, first);
+  return sum;
+}
 }
 
 /**
@@ -138,6 +202,7 @@ operator+=(Property const *right) {
       m_values.insert(m_values.end(), rhs->m_values.begin(),
                       rhs->m_values.end());
       m_propSortedFlag = TimeSeriesSortStatus::TSUNKNOWN;
+      m_chunkIntegrals.reset();
     } else {
       // Do nothing if appending yourself to yourself. The net result would be
       // the same anyway
@@ -268,6 +333,7 @@ void TimeSeriesProperty<TYPE>::filterByTime(const Kernel::DateAndTime &start,
   if (m_values.size() <= 1)
     return;
 
+  m_chunkIntegrals.reset();
   typename std::vector<TimeValueUnit<TYPE>>::iterator iterhead, iterend;
 
   // 2. Determine index for start and remove  Note erase is [...)
@@ -388,6 +454,7 @@ void TimeSeriesProperty<TYPE>::filterByTimes(
   m_values.clear();
   m_values = mp_copy;
   mp_copy.clear();
+  m_chunkIntegrals.reset();
 
   m_size = static_cast<int>(m_values.size());
 
@@ -427,6 +494,7 @@ void TimeSeriesProperty<TYPE>::splitByTime(
         dynamic_cast<TimeSeriesProperty<TYPE> *>(outputs[i]);
     if (myOutput) {
       outputs_tsp.push_back(myOutput);
+      myOutput->m_chunkIntegrals.reset();
       if (this->m_values.size() == 1) {
         // Special case for TSP with a single entry = just copy.
         myOutput->m_values = this->m_values;
@@ -460,8 +528,11 @@ void TimeSeriesProperty<TYPE>::splitByTime(
 
     int output_index = itspl->index();
     // output workspace index is out of range. go to the next splitter
-    if (output_index < 0 || output_index >= static_cast<int>(numOutputs))
+    if (output_index < 0 || output_index >= static_cast<int>(numOutputs)) {
+      ++itspl;
+      ++counter;
       continue;
+    }
 
     TimeSeriesProperty<TYPE> *myOutput = outputs_tsp[output_index];
     // skip if the input property is of wrong type
@@ -742,6 +813,16 @@ double TimeSeriesProperty<TYPE>::averageValueInFilter(
   // Sort, if necessary.
   sort();
 
+  // Sums of whole chunks of entries. Const methods may run concurrently, so
+  // the sums are built into a new vector and published atomically; two
+  // threads may both build them, with the same result.
+  auto chunkIntegrals = std::atomic_load(&m_chunkIntegrals);
+  if (!chunkIntegrals) {
+    chunkIntegrals =
+        std::make_shared<const std::vector<double>>(integrateChunks(m_values));
+    std::atomic_store(&m_chunkIntegrals, chunkIntegrals);
+  }
+
   double numerator(0.0), totalTime(0.0);
   // Loop through the filter ranges
   for (const auto &time : filter) {
@@ -753,13 +834,21 @@ double TimeSeriesProperty<TYPE>::averageValueInFilter(
     double value = getSingleValue(time.start(), index);
     DateAndTime startTime = time.start();
 
-    while (index < realSize() - 1 && m_values[index + 1].time() < time.stop()) {
-      ++index;
-      numerator +=
-          DateAndTime::secondsFromDuration(m_values[index].time() - startTime) *
-          value;
-      startTime = m_values[index].time();
-      value = static_cast<double>(m_values[index].value());
+    // The last entry before the end of the filter range
+    const TimeValueUnit<TYPE> stop(time.stop(), m_values[index].value());
+    const auto stopIter =
+        std::lower_bound(m_values.begin() + index + 1, m_values.end(), stop);
+    const size_t last = static_cast<size_t>(stopIter - m_values.begin()) - 1;
+
+    if (last > static_cast<size_t>(index)) {
+      // The entry at the start of the filter range, and the whole entries
+      // inside it
+      numerator += DateAndTime::secondsFromDuration(
+                       m_values[index + 1].time() - startTime) *
+                   value;
+      numerator += integrateEntries(m_values, *chunkIntegrals, index + 1, last);
+      startTime = m_values[last].time();
+      value = static_cast<double>(m_values[last].value());
     }
 
     // Now close off with the end of the current filter range
@@ -936,6 +1025,7 @@ void TimeSeriesProperty<TYPE>::addValue(const Kernel::DateAndTime &time,
   }
 
   m_filterApplied = false;
+  m_chunkIntegrals.reset();
 
   return;
 }
@@ -975,17 +1065,16 @@ template <typename TYPE>
 void TimeSeriesProperty<TYPE>::addValues(
     const std::vector<Kernel::DateAndTime> &times,
     const std::vector<TYPE> &values) {
-  for (size_t i = 0; i < times.size(); i++) {
-    if (i >= values.size())
-      break;
-    else {
-      m_values.push_back(TimeValueUnit<TYPE>(times[i], values[i]));
-      m_size++;
-    }
+  const size_t num = std::min(times.size(), values.size());
+  m_values.reserve(m_values.size() + num);
+  for (size_t i = 0; i < num; i++) {
+    m_values.push_back(TimeValueUnit<TYPE>(times[i], values[i]));
+    m_size++;
   }
 
   if (!values.empty())
     m_propSortedFlag = TimeSeriesSortStatus::TSUNKNOWN;
+  m_chunkIntegrals.reset();
 
   return;
 }
@@ -1201,6 +1290,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::clear() {
 
   m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
   m_filterApplied = false;
+  m_chunkIntegrals.reset();
 }
 
 /** Clears out all but the last value in the property.
@@ -1780,6 +1870,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::eliminateDuplicates() {
       vit = m_values.erase(vit - 1);
 
       numremoved++;
+      m_chunkIntegrals.reset();
     }
 
     // b) progress
@@ -2055,14 +2146,20 @@ size_t TimeSeriesProperty<TYPE>::findNthIndexFromQuickRef(int n) const {
     // 2A.  Out side of boundary
     index = m_filterQuickRef.size();
   } else {
-    // 2B. Inside
-    for (size_t i = 0; i < m_filterQuickRef.size(); i += 4) {
-      if (static_cast<size_t>(n) >= m_filterQuickRef[i].second &&
-          static_cast<size_t>(n) < m_filterQuickRef[i + 3].second) {
-        index = i;
-        break;
-      }
+    // 2B. Inside. The regions of 4 entries are in the order of their counts:
+    // bisect for the first region that ends after n.
+    size_t low = 0;
+    size_t high = m_filterQuickRef.size() / 4;
+    while (low < high) {
+      const size_t mid = (low + high) / 2;
+      if (m_filterQuickRef[4 * mid + 3].second <= static_cast<size_t>(n))
+        low = mid + 1;
+      else
+        high = mid;
     }
+    if (low < m_filterQuickRef.size() / 4 &&
+        static_cast<size_t>(n) >= m_filterQuickRef[4 * low].second)
+      index = 4 * low;
   }
 
   return index;
@@ -2088,6 +2185,7 @@ TimeSeriesProperty<TYPE>::setValueFromProperty(const Property &right) {
   m_filter = prop->m_filter;
   m_filterQuickRef = prop->m_filterQuickRef;
   m_filterApplied = prop->m_filterApplied;
+  m_chunkIntegrals = prop->m_chunkIntegrals;
   return "";
 }
 
@@ -1,6 +1,9 @@
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/TimeSplitter.h"
 
+#include <algorithm>
+#include <stdexcept>
+
 namespace Mantid {
 namespace Kernel {
 
@@ -267,5 +270,26 @@ TimeSplitterType operator~(const TimeSplitterType &a) {
   }
   return out;
 }
+
+/**
+ * Constructor
+ * @param boundaries :: sorted times in nanoseconds at which the intervals
+ * change
+ * @param destinations :: destination of each interval, one more than the
+ * number of boundaries
+ * @throw std::invalid_argument if the boundaries are not sorted, or the
+ * number of destinations does not match them
+ */
+TimeSplitterIndex::TimeSplitterIndex(std::vector<int64_t> boundaries,
+                                     std::vector<int> destinations)
+    : m_boundaries(std::move(boundaries)),
+      m_destinations(std::move(destinations)) {
+  if (m_destinations.size() != m_boundaries.size() + 1)
+    throw std::invalid_argument("TimeSplitterIndex: there must be one more "
+                                "destination than boundaries.");
+  if (!std::is_sorted(m_boundaries.begin(), m_boundaries.end()))
+    throw std::invalid_argument(
+        "TimeSplitterIndex: the boundaries must be sorted.");
+}
 }
 }
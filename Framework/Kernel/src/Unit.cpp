@@ -142,9 +142,7 @@ void Unit::toTOF(std::vector<double> &xdata, std::vector<double> &ydata,
                  const double &_delta) {
   UNUSED_ARG(ydata);
   this->initialize(_l1, _l2, _twoTheta, _emode, _efixed, _delta);
-  size_t numX = xdata.size();
-  for (size_t i = 0; i < numX; i++)
-    xdata[i] = this->singleToTOF(xdata[i]);
+  this->rangeToTOF(xdata.data(), xdata.data() + xdata.size());
 }
 
 /** Convert a single value to TOF
@@ -173,9 +171,7 @@ void Unit::fromTOF(std::vector<double> &xdata, std::vector<double> &ydata,
                    const double &_efixed, const double &_delta) {
   UNUSED_ARG(ydata);
   this->initialize(_l1, _l2, _twoTheta, _emode, _efixed, _delta);
-  size_t numX = xdata.size();
-  for (size_t i = 0; i < numX; i++)
-    xdata[i] = this->singleFromTOF(xdata[i]);
+  this->rangeFromTOF(xdata.data(), xdata.data() + xdata.size());
 }
 
 /** Convert a single value from TOF
@@ -195,6 +191,18 @@ double Unit::convertSingleFromTOF(const double xvalue, const double &l1,
   return this->singleFromTOF(xvalue);
 }
 
+/// Convert values to TOF one by one with singleToTOF()
+void Unit::rangeToTOF(double *first, double *last) const {
+  for (; first != last; ++first)
+    *first = this->singleToTOF(*first);
+}
+
+/// Convert values from TOF one by one with singleFromTOF()
+void Unit::rangeFromTOF(double *first, double *last) const {
+  for (; first != last; ++first)
+    *first = this->singleFromTOF(*first);
+}
+
 std::pair<double, double> Unit::conversionRange() const {
   double u1 = this->singleFromTOF(this->conversionTOFMin());
   double u2 = this->singleFromTOF(this->conversionTOFMax());
@@ -204,6 +212,32 @@ std::pair<double, double> Unit::conversionRange() const {
 
 namespace Units {
 
+namespace {
+/** Convert values to TOF with the singleToTOF() of a given unit. The call is
+ * not virtual, so it can be inlined and the loop vectorized.
+ * @param unit :: The unit, which must be initialized
+ * @param first :: The first value to convert
+ * @param last :: One past the last value to convert
+ */
+template <class UnitType>
+void convertRangeToTOF(const UnitType &unit, double *first, double *last) {
+  for (; first != last; ++first)
+    *first = unit.UnitType::singleToTOF(*first);
+}
+
+/** Convert values from TOF with the singleFromTOF() of a given unit, see
+ * convertRangeToTOF()
+ * @param unit :: The unit, which must be initialized
+ * @param first :: The first value to convert
+ * @param last :: One past the last value to convert
+ */
+template <class UnitType>
+void convertRangeFromTOF(const UnitType &unit, double *first, double *last) {
+  for (; first != last; ++first)
+    *first = unit.UnitType::singleFromTOF(*first);
+}
+}
+
 /* =============================================================================
  * EMPTY
  * =============================================================================
@@ -291,6 +325,18 @@ double TOF::singleFromTOF(const double tof) const {
   return tof;
 }
 
+void TOF::rangeToTOF(double *first, double *last) const {
+  // Nothing to do
+  UNUSED_ARG(first);
+  UNUSED_ARG(last);
+}
+
+void TOF::rangeFromTOF(double *first, double *last) const {
+  // Nothing to do
+  UNUSED_ARG(first);
+  UNUSED_ARG(last);
+}
+
 Unit *TOF::clone() const { return new TOF(*this); }
 double TOF::conversionTOFMin() const { return -DBL_MAX; }
 ///@return DBL_MAX as ToF convetanble to TOF for in any time range
@@ -419,6 +465,14 @@ double Wavelength::conversionTOFMax() const {
   return max_tof;
 }
 
+void Wavelength::rangeToTOF(double *first, double *last) const {
+  convertRangeToTOF(*this, first, last);
+}
+
+void Wavelength::rangeFromTOF(double *first, double *last) const {
+  convertRangeFromTOF(*this, first, last);
+}
+
 Unit *Wavelength::clone() const { return new Wavelength(*this); }
 
 // ============================================================================================
@@ -475,6 +529,14 @@ double Energy::singleFromTOF(const double tof) const {
   return factorFrom / (temp * temp);
 }
 
+void Energy::rangeToTOF(double *first, double *last) const {
+  convertRangeToTOF(*this, first, last);
+}
+
+void Energy::rangeFromTOF(double *first, double *last) const {
+  convertRangeFromTOF(*this, first, last);
+}
+
 Unit *Energy::clone() const { return new Energy(*this); }
 
 // ============================================================================================
@@ -542,6 +604,14 @@ double Energy_inWavenumber::singleFromTOF(const double tof) const {
   return factorFrom / (temp * temp);
 }
 
+void Energy_inWavenumber::rangeToTOF(double *first, double *last) const {
+  convertRangeToTOF(*this, first, last);
+}
+
+void Energy_inWavenumber::rangeFromTOF(double *first, double *last) const {
+  convertRangeFromTOF(*this, first, last);
+}
+
 Unit *Energy_inWavenumber::clone() const {
   return new Energy_inWavenumber(*this);
 }
@@ -584,6 +654,14 @@ double dSpacing::singleFromTOF(const double tof) const {
 double dSpacing::conversionTOFMin() const { return 0; }
 double dSpacing::conversionTOFMax() const { return DBL_MAX / factorTo; }
 
+void dSpacing::rangeToTOF(double *first, double *last) const {
+  convertRangeToTOF(*this, first, last);
+}
+
+void dSpacing::rangeFromTOF(double *first, double *last) const {
+  convertRangeFromTOF(*this, first, last);
+}
+
 Unit *dSpacing::clone() const { return new dSpacing(*this); }
 
 // ================================================================================
@@ -642,6 +720,14 @@ double MomentumTransfer::conversionTOFMin() const {
 }
 double MomentumTransfer::conversionTOFMax() const { return DBL_MAX; }
 
+void MomentumTransfer::rangeToTOF(double *first, double *last) const {
+  convertRangeToTOF(*this, first, last);
+}
+
+void MomentumTransfer::rangeFromTOF(double *first, double *last) const {
+  convertRangeFromTOF(*this, first, last);
+}
+
 Unit *MomentumTransfer::clone() const { return new MomentumTransfer(*this); }
 
 /* ===================================================================================================
@@ -703,6 +789,14 @@ double QSquared::conversionTOFMax() const {
     return factorTo / sqrt(DBL_MAX);
 }
 
+void QSquared::rangeToTOF(double *first, double *last) const {
+  convertRangeToTOF(*this, first, last);
+}
+
+void QSquared::rangeFromTOF(double *first, double *last) const {
+  convertRangeFromTOF(*this, first, last);
+}
+
 Unit *QSquared::clone() const { return new QSquared(*this); }
 
 /* ==============================================================================
@@ -825,6 +919,14 @@ double DeltaE::conversionTOFMax() const {
     return t_otherFrom + sqrt(factorFrom) / sqrt(DBL_MIN);
 }
 
+void DeltaE::rangeToTOF(double *first, double *last) const {
+  convertRangeToTOF(*this, first, last);
+}
+
+void DeltaE::rangeFromTOF(double *first, double *last) const {
+  convertRangeFromTOF(*this, first, last);
+}
+
 Unit *DeltaE::clone() const { return new DeltaE(*this); }
 
 // =====================================================================================================
@@ -977,6 +1079,14 @@ double Momentum::singleFromTOF(const double tof) const {
   return factorFrom / x;
 }
 
+void Momentum::rangeToTOF(double *first, double *last) const {
+  convertRangeToTOF(*this, first, last);
+}
+
+void Momentum::rangeFromTOF(double *first, double *last) const {
+  convertRangeFromTOF(*this, first, last);
+}
+
 Unit *Momentum::clone() const { return new Momentum(*this); }
 
 // ============================================================================================
@@ -1028,6 +1138,14 @@ double SpinEchoLength::singleFromTOF(const double tof) const {
   return x;
 }
 
+void SpinEchoLength::rangeToTOF(double *first, double *last) const {
+  convertRangeToTOF(*this, first, last);
+}
+
+void SpinEchoLength::rangeFromTOF(double *first, double *last) const {
+  convertRangeFromTOF(*this, first, last);
+}
+
 Unit *SpinEchoLength::clone() const { return new SpinEchoLength(*this); }
 
 // ============================================================================================
@@ -1073,6 +1191,14 @@ double SpinEchoTime::singleFromTOF(const double tof) const {
   return x;
 }
 
+void SpinEchoTime::rangeToTOF(double *first, double *last) const {
+  convertRangeToTOF(*this, first, last);
+}
+
+void SpinEchoTime::rangeFromTOF(double *first, double *last) const {
+  convertRangeFromTOF(*this, first, last);
+}
+
 Unit *SpinEchoTime::clone() const { return new SpinEchoTime(*this); }
 
 // ================================================================================
@@ -266,6 +266,106 @@ public:
     for (size_t i = 0; i < size_t(bigNum); i++)
       delete bigData[i];
   }
+
+  //--------------------------------------------------------------------------------
+  /** With background I/O the objects are written out in the same places as
+   * without it */
+  void test_backgroundIO_writesOutEverything() {
+    for (size_t i = 0; i < data.size(); i++)
+      data[i]->setDataChanged();
+    // Room for 2 objects of size 2 in the to-write cache
+    DiskBuffer dbuf(2 * 2);
+    dbuf.setBackgroundIO(true);
+    TS_ASSERT(dbuf.getBackgroundIO());
+    for (size_t i = 0; i < data.size(); i++)
+      dbuf.toWrite(data[i]);
+
+    dbuf.flushCache();
+    TS_ASSERT_EQUALS(dbuf.getWriteBufferUsed(), 0);
+    TS_ASSERT_EQUALS(SaveableTesterWithFile::fakeFile, "AABBCCDDEEFFGGHHIIJJ");
+  }
+
+  /** Busy objects are kept in the buffer with background I/O too */
+  void test_backgroundIO_keepsBusyObjects() {
+    DiskBuffer dbuf(4);
+    dbuf.setBackgroundIO(true);
+    for (size_t i = 0; i < 9; i++) {
+      data[i]->setBusy(true);
+      dbuf.toWrite(data[i]);
+    }
+    dbuf.flushCache();
+    TS_ASSERT_EQUALS(dbuf.getWriteBufferUsed(), 2 * 9);
+    TS_ASSERT_EQUALS(SaveableTesterWithFile::fakeFile, "");
+
+    for (size_t i = 0; i < 9; i++) {
+      data[i]->setBusy(false);
+      data[i]->setDataChanged();
+    }
+    dbuf.flushCache();
+    TS_ASSERT_EQUALS(dbuf.getWriteBufferUsed(), 0);
+    TS_ASSERT_EQUALS(SaveableTesterWithFile::fakeFile, "AABBCCDDEEFFGGHHII");
+  }
+
+  /** A prefetched object is loaded only once, whether it is used before or
+   * after the background thread gets to it */
+  void test_prefetch() {
+    DiskBuffer dbuf(100);
+    // Without background I/O prefetching does nothing
+    data[0]->clearDataFromMemory();
+    dbuf.prefetch(data[0]);
+    dbuf.flushCache();
+    TS_ASSERT(!data[0]->isLoaded());
+
+    dbuf.setBackgroundIO(true);
+    for (size_t i = 0; i < data.size(); i++) {
+      data[i]->clearDataFromMemory();
+      dbuf.prefetch(data[i]);
+    }
+    for (size_t i = 0; i < data.size(); i++) {
+      data[i]->loadAndSetBusy();
+      TS_ASSERT(data[i]->isLoaded());
+      TS_ASSERT_EQUALS(data[i]->m_memory, 2);
+      data[i]->setBusy(false);
+    }
+    dbuf.flushCache();
+    TS_ASSERT_EQUALS(dbuf.getWriteBufferUsed(), 0);
+  }
+
+  /** Objects can be deleted while the background thread writes and loads */
+  void test_backgroundIO_objectDeleted() {
+    DiskBuffer dbuf(4);
+    dbuf.setBackgroundIO(true);
+    for (size_t i = 0; i < data.size(); i++) {
+      data[i]->setDataChanged();
+      dbuf.toWrite(data[i]);
+      if (i % 2 == 0)
+        dbuf.objectDeleted(data[i]);
+    }
+    dbuf.flushCache();
+    TS_ASSERT_EQUALS(dbuf.getWriteBufferUsed(), 0);
+    // The objects not deleted were all written out
+    const std::string &file = SaveableTesterWithFile::fakeFile;
+    TS_ASSERT_EQUALS(file.size(), 2 * data.size());
+    for (size_t i = 1; i < data.size() && i < file.size() / 2; i += 2)
+      TS_ASSERT_EQUALS(file.substr(2 * i, 2), std::string(2, data[i]->m_ch));
+  }
+
+  /** Turning background I/O off does not write out the buffer */
+  void test_setBackgroundIO_off_does_not_flush() {
+    DiskBuffer dbuf(100);
+    dbuf.setBackgroundIO(true);
+    for (size_t i = 0; i < 3; i++) {
+      data[i]->setDataChanged();
+      dbuf.toWrite(data[i]);
+    }
+    dbuf.setBackgroundIO(false);
+    TS_ASSERT(!dbuf.getBackgroundIO());
+    TS_ASSERT_EQUALS(dbuf.getWriteBufferUsed(), 2 * 3);
+    TS_ASSERT_EQUALS(SaveableTesterWithFile::fakeFile, "");
+    dbuf.flushCache();
+    TS_ASSERT_EQUALS(SaveableTesterWithFile::fakeFile, "AABBCC");
+  }
+
   ////--------------------------------------------------------------------------------
   ////--------------------------------------------------------------------------------
   ////----------TESTS FOR FREE SPACE MAPS
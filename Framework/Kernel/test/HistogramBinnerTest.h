@@ -0,0 +1,95 @@
+#ifndef MANTID_KERNEL_HISTOGRAMBINNERTEST_H_
+#define MANTID_KERNEL_HISTOGRAMBINNERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/HistogramBinner.h"
+#include "MantidKernel/VectorHelper.h"
+
+#include <limits>
+
+using Mantid::Kernel::HistogramBinner;
+
+class HistogramBinnerTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static HistogramBinnerTest *createSuite() { return new HistogramBinnerTest(); }
+  static void destroySuite(HistogramBinnerTest *suite) { delete suite; }
+
+  void test_empty_edges() {
+    const std::vector<double> edges;
+    HistogramBinner binner(edges);
+    TS_ASSERT_EQUALS(binner.numberOfBins(), 0);
+    TS_ASSERT_EQUALS(binner.binIndex(1.0), 0);
+  }
+
+  void test_linear() {
+    const std::vector<double> edges{0.0, 2.0, 4.0, 6.0, 8.0};
+    HistogramBinner binner(edges);
+    TS_ASSERT_EQUALS(binner.spacing(), HistogramBinner::Spacing::Linear);
+    TS_ASSERT_EQUALS(binner.numberOfBins(), 4);
+    TS_ASSERT_EQUALS(binner.binIndex(-0.1), 4);
+    TS_ASSERT_EQUALS(binner.binIndex(0.0), 0);
+    TS_ASSERT_EQUALS(binner.binIndex(1.999), 0);
+    TS_ASSERT_EQUALS(binner.binIndex(2.0), 1);
+    TS_ASSERT_EQUALS(binner.binIndex(7.999), 3);
+    TS_ASSERT_EQUALS(binner.binIndex(8.0), 4);
+    TS_ASSERT_EQUALS(
+        binner.binIndex(std::numeric_limits<double>::quiet_NaN()), 4);
+  }
+
+  void test_linear_with_wider_last_bin() {
+    const std::vector<double> edges{0.0, 1.0, 2.0, 3.0, 4.2};
+    HistogramBinner binner(edges);
+    TS_ASSERT_EQUALS(binner.spacing(), HistogramBinner::Spacing::Linear);
+    TS_ASSERT_EQUALS(binner.binIndex(2.999), 2);
+    TS_ASSERT_EQUALS(binner.binIndex(4.1), 3);
+    TS_ASSERT_EQUALS(binner.binIndex(4.2), 4);
+  }
+
+  void test_logarithmic() {
+    const std::vector<double> edges{1.0, 2.0, 4.0, 8.0, 16.0};
+    HistogramBinner binner(edges);
+    TS_ASSERT_EQUALS(binner.spacing(), HistogramBinner::Spacing::Logarithmic);
+    TS_ASSERT_EQUALS(binner.binIndex(0.5), 4);
+    TS_ASSERT_EQUALS(binner.binIndex(1.0), 0);
+    TS_ASSERT_EQUALS(binner.binIndex(3.999), 1);
+    TS_ASSERT_EQUALS(binner.binIndex(4.0), 2);
+    TS_ASSERT_EQUALS(binner.binIndex(15.0), 3);
+    TS_ASSERT_EQUALS(binner.binIndex(16.0), 4);
+  }
+
+  void test_irregular() {
+    const std::vector<double> edges{0.0, 1.0, 5.0, 6.0};
+    HistogramBinner binner(edges);
+    TS_ASSERT_EQUALS(binner.spacing(), HistogramBinner::Spacing::Irregular);
+    TS_ASSERT_EQUALS(binner.binIndex(0.5), 0);
+    TS_ASSERT_EQUALS(binner.binIndex(1.0), 1);
+    TS_ASSERT_EQUALS(binner.binIndex(5.5), 2);
+    TS_ASSERT_EQUALS(binner.binIndex(6.0), 3);
+  }
+
+  void test_binIndices_matches_edges_exactly() {
+    // Edges as produced by Rebin; values exactly on the edges must end up in
+    // the bin starting at that edge despite rounding in the arithmetic.
+    std::vector<double> linear, logarithmic;
+    Mantid::Kernel::VectorHelper::createAxisFromRebinParams({0.0, 0.1, 100.0},
+                                                            linear);
+    Mantid::Kernel::VectorHelper::createAxisFromRebinParams(
+        {10.0, -0.01, 1000.0}, logarithmic);
+    for (const auto &edges : {linear, logarithmic}) {
+      HistogramBinner binner(edges);
+      TS_ASSERT_DIFFERS(binner.spacing(), HistogramBinner::Spacing::Irregular);
+      std::vector<double> x(edges);
+      x.push_back(0.5 * (edges[3] + edges[4]));
+      std::vector<size_t> indices(x.size());
+      binner.binIndices(x.data(), x.size(), indices.data());
+      for (size_t i = 0; i < edges.size(); ++i)
+        TS_ASSERT_EQUALS(indices[i], i);
+      TS_ASSERT_EQUALS(indices.back(), 3);
+    }
+  }
+};
+
+#endif /* MANTID_KERNEL_HISTOGRAMBINNERTEST_H_ */
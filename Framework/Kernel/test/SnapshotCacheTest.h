@@ -0,0 +1,208 @@
+#ifndef MANTID_KERNEL_SNAPSHOTCACHETEST_H_
+#define MANTID_KERNEL_SNAPSHOTCACHETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/SnapshotCache.h"
+
+#include <thread>
+#include <vector>
+
+using Mantid::Kernel::SnapshotCache;
+
+class SnapshotCacheTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static SnapshotCacheTest *createSuite() { return new SnapshotCacheTest(); }
+  static void destroySuite(SnapshotCacheTest *suite) { delete suite; }
+
+  void test_set_and_get() {
+    SnapshotCache<int, double> cache;
+    double value(0.0);
+    TS_ASSERT(!cache.getCache(1, value));
+    cache.setCache(1, 1.5);
+    cache.setCache(2, 2.5);
+    TS_ASSERT(cache.getCache(1, value));
+    TS_ASSERT_EQUALS(value, 1.5);
+    TS_ASSERT_EQUALS(cache.size(), 2);
+    // Not in the snapshot yet
+    TS_ASSERT(!cache.getSnapshot(1, value));
+
+    cache.setCache(1, 3.5);
+    TS_ASSERT(cache.getCache(1, value));
+    TS_ASSERT_EQUALS(value, 3.5);
+  }
+
+  void test_publish_moves_values_to_the_snapshot() {
+    SnapshotCache<int, double> cache;
+    cache.setCache(1, 1.5);
+    cache.publish();
+    double value(0.0);
+    TS_ASSERT(cache.getSnapshot(1, value));
+    TS_ASSERT_EQUALS(value, 1.5);
+
+    // A value in the snapshot is only replaced by the next publish()
+    cache.setCache(1, 2.5);
+    TS_ASSERT(cache.getCache(1, value));
+    TS_ASSERT_EQUALS(value, 1.5);
+    TS_ASSERT_EQUALS(cache.size(), 1);
+    cache.publish();
+    TS_ASSERT(cache.getCache(1, value));
+    TS_ASSERT_EQUALS(value, 2.5);
+  }
+
+  void test_publish_with_new_values() {
+    SnapshotCache<int, double> cache;
+    cache.setCache(1, 1.5);
+    cache.setCache(2, 2.5);
+    SnapshotCache<int, double>::Map newValues;
+    newValues[2] = 4.5;
+    newValues[3] = 5.5;
+    cache.publish(newValues);
+    TS_ASSERT_EQUALS(cache.size(), 3);
+    double value(0.0);
+    TS_ASSERT(cache.getSnapshot(1, value));
+    TS_ASSERT_EQUALS(value, 1.5);
+    TS_ASSERT(cache.getSnapshot(2, value));
+    TS_ASSERT_EQUALS(value, 4.5);
+    TS_ASSERT(cache.getSnapshot(3, value));
+    TS_ASSERT_EQUALS(value, 5.5);
+  }
+
+  void test_clear() {
+    SnapshotCache<int, double> cache;
+    TS_ASSERT(!cache.hasSnapshot());
+    cache.setCache(1, 1.5);
+    cache.publish();
+    TS_ASSERT(cache.hasSnapshot());
+    cache.setCache(2, 2.5);
+    cache.clear();
+    TS_ASSERT(!cache.hasSnapshot());
+    TS_ASSERT_EQUALS(cache.size(), 0);
+    double value(0.0);
+    TS_ASSERT(!cache.getCache(1, value));
+    TS_ASSERT(!cache.getCache(2, value));
+  }
+
+  void test_copy() {
+    SnapshotCache<int, double> cache;
+    cache.setCache(1, 1.5);
+    cache.publish();
+    cache.setCache(2, 2.5);
+
+    SnapshotCache<int, double> copy(cache);
+    double value(0.0);
+    TS_ASSERT(copy.getSnapshot(1, value));
+    TS_ASSERT(copy.getSnapshot(2, value));
+    TS_ASSERT_EQUALS(value, 2.5);
+
+    SnapshotCache<int, double> assigned;
+    assigned.setCache(3, 3.5);
+    assigned = cache;
+    TS_ASSERT_EQUALS(assigned.size(), 2);
+    TS_ASSERT(!assigned.getCache(3, value));
+
+    // The copies are independent
+    cache.clear();
+    TS_ASSERT(copy.getCache(1, value));
+    TS_ASSERT(assigned.getCache(1, value));
+  }
+
+  void test_concurrent_reads_and_writes() {
+    SnapshotCache<int, int> cache;
+    const int numValues = 1000;
+    for (int i = 0; i < numValues; i += 2)
+      cache.setCache(i, i);
+    cache.publish();
+
+    // Readers of the snapshot while other threads set the odd values
+    std::vector<std::thread> threads;
+    std::vector<int> numFound(4, 0);
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&cache, &numFound, t] {
+        if (t % 2 == 0) {
+          for (int i = 1 + t; i < numValues; i += 4)
+            cache.setCache(i, i);
+        } else {
+          for (int i = 0; i < numValues; i += 2) {
+            int value(-1);
+            if (cache.getCache(i, value) && value == i)
+              ++numFound[t];
+          }
+        }
+      });
+    }
+    for (auto &thread : threads)
+      thread.join();
+    TS_ASSERT_EQUALS(numFound[1], numValues / 2);
+    TS_ASSERT_EQUALS(numFound[3], numValues / 2);
+    TS_ASSERT_EQUALS(cache.size(), numValues);
+  }
+
+  void test_publish_while_reading() {
+    SnapshotCache<int, int> cache;
+    const int numValues = 1000;
+    for (int i = 0; i < numValues; ++i)
+      cache.setCache(i, i);
+    cache.publish();
+
+    // Replacing the snapshot must not free one that is read
+    std::vector<std::thread> threads;
+    std::vector<int> numWrong(4, 0);
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&cache, &numWrong, t] {
+        for (int i = 0; i < numValues; ++i) {
+          if (t == 0) {
+            cache.setCache(i, i);
+            if (i % 10 == 0)
+              cache.publish();
+          } else {
+            int value(i);
+            cache.getCache(i, value);
+            if (value != i)
+              ++numWrong[t];
+          }
+        }
+      });
+    }
+    for (auto &thread : threads)
+      thread.join();
+    TS_ASSERT_EQUALS(numWrong, std::vector<int>(4, 0));
+    cache.clear();
+    TS_ASSERT_EQUALS(cache.size(), 0);
+  }
+};
+
+class SnapshotCacheTestPerformance : public CxxTest::TestSuite {
+public:
+  static SnapshotCacheTestPerformance *createSuite() {
+    return new SnapshotCacheTestPerformance();
+  }
+  static void destroySuite(SnapshotCacheTestPerformance *suite) {
+    delete suite;
+  }
+
+  SnapshotCacheTestPerformance() {
+    for (int i = 0; i < numValues; ++i)
+      m_cache.setCache(i, static_cast<double>(i));
+    m_cache.publish();
+  }
+
+  void test_parallel_reads_of_the_snapshot() {
+    std::vector<double> values(numValues);
+    for (int repeat = 0; repeat < 20; ++repeat) {
+      PARALLEL_FOR_NO_WSP_CHECK()
+      for (int i = 0; i < numValues; ++i)
+        m_cache.getCache(i, values[i]);
+    }
+    TS_ASSERT_EQUALS(values.back(), static_cast<double>(numValues - 1));
+  }
+
+private:
+  static const int numValues = 1000000;
+  SnapshotCache<int, double> m_cache;
+};
+
+#endif /* MANTID_KERNEL_SNAPSHOTCACHETEST_H_ */
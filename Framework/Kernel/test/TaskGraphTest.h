@@ -0,0 +1,178 @@
+#ifndef MANTID_KERNEL_TASKGRAPHTEST_H_
+#define MANTID_KERNEL_TASKGRAPHTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/TaskGraph.h"
+#include "MantidKernel/ThreadPool.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace Mantid::Kernel;
+
+class TaskGraphTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static TaskGraphTest *createSuite() { return new TaskGraphTest(); }
+  static void destroySuite(TaskGraphTest *suite) { delete suite; }
+
+  void test_addTask() {
+    TaskGraph graph;
+    TS_ASSERT_EQUALS(graph.size(), 0);
+    TS_ASSERT_EQUALS(graph.addTask([] {}), 0);
+    TS_ASSERT_EQUALS(graph.addTask([] {}, {0}), 1);
+    TS_ASSERT_EQUALS(graph.size(), 2);
+  }
+
+  void test_addTask_throws_for_dependency_that_was_not_added() {
+    TaskGraph graph;
+    graph.addTask([] {});
+    TS_ASSERT_THROWS(graph.addTask([] {}, {1}), std::invalid_argument);
+    TS_ASSERT_THROWS(graph.addTask([] {}, {0, 5}), std::invalid_argument);
+    TS_ASSERT_EQUALS(graph.size(), 1);
+  }
+
+  void test_execute_empty_graph() {
+    TaskGraph graph;
+    TS_ASSERT_THROWS_NOTHING(graph.execute());
+  }
+
+  void test_execute_runs_tasks_after_their_dependencies() {
+    TaskGraph graph;
+    const size_t num = 50;
+    std::unique_ptr<std::atomic<bool>[]> done(new std::atomic<bool>[num]);
+    std::atomic<size_t> numRun(0);
+    std::atomic<bool> orderOk(true);
+    for (size_t i = 0; i < num; ++i) {
+      done[i] = false;
+      // Every task depends on the tasks with half its index and one less
+      std::vector<size_t> dependencies;
+      if (i > 0)
+        dependencies.push_back(i / 2);
+      if (i > 1 && i - 1 != i / 2)
+        dependencies.push_back(i - 1);
+      graph.addTask([&, i, dependencies] {
+        for (const auto dependency : dependencies)
+          if (!done[dependency])
+            orderOk = false;
+        ++numRun;
+        done[i] = true;
+      }, dependencies);
+    }
+    graph.execute();
+    TS_ASSERT_EQUALS(numRun, num);
+    TS_ASSERT(orderOk);
+    TS_ASSERT_EQUALS(TaskGraph::threadsInUse(), 0);
+
+    // Can be run again
+    numRun = 0;
+    for (size_t i = 0; i < num; ++i)
+      done[i] = false;
+    graph.execute();
+    TS_ASSERT_EQUALS(numRun, num);
+    TS_ASSERT(orderOk);
+  }
+
+  void test_independent_tasks_run_in_parallel() {
+    if (ThreadPool::getNumPhysicalCores() < 2)
+      return;
+    TaskGraph graph;
+    std::atomic<int> waiting(0);
+    std::atomic<bool> metOther(false);
+    // Each task waits a while for the other one to start
+    for (int i = 0; i < 2; ++i)
+      graph.addTask([&] {
+        ++waiting;
+        for (int j = 0; j < 500 && waiting < 2; ++j)
+          std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        if (waiting == 2)
+          metOther = true;
+      });
+    graph.execute();
+    TS_ASSERT(metOther);
+  }
+
+  void test_single_thread_runs_in_calling_thread() {
+    TaskGraph graph;
+    std::vector<std::thread::id> ids;
+    for (int i = 0; i < 3; ++i)
+      graph.addTask([&] {
+        TS_ASSERT(TaskGraph::inTask());
+        ids.push_back(std::this_thread::get_id());
+      });
+    TS_ASSERT(!TaskGraph::inTask());
+    graph.execute(1);
+    TS_ASSERT(!TaskGraph::inTask());
+    TS_ASSERT_EQUALS(ids.size(), 3);
+    for (const auto &id : ids)
+      TS_ASSERT_EQUALS(id, std::this_thread::get_id());
+  }
+
+  void test_nested_graphs_share_the_threads() {
+    const size_t cores = ThreadPool::getNumPhysicalCores();
+    std::atomic<size_t> maxInUse(0);
+    std::atomic<size_t> numRun(0);
+    TaskGraph outer;
+    for (int i = 0; i < 6; ++i)
+      outer.addTask([&] {
+        TaskGraph inner;
+        for (int j = 0; j < 6; ++j)
+          inner.addTask([&] {
+            size_t inUse = TaskGraph::threadsInUse();
+            size_t previous = maxInUse;
+            while (inUse > previous &&
+                   !maxInUse.compare_exchange_weak(previous, inUse)) {
+            }
+            ++numRun;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          });
+        inner.execute();
+      });
+    outer.execute();
+    TS_ASSERT_EQUALS(numRun, 36);
+    TS_ASSERT_LESS_THAN_EQUALS(maxInUse, cores);
+    TS_ASSERT_EQUALS(TaskGraph::threadsInUse(), 0);
+  }
+
+  void test_parallel_regions_in_tasks_use_the_remaining_threads() {
+    const int cores = static_cast<int>(ThreadPool::getNumPhysicalCores());
+    TS_ASSERT_EQUALS(threadsForParallelRegion(), PARALLEL_GET_MAX_THREADS);
+    TaskGraph graph;
+    graph.addTask([&] {
+      TS_ASSERT_LESS_THAN_EQUALS(threadsForParallelRegion(), cores);
+      TS_ASSERT_LESS_THAN_EQUALS(1, threadsForParallelRegion());
+    });
+    graph.execute(1);
+  }
+
+  void test_parallel_regions_outside_tasks_are_not_limited() {
+    const int maxThreads = PARALLEL_GET_MAX_THREADS;
+    std::atomic<int> outside(0);
+    TaskGraph graph;
+    graph.addTask([&] {
+      std::thread other([&] { outside = threadsForParallelRegion(); });
+      other.join();
+    });
+    graph.addTask([] {});
+    graph.execute(2);
+    TS_ASSERT_EQUALS(outside, maxThreads);
+  }
+
+  void test_exception_in_task_is_rethrown_and_dependents_are_skipped() {
+    TaskGraph graph;
+    std::atomic<bool> dependentRun(false);
+    const auto failing =
+        graph.addTask([] { throw std::runtime_error("task failed"); });
+    graph.addTask([&] { dependentRun = true; }, {failing});
+    TS_ASSERT_THROWS(graph.execute(), std::runtime_error);
+    TS_ASSERT(!dependentRun);
+    TS_ASSERT_EQUALS(TaskGraph::threadsInUse(), 0);
+  }
+};
+
+#endif /* MANTID_KERNEL_TASKGRAPHTEST_H_ */
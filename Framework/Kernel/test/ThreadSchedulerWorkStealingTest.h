@@ -0,0 +1,156 @@
+#ifndef MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_
+#define MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+
+#include <thread>
+
+using namespace Mantid::Kernel;
+
+int ThreadSchedulerWorkStealingTest_numDestructed;
+
+class ThreadSchedulerWorkStealingTest : public CxxTest::TestSuite {
+public:
+  class TaskDoNothing : public Task {
+  public:
+    ~TaskDoNothing() override {
+      ThreadSchedulerWorkStealingTest_numDestructed++;
+    }
+    void run() override {}
+  };
+
+  void test_push_and_clear() {
+    ThreadSchedulerWorkStealing sc(2);
+    TS_ASSERT_EQUALS(sc.numberOfQueues(), 2);
+    TS_ASSERT(sc.empty());
+    sc.push(new TaskDoNothing());
+    sc.push(new TaskDoNothing());
+    sc.push(new TaskDoNothing());
+    TS_ASSERT_EQUALS(sc.size(), 3);
+    TS_ASSERT(!sc.empty());
+
+    ThreadSchedulerWorkStealingTest_numDestructed = 0;
+    sc.clear();
+    TS_ASSERT_EQUALS(sc.size(), 0);
+    TS_ASSERT_EQUALS(ThreadSchedulerWorkStealingTest_numDestructed, 3);
+  }
+
+  void test_default_uses_a_queue_per_core() {
+    ThreadSchedulerWorkStealing sc;
+    TS_ASSERT_LESS_THAN(0, sc.numberOfQueues());
+  }
+
+  void test_tasks_from_outside_are_distributed_over_the_queues() {
+    ThreadSchedulerWorkStealing sc(3);
+    Task *tasks[6];
+    // Push from a thread that never popped from this scheduler
+    std::thread pusher([&] {
+      for (auto &task : tasks) {
+        task = new TaskDoNothing();
+        sc.push(task);
+      }
+    });
+    pusher.join();
+    TS_ASSERT_EQUALS(sc.queueSize(0), 2);
+    TS_ASSERT_EQUALS(sc.queueSize(1), 2);
+    TS_ASSERT_EQUALS(sc.queueSize(2), 2);
+
+    // A thread pops the newest task of its own queue first
+    Task *popped = sc.pop(1);
+    TS_ASSERT_EQUALS(popped, tasks[4]);
+    delete popped;
+  }
+
+  void test_tasks_pushed_by_a_thread_go_to_its_queue() {
+    ThreadSchedulerWorkStealing sc(2);
+    std::thread pusher([&] {
+      sc.push(new TaskDoNothing());
+      sc.push(new TaskDoNothing());
+    });
+    pusher.join();
+
+    // Thread 1 pops its task, and then pushes more tasks from "within" it
+    Task *task = sc.pop(1);
+    Task *pushed1 = new TaskDoNothing();
+    Task *pushed2 = new TaskDoNothing();
+    sc.push(pushed1);
+    sc.push(pushed2);
+    TS_ASSERT_EQUALS(sc.queueSize(0), 1);
+    TS_ASSERT_EQUALS(sc.queueSize(1), 2);
+    delete task;
+
+    // Own queue is last-in-first-out
+    task = sc.pop(1);
+    TS_ASSERT_EQUALS(task, pushed2);
+    delete task;
+  }
+
+  void test_empty_queue_steals_oldest_task() {
+    ThreadSchedulerWorkStealing sc(2);
+    Task *first = new TaskDoNothing();
+    Task *second = new TaskDoNothing();
+    Task *third = new TaskDoNothing();
+    // Everything goes to the queue of thread 0
+    sc.pop(0);
+    sc.push(first);
+    sc.push(second);
+    sc.push(third);
+    TS_ASSERT_EQUALS(sc.queueSize(0), 3);
+
+    std::vector<Task *> stolen;
+    std::thread thief([&] {
+      stolen.push_back(sc.pop(1));
+      stolen.push_back(sc.pop(1));
+    });
+    thief.join();
+    TS_ASSERT_EQUALS(stolen[0], first);
+    TS_ASSERT_EQUALS(stolen[1], second);
+    TS_ASSERT_EQUALS(sc.size(), 1);
+    Task *last = sc.pop(0);
+    TS_ASSERT_EQUALS(last, third);
+    TS_ASSERT(sc.empty());
+    TS_ASSERT(!sc.pop(0));
+    delete first;
+    delete second;
+    delete third;
+  }
+
+  void test_total_cost() {
+    ThreadSchedulerWorkStealing sc(2);
+    sc.push(new TaskDoNothing());
+    sc.push(new TaskDoNothing());
+    sc.push(new TaskDoNothing());
+    TS_ASSERT_DELTA(sc.totalCost(), 3.0, 1e-10);
+    TS_ASSERT_DELTA(sc.totalCostExecuted(), 0.0, 1e-10);
+    delete sc.pop(0);
+    delete sc.pop(0);
+    TS_ASSERT_DELTA(sc.totalCostExecuted(), 2.0, 1e-10);
+    // Stolen tasks count as well
+    std::thread thief([&sc] { delete sc.pop(1); });
+    thief.join();
+    TS_ASSERT_DELTA(sc.totalCostExecuted(), 3.0, 1e-10);
+    TS_ASSERT_DELTA(sc.totalCost(), 3.0, 1e-10);
+    sc.clear();
+    TS_ASSERT_DELTA(sc.totalCost(), 0.0, 1e-10);
+    TS_ASSERT_DELTA(sc.totalCostExecuted(), 0.0, 1e-10);
+  }
+
+  void test_thread_that_popped_from_a_destroyed_scheduler() {
+    std::thread worker([] {
+      {
+        ThreadSchedulerWorkStealing sc(8);
+        TS_ASSERT(!sc.pop(7));
+      }
+      // The next scheduler has fewer queues than the queue of this thread
+      ThreadSchedulerWorkStealing sc(2);
+      sc.push(new TaskDoNothing());
+      TS_ASSERT_EQUALS(sc.size(), 1);
+      TS_ASSERT_EQUALS(sc.queueSize(0), 1);
+    });
+    worker.join();
+  }
+};
+
+#endif /* MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_ */
@@ -11,6 +11,7 @@
 #include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/scoped_ptr.hpp>
+#include <algorithm>
 #include <vector>
 
 using namespace Mantid::Kernel;
@@ -586,6 +587,48 @@ public:
     delete intLog;
   }
 
+  void test_averageValueInFilter_long_log() {
+    // Long enough for the sums of whole chunks of entries to be used
+    TimeSeriesProperty<double> log("LongLog");
+    const DateAndTime start("2007-11-30T16:17:00");
+    const int numEntries = 2000;
+    for (int i = 0; i < numEntries; ++i)
+      log.addValue(start + static_cast<double>(i), static_cast<double>(i % 7));
+
+    // Each entry lasts one second, the last one until the end of the filter
+    auto expected = [&](const TimeSplitterType &filter) {
+      double numerator(0.0), denominator(0.0);
+      for (const auto &interval : filter) {
+        const double from = DateAndTime::secondsFromDuration(
+            interval.start() - start);
+        const double to =
+            DateAndTime::secondsFromDuration(interval.stop() - start);
+        for (int i = 0; i < numEntries; ++i) {
+          const double end = i == numEntries - 1 ? to : i + 1.0;
+          const double overlap = std::min(end, to) - std::max(i + 0.0, from);
+          if (overlap > 0.0)
+            numerator += overlap * (i % 7);
+        }
+        denominator += to - from;
+      }
+      return numerator / denominator;
+    };
+
+    TimeSplitterType filter;
+    filter.push_back(SplittingInterval(start + 10.5, start + 1700.25));
+    TS_ASSERT_DELTA(log.averageValueInFilter(filter), expected(filter), 1e-9);
+    filter.push_back(SplittingInterval(start + 1800.0, start + 2100.0));
+    TS_ASSERT_DELTA(log.averageValueInFilter(filter), expected(filter), 1e-9);
+
+    filter.assign(1, SplittingInterval(start, start + 1999.0));
+    TS_ASSERT_DELTA(log.timeAverageValue(), expected(filter), 1e-9);
+
+    // Changing the values updates the average
+    log.addValue(start + 0.5, 100.0);
+    TS_ASSERT_DELTA(log.timeAverageValue(), expected(filter) + 50.0 / 1999.0,
+                    1e-9);
+  }
+
   void test_averageValueInFilter_throws_for_string_property() {
     TimeSplitterType splitter;
     TS_ASSERT_THROWS(sProp->averageValueInFilter(splitter),
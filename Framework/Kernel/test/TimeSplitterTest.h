@@ -538,6 +538,44 @@ public:
     int index2 = int(sit - b.begin());
     TS_ASSERT_EQUALS(index2, 2);
   }
+
+  void test_TimeSplitterIndex_throws_for_invalid_input() {
+    TS_ASSERT_THROWS(TimeSplitterIndex({10, 20}, {0, 1}),
+                     std::invalid_argument);
+    TS_ASSERT_THROWS(TimeSplitterIndex({20, 10}, {0, 1, 2}),
+                     std::invalid_argument);
+    TS_ASSERT_THROWS_NOTHING(TimeSplitterIndex({}, {0}));
+  }
+
+  void test_TimeSplitterIndex_destination() {
+    // Destination 1 before 10, 2 in [10, 20), 3 in [20, 30), none afterwards
+    TimeSplitterIndex index({10, 20, 30}, {1, 2, 3, -1});
+    TS_ASSERT_EQUALS(index.numberOfIntervals(), 4);
+
+    // Sorted times in one sweep
+    size_t interval = 0;
+    TS_ASSERT_EQUALS(index.destination(-5, interval), 1);
+    TS_ASSERT_EQUALS(index.destination(9, interval), 1);
+    TS_ASSERT_EQUALS(index.destination(10, interval), 2);
+    TS_ASSERT_EQUALS(index.destination(19, interval), 2);
+    TS_ASSERT_EQUALS(index.destination(25, interval), 3);
+    TS_ASSERT_EQUALS(index.destination(30, interval), -1);
+    TS_ASSERT_EQUALS(interval, 3);
+
+    // Jumps in either direction, from any starting interval
+    TS_ASSERT_EQUALS(index.destination(0, interval), 1);
+    TS_ASSERT_EQUALS(index.destination(1000, interval), -1);
+    TS_ASSERT_EQUALS(index.destination(20, interval), 3);
+    interval = 100;
+    TS_ASSERT_EQUALS(index.destination(15, interval), 2);
+  }
+
+  void test_TimeSplitterIndex_skips_empty_intervals() {
+    TimeSplitterIndex index({10, 20, 20, 30}, {0, 1, 2, 3, 4});
+    size_t interval = 1;
+    TS_ASSERT_EQUALS(index.destination(20, interval), 3);
+    TS_ASSERT_EQUALS(index.destination(19, interval), 1);
+  }
 };
 
 #endif /* TIMESPLITTERTEST_H_ */
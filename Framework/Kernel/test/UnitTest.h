@@ -1224,7 +1224,80 @@ public:
     TS_ASSERT_EQUALS(degrees.unitID(), "Degrees");
   }
 
+  //----------------------------------------------------------------------
+  // Range conversion tests
+  //----------------------------------------------------------------------
+
+  void test_range_conversions_match_single_conversions() {
+    for (int emode = 0; emode <= 2; ++emode) {
+      Units::Wavelength wavelength;
+      checkRangeConversions(wavelength, emode);
+    }
+    Units::SpinEchoLength spinEchoLength;
+    checkRangeConversions(spinEchoLength, 0);
+    Units::SpinEchoTime spinEchoTime;
+    checkRangeConversions(spinEchoTime, 0);
+    Units::Energy energyUnit;
+    checkRangeConversions(energyUnit, 0);
+    Units::Energy_inWavenumber energykUnit;
+    checkRangeConversions(energykUnit, 0);
+    Units::dSpacing dUnit;
+    checkRangeConversions(dUnit, 0);
+    Units::MomentumTransfer qUnit;
+    checkRangeConversions(qUnit, 0);
+    Units::QSquared q2Unit;
+    checkRangeConversions(q2Unit, 0);
+    Units::Momentum kUnit;
+    checkRangeConversions(kUnit, 0);
+    for (int emode = 1; emode <= 2; ++emode) {
+      Units::DeltaE dEUnit;
+      checkRangeConversions(dEUnit, emode);
+      Units::DeltaE_inWavenumber dEkUnit;
+      checkRangeConversions(dEkUnit, emode);
+    }
+  }
+
+  void test_range_conversions_of_TOF_leave_values_unchanged() {
+    std::vector<double> values = {1.0, 2.5, 1000.0};
+    const auto original = values;
+    tof.rangeToTOF(values.data(), values.data() + values.size());
+    TS_ASSERT_EQUALS(values, original);
+    tof.rangeFromTOF(values.data(), values.data() + values.size());
+    TS_ASSERT_EQUALS(values, original);
+  }
+
+  void test_default_range_conversions_use_single_conversions() {
+    UnitTester t;
+    std::vector<double> values = {1.0, 2.5, 1000.0};
+    t.rangeToTOF(values.data(), values.data() + values.size());
+    TS_ASSERT_EQUALS(values, std::vector<double>(3, 0.0));
+    values.assign(3, 1.0);
+    t.rangeFromTOF(values.data(), values.data() + values.size());
+    TS_ASSERT_EQUALS(values, std::vector<double>(3, 0.0));
+  }
+
 private:
+  /// Checks that rangeToTOF() and rangeFromTOF() give the same values as
+  /// converting the values one at a time
+  void checkRangeConversions(Unit &unit, const int emode) {
+    unit.initialize(10.0, 2.0, 0.5, emode, 25.0, 0.0);
+    std::vector<double> values;
+    for (int i = 1; i <= 20; ++i)
+      values.push_back(1000.0 * i);
+
+    std::vector<double> converted(values);
+    unit.rangeFromTOF(converted.data(), converted.data() + converted.size());
+    for (size_t i = 0; i < values.size(); ++i)
+      TS_ASSERT_DELTA(converted[i], unit.singleFromTOF(values[i]),
+                      1e-12 * std::abs(converted[i]));
+
+    std::vector<double> backToTOF(converted);
+    unit.rangeToTOF(backToTOF.data(), backToTOF.data() + backToTOF.size());
+    for (size_t i = 0; i < values.size(); ++i)
+      TS_ASSERT_DELTA(backToTOF[i], unit.singleToTOF(converted[i]),
+                      1e-12 * std::abs(backToTOF[i]));
+  }
+
   Units::Label label;
   Units::TOF tof;
   Units::Wavelength lambda;
@@ -63,10 +63,20 @@ private:
   template <typename MDE, size_t nd>
   void binByIterating(typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws);
 
+  template <typename MDE, size_t nd>
+  void binIntoThreadHistograms(
+      typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws,
+      const int numThreads);
+
+  template <typename MDE, size_t nd>
+  void binInChunks(typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws,
+                   const bool doParallel);
+
   /// Method to bin a single MDBox
   template <typename MDE, size_t nd>
   void binMDBox(DataObjects::MDBox<MDE, nd> *box, const size_t *const chunkMin,
-                const size_t *const chunkMax);
+                const size_t *const chunkMax, signal_t *signals,
+                signal_t *errors, signal_t *numEvents);
 
   /// The output MDHistoWorkspace
   Mantid::DataObjects::MDHistoWorkspace_sptr outWS;
@@ -77,9 +87,6 @@ private:
 
   /// Cached values for speed up
   size_t *indexMultiplier;
-  signal_t *signals;
-  signal_t *errors;
-  signal_t *numEvents;
 };
 
 } // namespace Mantid
@@ -61,15 +61,32 @@ public:
   void runConversion(API::Progress *pProgress) override;
 
 private:
+  /// Events converted into MD space, staged before they are added to the
+  /// workspace
+  struct ConvertedEvents {
+    std::vector<coord_t> coord;
+    std::vector<float> sigErr;
+    std::vector<uint16_t> runIndex;
+    std::vector<uint32_t> detIds;
+  };
+
   // function runs the conversion on
   size_t conversionChunk(size_t workspaceIndex) override;
+  // converts a block of spectra in parallel and adds their events to the
+  // workspace
+  size_t convertBlock(size_t begin, size_t end, bool inParallel);
+  // converts the events of a spectrum into MD space, without adding them
+  size_t convertSpectrum(size_t workspaceIndex, MDTransfInterface &qConverter,
+                         ConvertedEvents &converted) const;
   // the pointer to the source event workspace as event ws does not work through
   // the public Matrix WS interface
   DataObjects::EventWorkspace_const_sptr m_EventWS;
 
-  /**function converts particular type of events into MD space and add these
-   * events to the workspace itself    */
-  template <class T> size_t convertEventList(size_t workspaceIndex);
+  /**function converts particular type of events into MD space and stages
+   * these events to be added to the workspace    */
+  template <class T>
+  size_t convertEventList(size_t workspaceIndex, MDTransfInterface &qConverter,
+                          ConvertedEvents &converted) const;
 };
 
 } // endNamespace DataObjects
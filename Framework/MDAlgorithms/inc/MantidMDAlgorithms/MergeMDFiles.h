@@ -74,6 +74,29 @@ private:
 
   uint64_t loadEventsFromSubBoxes(API::IMDNode *TargetBox);
 
+  /// The events of a range of consecutive boxes, read from all the files
+  struct Extent {
+    /// Range of the boxes, as indexes into the merged boxes
+    size_t begin = 0;
+    size_t end = 0;
+    /// Position of the events of the first box in the output file
+    uint64_t outputPosition = 0;
+    /// Blocks of events read from the files
+    std::vector<std::vector<coord_t>> blocks;
+    /// For each file of each box: the block holding its events and the index
+    /// of the first of them in the block
+    std::vector<std::pair<size_t, size_t>> boxBlocks;
+    /// Number of values per event
+    size_t numColumns = 0;
+  };
+
+  void mergeInExtents(API::IBoxControllerIO *saver);
+
+  void readExtent(const std::vector<API::IMDNode *> &boxes, Extent &extent);
+
+  void mergeExtent(const std::vector<API::IMDNode *> &boxes,
+                   const Extent &extent, std::vector<coord_t> &output);
+
   // the class which flatten the box structure and deal with it
   DataObjects::MDBoxFlatTree m_BoxStruct;
   // the vector of box structures for contributing files components
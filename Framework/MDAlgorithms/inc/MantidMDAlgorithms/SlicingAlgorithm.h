@@ -74,6 +74,34 @@ protected:
   getGeneralImplicitFunction(const size_t *const chunkMin,
                              const size_t *const chunkMax);
 
+  /// Number of events transformed at once by transformEvents()
+  static const size_t TRANSFORM_BLOCK_SIZE = 1024;
+
+  /** Transform the centers of a block of events with
+   * CoordTransform::applyBlock(). The output coordinate d of event i is
+   * outputs[d * numEvents + i].
+   *
+   * @param transform :: the transformation to apply
+   * @param events :: pointer to the first event of the block
+   * @param numEvents :: number of events in the block
+   * @param inputs :: buffer for the event centers, resized as needed
+   * @param outputs :: filled with the output coordinates
+   */
+  template <typename MDE, size_t nd>
+  static void transformEvents(const API::CoordTransform &transform,
+                              const MDE *events, const size_t numEvents,
+                              std::vector<coord_t> &inputs,
+                              std::vector<coord_t> &outputs) {
+    inputs.resize(nd * numEvents);
+    outputs.resize(transform.getOutD() * numEvents);
+    for (size_t i = 0; i < numEvents; ++i) {
+      const coord_t *center = events[i].getCenter();
+      for (size_t d = 0; d < nd; ++d)
+        inputs[d * numEvents + i] = center[d];
+    }
+    transform.applyBlock(inputs.data(), outputs.data(), numEvents);
+  }
+
   /// Input workspace
   Mantid::API::IMDWorkspace_sptr m_inWS;
 
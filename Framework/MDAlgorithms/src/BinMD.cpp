@@ -2,6 +2,8 @@
 #include "MantidGeometry/MDGeometry/MDBoxImplicitFunction.h"
 #include "MantidGeometry/MDGeometry/MDHistoDimension.h"
 #include "MantidKernel/CPUTimer.h"
+#include "MantidKernel/Memory.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/Utils.h"
@@ -14,6 +16,7 @@
 #include "MantidDataObjects/MDHistoWorkspace.h"
 #include "MantidMDAlgorithms/BinMD.h"
 #include <boost/algorithm/string.hpp>
+#include <memory>
 #include "MantidKernel/EnabledWhenProperty.h"
 #include "MantidDataObjects/CoordTransformAffine.h"
 
@@ -26,6 +29,32 @@ namespace MDAlgorithms {
 // Register the algorithm into the AlgorithmFactory
 DECLARE_ALGORITHM(BinMD)
 
+namespace {
+/// How many boxes ahead of the one being binned are loaded in the background
+/// when the workspace is file-backed
+const size_t PREFETCH_BOXES = 16;
+
+/// Turns on the background I/O of a file-backed workspace, and restores the
+/// previous setting when it goes out of scope
+class BackgroundIOScope {
+public:
+  explicit BackgroundIOScope(API::IBoxControllerIO *fileIO)
+      : m_fileIO(fileIO), m_backgroundIO(fileIO->getBackgroundIO()) {
+    m_fileIO->setBackgroundIO(true);
+  }
+  BackgroundIOScope(const BackgroundIOScope &) = delete;
+  BackgroundIOScope &operator=(const BackgroundIOScope &) = delete;
+  ~BackgroundIOScope() {
+    if (!m_backgroundIO)
+      m_fileIO->setBackgroundIO(false);
+  }
+
+private:
+  API::IBoxControllerIO *m_fileIO;
+  bool m_backgroundIO;
+};
+}
+
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
 using namespace Mantid::Geometry;
@@ -36,8 +65,7 @@ using namespace Mantid::DataObjects;
  */
 BinMD::BinMD()
     : outWS(), prog(nullptr), implicitFunction(nullptr),
-      indexMultiplier(nullptr), signals(nullptr), errors(nullptr),
-      numEvents(nullptr) {}
+      indexMultiplier(nullptr) {}
 
 //----------------------------------------------------------------------------------------------
 /** Initialize the algorithm's properties.
@@ -88,19 +116,22 @@ void BinMD::init() {
  *(inclusive)
  * @param chunkMax :: the maximum index in each dimension to consider "valid"
  *(exclusive)
+ * @param signals :: signal of each bin, added to
+ * @param errors :: squared error of each bin, added to
+ * @param numEvents :: number of events of each bin, added to
  */
 template <typename MDE, size_t nd>
 inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
-                            const size_t *const chunkMax) {
-  // An array to hold the rotated/transformed coordinates
-  auto outCenter = new coord_t[m_outD];
-
+                            const size_t *const chunkMax, signal_t *signals,
+                            signal_t *errors, signal_t *numEvents) {
   // Evaluate whether the entire box is in the same bin
   if (box->getNPoints() > (1 << nd) * 2) {
     // There is a check that the number of events is enough for it to make sense
     // to do all this processing.
     size_t numVertexes = 0;
     coord_t *vertexes = box->getVertexesArray(numVertexes);
+    // An array to hold the rotated/transformed coordinates
+    std::vector<coord_t> outCenter(m_outD);
 
     // All vertexes have to be within THE SAME BIN = have the same linear index.
     size_t lastLinearIndex = 0;
@@ -111,9 +142,7 @@ inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
       const coord_t *inCenter = vertexes + i * nd;
 
       // Now transform to the output dimensions
-      m_transform->apply(inCenter, outCenter);
-      // std::cout << "Input coord " << VMD(nd,inCenter) << " transformed to "
-      // <<  VMD(nd,outCenter) << '\n';
+      m_transform->apply(inCenter, outCenter.data());
 
       // To build up the linear index
       size_t linearIndex = 0;
@@ -155,8 +184,6 @@ inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
 
     if (!badOne) {
       // Yes, the entire box is within a single bin
-      //        std::cout << "Box at " << box->getExtentsStr() << " is within a
-      //        single bin.\n";
       // Add the CACHED signal from the entire box
       signals[lastLinearIndex] += box->getSignal();
       errors[lastLinearIndex] += box->getErrorSquared();
@@ -166,56 +193,58 @@ inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
 
       // And don't bother looking at each event. This may save lots of time
       // loading from disk.
-      delete[] outCenter;
       return;
     }
   }
 
   // If you get here, you could not determine that the entire box was in the
   // same bin.
-  // So you need to iterate through events.
+  // So you need to iterate through events, transforming them in blocks.
   const std::vector<MDE> &events = box->getConstEvents();
-  for (auto it = events.begin(); it != events.end(); ++it) {
-    // Cache the center of the event (again for speed)
-    const coord_t *inCenter = it->getCenter();
-
-    // Now transform to the output dimensions
-    m_transform->apply(inCenter, outCenter);
+  std::vector<coord_t> inCenters;
+  std::vector<coord_t> outCenters;
+  for (size_t first = 0; first < events.size();
+       first += TRANSFORM_BLOCK_SIZE) {
+    const size_t numInBlock =
+        std::min(TRANSFORM_BLOCK_SIZE, events.size() - first);
+    transformEvents<MDE, nd>(*m_transform, events.data() + first, numInBlock,
+                             inCenters, outCenters);
+
+    for (size_t i = 0; i < numInBlock; ++i) {
+      // To build up the linear index
+      size_t linearIndex = 0;
+      // To mark events outside range
+      bool badOne = false;
 
-    // To build up the linear index
-    size_t linearIndex = 0;
-    // To mark events outside range
-    bool badOne = false;
+      /// Loop through the dimensions on which we bin
+      for (size_t bd = 0; bd < m_outD; bd++) {
+        // What is the bin index in that dimension
+        coord_t x = outCenters[bd * numInBlock + i];
+        size_t ix = size_t(x);
+        // Within range (for this chunk)?
+        if ((x >= 0) && (ix >= chunkMin[bd]) && (ix < chunkMax[bd])) {
+          // Build up the linear index
+          linearIndex += indexMultiplier[bd] * ix;
+        } else {
+          // Outside the range
+          badOne = true;
+          break;
+        }
+      } // (for each dim in MDHisto)
 
-    /// Loop through the dimensions on which we bin
-    for (size_t bd = 0; bd < m_outD; bd++) {
-      // What is the bin index in that dimension
-      coord_t x = outCenter[bd];
-      size_t ix = size_t(x);
-      // Within range (for this chunk)?
-      if ((x >= 0) && (ix >= chunkMin[bd]) && (ix < chunkMax[bd])) {
-        // Build up the linear index
-        linearIndex += indexMultiplier[bd] * ix;
-      } else {
-        // Outside the range
-        badOne = true;
-        break;
+      if (!badOne) {
+        const MDE &event = events[first + i];
+        // Sum the signals as doubles to preserve precision
+        signals[linearIndex] += static_cast<signal_t>(event.getSignal());
+        errors[linearIndex] += static_cast<signal_t>(event.getErrorSquared());
+        // TODO: If DataObjects get a weight, this would need to get the summed
+        // weight.
+        numEvents[linearIndex] += 1.0;
       }
-    } // (for each dim in MDHisto)
-
-    if (!badOne) {
-      // Sum the signals as doubles to preserve precision
-      signals[linearIndex] += static_cast<signal_t>(it->getSignal());
-      errors[linearIndex] += static_cast<signal_t>(it->getErrorSquared());
-      // TODO: If DataObjects get a weight, this would need to get the summed
-      // weight.
-      numEvents[linearIndex] += 1.0;
     }
   }
   // Done with the events list
   box->releaseEvents();
-
-  delete[] outCenter;
 }
 
 //----------------------------------------------------------------------------------------------
@@ -241,117 +270,238 @@ void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
     else
       indexMultiplier[d] = 1;
   }
-  signals = outWS->getSignalArray();
-  errors = outWS->getErrorSquaredArray();
-  numEvents = outWS->getNumEventsArray();
 
   // Start with signal/error/numEvents at 0.0
   outWS->setTo(0.0, 0.0, 0.0);
 
+  // Do we actually do it in parallel?
+  bool doParallel = getProperty("Parallel");
+  // Not if file-backed!
+  if (bc->isFileBacked())
+    doParallel = false;
+
+  if (prog)
+    prog->setNotifyStep(0.1);
+
+  // Each thread bins into a histogram of its own, unless the copies of the
+  // output would use more than half of the available memory.
+  int numThreads = 1;
+  if (doParallel) {
+    Kernel::MemoryStats memory;
+    const size_t histogramKiB =
+        outWS->getNPoints() * 3 * sizeof(signal_t) / 1024 + 1;
+    const size_t maxThreads = memory.availMem() / 2 / histogramKiB + 1;
+    numThreads = static_cast<int>(std::min(
+        static_cast<size_t>(Kernel::threadsForParallelRegion()), maxThreads));
+  }
+  if (numThreads > 1)
+    this->binIntoThreadHistograms<MDE, nd>(ws, numThreads);
+  else
+    this->binInChunks<MDE, nd>(ws, doParallel);
+
+  // Now the implicit function
+  if (implicitFunction) {
+    if (prog)
+      prog->report("Applying implicit function.");
+    signal_t nan = std::numeric_limits<signal_t>::quiet_NaN();
+    outWS->applyImplicitFunction(implicitFunction, nan, nan);
+  }
+
+  // return the size of the input workspace write buffer to its initial value
+  // bc->setCacheParameters(sizeof(MDE),writeBufSize);
+}
+
+//----------------------------------------------------------------------------------------------
+/** Bin all the boxes in parallel. The first thread adds to the output
+ * workspace and each of the other threads to a histogram of its own, so that
+ * no two threads write to the same bin. The histograms are summed into the
+ * output at the end.
+ *
+ * @param ws :: MDEventWorkspace of the given type.
+ * @param numThreads :: number of threads, and of histograms.
+ */
+template <typename MDE, size_t nd>
+void BinMD::binIntoThreadHistograms(
+    typename MDEventWorkspace<MDE, nd>::sptr ws, const int numThreads) {
+  // The whole output workspace
+  std::vector<size_t> chunkMin(m_outD, 0);
+  std::vector<size_t> chunkMax(m_outD);
+  for (size_t bd = 0; bd < m_outD; bd++)
+    chunkMax[bd] = m_binDimensions[bd]->getNBins();
+  std::unique_ptr<MDImplicitFunction> function(
+      this->getImplicitFunctionForChunk(chunkMin.data(), chunkMax.data()));
+
+  // Use getBoxes() to get an array with a pointer to each box
+  std::vector<API::IMDNode *> boxes;
+  // Leaf-only; no depth limit; with the implicit function passed to it.
+  ws->getBox()->getBoxes(boxes, 1000, true, function.get());
+  g_log.debug() << "Found " << boxes.size()
+                << " boxes within the implicit function.\n";
+  if (prog)
+    prog->resetNumSteps(static_cast<int64_t>(boxes.size()), 0.0, 1.0);
+
+  // Signal, squared error and number of events of each bin, for each thread
+  // but the first. A thread allocates its histogram when it starts binning.
+  const size_t numBins = outWS->getNPoints();
+  std::vector<std::vector<signal_t>> histograms(numThreads - 1);
+
+  PRAGMA_OMP(parallel for schedule(dynamic, 16) num_threads(numThreads))
+  for (int i = 0; i < static_cast<int>(boxes.size()); ++i) {
+    PARALLEL_START_INTERUPT_REGION
+    const int thread = PARALLEL_THREAD_NUMBER;
+    signal_t *signals = outWS->getSignalArray();
+    signal_t *errors = outWS->getErrorSquaredArray();
+    signal_t *numEvents = outWS->getNumEventsArray();
+    if (thread > 0) {
+      std::vector<signal_t> &histogram = histograms[thread - 1];
+      if (histogram.empty())
+        histogram.resize(3 * numBins, 0.0);
+      signals = histogram.data();
+      errors = signals + numBins;
+      numEvents = errors + numBins;
+    }
+
+    MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(boxes[i]);
+    // Perform the binning in this separate method.
+    if (box && !box->getIsMasked())
+      this->binMDBox(box, chunkMin.data(), chunkMax.data(), signals, errors,
+                     numEvents);
+
+    // Progress reporting
+    if (prog)
+      prog->report();
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  // Sum the histograms into the output, each thread summing a range of bins
+  signal_t *signals = outWS->getSignalArray();
+  signal_t *errors = outWS->getErrorSquaredArray();
+  signal_t *numEvents = outWS->getNumEventsArray();
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t bin = 0; bin < static_cast<int64_t>(numBins); ++bin) {
+    for (const auto &histogram : histograms) {
+      if (histogram.empty())
+        continue;
+      signals[bin] += histogram[bin];
+      errors[bin] += histogram[numBins + bin];
+      numEvents[bin] += histogram[2 * numBins + bin];
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------
+/** Bin the boxes in chunks of bins along the first output dimension. When
+ * running in parallel, each thread bins a chunk at a time; the chunks do not
+ * overlap in the output workspace so it is thread safe to write to it.
+ *
+ * @param ws :: MDEventWorkspace of the given type.
+ * @param doParallel :: true to bin the chunks in parallel.
+ */
+template <typename MDE, size_t nd>
+void BinMD::binInChunks(typename MDEventWorkspace<MDE, nd>::sptr ws,
+                        const bool doParallel) {
+  BoxController_sptr bc = ws->getBoxController();
+
   // The dimension (in the output workspace) along which we chunk for parallel
   // processing
   // TODO: Find the smartest dimension to chunk against
   size_t chunkDimension = 0;
+  const size_t numChunkBins = m_binDimensions[chunkDimension]->getNBins();
 
   // How many bins (in that dimension) per chunk.
   // Try to split it so each core will get 2 tasks:
-  int chunkNumBins = int(m_binDimensions[chunkDimension]->getNBins() /
-                         (PARALLEL_GET_MAX_THREADS * 2));
+  size_t chunkNumBins =
+      numChunkBins / (static_cast<size_t>(PARALLEL_GET_MAX_THREADS) * 2);
   if (chunkNumBins < 1)
     chunkNumBins = 1;
-
-  // Do we actually do it in parallel?
-  bool doParallel = getProperty("Parallel");
-  // Not if file-backed!
-  if (bc->isFileBacked())
-    doParallel = false;
   if (!doParallel)
-    chunkNumBins = int(m_binDimensions[chunkDimension]->getNBins());
+    chunkNumBins = numChunkBins;
 
-  // Total number of steps
+  // Find the boxes of each chunk first, to know the number of progress steps
+  const size_t numChunks = (numChunkBins + chunkNumBins - 1) / chunkNumBins;
+  std::vector<std::vector<size_t>> chunkMins(numChunks);
+  std::vector<std::vector<size_t>> chunkMaxs(numChunks);
+  std::vector<std::vector<API::IMDNode *>> chunkBoxes(numChunks);
   size_t progNumSteps = 0;
+  for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+    // Region of interest for this chunk.
+    std::vector<size_t> &chunkMin = chunkMins[chunk];
+    std::vector<size_t> &chunkMax = chunkMaxs[chunk];
+    chunkMin.assign(m_outD, 0);
+    chunkMax.resize(m_outD);
+    for (size_t bd = 0; bd < m_outD; bd++) {
+      // Same limits in the other dimensions
+      chunkMax[bd] = m_binDimensions[bd]->getNBins();
+    }
+    // Parcel out a chunk in that single dimension dimension
+    chunkMin[chunkDimension] = chunk * chunkNumBins;
+    chunkMax[chunkDimension] =
+        std::min((chunk + 1) * chunkNumBins, numChunkBins);
+
+    // Build an implicit function (it needs to be in the space of the
+    // MDEventWorkspace)
+    std::unique_ptr<MDImplicitFunction> function(
+        this->getImplicitFunctionForChunk(chunkMin.data(), chunkMax.data()));
+
+    // Leaf-only; no depth limit; with the implicit function passed to it.
+    std::vector<API::IMDNode *> &boxes = chunkBoxes[chunk];
+    ws->getBox()->getBoxes(boxes, 1000, true, function.get());
+
+    // Sort boxes by file position IF file backed. This reduces seeking time,
+    // hopefully.
+    if (bc->isFileBacked())
+      API::IMDNode::sortObjByID(boxes);
+
+    g_log.debug() << "Chunk " << chunk << ": found " << boxes.size()
+                  << " boxes within the implicit function.\n";
+    progNumSteps += boxes.size();
+  }
   if (prog)
-    prog->setNotifyStep(0.1);
-  if (prog)
-    prog->resetNumSteps(100, 0.00, 1.0);
-
-  // Run the chunks in parallel. There is no overlap in the output workspace so
-  // it is thread safe to write to it..
-  // cppcheck-suppress syntaxError
-    PRAGMA_OMP( parallel for schedule(dynamic,1) if (doParallel) )
-    for (int chunk = 0;
-         chunk < int(m_binDimensions[chunkDimension]->getNBins());
-         chunk += chunkNumBins) {
-      PARALLEL_START_INTERUPT_REGION
-      // Region of interest for this chunk.
-      std::vector<size_t> chunkMin(m_outD);
-      std::vector<size_t> chunkMax(m_outD);
-      for (size_t bd = 0; bd < m_outD; bd++) {
-        // Same limits in the other dimensions
-        chunkMin[bd] = 0;
-        chunkMax[bd] = m_binDimensions[bd]->getNBins();
-      }
-      // Parcel out a chunk in that single dimension dimension
-      chunkMin[chunkDimension] = size_t(chunk);
-      if (size_t(chunk + chunkNumBins) >
-          m_binDimensions[chunkDimension]->getNBins())
-        chunkMax[chunkDimension] = m_binDimensions[chunkDimension]->getNBins();
-      else
-        chunkMax[chunkDimension] = size_t(chunk + chunkNumBins);
-
-      // Build an implicit function (it needs to be in the space of the
-      // MDEventWorkspace)
-      MDImplicitFunction *function =
-          this->getImplicitFunctionForChunk(chunkMin.data(), chunkMax.data());
-
-      // Use getBoxes() to get an array with a pointer to each box
-      std::vector<API::IMDNode *> boxes;
-      // Leaf-only; no depth limit; with the implicit function passed to it.
-      ws->getBox()->getBoxes(boxes, 1000, true, function);
-
-      // Sort boxes by file position IF file backed. This reduces seeking time,
-      // hopefully.
-      if (bc->isFileBacked())
-        API::IMDNode::sortObjByID(boxes);
-
-      // For progress reporting, the # of boxes
-      if (prog) {
-        PARALLEL_CRITICAL(BinMD_progress) {
-          g_log.debug() << "Chunk " << chunk << ": found " << boxes.size()
-                        << " boxes within the implicit function.\n";
-          progNumSteps += boxes.size();
-          prog->setNumSteps(progNumSteps);
-        }
-      }
-
-      // Go through every box for this chunk.
-      for (auto &boxe : boxes) {
-        MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(boxe);
-        // Perform the binning in this separate method.
-        if (box && !box->getIsMasked())
-          this->binMDBox(box, chunkMin.data(), chunkMax.data());
-
-        // Progress reporting
-        if (prog)
-          prog->report();
-        // For early cancelling of the loop
-        if (this->m_cancel)
-          break;
-      } // for each box in the vector
-      PARALLEL_END_INTERUPT_REGION
-    } // for each chunk in parallel
-    PARALLEL_CHECK_INTERUPT_REGION
+    prog->resetNumSteps(static_cast<int64_t>(progNumSteps), 0.0, 1.0);
+
+  signal_t *signals = outWS->getSignalArray();
+  signal_t *errors = outWS->getErrorSquaredArray();
+  signal_t *numEvents = outWS->getNumEventsArray();
+
+  // File-backed workspaces are binned in one chunk. Its boxes are loaded by
+  // the file's I/O thread a few boxes ahead of the one being binned.
+  IBoxControllerIO *fileIO = nullptr;
+  std::unique_ptr<BackgroundIOScope> backgroundIO;
+  if (bc->isFileBacked() && !doParallel) {
+    fileIO = bc->getFileIO();
+    backgroundIO.reset(new BackgroundIOScope(fileIO));
+  }
 
-    // Now the implicit function
-    if (implicitFunction) {
+  PRAGMA_OMP(parallel for schedule(dynamic, 1) if (doParallel)
+             num_threads(Kernel::threadsForParallelRegion()))
+  for (int chunk = 0; chunk < static_cast<int>(numChunks); ++chunk) {
+    PARALLEL_START_INTERUPT_REGION
+    const std::vector<API::IMDNode *> &boxes = chunkBoxes[chunk];
+    if (fileIO)
+      for (size_t i = 0; i < std::min(PREFETCH_BOXES, boxes.size()); ++i)
+        fileIO->prefetch(boxes[i]->getISaveable());
+    // Go through every box for this chunk.
+    for (size_t i = 0; i < boxes.size(); ++i) {
+      if (fileIO && i + PREFETCH_BOXES < boxes.size())
+        fileIO->prefetch(boxes[i + PREFETCH_BOXES]->getISaveable());
+      MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(boxes[i]);
+      // Perform the binning in this separate method.
+      if (box && !box->getIsMasked())
+        this->binMDBox(box, chunkMins[chunk].data(), chunkMaxs[chunk].data(),
+                       signals, errors, numEvents);
+
+      // Progress reporting
       if (prog)
-        prog->report("Applying implicit function.");
-      signal_t nan = std::numeric_limits<signal_t>::quiet_NaN();
-      outWS->applyImplicitFunction(implicitFunction, nan, nan);
-    }
-
-    // return the size of the input workspace write buffer to its initial value
-    // bc->setCacheParameters(sizeof(MDE),writeBufSize);
+        prog->report();
+      // For early cancelling of the loop
+      if (this->m_cancel)
+        break;
+    } // for each box in the vector
+    PARALLEL_END_INTERUPT_REGION
+  } // for each chunk in parallel
+  backgroundIO.reset();
+  PARALLEL_CHECK_INTERUPT_REGION
 }
 
 //----------------------------------------------------------------------------------------------
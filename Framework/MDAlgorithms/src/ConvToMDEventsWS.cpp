@@ -1,13 +1,26 @@
 #include "MantidMDAlgorithms/ConvToMDEventsWS.h"
 
 #include "MantidMDAlgorithms/UnitsConversionHelper.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+
+#include <exception>
+#include <memory>
 
 namespace Mantid {
 namespace MDAlgorithms {
-/**function converts particular list of events of type T into MD workspace and
- * adds these events to the workspace itself  */
+/**function converts particular list of events of type T into MD space and
+ * appends these events to the buffer of converted events
+ * @param workspaceIndex -- the workspace index of the event list
+ * @param qConverter -- the conversion into MD coordinates. It holds the
+ *                      coordinates of the spectrum, so every thread needs
+ *                      its own.
+ * @param converted  -- the buffer the converted events are appended to
+ * @returns the number of converted events  */
 template <class T>
-size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
+size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex,
+                                          MDTransfInterface &qConverter,
+                                          ConvertedEvents &converted) const {
 
   const Mantid::DataObjects::EventList &el =
       m_EventWS->getSpectrum(workspaceIndex);
@@ -24,21 +37,16 @@ size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
   std::vector<coord_t> locCoord(m_Coord);
   // set up unit conversion and calculate up all coordinates, which depend on
   // spectra index only
-  if (!m_QConverter->calcYDepCoordinates(locCoord, workspaceIndex))
+  if (!qConverter.calcYDepCoordinates(locCoord, workspaceIndex))
     return 0; // skip if any y outsize of the range of interest;
   localUnitConv.updateConversion(workspaceIndex);
   //
-  // allocate temporary buffers for MD Events data
-  // MD events coordinates buffer
-  std::vector<coord_t> allCoord;
-  std::vector<float> sig_err;      // array for signal and error.
-  std::vector<uint16_t> run_index; // Buffer for run index for each event
-  std::vector<uint32_t> det_ids;   // Buffer of det Id-s for each event
-
-  allCoord.reserve(this->m_NDims * numEvents);
-  sig_err.reserve(2 * numEvents);
-  run_index.reserve(numEvents);
-  det_ids.reserve(numEvents);
+  // reserve the buffers for MD Events data
+  const size_t nExisting = converted.runIndex.size();
+  converted.coord.reserve(this->m_NDims * (nExisting + numEvents));
+  converted.sigErr.reserve(2 * (nExisting + numEvents));
+  converted.runIndex.reserve(nExisting + numEvents);
+  converted.detIds.reserve(nExisting + numEvents);
 
   // This little dance makes the getting vector of events more general (since
   // you can't overload by return type).
@@ -51,42 +59,114 @@ size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
     double val = localUnitConv.convertUnits(it->tof());
     double signal = it->weight();
     double errorSq = it->errorSquared();
-    if (!m_QConverter->calcMatrixCoord(val, locCoord, signal, errorSq))
+    if (!qConverter.calcMatrixCoord(val, locCoord, signal, errorSq))
       continue; // skip ND outside the range
 
-    sig_err.push_back(static_cast<float>(signal));
-    sig_err.push_back(static_cast<float>(errorSq));
-    run_index.push_back(runIndexLoc);
-    det_ids.push_back(detID);
-    allCoord.insert(allCoord.end(), locCoord.begin(), locCoord.end());
+    converted.sigErr.push_back(static_cast<float>(signal));
+    converted.sigErr.push_back(static_cast<float>(errorSq));
+    converted.runIndex.push_back(runIndexLoc);
+    converted.detIds.push_back(detID);
+    converted.coord.insert(converted.coord.end(), locCoord.begin(),
+                           locCoord.end());
   }
 
-  // Add them to the MDEW
-  size_t n_added_events = run_index.size();
-  m_OutWSWrapper->addMDData(sig_err, run_index, det_ids, allCoord,
-                            n_added_events);
-  return n_added_events;
+  return converted.runIndex.size() - nExisting;
 }
 
-/** The method runs conversion for a single event list, corresponding to a
- * particular workspace index */
-size_t ConvToMDEventsWS::conversionChunk(size_t workspaceIndex) {
+/** The method converts the events of a single event list, corresponding to a
+ * particular workspace index, without adding them to the workspace */
+size_t ConvToMDEventsWS::convertSpectrum(size_t workspaceIndex,
+                                         MDTransfInterface &qConverter,
+                                         ConvertedEvents &converted) const {
 
   switch (m_EventWS->getSpectrum(workspaceIndex).getEventType()) {
   case Mantid::API::TOF:
     return this->convertEventList<Mantid::DataObjects::TofEvent>(
-        workspaceIndex);
+        workspaceIndex, qConverter, converted);
   case Mantid::API::WEIGHTED:
     return this->convertEventList<Mantid::DataObjects::WeightedEvent>(
-        workspaceIndex);
+        workspaceIndex, qConverter, converted);
   case Mantid::API::WEIGHTED_NOTIME:
     return this->convertEventList<Mantid::DataObjects::WeightedEventNoTime>(
-        workspaceIndex);
+        workspaceIndex, qConverter, converted);
   default:
     throw std::runtime_error("EventList had an unexpected data type!");
   }
 }
 
+/** The method runs conversion for a single event list, corresponding to a
+ * particular workspace index */
+size_t ConvToMDEventsWS::conversionChunk(size_t workspaceIndex) {
+  ConvertedEvents converted;
+  size_t nConverted =
+      this->convertSpectrum(workspaceIndex, *m_QConverter, converted);
+  m_OutWSWrapper->addMDData(converted.sigErr, converted.runIndex,
+                            converted.detIds, converted.coord, nConverted);
+  return nConverted;
+}
+
+/** The method converts the event lists of a block of spectra, in parallel if
+ * requested, and adds their events to the workspace in the order of the
+ * spectra. The events are added in one go, so that they are sorted into the
+ * boxes without locking each box for each event.
+ * @param begin -- the first workspace index of the block
+ * @param end   -- the workspace index after the last one of the block
+ * @param inParallel -- if the spectra should be converted in parallel
+ * @returns the number of events added to the workspace */
+size_t ConvToMDEventsWS::convertBlock(size_t begin, size_t end,
+                                      bool inParallel) {
+  // Each spectrum is staged separately, so that the events are added in
+  // the same order whatever the number of threads
+  std::vector<ConvertedEvents> staged(end - begin);
+  std::exception_ptr error;
+  PARALLEL_FOR_IF(inParallel)
+  for (int i = static_cast<int>(begin); i < static_cast<int>(end); ++i) {
+    const size_t workspaceIndex = static_cast<size_t>(i);
+    if (m_EventWS->getSpectrum(workspaceIndex).getNumberEvents() == 0)
+      continue;
+    try {
+      std::unique_ptr<MDTransfInterface> qConverter(m_QConverter->clone());
+      this->convertSpectrum(workspaceIndex, *qConverter,
+                            staged[workspaceIndex - begin]);
+    } catch (...) {
+      PARALLEL_CRITICAL(ConvToMDEventsWS_convertBlock) {
+        if (!error)
+          error = std::current_exception();
+      }
+    }
+  }
+  if (error)
+    std::rethrow_exception(error);
+
+  size_t nConverted = 0;
+  for (const auto &spectrum : staged)
+    nConverted += spectrum.runIndex.size();
+  if (nConverted == 0)
+    return 0;
+
+  ConvertedEvents converted;
+  converted.coord.reserve(this->m_NDims * nConverted);
+  converted.sigErr.reserve(2 * nConverted);
+  converted.runIndex.reserve(nConverted);
+  converted.detIds.reserve(nConverted);
+  for (auto &spectrum : staged) {
+    converted.coord.insert(converted.coord.end(), spectrum.coord.begin(),
+                           spectrum.coord.end());
+    converted.sigErr.insert(converted.sigErr.end(), spectrum.sigErr.begin(),
+                            spectrum.sigErr.end());
+    converted.runIndex.insert(converted.runIndex.end(),
+                              spectrum.runIndex.begin(),
+                              spectrum.runIndex.end());
+    converted.detIds.insert(converted.detIds.end(), spectrum.detIds.begin(),
+                            spectrum.detIds.end());
+    spectrum = ConvertedEvents();
+  }
+
+  m_OutWSWrapper->addMDData(converted.sigErr, converted.runIndex,
+                            converted.detIds, converted.coord, nConverted);
+  return nConverted;
+}
+
 /** method sets up all internal variables necessary to convert from Event
 Workspace to MDEvent workspace
 @param WSD         -- the class describing the target MD workspace, sorurce
@@ -125,7 +205,7 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
   size_t nValidSpectra = m_NSpectra;
 
   //--->>> Thread control stuff
-  Kernel::ThreadSchedulerFIFO *ts(nullptr);
+  Kernel::ThreadScheduler *ts(nullptr);
 
   int nThreads(m_NumThreads);
   if (nThreads < 0)
@@ -135,8 +215,9 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
   if (m_NumThreads != 0) {
     runMultithreaded = true;
     // Create the thread pool that will run all of these. It will be deleted by
-    // the threadpool
-    ts = new Kernel::ThreadSchedulerFIFO();
+    // the threadpool. Splitting a box creates tasks for its children, which
+    // are best run by the same thread.
+    ts = new Kernel::ThreadSchedulerWorkStealing(nThreads);
     // it will initiate thread pool with number threads or machine's cores (0 in
     // tp constructor)
     pProgress->resetNumSteps(nValidSpectra, 0, 1);
@@ -149,15 +230,27 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
   if (!m_QConverter->calcGenericVariables(m_Coord, m_NDims))
     return;
 
+  // Blocks of spectra are converted in parallel. A block holds at most this
+  // many events, to bound the memory of the staged events
+  const size_t maxBlockEvents = bc->getSignificantEventsNumber();
+
   size_t eventsAdded = 0;
-  for (size_t wi = 0; wi < nValidSpectra; wi++) {
+  size_t wi = 0;
+  while (wi < nValidSpectra) {
+    // The block ends where the boxes would need splitting
+    size_t blockEnd = wi;
+    size_t nBlockEvents = 0;
+    do {
+      nBlockEvents += m_EventWS->getSpectrum(blockEnd).getNumberEvents();
+      ++blockEnd;
+    } while (blockEnd < nValidSpectra && nBlockEvents < maxBlockEvents &&
+             !bc->shouldSplitBoxes(nEventsInWS + nBlockEvents,
+                                   eventsAdded + nBlockEvents, lastNumBoxes));
 
-    size_t nConverted = this->conversionChunk(wi);
+    size_t nConverted = this->convertBlock(wi, blockEnd, runMultithreaded);
     eventsAdded += nConverted;
     nEventsInWS += nConverted;
-    // Give this task to the scheduler
-    //%double cost = double(el.getNumberEvents());
-    // ts->push( new FunctionTask( func, cost) );
+    wi = blockEnd;
 
     // Keep a running total of how many events we've added
     if (bc->shouldSplitBoxes(nEventsInWS, eventsAdded, lastNumBoxes)) {
@@ -63,7 +63,8 @@ void MDEventWSWrapper::createEmptyEventWS<0>(const MDWSDescription &) {
 /** templated by number of dimensions function to add multidimensional data to
 the workspace
 * it is  expected that all MD coordinates are within the ranges of MD defined
-workspace, so no checks are performed
+workspace, so no checks are performed. Not thread-safe: only one thread may
+add data to the workspace at a time.
 
    tempate parameter:
      * nd -- number of dimensions
@@ -88,11 +89,14 @@ void MDEventWSWrapper::addMDDataND(float *sigErr, uint16_t *runIndex,
           DataObjects::MDEventWorkspace<DataObjects::MDEvent<nd>, nd> *>(
           m_Workspace.get());
   if (pWs) {
+    std::vector<DataObjects::MDEvent<nd>> events;
+    events.reserve(dataSize);
     for (size_t i = 0; i < dataSize; i++) {
-      pWs->addEvent(DataObjects::MDEvent<nd>(
-          *(sigErr + 2 * i), *(sigErr + 2 * i + 1), *(runIndex + i),
-          *(detId + i), (Coord + i * nd)));
+      events.emplace_back(*(sigErr + 2 * i), *(sigErr + 2 * i + 1),
+                          *(runIndex + i), *(detId + i), (Coord + i * nd));
     }
+    // Sort the events into the boxes in one go, without locking every box
+    pWs->getBox()->addEventsUnsafe(events);
   } else {
     DataObjects::MDEventWorkspace<DataObjects::MDLeanEvent<nd>, nd> *const
         pLWs = dynamic_cast<
@@ -104,10 +108,13 @@ void MDEventWSWrapper::addMDDataND(float *sigErr, uint16_t *runIndex,
                                "does not correspond to type of events you try "
                                "to add to it");
 
+    std::vector<DataObjects::MDLeanEvent<nd>> events;
+    events.reserve(dataSize);
     for (size_t i = 0; i < dataSize; i++) {
-      pLWs->addEvent(DataObjects::MDLeanEvent<nd>(
-          *(sigErr + 2 * i), *(sigErr + 2 * i + 1), (Coord + i * nd)));
+      events.emplace_back(*(sigErr + 2 * i), *(sigErr + 2 * i + 1),
+                          (Coord + i * nd));
     }
+    pLWs->getBox()->addEventsUnsafe(events);
   }
 }
 
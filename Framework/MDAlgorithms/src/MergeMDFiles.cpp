@@ -1,6 +1,7 @@
 #include "MantidAPI/FileProperty.h"
 #include "MantidAPI/MultipleFileProperty.h"
 #include "MantidKernel/CPUTimer.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/System.h"
 #include "MantidDataObjects/MDBoxBase.h"
@@ -11,6 +12,9 @@
 #include <boost/scoped_ptr.hpp>
 #include <Poco/File.h>
 
+#include <algorithm>
+#include <future>
+
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
 using namespace Mantid::DataObjects;
@@ -21,6 +25,12 @@ namespace MDAlgorithms {
 // Register the algorithm into the AlgorithmFactory
 DECLARE_ALGORITHM(MergeMDFiles)
 
+namespace {
+/// Memory used by the events of the boxes merged at a time in parallel, in
+/// bytes
+const uint64_t EXTENT_MEMORY = 200000000;
+}
+
 //----------------------------------------------------------------------------------------------
 /** Constructor
  */
@@ -53,8 +63,9 @@ void MergeMDFiles::init() {
       "If not, it will be created in memory.");
 
   declareProperty("Parallel", false,
-                  "Run the loading tasks in parallel.\n"
-                  "This can be faster but might use more memory.");
+                  "Merge the boxes in parallel, while reading the input files "
+                  "and writing the output file in large blocks.\n"
+                  "This is faster but uses more memory.");
 
   declareProperty(make_unique<WorkspaceProperty<IMDEventWorkspace>>(
                       "OutputWorkspace", "", Direction::Output),
@@ -180,6 +191,221 @@ uint64_t MergeMDFiles::loadEventsFromSubBoxes(API::IMDNode *TargetBox) {
   return nBoxEvents;
 }
 
+//----------------------------------------------------------------------------------------------
+/** Merge the boxes in parallel, an extent of consecutive boxes at a time.
+ * While the boxes of an extent are merged by several threads, the events of
+ * the next extent are read from the input files and those of the previous
+ * one are written to the output file in one block. The NeXus API is not
+ * thread safe, so the file I/O is done by one thread.
+ *
+ * @param saver :: file of the output workspace; null if it is not
+ *file-backed
+ */
+void MergeMDFiles::mergeInExtents(API::IBoxControllerIO *saver) {
+  // The boxes with events, in the order of their events in the output file
+  std::vector<API::IMDNode *> boxes;
+  for (auto box : m_BoxStruct.getBoxes())
+    if (box->isBox())
+      boxes.push_back(box);
+  if (boxes.empty())
+    return;
+
+  // Split them into extents with about EXTENT_MEMORY of events
+  const std::vector<uint64_t> &targetEventIndexes = m_BoxStruct.getEventIndex();
+  const uint64_t maxEvents =
+      std::max(uint64_t(1), EXTENT_MEMORY / m_OutIWS->sizeofEvent());
+  std::vector<size_t> bounds(1, 0);
+  uint64_t numEvents = 0;
+  for (size_t i = 0; i < boxes.size(); ++i) {
+    numEvents += targetEventIndexes[2 * boxes[i]->getID() + 1];
+    if (numEvents >= maxEvents) {
+      bounds.push_back(i + 1);
+      numEvents = 0;
+    }
+  }
+  if (bounds.back() != boxes.size())
+    bounds.push_back(boxes.size());
+  const size_t numExtents = bounds.size() - 1;
+  g_log.information() << "Merging the boxes in " << numExtents
+                      << " extents.\n";
+
+  // Two sets of buffers, one being merged while the other is read and written
+  Extent extents[2];
+  std::vector<coord_t> outputs[2];
+  extents[0].begin = bounds[0];
+  extents[0].end = bounds[1];
+  this->readExtent(boxes, extents[0]);
+
+  std::future<void> io;
+  for (size_t k = 0; k < numExtents; ++k) {
+    const Extent &extent = extents[k % 2];
+    Extent &next = extents[(k + 1) % 2];
+    const std::vector<coord_t> &previousOutput = outputs[(k + 1) % 2];
+    // next still holds the previous extent until the next one is read
+    io = std::async(std::launch::async, [&, k] {
+      if (saver && k > 0 && !previousOutput.empty())
+        saver->saveBlock(previousOutput, next.outputPosition);
+      if (k + 1 < numExtents) {
+        next.begin = bounds[k + 1];
+        next.end = bounds[k + 2];
+        this->readExtent(boxes, next);
+      }
+    });
+    this->mergeExtent(boxes, extent, outputs[k % 2]);
+    io.get();
+    prog->reportIncrement(extent.end - extent.begin,
+                          "Loading and merging box data");
+  }
+  const size_t last = (numExtents - 1) % 2;
+  if (saver && !outputs[last].empty())
+    saver->saveBlock(outputs[last], extents[last].outputPosition);
+}
+
+/** Read the events of an extent of boxes from all the input files. The
+ * events of the boxes that are next to each other in a file are read in one
+ * block.
+ *
+ * @param boxes :: the boxes with events of the output workspace
+ * @param extent :: the range of boxes to read; filled with their events
+ */
+void MergeMDFiles::readExtent(const std::vector<API::IMDNode *> &boxes,
+                              Extent &extent) {
+  const size_t numFiles = m_EventLoader.size();
+  const size_t numBoxes = extent.end - extent.begin;
+  extent.blocks.clear();
+  extent.boxBlocks.assign(numBoxes * numFiles,
+                          std::pair<size_t, size_t>(0, 0));
+  extent.outputPosition =
+      m_BoxStruct.getEventIndex()[2 * boxes[extent.begin]->getID()];
+
+  // The events of a box in a file
+  struct BoxEvents {
+    uint64_t position;
+    uint64_t numEvents;
+    size_t box;
+  };
+  std::vector<BoxEvents> fileEvents;
+  for (size_t iw = 0; iw < numFiles; ++iw) {
+    const std::vector<uint64_t> &eventIndex =
+        m_fileComponentsStructure[iw].getEventIndex();
+    fileEvents.clear();
+    for (size_t i = 0; i < numBoxes; ++i) {
+      const size_t ID = boxes[extent.begin + i]->getID();
+      if (eventIndex[2 * ID + 1] > 0)
+        fileEvents.push_back({eventIndex[2 * ID], eventIndex[2 * ID + 1], i});
+    }
+    std::sort(fileEvents.begin(), fileEvents.end(),
+              [](const BoxEvents &a, const BoxEvents &b) {
+                return a.position < b.position;
+              });
+
+    for (size_t first = 0; first < fileEvents.size();) {
+      // Boxes whose events follow each other in the file
+      uint64_t blockEvents = fileEvents[first].numEvents;
+      size_t end = first + 1;
+      while (end < fileEvents.size() &&
+             fileEvents[end].position ==
+                 fileEvents[first].position + blockEvents) {
+        blockEvents += fileEvents[end].numEvents;
+        ++end;
+      }
+      extent.blocks.emplace_back();
+      m_EventLoader[iw]->loadBlock(extent.blocks.back(),
+                                   fileEvents[first].position,
+                                   static_cast<size_t>(blockEvents));
+      extent.numColumns =
+          extent.blocks.back().size() / static_cast<size_t>(blockEvents);
+      for (size_t j = first; j < end; ++j)
+        extent.boxBlocks[fileEvents[j].box * numFiles + iw] = std::make_pair(
+            extent.blocks.size() - 1,
+            static_cast<size_t>(fileEvents[j].position -
+                                fileEvents[first].position));
+      first = end;
+    }
+  }
+}
+
+/** Merge the events of an extent of boxes from all the files, in parallel.
+ * If the output workspace is file-backed, the events are put in the output
+ * block, at the place of the box in the file, and the boxes are marked as
+ * saved. If not, they are added to the boxes.
+ *
+ * @param boxes :: the boxes with events of the output workspace
+ * @param extent :: the range of boxes and their events read from the files
+ * @param output :: filled with the events of the extent to write to the
+ *output file, if any.
+ */
+void MergeMDFiles::mergeExtent(const std::vector<API::IMDNode *> &boxes,
+                               const Extent &extent,
+                               std::vector<coord_t> &output) {
+  const size_t numFiles = m_EventLoader.size();
+  const size_t numColumns = extent.numColumns;
+  const std::vector<uint64_t> &targetEventIndexes = m_BoxStruct.getEventIndex();
+  output.clear();
+  if (m_fileBasedTargetWS) {
+    const size_t lastID = boxes[extent.end - 1]->getID();
+    const uint64_t numEvents = targetEventIndexes[2 * lastID] +
+                               targetEventIndexes[2 * lastID + 1] -
+                               extent.outputPosition;
+    output.resize(static_cast<size_t>(numEvents) * numColumns);
+  }
+
+  PRAGMA_OMP(parallel for schedule(dynamic, 16)
+             num_threads(Kernel::threadsForParallelRegion()))
+  for (int i = 0; i < static_cast<int>(extent.end - extent.begin); ++i) {
+    PARALLEL_START_INTERUPT_REGION
+    API::IMDNode *box = boxes[extent.begin + i];
+    const size_t ID = box->getID();
+    const size_t numEvents = static_cast<size_t>(targetEventIndexes[2 * ID + 1]);
+    // get rid of the events and averages which are in the memory erroneously
+    // (from cloning)
+    box->clear();
+    if (numEvents > 0) {
+      // Copy the events of the box from each file one after the other
+      std::vector<coord_t> table;
+      coord_t *events;
+      if (m_fileBasedTargetWS) {
+        events = output.data() +
+                 static_cast<size_t>(targetEventIndexes[2 * ID] -
+                                     extent.outputPosition) *
+                     numColumns;
+      } else {
+        table.resize(numEvents * numColumns);
+        events = table.data();
+      }
+      coord_t *out = events;
+      for (size_t iw = 0; iw < numFiles; ++iw) {
+        const size_t fileEvents = static_cast<size_t>(
+            m_fileComponentsStructure[iw].getEventIndex()[2 * ID + 1]);
+        if (fileEvents == 0)
+          continue;
+        const auto &boxBlock = extent.boxBlocks[i * numFiles + iw];
+        const coord_t *in = extent.blocks[boxBlock.first].data() +
+                            boxBlock.second * numColumns;
+        out = std::copy(in, in + fileEvents * numColumns, out);
+      }
+
+      if (m_fileBasedTargetWS) {
+        // The signal and the squared error are the first two values of each
+        // event. Keep their sums, as saving the box would.
+        double signal = 0.0;
+        double errorSquared = 0.0;
+        for (size_t j = 0; j < numEvents; ++j) {
+          signal += events[j * numColumns];
+          errorSquared += events[j * numColumns + 1];
+        }
+        box->setSignal(static_cast<signal_t>(signal));
+        box->setErrorSquared(static_cast<signal_t>(errorSquared));
+        box->setFileBacked(targetEventIndexes[2 * ID], numEvents, true);
+      } else {
+        box->setEventsData(table);
+      }
+    }
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+}
+
 //----------------------------------------------------------------------------------------------
 /** Perform the merging, but clone the initial workspace and use the same
  *splitting
@@ -194,8 +420,8 @@ void MergeMDFiles::doExecByCloning(Mantid::API::IMDEventWorkspace_sptr ws,
   m_OutIWS = ws;
   m_MDEventType = ws->getEventTypeName();
 
-  // Run the tasks in parallel? TODO: enable
-  // bool Parallel = this->getProperty("Parallel");
+  // Merge the boxes in parallel?
+  bool Parallel = this->getProperty("Parallel");
 
   // Fix the box controller settings in the output workspace so that it splits
   // normally
@@ -249,41 +475,33 @@ void MergeMDFiles::doExecByCloning(Mantid::API::IMDEventWorkspace_sptr ws,
   this->totalLoaded = 0;
   std::vector<API::IMDNode *> &boxes = m_BoxStruct.getBoxes();
 
-  for (size_t ib = 0; ib < numBoxes; ib++) {
-    auto box = boxes[ib];
-    if (!box->isBox())
-      continue;
-    // load all contributed events into current box;
-    this->loadEventsFromSubBoxes(boxes[ib]);
-
-    if (DiskBuf) {
-      if (box->getDataInMemorySize() >
-          0) { // data position has been already pre-calculated
-        box->getISaveable()->save();
-        box->clearDataFromMemory();
-        // Kernel::ISaveable *Saver = box->getISaveable();
-        // DiskBuf->toWrite(Saver);
+  if (Parallel) {
+    this->mergeInExtents(m_fileBasedTargetWS ? bc->getFileIO() : nullptr);
+  } else {
+    for (size_t ib = 0; ib < numBoxes; ib++) {
+      auto box = boxes[ib];
+      if (!box->isBox())
+        continue;
+      // load all contributed events into current box;
+      this->loadEventsFromSubBoxes(boxes[ib]);
+
+      if (DiskBuf) {
+        if (box->getDataInMemorySize() >
+            0) { // data position has been already pre-calculated
+          box->getISaveable()->save();
+          box->clearDataFromMemory();
+          // Kernel::ISaveable *Saver = box->getISaveable();
+          // DiskBuf->toWrite(Saver);
+        }
       }
+      // else
+      //{   size_t ID = box->getID();
+      //    uint64_t filePosition = targetEventIndexes[2*ID];
+      //    box->saveAt(saver.get(), filePosition);
+      //}
+
+      prog->reportIncrement(ib, "Loading and merging box data");
     }
-    // else
-    //{   size_t ID = box->getID();
-    //    uint64_t filePosition = targetEventIndexes[2*ID];
-    //    box->saveAt(saver.get(), filePosition);
-    //}
-    //
-    // if (!Parallel)
-    //{
-    //  // Run the task serially only
-    //  task->run();
-    //  delete task;
-    //}
-    // else
-    //{
-    //  // Enqueue to run in parallel (at the joinAll() call below).
-    //  ts->push(task);
-    //}
-
-    prog->reportIncrement(ib, "Loading and merging box data");
   }
   if (DiskBuf) {
     DiskBuf->flushCache();
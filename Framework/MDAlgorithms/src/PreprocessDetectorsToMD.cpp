@@ -213,6 +213,8 @@ void PreprocessDetectorsToMD::processDetectorsPositions(
       "InstrumentName", InstrName,
       true); // "The name which should unique identify current instrument");
   targWS->logs()->addProperty<bool>("FakeDetectors", false, true);
+  // Compute the positions of all detectors at once, in parallel
+  instrument->cacheDetectorPositions();
 
   // get access to the workspace memory
   auto &sp2detMap = targWS->getColVector<size_t>("spec2detMap");
@@ -10,6 +10,8 @@
 #include "MantidGeometry/MDGeometry/MDHistoDimension.h"
 #include "MantidKernel/BoundedValidator.h"
 
+#include <algorithm>
+
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
 using namespace Mantid::Geometry;
@@ -194,33 +196,48 @@ void SliceMD::slice(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   uint64_t totalAdded = outWS->getNEvents();
   uint64_t numSinceSplit = 0;
 
+  // Buffers for the coordinates of a block of events, and the new events
+  std::vector<coord_t> inCenters;
+  std::vector<coord_t> outCenters;
+  std::vector<OMDE> newEvents;
+  newEvents.reserve(TRANSFORM_BLOCK_SIZE);
+
   // Go through every box for this chunk.
   // PARALLEL_FOR_IF( !bc->isFileBacked() )
   for (int i = 0; i < int(boxes.size()); i++) {
     MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(boxes[i]);
     // Perform the binning in this separate method.
     if (box && !box->getIsMasked()) {
-      // An array to hold the rotated/transformed coordinates
-      coord_t outCenter[ond];
-
       const std::vector<MDE> &events = box->getConstEvents();
 
-      for (auto it = events.cbegin(); it != events.cend(); ++it) {
-        // Cache the center of the event (again for speed)
-        const coord_t *inCenter = it->getCenter();
-
-        if (function->isPointContained(inCenter)) {
-          // Now transform to the output dimensions
-          m_transformFromOriginal->apply(inCenter, outCenter);
-
+      // Transform the events in blocks, then add those in the slice
+      for (size_t first = 0; first < events.size();
+           first += TRANSFORM_BLOCK_SIZE) {
+        const size_t numInBlock =
+            std::min(TRANSFORM_BLOCK_SIZE, events.size() - first);
+        transformEvents<MDE, nd>(*m_transformFromOriginal,
+                                 events.data() + first, numInBlock, inCenters,
+                                 outCenters);
+
+        newEvents.clear();
+        for (size_t j = 0; j < numInBlock; ++j) {
+          const MDE &event = events[first + j];
+          if (!function->isPointContained(event.getCenter()))
+            continue;
+          // An array to hold the rotated/transformed coordinates
+          coord_t outCenter[ond];
+          for (size_t d = 0; d < ond; ++d)
+            outCenter[d] = outCenters[d * numInBlock + j];
           // Create the event
-          OMDE newEvent(it->getSignal(), it->getErrorSquared(), outCenter);
+          OMDE newEvent(event.getSignal(), event.getErrorSquared(), outCenter);
           // Copy extra data, if any
-          copyEvent(*it, newEvent);
-          // Add it to the workspace
-          if (outRootBox->addEvent(newEvent))
-            numSinceSplit++;
+          copyEvent(event, newEvent);
+          newEvents.push_back(newEvent);
         }
+        // Add them to the workspace. Boxes are sliced one at a time, so
+        // nothing else adds events meanwhile.
+        numSinceSplit +=
+            newEvents.size() - outRootBox->addEventsUnsafe(newEvents);
       }
       box->releaseEvents();
 
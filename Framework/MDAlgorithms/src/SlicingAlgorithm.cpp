@@ -21,6 +21,8 @@ using Mantid::Kernel::Strings::strip;
 namespace Mantid {
 namespace MDAlgorithms {
 
+const size_t SlicingAlgorithm::TRANSFORM_BLOCK_SIZE;
+
 //----------------------------------------------------------------------------------------------
 /** Constructor
  */
@@ -291,6 +291,44 @@ public:
                  true /*IterateEvents*/, 20 /*numEventsPerBox*/, VMD(0, 0, 1));
   }
 
+  MDHistoWorkspace_sptr binFourEventsPerBox(const bool parallel) {
+    IMDEventWorkspace_sptr in_ws =
+        MDEventsTestHelper::makeMDEW<3>(10, 0.0, 10.0, 4);
+    BinMD alg;
+    alg.setChild(true);
+    alg.initialize();
+    alg.setProperty("InputWorkspace", in_ws);
+    alg.setPropertyValue("AlignedDim0", "Axis0,0.5,9.5, 7");
+    alg.setPropertyValue("AlignedDim1", "Axis1,0.0,10.0, 4");
+    alg.setPropertyValue("AlignedDim2", "Axis2,2.0,8.0, 3");
+    alg.setProperty("Parallel", parallel);
+    alg.setPropertyValue("OutputWorkspace", "unused");
+    alg.execute();
+    TS_ASSERT(alg.isExecuted());
+    Workspace_sptr out = alg.getProperty("OutputWorkspace");
+    return boost::dynamic_pointer_cast<MDHistoWorkspace>(out);
+  }
+
+  void test_exec_Parallel_gives_the_same_bins() {
+    MDHistoWorkspace_sptr serial = binFourEventsPerBox(false);
+    MDHistoWorkspace_sptr parallel = binFourEventsPerBox(true);
+    TS_ASSERT(serial);
+    TS_ASSERT(parallel);
+    if (!serial || !parallel)
+      return;
+    TS_ASSERT_EQUALS(parallel->getNPoints(), 7 * 4 * 3);
+    double total = 0.0;
+    for (size_t i = 0; i < serial->getNPoints(); i++) {
+      TS_ASSERT_DELTA(parallel->getSignalAt(i), serial->getSignalAt(i), 1e-5);
+      TS_ASSERT_DELTA(parallel->getErrorAt(i), serial->getErrorAt(i), 1e-5);
+      TS_ASSERT_DELTA(parallel->getNumEventsAt(i), serial->getNumEventsAt(i),
+                      1e-5);
+      total += parallel->getSignalAt(i);
+    }
+    // The events between 0.5 and 9.5 in X and 2 and 8 in Z
+    TS_ASSERT_DELTA(total, 4.0 * 9 * 10 * 6, 1e-5);
+  }
+
   bool etta(int x, int base) {
     int ii = x - base / 2;
     if (ii < 0)
@@ -522,6 +522,76 @@ public:
     }
   }
 
+  /** No events are lost when they are added to a file-backed workspace with
+   * background I/O on */
+  void test_execute_filebackend_with_background_IO() {
+    std::string file_name = "convert_to_md_test_background_io.nxs";
+    if (Poco::File(file_name).exists())
+      Poco::File(file_name).remove();
+    {
+      auto test_workspace = createTestWorkspaces();
+      Algorithm_sptr min_max_alg = AlgorithmManager::Instance().createUnmanaged(
+          "ConvertToMDMinMaxGlobal");
+      min_max_alg->initialize();
+      min_max_alg->setChild(true);
+      min_max_alg->setProperty("InputWorkspace", test_workspace);
+      min_max_alg->setProperty("QDimensions", "Q3D");
+      min_max_alg->setProperty("dEAnalysisMode", "Direct");
+      min_max_alg->executeAsChildAlg();
+      std::string min_values = min_max_alg->getPropertyValue("MinValues");
+      std::string max_values = min_max_alg->getPropertyValue("MaxValues");
+
+      auto convert = [&](IMDEventWorkspace_sptr out_ws) {
+        Algorithm_sptr convert_alg =
+            AlgorithmManager::Instance().createUnmanaged("ConvertToMD");
+        convert_alg->initialize();
+        convert_alg->setChild(true);
+        convert_alg->setProperty("InputWorkspace", test_workspace);
+        convert_alg->setProperty("QDimensions", "Q3D");
+        convert_alg->setProperty("dEAnalysisMode", "Direct");
+        convert_alg->setPropertyValue("MinValues", min_values);
+        convert_alg->setPropertyValue("MaxValues", max_values);
+        convert_alg->setPropertyValue("SplitThreshold", "10");
+        if (out_ws) {
+          convert_alg->setProperty("OutputWorkspace", out_ws);
+          convert_alg->setProperty("OverwriteExisting", false);
+        } else {
+          convert_alg->setProperty("Filename", file_name);
+          convert_alg->setProperty("FileBackEnd", true);
+          convert_alg->setProperty("OutputWorkspace", "blank");
+        }
+        TS_ASSERT_THROWS_NOTHING(convert_alg->execute());
+        IMDEventWorkspace_sptr result =
+            convert_alg->getProperty("OutputWorkspace");
+        return result;
+      };
+
+      IMDEventWorkspace_sptr out_ws = convert(IMDEventWorkspace_sptr());
+      TS_ASSERT(out_ws);
+      if (!out_ws)
+        return;
+      file_name = out_ws->getBoxController()->getFilename();
+      const uint64_t numEvents = out_ws->getNPoints();
+      const double signal = out_ws->getBox()->getSignal();
+      TS_ASSERT_LESS_THAN(0u, numEvents);
+
+      // Add the same events again, with a small write buffer
+      auto fileIO = out_ws->getBoxController()->getFileIO();
+      fileIO->setWriteBufferSize(100);
+      fileIO->setBackgroundIO(true);
+      TS_ASSERT_EQUALS(convert(out_ws), out_ws);
+      TS_ASSERT(fileIO->getBackgroundIO());
+      fileIO->flushCache();
+      out_ws->refreshCache();
+      TS_ASSERT_EQUALS(out_ws->getNPoints(), 2 * numEvents);
+      TS_ASSERT_DELTA(out_ws->getBox()->getSignal(), 2 * signal,
+                      1e-6 * signal);
+      out_ws->clearFileBacked(false);
+    }
+    if (Poco::File(file_name).exists())
+      Poco::File(file_name).remove();
+  }
+
 private:
   void checkHistogramsHaveBeenStored(const std::string &wsName,
                                      double val = 0.34, double bin_min = 0.3,
@@ -26,7 +26,13 @@ public:
 
   void test_exec_fileBacked() { do_test_exec("MergeMDFilesTest_OutputWS.nxs"); }
 
-  void do_test_exec(std::string OutputFilename) {
+  void test_exec_Parallel() { do_test_exec("", true); }
+
+  void test_exec_fileBacked_Parallel() {
+    do_test_exec("MergeMDFilesTest_OutputWS.nxs", true);
+  }
+
+  void do_test_exec(std::string OutputFilename, bool parallel = false) {
     if (OutputFilename != "") {
       if (Poco::File(OutputFilename).exists())
         Poco::File(OutputFilename).remove();
@@ -62,6 +68,7 @@ public:
         alg.setPropertyValue("OutputFilename", OutputFilename));
     TS_ASSERT_THROWS_NOTHING(
         alg.setPropertyValue("OutputWorkspace", outWSName));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("Parallel", parallel));
 
     // clean up possible rubbish from previous runs
     std::string fullName = alg.getPropertyValue("OutputFilename");
@@ -93,6 +100,14 @@ public:
     for (size_t i = 0; i < box->getNumChildren(); i++)
       TS_ASSERT_LESS_THAN(1, box->getChild(i)->getNPoints());
 
+    // The signal of each box is the sum of the signals in the input files
+    for (size_t i = 0; i < box->getNumChildren(); i++) {
+      double signal = 0;
+      for (const auto &inWS : inWorkspaces)
+        signal += inWS->getBox()->getChild(i)->getSignal();
+      TS_ASSERT_DELTA(box->getChild(i)->getSignal(), signal, 1e-3);
+    }
+
     if (!OutputFilename.empty()) {
       TS_ASSERT(ws->isFileBacked());
       TS_ASSERT(Poco::File(actualOutputFilename).exists());
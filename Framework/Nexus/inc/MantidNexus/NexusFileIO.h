@@ -92,16 +92,23 @@ public:
   int writeNexusProcessedDataEvent(
       const DataObjects::EventWorkspace_const_sptr &ws);
 
-  int writeNexusProcessedDataEventCombined(
+  int openNexusProcessedDataEventColumns(
       const DataObjects::EventWorkspace_const_sptr &ws,
-      std::vector<int64_t> &indices, double *tofs, float *weights,
-      float *errorSquareds, int64_t *pulsetimes, bool compress) const;
+      std::vector<int64_t> &indices, bool writePulsetime, bool writeWeight,
+      bool compress) const;
+
+  void writeNexusProcessedDataEventSlab(int64_t start, int64_t size,
+                                        double *tofs, float *weights,
+                                        float *errorSquareds,
+                                        int64_t *pulsetimes) const;
+
+  int closeNexusProcessedDataEventColumns() const;
 
   int writeEventList(const DataObjects::EventList &el,
                      std::string group_name) const;
 
   template <class T>
-  void writeEventListData(std::vector<T> events, bool writeTOF,
+  void writeEventListData(const std::vector<T> &events, bool writeTOF,
                           bool writePulsetime, bool writeWeight,
                           bool writeError) const;
   void NXwritedata(const char *name, int datatype, int rank, int *dims_array,
@@ -135,6 +142,9 @@ private:
   int m_nexuscompression;
   /// Allow an externally supplied progress object to be used
   API::Progress *m_progress;
+  /// Create a column of the combined event data
+  void makeEventColumn(const std::string &name, ::NeXus::NXnumtype type,
+                       int64_t numEvents, bool compress) const;
   /// Write a simple value plus possible attributes
   template <class TYPE>
   bool writeNxValue(const std::string &name, const TYPE &value,
@@ -3,6 +3,7 @@
 //----------------------------------------------------------------------
 // Includes
 //----------------------------------------------------------------------
+#include <algorithm>
 #include <vector>
 #include <sstream>
 
@@ -32,6 +33,9 @@ using namespace DataObjects;
 namespace {
 /// static logger
 Logger g_log("NexusFileIO");
+
+/// Number of events in each chunk of the compressed event columns
+const int64_t EVENT_CHUNK_SIZE = 65536;
 }
 
 /// Empty default constructor
@@ -706,20 +710,22 @@ int NexusFileIO::writeNexusTableWorkspace(
 }
 
 //-------------------------------------------------------------------------------------
-/** Write out a combined chunk of event data
+/** Write out the index of the combined event data, and create the columns of
+ * the events, to be filled with writeNexusProcessedDataEventSlab(). The
+ * event_workspace group stays open until closeNexusProcessedDataEventColumns()
+ * is called.
  *
  * @param ws :: an EventWorkspace
- * @param indices :: array of event list indexes
- * @param tofs :: array of TOFs
- * @param weights :: array of event weights
- * @param errorSquareds :: array of event squared errors
- * @param pulsetimes :: array of pulsetimes
- * @param compress :: if true, compress the entry
+ * @param indices :: array of event list indexes, the last one being the total
+ * number of events
+ * @param writePulsetime :: if true, create the pulse time column
+ * @param writeWeight :: if true, create the weight and error columns
+ * @param compress :: if true, compress the columns in chunks
  */
-int NexusFileIO::writeNexusProcessedDataEventCombined(
+int NexusFileIO::openNexusProcessedDataEventColumns(
     const DataObjects::EventWorkspace_const_sptr &ws,
-    std::vector<int64_t> &indices, double *tofs, float *weights,
-    float *errorSquareds, int64_t *pulsetimes, bool compress) const {
+    std::vector<int64_t> &indices, bool writePulsetime, bool writeWeight,
+    bool compress) const {
   NXopengroup(fileID, "event_workspace", "NXdata");
 
   // The array of indices for each event list #
@@ -741,24 +747,84 @@ int NexusFileIO::writeNexusProcessedDataEventCombined(
     NXclosedata(fileID);
   }
 
-  // Write out each field
-  dims_array[0] = static_cast<int>(
-      indices.back()); // TODO big truncation error! This is the # of events
+  // Create each column, as long as the total number of events
+  const int64_t numEvents = indices.empty() ? 0 : indices.back();
+  makeEventColumn("tof", ::NeXus::FLOAT64, numEvents, compress);
+  if (writePulsetime)
+    makeEventColumn("pulsetime", ::NeXus::INT64, numEvents, compress);
+  if (writeWeight) {
+    makeEventColumn("weight", ::NeXus::FLOAT32, numEvents, compress);
+    makeEventColumn("error_squared", ::NeXus::FLOAT32, numEvents, compress);
+  }
+  return 0;
+}
+
+//-------------------------------------------------------------------------------------
+/** Write a slab of the event columns created by
+ * openNexusProcessedDataEventColumns()
+ *
+ * @param start :: index of the first event of the slab in the columns
+ * @param size :: number of events in the slab
+ * @param tofs :: array of TOFs
+ * @param weights :: array of event weights, or NULL if not written
+ * @param errorSquareds :: array of event squared errors, or NULL if not
+ * written
+ * @param pulsetimes :: array of pulsetimes, or NULL if not written
+ */
+void NexusFileIO::writeNexusProcessedDataEventSlab(
+    int64_t start, int64_t size, double *tofs, float *weights,
+    float *errorSquareds, int64_t *pulsetimes) const {
+  if (size <= 0)
+    return;
+  std::vector<int64_t> startDims(1, start);
+  std::vector<int64_t> sizeDims(1, size);
+  auto putSlab = [&](const std::string &name, void *data) {
+    m_filehandle->openData(name);
+    m_filehandle->putSlab(data, startDims, sizeDims);
+    m_filehandle->closeData();
+  };
   if (tofs)
-    NXwritedata("tof", NX_FLOAT64, 1, dims_array, tofs, compress);
+    putSlab("tof", tofs);
   if (pulsetimes)
-    NXwritedata("pulsetime", NX_INT64, 1, dims_array, pulsetimes, compress);
+    putSlab("pulsetime", pulsetimes);
   if (weights)
-    NXwritedata("weight", NX_FLOAT32, 1, dims_array, weights, compress);
+    putSlab("weight", weights);
   if (errorSquareds)
-    NXwritedata("error_squared", NX_FLOAT32, 1, dims_array, errorSquareds,
-                compress);
+    putSlab("error_squared", errorSquareds);
+}
 
-  // Close up the overall group
+//-------------------------------------------------------------------------------------
+/** Close the event_workspace group opened by
+ * openNexusProcessedDataEventColumns() */
+int NexusFileIO::closeNexusProcessedDataEventColumns() const {
   NXstatus status = NXclosegroup(fileID);
   return ((status == NX_ERROR) ? 3 : 0);
 }
 
+//-------------------------------------------------------------------------------------
+/** Create a column of events in the open group. Compressed columns are split
+ * into chunks of EVENT_CHUNK_SIZE events, so that they are compressed
+ * piecewise as slabs are written, and can be read back in parts.
+ *
+ * @param name :: name of the column
+ * @param type :: type of the values
+ * @param numEvents :: length of the column
+ * @param compress :: if true, compress the column
+ */
+void NexusFileIO::makeEventColumn(const std::string &name,
+                                  ::NeXus::NXnumtype type, int64_t numEvents,
+                                  bool compress) const {
+  std::vector<int64_t> dims(1, numEvents);
+  if (compress && numEvents > 0) {
+    std::vector<int64_t> chunk(1, std::min(numEvents, EVENT_CHUNK_SIZE));
+    m_filehandle->makeCompData(
+        name, type, dims,
+        static_cast< ::NeXus::NXcompression>(m_nexuscompression), chunk);
+  } else {
+    m_filehandle->makeData(name, type, dims);
+  }
+}
+
 //-------------------------------------------------------------------------------------
 /** Write out all of the event lists in the given workspace
  * @param ws :: an EventWorkspace */
@@ -809,7 +875,8 @@ void NexusFileIO::NXwritedata(const char *name, int datatype, int rank,
  * @param writeError :: if true, write the errors
  */
 template <class T>
-void NexusFileIO::writeEventListData(std::vector<T> events, bool writeTOF,
+void NexusFileIO::writeEventListData(const std::vector<T> &events,
+                                     bool writeTOF,
                                      bool writePulsetime, bool writeWeight,
                                      bool writeError) const {
   // Do nothing if there are no events.
@@ -818,8 +885,8 @@ void NexusFileIO::writeEventListData(std::vector<T> events, bool writeTOF,
 
   size_t num = events.size();
   auto tofs = new double[num];
-  auto weights = new double[num];
-  auto errorSquareds = new double[num];
+  auto weights = new float[num];
+  auto errorSquareds = new float[num];
   auto pulsetimes = new int64_t[num];
 
   typename std::vector<T>::const_iterator it;
@@ -833,9 +900,9 @@ void NexusFileIO::writeEventListData(std::vector<T> events, bool writeTOF,
     if (writePulsetime)
       pulsetimes[i] = it->pulseTime().totalNanoseconds();
     if (writeWeight)
-      weights[i] = it->weight();
+      weights[i] = static_cast<float>(it->weight());
     if (writeError)
-      errorSquareds[i] = it->errorSquared();
+      errorSquareds[i] = static_cast<float>(it->errorSquared());
     i++;
   }
 